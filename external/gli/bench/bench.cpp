@@ -0,0 +1,486 @@
+/// Benchmarks of the gli and glm hot paths of the skybox viewer, on synthetic deterministic inputs.
+///
+/// Usage: gli-bench [--quick] [--filter TEXT] [--min-time SECONDS] [--repetitions COUNT]
+///                  [--json PATH] [--baseline PATH] [--threshold [PREFIX=]FRACTION]...
+///
+/// --json writes the results, which serve as the baseline of later runs. With --baseline, each benchmark is
+/// compared against the baseline report and the run fails when one is slower by more than its threshold:
+/// 0.1 by default, --threshold 0.05 changes the default, --threshold load/=0.25 applies to the names starting with load/.
+/// Exit code: 0 on success, 1 when a benchmark regressed, 2 on invalid arguments or unreadable files.
+
+#include "bench.hpp"
+#include <gli/convert.hpp>
+#include <gli/generate_mipmaps.hpp>
+#include <gli/levels.hpp>
+#include <gli/load.hpp>
+#include <gli/sampler_cube.hpp>
+#include <gli/sampler_cube_batch.hpp>
+#include <gli/save.hpp>
+#include <gli/core/bc.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/constants.hpp>
+#include <glm/gtx/batch_transform.hpp>
+#include <random>
+
+namespace
+{
+	std::string name(char const* Prefix, int Size)
+	{
+		return std::string(Prefix) + "/" + std::to_string(Size);
+	}
+
+	/// Deterministic bytes, identical on every platform
+	void fill(void* Data, std::size_t Size, unsigned Seed)
+	{
+		std::minstd_rand Random(Seed);
+		glm::u8* Bytes = static_cast<glm::u8*>(Data);
+		for(std::size_t Index = 0; Index < Size; ++Index)
+			Bytes[Index] = static_cast<glm::u8>(Random() >> 8);
+	}
+
+	/// Texture with a complete mipmap chain and deterministic texels.
+	/// Float formats are converted from random RGBA8 texels, to avoid NaN and denormal values.
+	template <typename texture_type>
+	texture_type make_texture(gli::format Format, int Size)
+	{
+		gli::extent2d const Extent(Size);
+		if(gli::is_float(Format))
+			return gli::convert(make_texture<texture_type>(gli::FORMAT_RGBA8_UNORM_PACK8, Size), Format);
+
+		texture_type Texture(Format, Extent, gli::levels(Extent));
+		fill(Texture.data(), Texture.size(), static_cast<unsigned>(Size) + Format);
+		return Texture;
+	}
+
+	double texels(gli::texture const& Texture, gli::texture::size_type Level)
+	{
+		gli::texture::extent_type const Extent(Texture.extent(Level));
+		return static_cast<double>(Extent.x) * Extent.y * Extent.z * Texture.layers() * Texture.faces();
+	}
+
+	double texels(gli::texture const& Texture)
+	{
+		double Texels = 0;
+		for(gli::texture::size_type Level = 0; Level < Texture.levels(); ++Level)
+			Texels += texels(Texture, Level);
+		return Texels;
+	}
+
+	double size(gli::texture const& Texture, gli::texture::size_type Level)
+	{
+		return static_cast<double>(Texture.size(Level)) * Texture.layers() * Texture.faces();
+	}
+
+	/// Throughput of the file parsing, from memory: the bytes are the file size, the texels those of every level
+	void load(bench::suite& Suite, std::vector<int> const& Sizes)
+	{
+		struct container
+		{
+			char const* Name;
+			gli::format Format;
+			bool (*Save)(gli::texture const&, std::vector<char>&);
+		};
+
+		container const Containers[] =
+		{
+			{"load/dds/rgba8_unorm", gli::FORMAT_RGBA8_UNORM_PACK8, gli::save_dds},
+			{"load/dds/bc1_unorm", gli::FORMAT_RGBA_DXT1_UNORM_BLOCK8, gli::save_dds},
+			{"load/ktx/rgba8_unorm", gli::FORMAT_RGBA8_UNORM_PACK8, gli::save_ktx},
+			{"load/ktx/bc1_unorm", gli::FORMAT_RGBA_DXT1_UNORM_BLOCK8, gli::save_ktx}
+		};
+
+		for(std::size_t Index = 0; Index < sizeof(Containers) / sizeof(Containers[0]); ++Index)
+		for(std::size_t SizeIndex = 0; SizeIndex < Sizes.size(); ++SizeIndex)
+		{
+			std::string const Name(name(Containers[Index].Name, Sizes[SizeIndex]));
+			if(!Suite.selected(Name))
+				continue;
+
+			gli::texture2d const Texture(make_texture<gli::texture2d>(Containers[Index].Format, Sizes[SizeIndex]));
+			std::vector<char> File;
+			Containers[Index].Save(Texture, File);
+
+			Suite.run(Name, "texels", static_cast<double>(File.size()), texels(Texture), [&File]()
+			{
+				gli::texture const Loaded(gli::load(&File[0], File.size()));
+				bench::keep(Loaded);
+			});
+		}
+	}
+
+	/// Throughput of the format conversions: the bytes are those of the source texture
+	void convert(bench::suite& Suite, std::vector<int> const& Sizes)
+	{
+		struct conversion
+		{
+			char const* Name;
+			gli::format Source;
+			gli::format Destination;
+		};
+
+		conversion const Conversions[] =
+		{
+			{"convert/rgba8_unorm-bgra8_unorm", gli::FORMAT_RGBA8_UNORM_PACK8, gli::FORMAT_BGRA8_UNORM_PACK8},
+			{"convert/rgba8_unorm-rgba8_srgb", gli::FORMAT_RGBA8_UNORM_PACK8, gli::FORMAT_RGBA8_SRGB_PACK8},
+			{"convert/rgba8_unorm-rgba32_sfloat", gli::FORMAT_RGBA8_UNORM_PACK8, gli::FORMAT_RGBA32_SFLOAT_PACK32},
+			{"convert/rgba32_sfloat-rgba16_sfloat", gli::FORMAT_RGBA32_SFLOAT_PACK32, gli::FORMAT_RGBA16_SFLOAT_PACK16},
+			{"convert/rgba32_sfloat-rgba8_unorm", gli::FORMAT_RGBA32_SFLOAT_PACK32, gli::FORMAT_RGBA8_UNORM_PACK8}
+		};
+
+		for(std::size_t Index = 0; Index < sizeof(Conversions) / sizeof(Conversions[0]); ++Index)
+		for(std::size_t SizeIndex = 0; SizeIndex < Sizes.size(); ++SizeIndex)
+		{
+			std::string const Name(name(Conversions[Index].Name, Sizes[SizeIndex]));
+			if(!Suite.selected(Name))
+				continue;
+
+			gli::texture2d const Texture(make_texture<gli::texture2d>(Conversions[Index].Source, Sizes[SizeIndex]));
+			gli::format const Destination = Conversions[Index].Destination;
+
+			Suite.run(Name, "texels", static_cast<double>(Texture.size()), texels(Texture), [&Texture, Destination]()
+			{
+				gli::texture2d const Converted(gli::convert(Texture, Destination));
+				bench::keep(Converted);
+			});
+		}
+	}
+
+	/// Throughput of the mipmap generation: the bytes and texels are those of the base level, which the chain is built from
+	void generate_mipmaps(bench::suite& Suite, std::vector<int> const& Sizes)
+	{
+		struct generation
+		{
+			char const* Name;
+			gli::format Format;
+			bool Cube;
+		};
+
+		generation const Generations[] =
+		{
+			{"generate_mipmaps/2d/rgba8_unorm", gli::FORMAT_RGBA8_UNORM_PACK8, false},
+			{"generate_mipmaps/2d/rgba32_sfloat", gli::FORMAT_RGBA32_SFLOAT_PACK32, false},
+			{"generate_mipmaps/cube/rgba8_unorm", gli::FORMAT_RGBA8_UNORM_PACK8, true},
+			{"generate_mipmaps/cube/rgba16_sfloat", gli::FORMAT_RGBA16_SFLOAT_PACK16, true}
+		};
+
+		for(std::size_t Index = 0; Index < sizeof(Generations) / sizeof(Generations[0]); ++Index)
+		for(std::size_t SizeIndex = 0; SizeIndex < Sizes.size(); ++SizeIndex)
+		{
+			std::string const Name(name(Generations[Index].Name, Sizes[SizeIndex]));
+			if(!Suite.selected(Name))
+				continue;
+
+			if(Generations[Index].Cube)
+			{
+				gli::texture_cube const Texture(make_texture<gli::texture_cube>(Generations[Index].Format, Sizes[SizeIndex]));
+				Suite.run(Name, "texels", size(Texture, 0), texels(Texture, 0), [&Texture]()
+				{
+					gli::texture_cube const Mipmaps(gli::generate_mipmaps(Texture, gli::FILTER_LINEAR));
+					bench::keep(Mipmaps);
+				});
+			}
+			else
+			{
+				gli::texture2d const Texture(make_texture<gli::texture2d>(Generations[Index].Format, Sizes[SizeIndex]));
+				Suite.run(Name, "texels", size(Texture, 0), texels(Texture, 0), [&Texture]()
+				{
+					gli::texture2d const Mipmaps(gli::generate_mipmaps(Texture, gli::FILTER_LINEAR));
+					bench::keep(Mipmaps);
+				});
+			}
+		}
+	}
+
+	template <typename block_type>
+	void decompress_block(bench::suite& Suite, char const* Name, gli::detail::texel_block4x4 (*Decompress)(block_type const&))
+	{
+		std::size_t const Count = 4096;
+		std::vector<block_type> Blocks(Count);
+		fill(&Blocks[0], Blocks.size() * sizeof(block_type), static_cast<unsigned>(sizeof(block_type)));
+
+		Suite.run(Name, "texels", static_cast<double>(Count * sizeof(block_type)), static_cast<double>(Count * 16), [&Blocks, Decompress]()
+		{
+			for(std::size_t Index = 0; Index < Blocks.size(); ++Index)
+			{
+				gli::detail::texel_block4x4 const Texels(Decompress(Blocks[Index]));
+				bench::keep(Texels);
+			}
+		});
+	}
+
+	/// Throughput of the BC block decoders on random blocks: the bytes are the compressed ones
+	void decompress(bench::suite& Suite)
+	{
+		decompress_block<gli::detail::bc1_block>(Suite, "decompress/bc1_block", gli::detail::decompress_bc1_block);
+		decompress_block<gli::detail::bc2_block>(Suite, "decompress/bc2_block", gli::detail::decompress_bc2_block);
+		decompress_block<gli::detail::bc3_block>(Suite, "decompress/bc3_block", gli::detail::decompress_bc3_block);
+		decompress_block<gli::detail::bc4_block>(Suite, "decompress/bc4_unorm_block", gli::detail::decompress_bc4unorm_block);
+		decompress_block<gli::detail::bc5_block>(Suite, "decompress/bc5_unorm_block", gli::detail::decompress_bc5unorm_block);
+	}
+
+	/// Samples per second of trilinear lookups at random coordinates and levels of an RGBA8 cube map
+	void sample_cube(bench::suite& Suite, std::vector<int> const& Sizes)
+	{
+		std::size_t const Count = 16384;
+
+		for(std::size_t SizeIndex = 0; SizeIndex < Sizes.size(); ++SizeIndex)
+		{
+			std::string const Name(name("sampler_cube/texture_lod/rgba8_unorm", Sizes[SizeIndex]));
+			std::string const BatchName(name("sampler_cube_batch/texture_lod/rgba8_unorm", Sizes[SizeIndex]));
+			if(!Suite.selected(Name) && !Suite.selected(BatchName))
+				continue;
+
+			gli::texture_cube const Texture(make_texture<gli::texture_cube>(gli::FORMAT_RGBA8_UNORM_PACK8, Sizes[SizeIndex]));
+			float const MaxLevel = static_cast<float>(Texture.levels() - 1);
+
+			std::minstd_rand Random(static_cast<unsigned>(Sizes[SizeIndex]));
+			std::vector<gli::vec2> Coords(Count);
+			std::vector<gli::texture_cube::size_type> Faces(Count);
+			std::vector<float> Levels(Count), X(Count), Y(Count), Z(Count);
+			for(std::size_t Index = 0; Index < Count; ++Index)
+			{
+				Coords[Index] = gli::vec2(static_cast<float>(Random() % 4096) / 4096.0f, static_cast<float>(Random() % 4096) / 4096.0f);
+				Faces[Index] = Random() % 6;
+				Levels[Index] = static_cast<float>(Random() % 4096) / 4096.0f * MaxLevel;
+
+				gli::vec3 const Direction(glm::normalize(gli::vec3(static_cast<float>(Random() % 4096) - 2047.5f, static_cast<float>(Random() % 4096) - 2047.5f, static_cast<float>(Random() % 4096) - 2047.5f)));
+				X[Index] = Direction.x;
+				Y[Index] = Direction.y;
+				Z[Index] = Direction.z;
+			}
+
+			gli::fsamplerCube const Sampler(Texture, gli::WRAP_CLAMP_TO_EDGE, gli::FILTER_LINEAR, gli::FILTER_LINEAR);
+			Suite.run(Name, "samples", 0, static_cast<double>(Count), [&]()
+			{
+				gli::vec4 Sum(0.0f);
+				for(std::size_t Index = 0; Index < Count; ++Index)
+					Sum += Sampler.texture_lod(Coords[Index], Faces[Index], Levels[Index]);
+				bench::keep(Sum);
+			});
+
+			gli::sampler_cube_batch<gli::FORMAT_RGBA8_UNORM_PACK8> const Batch(Texture, gli::FILTER_LINEAR, gli::FILTER_LINEAR, true);
+			gli::cube_directions const Directions = {&X[0], &Y[0], &Z[0], Count};
+			std::vector<gli::vec4> Texels(Count);
+			Suite.run(BatchName, "samples", 0, static_cast<double>(Count), [&]()
+			{
+				Batch.texture_lod(Directions, &Levels[0], &Texels[0]);
+				bench::keep(Texels[0]);
+			});
+		}
+	}
+
+	/// Matrices per second of the transform the viewer computes each frame, and of its building blocks
+	void matrix(bench::suite& Suite)
+	{
+		std::size_t const Count = 1024;
+
+		std::minstd_rand Random(1);
+		std::vector<glm::vec2> Rotations(Count);
+		std::vector<glm::mat4> Matrices(Count);
+		std::vector<glm::vec4> Vertices(Count);
+		for(std::size_t Index = 0; Index < Count; ++Index)
+		{
+			Rotations[Index] = glm::vec2(static_cast<float>(Random() % 3600) / 10.0f, static_cast<float>(Random() % 1800) / 10.0f - 90.0f);
+			Vertices[Index] = glm::vec4(static_cast<float>(Random() % 2001) / 1000.0f - 1.0f, static_cast<float>(Random() % 2001) / 1000.0f - 1.0f, static_cast<float>(Random() % 2001) / 1000.0f - 1.0f, 1.0f);
+			Matrices[Index] = glm::rotate(glm::mat4(1.0f), glm::radians(Rotations[Index].x), glm::vec3(0.0f, 1.0f, 0.0f));
+		}
+
+		// Same computation as RenderFrame: perspective projection, two rotations and the skybox scale
+		Suite.run("glm/skybox_mvp", "matrices", 0, static_cast<double>(Count), [&Rotations]()
+		{
+			for(std::size_t Index = 0; Index < Rotations.size(); ++Index)
+			{
+				glm::mat4 const Projection = glm::perspective(glm::pi<float>() * 0.25f, 16.0f / 9.0f, 0.1f, 1000.0f);
+				glm::mat4 const ViewRotateX = glm::rotate(glm::mat4(1.0f), glm::radians(-Rotations[Index].y), glm::vec3(1.0f, 0.0f, 0.0f));
+				glm::mat4 const View = glm::rotate(ViewRotateX, glm::radians(-Rotations[Index].x), glm::vec3(0.0f, 1.0f, 0.0f));
+				glm::mat4 const Model = glm::scale(glm::mat4(1.0f), glm::vec3(500.0f));
+				glm::mat4 const MVP = Projection * View * Model;
+				bench::keep(MVP);
+			}
+		});
+
+		Suite.run("glm/mat4_mul", "matrices", 0, static_cast<double>(Count), [&Matrices]()
+		{
+			glm::mat4 Product(1.0f);
+			for(std::size_t Index = 0; Index < Matrices.size(); ++Index)
+				Product = Product * Matrices[Index];
+			bench::keep(Product);
+		});
+
+		Suite.run("glm/mat4_inverse", "matrices", 0, static_cast<double>(Count), [&Matrices]()
+		{
+			for(std::size_t Index = 0; Index < Matrices.size(); ++Index)
+			{
+				glm::mat4 const Inverse(glm::inverse(Matrices[Index]));
+				bench::keep(Inverse);
+			}
+		});
+
+		Suite.run("glm/mat4_transform_vec4", "vertices", static_cast<double>(Count * sizeof(glm::vec4)), static_cast<double>(Count), [&Matrices, &Vertices]()
+		{
+			glm::vec4 Sum(0.0f);
+			for(std::size_t Index = 0; Index < Vertices.size(); ++Index)
+				Sum += Matrices[0] * Vertices[Index];
+			bench::keep(Sum);
+		});
+	}
+
+	/// Throughput of the batched glm operations with each instruction set the CPU supports
+	void batch(bench::suite& Suite)
+	{
+		std::size_t const Count = 4096;
+		char const* const Archs[] = {"scalar", "sse41", "avx2"};
+
+		std::minstd_rand Random(2);
+		std::vector<glm::mat4> A(Count), B(Count), Products(Count);
+		std::vector<glm::mat3> Normals(Count);
+		std::vector<float> Components(4 * Count), Results(4 * Count);
+		for(std::size_t Index = 0; Index < Count; ++Index)
+		{
+			A[Index] = glm::rotate(glm::mat4(1.0f), static_cast<float>(Random() % 3600) / 10.0f, glm::vec3(0.0f, 1.0f, 0.0f));
+			B[Index] = glm::scale(glm::mat4(1.0f), glm::vec3(static_cast<float>(Random() % 1000) / 100.0f + 0.5f));
+		}
+		for(std::size_t Index = 0; Index < Components.size(); ++Index)
+			Components[Index] = static_cast<float>(Random() % 2001) / 1000.0f - 1.0f;
+
+		glm::soa_vec4<float const> const Vectors = {&Components[0], &Components[Count], &Components[2 * Count], &Components[3 * Count]};
+		glm::soa_vec4<float> const Transformed = {&Results[0], &Results[Count], &Results[2 * Count], &Results[3 * Count]};
+		glm::soa_vec3<float const> const Directions = {Vectors.x, Vectors.y, Vectors.z};
+		glm::soa_vec3<float> const Normalized = {Transformed.x, Transformed.y, Transformed.z};
+
+		for(int Arch = glm::BATCH_ARCH_SCALAR; Arch <= glm::batchArch(); ++Arch)
+		{
+			glm::batch_arch const BatchArch = static_cast<glm::batch_arch>(Arch);
+			std::string const Suffix(std::string("/") + Archs[Arch]);
+
+			Suite.run("glm/batch/mat4_mul" + Suffix, "matrices", static_cast<double>(2 * Count * sizeof(glm::mat4)), static_cast<double>(Count), [&]()
+			{
+				glm::mulBatch(&A[0], &B[0], &Products[0], Count, BatchArch);
+				bench::keep(Products[0]);
+			});
+
+			Suite.run("glm/batch/mat4_transform_vec4" + Suffix, "vertices", static_cast<double>(Count * sizeof(glm::vec4)), static_cast<double>(Count), [&]()
+			{
+				glm::mulBatch(A[0], Vectors, Transformed, Count, BatchArch);
+				bench::keep(Results[0]);
+			});
+
+			Suite.run("glm/batch/normalize_vec3" + Suffix, "vertices", static_cast<double>(Count * sizeof(glm::vec3)), static_cast<double>(Count), [&]()
+			{
+				glm::normalizeBatch(Directions, Normalized, Count, BatchArch);
+				bench::keep(Results[0]);
+			});
+
+			Suite.run("glm/batch/inverse_transpose" + Suffix, "matrices", static_cast<double>(Count * sizeof(glm::mat4)), static_cast<double>(Count), [&]()
+			{
+				glm::inverseTransposeBatch(&B[0], &Normals[0], Count, BatchArch);
+				bench::keep(Normals[0]);
+			});
+		}
+	}
+
+	int usage()
+	{
+		std::fprintf(stderr, "usage: gli-bench [--quick] [--filter TEXT] [--min-time SECONDS] [--repetitions COUNT] [--json PATH] [--baseline PATH] [--threshold [PREFIX=]FRACTION]...\n");
+		return 2;
+	}
+}//namespace
+
+int main(int argc, char* argv[])
+{
+	bool Quick = false;
+	double MinTime = 0.05;
+	std::size_t Repetitions = 5;
+	std::string Filter, Json, Baseline;
+	bench::thresholds Thresholds;
+
+	for(int Arg = 1; Arg < argc; ++Arg)
+	{
+		std::string const Option(argv[Arg]);
+		bool const HasValue = Arg + 1 < argc;
+
+		if(Option == "--quick")
+			Quick = true;
+		else if(Option == "--filter" && HasValue)
+			Filter = argv[++Arg];
+		else if(Option == "--min-time" && HasValue)
+			MinTime = std::atof(argv[++Arg]);
+		else if(Option == "--repetitions" && HasValue)
+			Repetitions = static_cast<std::size_t>(std::atoi(argv[++Arg]));
+		else if(Option == "--json" && HasValue)
+			Json = argv[++Arg];
+		else if(Option == "--baseline" && HasValue)
+			Baseline = argv[++Arg];
+		else if(Option == "--threshold" && HasValue)
+		{
+			std::string const Value(argv[++Arg]);
+			std::size_t const Separator = Value.find('=');
+			if(Separator == std::string::npos)
+				Thresholds.Default = std::atof(Value.c_str());
+			else
+				Thresholds.Prefixes[Value.substr(0, Separator)] = std::atof(Value.c_str() + Separator + 1);
+		}
+		else
+			return usage();
+	}
+
+	// Quick runs check that every benchmark runs, their timings are too short to compare
+	if(Quick)
+	{
+		MinTime = 0.001;
+		Repetitions = 1;
+	}
+
+	std::map<std::string, double> BaselineSeconds;
+	if(!Baseline.empty() && !bench::read_json(Baseline.c_str(), BaselineSeconds))
+	{
+		std::fprintf(stderr, "Could not read the baseline %s\n", Baseline.c_str());
+		return 2;
+	}
+
+	std::vector<int> Sizes;
+	Sizes.push_back(64);
+	if(!Quick)
+	{
+		Sizes.push_back(256);
+		Sizes.push_back(1024);
+	}
+
+	bench::suite Suite(MinTime, Repetitions, Filter);
+	load(Suite, Sizes);
+	convert(Suite, Sizes);
+	generate_mipmaps(Suite, Sizes);
+	decompress(Suite);
+	sample_cube(Suite, Sizes);
+	matrix(Suite);
+	batch(Suite);
+
+	std::map<std::string, std::string> Context;
+#	if defined(__clang__)
+		Context["compiler"] = "clang " __clang_version__;
+#	elif defined(__GNUC__)
+		Context["compiler"] = "gcc " __VERSION__;
+#	elif defined(_MSC_VER)
+		Context["compiler"] = "msvc " + std::to_string(_MSC_VER);
+#	endif
+#	if defined(NDEBUG)
+		Context["build"] = "release";
+#	else
+		Context["build"] = "debug";
+#	endif
+	Context["threads"] = std::to_string(gli::detail::thread_count());
+	Context["quick"] = Quick ? "true" : "false";
+
+	if(!Json.empty() && !bench::write_json(Json.c_str(), Context, Suite.results()))
+	{
+		std::fprintf(stderr, "Could not write %s\n", Json.c_str());
+		return 2;
+	}
+
+	if(Baseline.empty())
+		return 0;
+
+	std::size_t const Regressions = bench::compare(BaselineSeconds, Suite.results(), Thresholds);
+	std::printf("\n%d regression(s)\n", static_cast<int>(Regressions));
+	return Regressions > 0 ? 1 : 0;
+}
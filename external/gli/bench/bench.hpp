@@ -0,0 +1,249 @@
+/// @brief Minimal benchmark harness: timing, JSON report and comparison against a baseline report.
+/// @file bench/bench.hpp
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace bench
+{
+	/// Measurement of a benchmark. Throughputs are per second of the median repetition.
+	struct result
+	{
+		result()
+			: Bytes(0)
+			, Items(0)
+			, Iterations(0)
+			, Seconds(0)
+		{}
+
+		double bytes_per_second() const
+		{
+			return this->Seconds > 0 ? this->Bytes / this->Seconds : 0;
+		}
+
+		double items_per_second() const
+		{
+			return this->Seconds > 0 ? this->Items / this->Seconds : 0;
+		}
+
+		std::string Name;
+
+		/// What Items counts: texels, samples, blocks, matrices
+		std::string Unit;
+
+		/// Bytes read by one iteration, 0 when throughput in bytes is meaningless
+		double Bytes;
+
+		/// Units processed by one iteration
+		double Items;
+
+		std::size_t Iterations;
+
+		/// Median time of one iteration
+		double Seconds;
+	};
+
+	/// Keep the compiler from discarding the computation of Value
+	template <typename T>
+	inline void keep(T const& Value)
+	{
+#		if defined(__GNUC__) || defined(__clang__)
+			asm volatile("" : : "g"(&Value) : "memory");
+#		else
+			static char const volatile* Sink = nullptr;
+			Sink = reinterpret_cast<char const volatile*>(&Value);
+#		endif
+	}
+
+	/// Runs the benchmarks whose name contains Filter, each for Repetitions repetitions of at least MinTime seconds
+	class suite
+	{
+	public:
+		suite(double MinTime, std::size_t Repetitions, std::string const& Filter)
+			: MinTime(MinTime)
+			, Repetitions(std::max<std::size_t>(Repetitions, 1))
+			, Filter(Filter)
+		{}
+
+		bool selected(std::string const& Name) const
+		{
+			return this->Filter.empty() || Name.find(this->Filter) != std::string::npos;
+		}
+
+		/// Time Func(), which processes Bytes bytes and Items units of Unit per call
+		template <typename func>
+		void run(std::string const& Name, char const* Unit, double Bytes, double Items, func Func)
+		{
+			if(!this->selected(Name))
+				return;
+
+			typedef std::chrono::steady_clock clock;
+
+			// Double the iteration count until a repetition lasts MinTime
+			std::size_t Iterations = 1;
+			for(;;)
+			{
+				clock::time_point const Start(clock::now());
+				for(std::size_t Iteration = 0; Iteration < Iterations; ++Iteration)
+					Func();
+				double const Seconds = std::chrono::duration<double>(clock::now() - Start).count();
+				if(Seconds >= this->MinTime)
+					break;
+				Iterations *= Seconds > 0 ? std::max<std::size_t>(2, std::min<std::size_t>(static_cast<std::size_t>(this->MinTime / Seconds * 1.2), 100)) : 100;
+			}
+
+			std::vector<double> Times;
+			for(std::size_t Repetition = 0; Repetition < this->Repetitions; ++Repetition)
+			{
+				clock::time_point const Start(clock::now());
+				for(std::size_t Iteration = 0; Iteration < Iterations; ++Iteration)
+					Func();
+				Times.push_back(std::chrono::duration<double>(clock::now() - Start).count() / static_cast<double>(Iterations));
+			}
+			std::sort(Times.begin(), Times.end());
+
+			result Result;
+			Result.Name = Name;
+			Result.Unit = Unit;
+			Result.Bytes = Bytes;
+			Result.Items = Items;
+			Result.Iterations = Iterations;
+			Result.Seconds = Times[Times.size() / 2];
+			this->Results.push_back(Result);
+
+			if(Bytes > 0)
+				std::printf("%-48s %12.3f us %12.1f MB/s %12.2f M%s/s\n", Name.c_str(), Result.Seconds * 1e6, Result.bytes_per_second() / 1e6, Result.items_per_second() / 1e6, Unit);
+			else
+				std::printf("%-48s %12.3f us %17s %12.2f M%s/s\n", Name.c_str(), Result.Seconds * 1e6, "-", Result.items_per_second() / 1e6, Unit);
+			std::fflush(stdout);
+		}
+
+		std::vector<result> const& results() const
+		{
+			return this->Results;
+		}
+
+	private:
+		double MinTime;
+		std::size_t Repetitions;
+		std::string Filter;
+		std::vector<result> Results;
+	};
+
+	/// Write the results as JSON, with Context as string properties describing the run
+	inline bool write_json(char const* Path, std::map<std::string, std::string> const& Context, std::vector<result> const& Results)
+	{
+		std::ofstream File(Path);
+		if(!File)
+			return false;
+
+		File.precision(9);
+		File << "{\n\t\"context\": {";
+		for(std::map<std::string, std::string>::const_iterator It = Context.begin(); It != Context.end(); ++It)
+			File << (It == Context.begin() ? "\n" : ",\n") << "\t\t\"" << It->first << "\": \"" << It->second << "\"";
+		File << "\n\t},\n\t\"benchmarks\": [";
+		for(std::size_t Index = 0; Index < Results.size(); ++Index)
+		{
+			result const& Result = Results[Index];
+			File << (Index == 0 ? "\n" : ",\n")
+				<< "\t\t{\"name\": \"" << Result.Name << "\""
+				<< ", \"unit\": \"" << Result.Unit << "\""
+				<< ", \"iterations\": " << Result.Iterations
+				<< ", \"seconds\": " << Result.Seconds
+				<< ", \"bytes_per_second\": " << Result.bytes_per_second()
+				<< ", \"items_per_second\": " << Result.items_per_second() << "}";
+		}
+		File << "\n\t]\n}\n";
+
+		return static_cast<bool>(File);
+	}
+
+	/// Read the benchmark names and times of a report written by write_json
+	inline bool read_json(char const* Path, std::map<std::string, double>& Seconds)
+	{
+		std::ifstream File(Path);
+		if(!File)
+			return false;
+
+		std::string const Content((std::istreambuf_iterator<char>(File)), std::istreambuf_iterator<char>());
+		char const NameKey[] = "\"name\": \"";
+		char const SecondsKey[] = "\"seconds\": ";
+
+		for(std::size_t Name = Content.find(NameKey); Name != std::string::npos; Name = Content.find(NameKey, Name))
+		{
+			Name += sizeof(NameKey) - 1;
+			std::size_t const NameEnd = Content.find('"', Name);
+			std::size_t const ObjectEnd = Content.find('}', Name);
+			std::size_t const Value = Content.find(SecondsKey, Name);
+			if(NameEnd == std::string::npos || Value == std::string::npos || Value > ObjectEnd)
+				return false;
+
+			Seconds[Content.substr(Name, NameEnd - Name)] = std::strtod(Content.c_str() + Value + sizeof(SecondsKey) - 1, nullptr);
+		}
+
+		return true;
+	}
+
+	/// Regression thresholds: relative slowdowns tolerated before a benchmark is reported as a regression.
+	/// The threshold of a benchmark is the one of the longest prefix of its name, or Default.
+	struct thresholds
+	{
+		thresholds()
+			: Default(0.1)
+		{}
+
+		double find(std::string const& Name) const
+		{
+			double Threshold = this->Default;
+			std::size_t Length = 0;
+			for(std::map<std::string, double>::const_iterator It = this->Prefixes.begin(); It != this->Prefixes.end(); ++It)
+				if(Name.compare(0, It->first.size(), It->first) == 0 && It->first.size() >= Length)
+				{
+					Threshold = It->second;
+					Length = It->first.size();
+				}
+			return Threshold;
+		}
+
+		double Default;
+		std::map<std::string, double> Prefixes;
+	};
+
+	/// Print the change of each benchmark against the baseline, returns the number of regressions
+	inline std::size_t compare(std::map<std::string, double> const& Baseline, std::vector<result> const& Results, thresholds const& Thresholds)
+	{
+		std::size_t Regressions = 0;
+
+		std::printf("\n%-48s %12s %12s %9s\n", "benchmark", "baseline us", "current us", "change");
+		for(std::size_t Index = 0; Index < Results.size(); ++Index)
+		{
+			result const& Result = Results[Index];
+			std::map<std::string, double>::const_iterator It = Baseline.find(Result.Name);
+			if(It == Baseline.end() || It->second <= 0)
+			{
+				std::printf("%-48s %12s %12.3f %9s\n", Result.Name.c_str(), "-", Result.Seconds * 1e6, "new");
+				continue;
+			}
+
+			double const Change = Result.Seconds / It->second - 1.0;
+			bool const Regression = Change > Thresholds.find(Result.Name);
+			Regressions += Regression ? 1 : 0;
+
+			std::printf("%-48s %12.3f %12.3f %+8.1f%%%s\n", Result.Name.c_str(), It->second * 1e6, Result.Seconds * 1e6, Change * 100.0, Regression ? "  REGRESSION" : "");
+		}
+
+		return Regressions;
+	}
+}//namespace bench
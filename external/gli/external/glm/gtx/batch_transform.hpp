@@ -0,0 +1,93 @@
+/// @ref gtx_batch_transform
+/// @file glm/gtx/batch_transform.hpp
+///
+/// @see core (dependence)
+///
+/// @defgroup gtx_batch_transform GLM_GTX_batch_transform
+/// @ingroup gtx
+///
+/// Include <glm/gtx/batch_transform.hpp> to use the features of this extension.
+///
+/// Matrix and vector operations on arrays of single precision values, dispatched at runtime
+/// to AVX2 and FMA, SSE4.1 or scalar code depending on the CPU.
+
+#pragma once
+
+// Dependency:
+#include "../glm.hpp"
+#include <cstddef>
+
+#ifndef GLM_ENABLE_EXPERIMENTAL
+#	error "GLM: GLM_GTX_batch_transform is an experimental extension and may change in the future. Use #define GLM_ENABLE_EXPERIMENTAL before including it, if you really want to use it."
+#endif
+
+#if GLM_MESSAGES == GLM_ENABLE && !defined(GLM_EXT_INCLUDED)
+#	pragma message("GLM: GLM_GTX_batch_transform extension included")
+#endif
+
+namespace glm
+{
+	/// @addtogroup gtx_batch_transform
+	/// @{
+
+	/// Instruction sets of the batch operations, from the narrowest to the widest
+	enum batch_arch
+	{
+		BATCH_ARCH_SCALAR,
+		BATCH_ARCH_SSE41,
+		BATCH_ARCH_AVX2
+	};
+
+	/// Structure of arrays of 3 components vectors: the vector i is (x[i], y[i], z[i])
+	template<typename T>
+	struct soa_vec3
+	{
+		T* x;
+		T* y;
+		T* z;
+	};
+
+	/// Structure of arrays of 4 components vectors: the vector i is (x[i], y[i], z[i], w[i])
+	template<typename T>
+	struct soa_vec4
+	{
+		T* x;
+		T* y;
+		T* z;
+		T* w;
+	};
+
+	/// Widest instruction set supported by the CPU and the compiler, detected once.
+	/// Always BATCH_ARCH_SCALAR with GLM_FORCE_PURE or outside x86.
+	///
+	/// @see gtx_batch_transform
+	GLM_FUNC_DECL batch_arch batchArch();
+
+	/// result[i] = a[i] * b[i] for i in [0, count). result may alias a or b.
+	/// The instruction set is arch, or the widest supported one below arch.
+	///
+	/// @see gtx_batch_transform
+	GLM_FUNC_DECL void mulBatch(mat4 const* a, mat4 const* b, mat4* result, std::size_t count, batch_arch arch = batchArch());
+
+	/// result[i] = m * v[i] for i in [0, count). result may alias v.
+	/// The instruction set is arch, or the widest supported one below arch.
+	///
+	/// @see gtx_batch_transform
+	GLM_FUNC_DECL void mulBatch(mat4 const& m, soa_vec4<float const> const& v, soa_vec4<float> const& result, std::size_t count, batch_arch arch = batchArch());
+
+	/// result[i] = normalize(v[i]) for i in [0, count). result may alias v.
+	/// The instruction set is arch, or the widest supported one below arch.
+	///
+	/// @see gtx_batch_transform
+	GLM_FUNC_DECL void normalizeBatch(soa_vec3<float const> const& v, soa_vec3<float> const& result, std::size_t count, batch_arch arch = batchArch());
+
+	/// result[i] = inverseTranspose(mat3(m[i])) for i in [0, count): the matrices transforming the normals.
+	/// The instruction set is arch, or the widest supported one below arch.
+	///
+	/// @see gtx_batch_transform
+	GLM_FUNC_DECL void inverseTransposeBatch(mat4 const* m, mat3* result, std::size_t count, batch_arch arch = batchArch());
+
+	/// @}
+}//namespace glm
+
+#include "batch_transform.inl"
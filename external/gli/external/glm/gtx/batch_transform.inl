@@ -0,0 +1,406 @@
+/// @ref gtx_batch_transform
+
+#include "../gtc/matrix_inverse.hpp"
+
+// The SSE4.1 and AVX2 kernels are compiled for their instruction set whatever the compiler options, and only run when the CPU supports it
+#if (GLM_ARCH & GLM_ARCH_X86_BIT) && !defined(GLM_FORCE_PURE) && (GLM_COMPILER & (GLM_COMPILER_GCC | GLM_COMPILER_CLANG | GLM_COMPILER_VC))
+#	define GLM_BATCH_X86 1
+#	include <immintrin.h>
+#	if GLM_COMPILER & GLM_COMPILER_VC
+#		include <intrin.h>
+#		define GLM_BATCH_SSE41
+#		define GLM_BATCH_AVX2
+#	else
+#		define GLM_BATCH_SSE41 __attribute__((target("sse4.1")))
+#		define GLM_BATCH_AVX2 __attribute__((target("avx2,fma")))
+#	endif
+#else
+#	define GLM_BATCH_X86 0
+#endif
+
+namespace glm{
+namespace detail
+{
+	GLM_FUNC_QUALIFIER batch_arch detectBatchArch()
+	{
+#		if GLM_BATCH_X86 && (GLM_COMPILER & GLM_COMPILER_VC)
+			int Info[4];
+			__cpuid(Info, 0);
+			int const Leaves = Info[0];
+
+			__cpuid(Info, 1);
+			bool const SSE41 = (Info[2] & (1 << 19)) != 0;
+			bool const FMA = (Info[2] & (1 << 12)) != 0;
+			// The OS saves the AVX registers on context switches
+			bool const AVX = (Info[2] & (1 << 27)) != 0 && (Info[2] & (1 << 28)) != 0 && (_xgetbv(0) & 6) == 6;
+
+			bool AVX2 = false;
+			if(Leaves >= 7)
+			{
+				__cpuidex(Info, 7, 0);
+				AVX2 = (Info[1] & (1 << 5)) != 0;
+			}
+
+			return AVX && AVX2 && FMA ? BATCH_ARCH_AVX2 : SSE41 ? BATCH_ARCH_SSE41 : BATCH_ARCH_SCALAR;
+#		elif GLM_BATCH_X86
+			__builtin_cpu_init();
+			return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma") ? BATCH_ARCH_AVX2 : __builtin_cpu_supports("sse4.1") ? BATCH_ARCH_SSE41 : BATCH_ARCH_SCALAR;
+#		else
+			return BATCH_ARCH_SCALAR;
+#		endif
+	}
+
+	GLM_FUNC_QUALIFIER batch_arch supportedBatchArch(batch_arch arch)
+	{
+		batch_arch const Supported = batchArch();
+		return arch < Supported ? arch : Supported;
+	}
+
+	GLM_FUNC_QUALIFIER void mulBatchScalar(mat4 const* a, mat4 const* b, mat4* result, std::size_t count)
+	{
+		for(std::size_t i = 0; i < count; ++i)
+			result[i] = a[i] * b[i];
+	}
+
+	GLM_FUNC_QUALIFIER void mulBatchScalar(mat4 const& m, soa_vec4<float const> const& v, soa_vec4<float> const& result, std::size_t first, std::size_t count)
+	{
+		for(std::size_t i = first; i < count; ++i)
+		{
+			float const x = v.x[i];
+			float const y = v.y[i];
+			float const z = v.z[i];
+			float const w = v.w[i];
+			result.x[i] = m[0][0] * x + m[1][0] * y + m[2][0] * z + m[3][0] * w;
+			result.y[i] = m[0][1] * x + m[1][1] * y + m[2][1] * z + m[3][1] * w;
+			result.z[i] = m[0][2] * x + m[1][2] * y + m[2][2] * z + m[3][2] * w;
+			result.w[i] = m[0][3] * x + m[1][3] * y + m[2][3] * z + m[3][3] * w;
+		}
+	}
+
+	GLM_FUNC_QUALIFIER void normalizeBatchScalar(soa_vec3<float const> const& v, soa_vec3<float> const& result, std::size_t first, std::size_t count)
+	{
+		for(std::size_t i = first; i < count; ++i)
+		{
+			vec3 const n(normalize(vec3(v.x[i], v.y[i], v.z[i])));
+			result.x[i] = n.x;
+			result.y[i] = n.y;
+			result.z[i] = n.z;
+		}
+	}
+
+	GLM_FUNC_QUALIFIER void inverseTransposeBatchScalar(mat4 const* m, mat3* result, std::size_t count)
+	{
+		for(std::size_t i = 0; i < count; ++i)
+			result[i] = inverseTranspose(mat3(m[i]));
+	}
+
+#	if GLM_BATCH_X86
+		// Columns are 4 floats apart in the mat4 arrays and 3 floats apart in the mat3 arrays
+		GLM_BATCH_SSE41 inline void mulBatchSSE41(float const* a, float const* b, float* result, std::size_t count)
+		{
+			for(std::size_t i = 0; i < count; ++i, a += 16, b += 16, result += 16)
+			{
+				__m128 const a0 = _mm_loadu_ps(a + 0);
+				__m128 const a1 = _mm_loadu_ps(a + 4);
+				__m128 const a2 = _mm_loadu_ps(a + 8);
+				__m128 const a3 = _mm_loadu_ps(a + 12);
+
+				__m128 r[4];
+				for(int j = 0; j < 4; ++j)
+				{
+					__m128 const bj = _mm_loadu_ps(b + j * 4);
+					__m128 const r0 = _mm_mul_ps(a0, _mm_shuffle_ps(bj, bj, _MM_SHUFFLE(0, 0, 0, 0)));
+					__m128 const r1 = _mm_mul_ps(a1, _mm_shuffle_ps(bj, bj, _MM_SHUFFLE(1, 1, 1, 1)));
+					__m128 const r2 = _mm_mul_ps(a2, _mm_shuffle_ps(bj, bj, _MM_SHUFFLE(2, 2, 2, 2)));
+					__m128 const r3 = _mm_mul_ps(a3, _mm_shuffle_ps(bj, bj, _MM_SHUFFLE(3, 3, 3, 3)));
+					r[j] = _mm_add_ps(_mm_add_ps(r0, r1), _mm_add_ps(r2, r3));
+				}
+
+				// Stored once every column is computed, in case result aliases a or b
+				for(int j = 0; j < 4; ++j)
+					_mm_storeu_ps(result + j * 4, r[j]);
+			}
+		}
+
+		// Two columns of b per register: each 128 bits lane computes a column of the product
+		GLM_BATCH_AVX2 inline void mulBatchAVX2(float const* a, float const* b, float* result, std::size_t count)
+		{
+			for(std::size_t i = 0; i < count; ++i, a += 16, b += 16, result += 16)
+			{
+				__m256 const a0 = _mm256_broadcast_ps(reinterpret_cast<__m128 const*>(a + 0));
+				__m256 const a1 = _mm256_broadcast_ps(reinterpret_cast<__m128 const*>(a + 4));
+				__m256 const a2 = _mm256_broadcast_ps(reinterpret_cast<__m128 const*>(a + 8));
+				__m256 const a3 = _mm256_broadcast_ps(reinterpret_cast<__m128 const*>(a + 12));
+				__m256 const b01 = _mm256_loadu_ps(b + 0);
+				__m256 const b23 = _mm256_loadu_ps(b + 8);
+
+				__m256 r01 = _mm256_mul_ps(a0, _mm256_permute_ps(b01, 0x00));
+				__m256 r23 = _mm256_mul_ps(a0, _mm256_permute_ps(b23, 0x00));
+				r01 = _mm256_fmadd_ps(a1, _mm256_permute_ps(b01, 0x55), r01);
+				r23 = _mm256_fmadd_ps(a1, _mm256_permute_ps(b23, 0x55), r23);
+				r01 = _mm256_fmadd_ps(a2, _mm256_permute_ps(b01, 0xAA), r01);
+				r23 = _mm256_fmadd_ps(a2, _mm256_permute_ps(b23, 0xAA), r23);
+				r01 = _mm256_fmadd_ps(a3, _mm256_permute_ps(b01, 0xFF), r01);
+				r23 = _mm256_fmadd_ps(a3, _mm256_permute_ps(b23, 0xFF), r23);
+
+				_mm256_storeu_ps(result + 0, r01);
+				_mm256_storeu_ps(result + 8, r23);
+			}
+		}
+
+		GLM_BATCH_SSE41 inline void mulBatchSSE41(mat4 const& m, soa_vec4<float const> const& v, soa_vec4<float> const& result, std::size_t count)
+		{
+			__m128 c[4][4];
+			for(int col = 0; col < 4; ++col)
+			for(int row = 0; row < 4; ++row)
+				c[col][row] = _mm_set1_ps(m[col][row]);
+
+			std::size_t i = 0;
+			for(; i + 4 <= count; i += 4)
+			{
+				__m128 const x = _mm_loadu_ps(v.x + i);
+				__m128 const y = _mm_loadu_ps(v.y + i);
+				__m128 const z = _mm_loadu_ps(v.z + i);
+				__m128 const w = _mm_loadu_ps(v.w + i);
+
+				__m128 r[4];
+				for(int row = 0; row < 4; ++row)
+					r[row] = _mm_add_ps(
+						_mm_add_ps(_mm_mul_ps(c[0][row], x), _mm_mul_ps(c[1][row], y)),
+						_mm_add_ps(_mm_mul_ps(c[2][row], z), _mm_mul_ps(c[3][row], w)));
+
+				_mm_storeu_ps(result.x + i, r[0]);
+				_mm_storeu_ps(result.y + i, r[1]);
+				_mm_storeu_ps(result.z + i, r[2]);
+				_mm_storeu_ps(result.w + i, r[3]);
+			}
+
+			mulBatchScalar(m, v, result, i, count);
+		}
+
+		GLM_BATCH_AVX2 inline void mulBatchAVX2(mat4 const& m, soa_vec4<float const> const& v, soa_vec4<float> const& result, std::size_t count)
+		{
+			__m256 c[4][4];
+			for(int col = 0; col < 4; ++col)
+			for(int row = 0; row < 4; ++row)
+				c[col][row] = _mm256_set1_ps(m[col][row]);
+
+			std::size_t i = 0;
+			for(; i + 8 <= count; i += 8)
+			{
+				__m256 const x = _mm256_loadu_ps(v.x + i);
+				__m256 const y = _mm256_loadu_ps(v.y + i);
+				__m256 const z = _mm256_loadu_ps(v.z + i);
+				__m256 const w = _mm256_loadu_ps(v.w + i);
+
+				__m256 r[4];
+				for(int row = 0; row < 4; ++row)
+					r[row] = _mm256_fmadd_ps(c[3][row], w, _mm256_fmadd_ps(c[2][row], z, _mm256_fmadd_ps(c[1][row], y, _mm256_mul_ps(c[0][row], x))));
+
+				_mm256_storeu_ps(result.x + i, r[0]);
+				_mm256_storeu_ps(result.y + i, r[1]);
+				_mm256_storeu_ps(result.z + i, r[2]);
+				_mm256_storeu_ps(result.w + i, r[3]);
+			}
+
+			mulBatchScalar(m, v, result, i, count);
+		}
+
+		GLM_BATCH_SSE41 inline void normalizeBatchSSE41(soa_vec3<float const> const& v, soa_vec3<float> const& result, std::size_t count)
+		{
+			__m128 const one = _mm_set1_ps(1.0f);
+
+			std::size_t i = 0;
+			for(; i + 4 <= count; i += 4)
+			{
+				__m128 const x = _mm_loadu_ps(v.x + i);
+				__m128 const y = _mm_loadu_ps(v.y + i);
+				__m128 const z = _mm_loadu_ps(v.z + i);
+
+				// Full precision square root and division rather than _mm_rsqrt_ps, to match normalize
+				__m128 const dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+				__m128 const scale = _mm_div_ps(one, _mm_sqrt_ps(dot));
+
+				_mm_storeu_ps(result.x + i, _mm_mul_ps(x, scale));
+				_mm_storeu_ps(result.y + i, _mm_mul_ps(y, scale));
+				_mm_storeu_ps(result.z + i, _mm_mul_ps(z, scale));
+			}
+
+			normalizeBatchScalar(v, result, i, count);
+		}
+
+		GLM_BATCH_AVX2 inline void normalizeBatchAVX2(soa_vec3<float const> const& v, soa_vec3<float> const& result, std::size_t count)
+		{
+			__m256 const one = _mm256_set1_ps(1.0f);
+
+			std::size_t i = 0;
+			for(; i + 8 <= count; i += 8)
+			{
+				__m256 const x = _mm256_loadu_ps(v.x + i);
+				__m256 const y = _mm256_loadu_ps(v.y + i);
+				__m256 const z = _mm256_loadu_ps(v.z + i);
+
+				__m256 const dot = _mm256_fmadd_ps(z, z, _mm256_fmadd_ps(y, y, _mm256_mul_ps(x, x)));
+				__m256 const scale = _mm256_div_ps(one, _mm256_sqrt_ps(dot));
+
+				_mm256_storeu_ps(result.x + i, _mm256_mul_ps(x, scale));
+				_mm256_storeu_ps(result.y + i, _mm256_mul_ps(y, scale));
+				_mm256_storeu_ps(result.z + i, _mm256_mul_ps(z, scale));
+			}
+
+			normalizeBatchScalar(v, result, i, count);
+		}
+
+		GLM_BATCH_SSE41 inline __m128 crossSSE41(__m128 a, __m128 b)
+		{
+			__m128 const a_yzx = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+			__m128 const b_yzx = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+			__m128 const c = _mm_sub_ps(_mm_mul_ps(a, b_yzx), _mm_mul_ps(a_yzx, b));
+			return _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 0, 2, 1));
+		}
+
+		// Write the x, y and z components of the columns of a mat3, without writing past its end
+		GLM_BATCH_SSE41 inline void storeMat3SSE41(float* result, __m128 c0, __m128 c1, __m128 c2)
+		{
+			_mm_storeu_ps(result + 0, c0);
+			_mm_storeu_ps(result + 3, c1);
+			_mm_storel_pi(reinterpret_cast<__m64*>(result + 6), c2);
+			_mm_store_ss(result + 8, _mm_movehl_ps(c2, c2));
+		}
+
+		// The columns of the inverse transpose of a 3x3 matrix are the cross products of its columns divided by its determinant
+		GLM_BATCH_SSE41 inline void inverseTransposeBatchSSE41(float const* m, float* result, std::size_t count)
+		{
+			__m128 const one = _mm_set1_ps(1.0f);
+
+			for(std::size_t i = 0; i < count; ++i, m += 16, result += 9)
+			{
+				__m128 const c0 = _mm_loadu_ps(m + 0);
+				__m128 const c1 = _mm_loadu_ps(m + 4);
+				__m128 const c2 = _mm_loadu_ps(m + 8);
+
+				__m128 const r0 = crossSSE41(c1, c2);
+				__m128 const r1 = crossSSE41(c2, c0);
+				__m128 const r2 = crossSSE41(c0, c1);
+				__m128 const scale = _mm_div_ps(one, _mm_dp_ps(c0, r0, 0x7F));
+
+				storeMat3SSE41(result, _mm_mul_ps(r0, scale), _mm_mul_ps(r1, scale), _mm_mul_ps(r2, scale));
+			}
+		}
+
+		GLM_BATCH_AVX2 inline __m256 crossAVX2(__m256 a, __m256 b)
+		{
+			__m256 const a_yzx = _mm256_permute_ps(a, _MM_SHUFFLE(3, 0, 2, 1));
+			__m256 const b_yzx = _mm256_permute_ps(b, _MM_SHUFFLE(3, 0, 2, 1));
+			__m256 const c = _mm256_fmsub_ps(a, b_yzx, _mm256_mul_ps(a_yzx, b));
+			return _mm256_permute_ps(c, _MM_SHUFFLE(3, 0, 2, 1));
+		}
+
+		// Two matrices per register, one in each 128 bits lane
+		GLM_BATCH_AVX2 inline void inverseTransposeBatchAVX2(float const* m, float* result, std::size_t count)
+		{
+			__m256 const one = _mm256_set1_ps(1.0f);
+
+			std::size_t i = 0;
+			for(; i + 2 <= count; i += 2, m += 32, result += 18)
+			{
+				__m256 const c0 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(m + 0)), _mm_loadu_ps(m + 16), 1);
+				__m256 const c1 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(m + 4)), _mm_loadu_ps(m + 20), 1);
+				__m256 const c2 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(m + 8)), _mm_loadu_ps(m + 24), 1);
+
+				__m256 const r0 = crossAVX2(c1, c2);
+				__m256 const r1 = crossAVX2(c2, c0);
+				__m256 const r2 = crossAVX2(c0, c1);
+				__m256 const scale = _mm256_div_ps(one, _mm256_dp_ps(c0, r0, 0x7F));
+
+				__m256 const s0 = _mm256_mul_ps(r0, scale);
+				__m256 const s1 = _mm256_mul_ps(r1, scale);
+				__m256 const s2 = _mm256_mul_ps(r2, scale);
+				storeMat3SSE41(result + 0, _mm256_castps256_ps128(s0), _mm256_castps256_ps128(s1), _mm256_castps256_ps128(s2));
+				storeMat3SSE41(result + 9, _mm256_extractf128_ps(s0, 1), _mm256_extractf128_ps(s1, 1), _mm256_extractf128_ps(s2, 1));
+			}
+
+			inverseTransposeBatchSSE41(m, result, count - i);
+		}
+#	endif//GLM_BATCH_X86
+}//namespace detail
+
+	GLM_FUNC_QUALIFIER batch_arch batchArch()
+	{
+		static batch_arch const Arch = detail::detectBatchArch();
+		return Arch;
+	}
+
+	GLM_FUNC_QUALIFIER void mulBatch(mat4 const* a, mat4 const* b, mat4* result, std::size_t count, batch_arch arch)
+	{
+		switch(detail::supportedBatchArch(arch))
+		{
+#		if GLM_BATCH_X86
+			case BATCH_ARCH_AVX2:
+				detail::mulBatchAVX2(reinterpret_cast<float const*>(a), reinterpret_cast<float const*>(b), reinterpret_cast<float*>(result), count);
+				break;
+			case BATCH_ARCH_SSE41:
+				detail::mulBatchSSE41(reinterpret_cast<float const*>(a), reinterpret_cast<float const*>(b), reinterpret_cast<float*>(result), count);
+				break;
+#		endif
+			default:
+				detail::mulBatchScalar(a, b, result, count);
+				break;
+		}
+	}
+
+	GLM_FUNC_QUALIFIER void mulBatch(mat4 const& m, soa_vec4<float const> const& v, soa_vec4<float> const& result, std::size_t count, batch_arch arch)
+	{
+		switch(detail::supportedBatchArch(arch))
+		{
+#		if GLM_BATCH_X86
+			case BATCH_ARCH_AVX2:
+				detail::mulBatchAVX2(m, v, result, count);
+				break;
+			case BATCH_ARCH_SSE41:
+				detail::mulBatchSSE41(m, v, result, count);
+				break;
+#		endif
+			default:
+				detail::mulBatchScalar(m, v, result, 0, count);
+				break;
+		}
+	}
+
+	GLM_FUNC_QUALIFIER void normalizeBatch(soa_vec3<float const> const& v, soa_vec3<float> const& result, std::size_t count, batch_arch arch)
+	{
+		switch(detail::supportedBatchArch(arch))
+		{
+#		if GLM_BATCH_X86
+			case BATCH_ARCH_AVX2:
+				detail::normalizeBatchAVX2(v, result, count);
+				break;
+			case BATCH_ARCH_SSE41:
+				detail::normalizeBatchSSE41(v, result, count);
+				break;
+#		endif
+			default:
+				detail::normalizeBatchScalar(v, result, 0, count);
+				break;
+		}
+	}
+
+	GLM_FUNC_QUALIFIER void inverseTransposeBatch(mat4 const* m, mat3* result, std::size_t count, batch_arch arch)
+	{
+		// The kernels write packed 3 floats columns, which aligned vec3 types pad
+		switch(sizeof(mat3) == 9 * sizeof(float) ? detail::supportedBatchArch(arch) : BATCH_ARCH_SCALAR)
+		{
+#		if GLM_BATCH_X86
+			case BATCH_ARCH_AVX2:
+				detail::inverseTransposeBatchAVX2(reinterpret_cast<float const*>(m), reinterpret_cast<float*>(result), count);
+				break;
+			case BATCH_ARCH_SSE41:
+				detail::inverseTransposeBatchSSE41(reinterpret_cast<float const*>(m), reinterpret_cast<float*>(result), count);
+				break;
+#		endif
+			default:
+				detail::inverseTransposeBatchScalar(m, result, count);
+				break;
+		}
+	}
+}//namespace glm
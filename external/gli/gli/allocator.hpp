@@ -0,0 +1,84 @@
+/// @brief Include to choose where the texel data of textures is allocated: zeroed or uninitialized heap blocks, or arenas shared by a batch of textures.
+/// @file gli/allocator.hpp
+
+#pragma once
+
+#include "type.hpp"
+#include <cstddef>
+#include <memory>
+#include <mutex>
+
+namespace gli
+{
+	/// Source of the memory of texture storages
+	class storage_allocator
+	{
+	public:
+		virtual ~storage_allocator() {}
+
+		/// Allocate Size bytes. The memory is released once the last pointer sharing it is destroyed, which may outlive the allocator.
+		virtual std::shared_ptr<byte> allocate(std::size_t Size) = 0;
+	};
+
+	/// Allocate each storage in its own heap block
+	class heap_allocator : public storage_allocator
+	{
+	public:
+		/// Size of the huge pages allocations are aligned on
+		static std::size_t const HugePageSize = 2 * 1024 * 1024;
+
+		/// @param Zero Zero-fill the allocations. Loaders, which overwrite the whole storage, skip this extra write pass.
+		/// @param Alignment Alignment of the allocations in bytes, a power of two
+		/// @param HugePages Align the allocations of at least HugePageSize bytes on huge pages and, on Linux, advise the kernel to back them with huge pages
+		explicit heap_allocator(bool Zero = true, std::size_t Alignment = 64, bool HugePages = false);
+
+		std::shared_ptr<byte> allocate(std::size_t Size);
+
+	private:
+		bool const Zero;
+		std::size_t const Alignment;
+		bool const HugePages;
+	};
+
+	/// Carve the storages of a batch of textures, such as a set of skyboxes or the layers of a cube array, out of large blocks:
+	/// a single allocation per block instead of one per texture. A block is released once every texture carved out of it is destroyed.
+	/// Allocations larger than a block get a block of their own. Thread safe.
+	class arena_allocator : public storage_allocator
+	{
+	public:
+		/// @param BlockSize Size of the blocks in bytes
+		/// @param Zero Zero-fill the blocks when they are allocated
+		/// @param Alignment Alignment of the allocations in bytes, a power of two
+		/// @param HugePages Align the blocks on huge pages, see heap_allocator
+		explicit arena_allocator(std::size_t BlockSize, bool Zero = false, std::size_t Alignment = 64, bool HugePages = false);
+
+		std::shared_ptr<byte> allocate(std::size_t Size);
+
+		/// Stop carving the current block: the next allocation starts a new one
+		void reset();
+
+		/// Number of blocks allocated so far
+		std::size_t blocks() const;
+
+	private:
+		arena_allocator(arena_allocator const&) = delete;
+		arena_allocator& operator=(arena_allocator const&) = delete;
+
+		heap_allocator Upstream;
+		std::size_t const BlockSize;
+		std::size_t const Alignment;
+
+		mutable std::mutex Mutex;
+		std::shared_ptr<byte> Block;
+		std::size_t Offset;
+		std::size_t Blocks;
+	};
+
+	/// Heap allocator zero-filling the allocations, used by the texture constructors without allocator
+	storage_allocator& default_allocator();
+
+	/// Heap allocator leaving the allocations uninitialized, used by the loaders and by the functions overwriting every texel they allocate
+	storage_allocator& uninitialized_allocator();
+}//namespace gli
+
+#include "./core/allocator.inl"
@@ -0,0 +1,92 @@
+/// @brief Include to cache processed textures on disk, keyed by the content of the source file and the processing recipe.
+/// @file gli/cache.hpp
+
+#pragma once
+
+#include "compress.hpp"
+#include "sampler.hpp"
+#include "texture.hpp"
+#include <cstdint>
+#include <string>
+
+namespace gli
+{
+	/// Processing applied to a source texture before upload: mipmap generation, then conversion or compression to a target format.
+	struct cache_recipe
+	{
+		cache_recipe()
+			: Format(FORMAT_UNDEFINED)
+			, GenerateMipmaps(false)
+			, MipmapFilter(FILTER_LINEAR)
+			, Quality(COMPRESS_QUALITY_NORMAL)
+		{}
+
+		/// Target format, FORMAT_UNDEFINED to keep the source format
+		format Format;
+
+		/// Generate the missing mipmaps of sources without a complete mipmap chain
+		bool GenerateMipmaps;
+
+		/// Minification filter of the generated mipmaps
+		filter MipmapFilter;
+
+		/// Endpoint search effort when the target format is compressed
+		compress_quality Quality;
+	};
+
+	/// Process a texture with a recipe: compressed sources are decompressed when they need mipmaps or a different format,
+	/// mipmaps are generated, then the texture is converted or compressed to the target format.
+	/// Returns an empty texture if a step doesn't support the formats involved.
+	texture process(texture const& Texture, cache_recipe const& Recipe);
+
+	/// 64 bits hash of a buffer, computed eight bytes at a time (the XXH64 algorithm)
+	std::uint64_t hash(void const* Data, std::size_t Size, std::uint64_t Seed = 0);
+
+	/// Directory of processed textures stored as DDS files named after the hash of the source file content and of the recipe.
+	/// Cached files keep the texel layout of texture storage, so load_dds_mapped hands them over without copy nor processing.
+	/// Files are written to a temporary file then renamed, other threads and processes never see partial files.
+	/// The modification time of a file is refreshed on each hit: past the capacity, the least recently used files are removed.
+	class texture_cache
+	{
+	public:
+		typedef std::uint64_t key_type;
+
+		/// @param Directory Directory of the cache files, created if it doesn't exist.
+		/// @param Capacity Total size in bytes of the cache files kept on disk after an insertion.
+		texture_cache(std::string const& Directory, std::uint64_t Capacity);
+
+		/// Key of the result of Recipe applied to the content of a source file
+		static key_type key(void const* Data, std::size_t Size, cache_recipe const& Recipe);
+
+		/// Path of the cache file of Key, whether it exists or not
+		std::string path(key_type Key) const;
+
+		/// Map the cached texture of Key and refresh its last use. Returns an empty texture if Key isn't cached.
+		texture find(key_type Key) const;
+
+		/// Store Texture as the cached texture of Key then evict the least recently used files past the capacity.
+		/// Returns false if the file can't be written.
+		bool insert(key_type Key, texture const& Texture);
+
+		/// Path of the cache file of the file Path processed by Recipe. On a miss, the file is loaded, processed and inserted.
+		/// Returns an empty string if the file can't be loaded, processed or cached.
+		std::string fetch(char const* Path, cache_recipe const& Recipe);
+
+		/// Texture of the file Path processed by Recipe, mapped from the cache. On a miss, the file is loaded, processed and inserted.
+		/// Returns an empty texture if the file can't be loaded or processed.
+		texture load(char const* Path, cache_recipe const& Recipe);
+
+		/// Remove the least recently used files until the cache files take at most Capacity bytes, keeping at least the most recently used one.
+		/// Returns the remaining size.
+		std::uint64_t evict(std::uint64_t Capacity);
+
+		/// Total size in bytes of the cache files
+		std::uint64_t size() const;
+
+	private:
+		std::string Directory;
+		std::uint64_t Capacity;
+	};
+}//namespace gli
+
+#include "./core/cache.inl"
@@ -0,0 +1,44 @@
+/// @brief Include to compress textures to BC1, BC3, BC4 and BC5 on the CPU.
+/// @file gli/compress.hpp
+
+#pragma once
+
+#include "texture1d.hpp"
+#include "texture1d_array.hpp"
+#include "texture2d.hpp"
+#include "texture2d_array.hpp"
+#include "texture3d.hpp"
+#include "texture_cube.hpp"
+#include "texture_cube_array.hpp"
+
+namespace gli
+{
+	/// Endpoint search effort of the block compression, each quality includes the searches of the lower qualities
+	enum compress_quality
+	{
+		COMPRESS_QUALITY_FAST, COMPRESS_QUALITY_FIRST = COMPRESS_QUALITY_FAST,	///< Range fit: endpoints at the extremes of the principal axis of the block colors
+		COMPRESS_QUALITY_NORMAL,	///< Range fit refined by least squares, alternate palette modes are tried
+		COMPRESS_QUALITY_HIGH, COMPRESS_QUALITY_LAST = COMPRESS_QUALITY_HIGH	///< Cluster fit: every ordered partition of the block colors along the principal axis is evaluated
+	};
+
+	enum
+	{
+		COMPRESS_QUALITY_COUNT = COMPRESS_QUALITY_LAST - COMPRESS_QUALITY_FIRST + 1
+	};
+
+	/// Compress every layer, face and level of an uncompressed texture to BC1 (DXT1), BC3 (DXT5), BC4 (ATI1N) or BC5 (ATI2N).
+	/// Blocks rows are spread across the hardware threads. The result can be saved with save_dds or save_ktx.
+	/// Mipmaps must be generated before compression, generate_mipmaps doesn't support compressed textures.
+	/// Returns an empty texture if the source format or destination format is not supported.
+	///
+	/// @param Texture Source texture, the format must be uncompressed. It is first converted to FORMAT_RGBA8_UNORM_PACK8, or FORMAT_RGBA8_SRGB_PACK8 for sRGB destination formats.
+	/// @param Format Destination texture format: FORMAT_RGB_DXT1_*_BLOCK8, FORMAT_RGBA_DXT1_*_BLOCK8, FORMAT_RGBA_DXT5_*_BLOCK16, FORMAT_R_ATI1N_UNORM_BLOCK8 or FORMAT_RG_ATI2N_UNORM_BLOCK16.
+	/// @param Quality Endpoint search effort.
+	template <typename texture_type>
+	texture_type compress(texture_type const& Texture, format Format, compress_quality Quality = COMPRESS_QUALITY_NORMAL);
+
+	/// Return whether compress supports compressing a texture to the format Format
+	bool is_compressible(format Format);
+}//namespace gli
+
+#include "./core/compress.inl"
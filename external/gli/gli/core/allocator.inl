@@ -0,0 +1,109 @@
+#include <cstdint>
+#include <cstring>
+#include <glm/simd/platform.h>
+
+#if GLM_PLATFORM & GLM_PLATFORM_LINUX
+#	include <sys/mman.h>
+#endif
+
+namespace gli{
+namespace detail
+{
+	inline std::size_t align_size(std::size_t Size, std::size_t Alignment)
+	{
+		return (Size + Alignment - 1) & ~(Alignment - 1);
+	}
+
+	/// Let the kernel back a huge page aligned range with huge pages. It only applies to pages not touched yet.
+	inline void advise_huge_pages(void* Data, std::size_t Size)
+	{
+#		if (GLM_PLATFORM & GLM_PLATFORM_LINUX) && defined(MADV_HUGEPAGE)
+			madvise(Data, Size, MADV_HUGEPAGE);
+#		else
+			(void)Data;
+			(void)Size;
+#		endif
+	}
+}//namespace detail
+
+	inline heap_allocator::heap_allocator(bool Zero, std::size_t Alignment, bool HugePages)
+		: Zero(Zero)
+		, Alignment(Alignment > 0 ? Alignment : 1)
+		, HugePages(HugePages)
+	{
+		GLI_ASSERT((this->Alignment & (this->Alignment - 1)) == 0);
+	}
+
+	inline std::shared_ptr<byte> heap_allocator::allocate(std::size_t Size)
+	{
+		bool const Huge = this->HugePages && Size >= HugePageSize;
+		std::size_t const Alignment = Huge && this->Alignment < HugePageSize ? static_cast<std::size_t>(HugePageSize) : this->Alignment;
+
+		// Default-initialized: the pages of the block are only written when used
+		std::shared_ptr<byte> const Block(new byte[Size + Alignment - 1], std::default_delete<byte[]>());
+		byte* const Data = Block.get() + (detail::align_size(reinterpret_cast<std::uintptr_t>(Block.get()), Alignment) - reinterpret_cast<std::uintptr_t>(Block.get()));
+
+		if(Huge)
+			detail::advise_huge_pages(Data, Size);
+		if(this->Zero)
+			std::memset(Data, 0, Size);
+
+		return std::shared_ptr<byte>(Block, Data);
+	}
+
+	inline arena_allocator::arena_allocator(std::size_t BlockSize, bool Zero, std::size_t Alignment, bool HugePages)
+		: Upstream(Zero, Alignment, HugePages)
+		, BlockSize(BlockSize)
+		, Alignment(Alignment > 0 ? Alignment : 1)
+		, Offset(0)
+		, Blocks(0)
+	{}
+
+	inline std::shared_ptr<byte> arena_allocator::allocate(std::size_t Size)
+	{
+		std::lock_guard<std::mutex> Lock(this->Mutex);
+
+		// Too large for any block: allocated apart, the current block keeps serving the smaller allocations
+		if(Size > this->BlockSize)
+		{
+			++this->Blocks;
+			return this->Upstream.allocate(Size);
+		}
+
+		std::size_t Begin = detail::align_size(this->Offset, this->Alignment);
+		if(!this->Block || Begin > this->BlockSize || Size > this->BlockSize - Begin)
+		{
+			this->Block = this->Upstream.allocate(this->BlockSize);
+			++this->Blocks;
+			Begin = 0;
+		}
+
+		this->Offset = Begin + Size;
+		return std::shared_ptr<byte>(this->Block, this->Block.get() + Begin);
+	}
+
+	inline void arena_allocator::reset()
+	{
+		std::lock_guard<std::mutex> Lock(this->Mutex);
+		this->Block.reset();
+		this->Offset = 0;
+	}
+
+	inline std::size_t arena_allocator::blocks() const
+	{
+		std::lock_guard<std::mutex> Lock(this->Mutex);
+		return this->Blocks;
+	}
+
+	inline storage_allocator& default_allocator()
+	{
+		static heap_allocator Allocator(true);
+		return Allocator;
+	}
+
+	inline storage_allocator& uninitialized_allocator()
+	{
+		static heap_allocator Allocator(false);
+		return Allocator;
+	}
+}//namespace gli
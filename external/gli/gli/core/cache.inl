@@ -0,0 +1,333 @@
+#include "../convert.hpp"
+#include "../copy.hpp"
+#include "../decompress.hpp"
+#include "../generate_mipmaps.hpp"
+#include "../levels.hpp"
+#include "../load.hpp"
+#include "../load_dds.hpp"
+#include "../save_dds.hpp"
+#include "./file.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace gli{
+namespace detail
+{
+	/// Version of the cache file content, part of every key: changing the processing code must change it
+	std::uint32_t const CACHE_VERSION = 2;
+
+	std::uint64_t const HASH_PRIME1 = 0x9E3779B185EBCA87ull;
+	std::uint64_t const HASH_PRIME2 = 0xC2B2AE3D27D4EB4Full;
+	std::uint64_t const HASH_PRIME3 = 0x165667B19E3779F9ull;
+	std::uint64_t const HASH_PRIME4 = 0x85EBCA77C2B2AE63ull;
+	std::uint64_t const HASH_PRIME5 = 0x27D4EB2F165667C5ull;
+
+	inline std::uint64_t hash_rotate(std::uint64_t Value, int Bits)
+	{
+		return (Value << Bits) | (Value >> (64 - Bits));
+	}
+
+	inline std::uint64_t hash_read64(glm::uint8 const* Data)
+	{
+		std::uint64_t Value;
+		std::memcpy(&Value, Data, sizeof(Value));
+		return Value;
+	}
+
+	inline std::uint32_t hash_read32(glm::uint8 const* Data)
+	{
+		std::uint32_t Value;
+		std::memcpy(&Value, Data, sizeof(Value));
+		return Value;
+	}
+
+	inline std::uint64_t hash_round(std::uint64_t Accumulator, std::uint64_t Input)
+	{
+		return hash_rotate(Accumulator + Input * HASH_PRIME2, 31) * HASH_PRIME1;
+	}
+
+	inline std::uint64_t hash_merge(std::uint64_t Hash, std::uint64_t Accumulator)
+	{
+		return (Hash ^ hash_round(0, Accumulator)) * HASH_PRIME1 + HASH_PRIME4;
+	}
+
+	template <typename texture_type>
+	inline texture process(texture_type Texture, cache_recipe const& Recipe)
+	{
+		format const Format = Recipe.Format == FORMAT_UNDEFINED ? Texture.format() : Recipe.Format;
+		texture::extent_type const Extent(Texture.texture::extent());
+		bool const Mipmaps = Recipe.GenerateMipmaps && Texture.levels() < static_cast<texture::size_type>(levels(Extent));
+
+		// Mipmap generation and compression read uncompressed texels
+		if(is_compressed(Texture.format()) && (Format != Texture.format() || Mipmaps))
+		{
+			format const Uncompressed = !Mipmaps && !is_compressed(Format) ? Format : (is_srgb(Texture.format()) ? FORMAT_RGBA8_SRGB_PACK8 : FORMAT_RGBA8_UNORM_PACK8);
+			if(!is_decompressible(Texture.format(), Uncompressed))
+				return texture();
+			Texture = gli::decompress(Texture, Uncompressed);
+		}
+
+		if(Mipmaps)
+		{
+			texture_type Chain(texture(Texture.target(), Texture.format(), Extent, Texture.layers(), Texture.faces(), levels(Extent), Texture.swizzles()));
+			copy_level(Texture, 0, Chain, 0);
+			Texture = generate_mipmaps(Chain, Recipe.MipmapFilter);
+		}
+
+		if(Format == Texture.format())
+			return Texture;
+		if(!is_compressed(Format))
+			return gli::convert(Texture, Format);
+		if(!is_compressible(Format))
+			return texture();
+		return compress(Texture, Format, Recipe.Quality);
+	}
+
+	/// Name of a temporary file next to Path, unique across the threads and processes writing the same path
+	inline std::string temporary_path(std::string const& Path)
+	{
+		static std::atomic<std::uint64_t> Counter(0);
+
+		std::uint64_t const Values[] =
+		{
+			static_cast<std::uint64_t>(std::hash<std::thread::id>()(std::this_thread::get_id())),
+			static_cast<std::uint64_t>(std::chrono::high_resolution_clock::now().time_since_epoch().count()),
+			Counter++
+		};
+
+		char Suffix[24];
+		std::snprintf(Suffix, sizeof(Suffix), ".%016llx", static_cast<unsigned long long>(hash(Values, sizeof(Values))));
+		return Path + Suffix + ".tmp";
+	}
+
+	/// Cache files are named after their key: 16 hexadecimal digits and the .dds extension
+	inline bool is_cache_file(std::string const& Name)
+	{
+		return Name.size() == 20 && Name.compare(16, 4, ".dds") == 0 && Name.find_first_not_of("0123456789abcdef") == 16;
+	}
+}//namespace detail
+
+	inline texture process(texture const& Texture, cache_recipe const& Recipe)
+	{
+		GLI_ASSERT(!Texture.empty());
+
+		switch(Texture.target())
+		{
+		case TARGET_1D:
+			return detail::process(texture1d(Texture), Recipe);
+		case TARGET_1D_ARRAY:
+			return detail::process(texture1d_array(Texture), Recipe);
+		case TARGET_2D:
+			return detail::process(texture2d(Texture), Recipe);
+		case TARGET_2D_ARRAY:
+			return detail::process(texture2d_array(Texture), Recipe);
+		case TARGET_3D:
+			return detail::process(texture3d(Texture), Recipe);
+		case TARGET_CUBE:
+			return detail::process(texture_cube(Texture), Recipe);
+		case TARGET_CUBE_ARRAY:
+			return detail::process(texture_cube_array(Texture), Recipe);
+		default:
+			return texture();
+		}
+	}
+
+	inline std::uint64_t hash(void const* Data, std::size_t Size, std::uint64_t Seed)
+	{
+		glm::uint8 const* Bytes = static_cast<glm::uint8 const*>(Data);
+		glm::uint8 const* const End = Bytes + Size;
+		std::uint64_t Hash = 0;
+
+		if(Size >= 32)
+		{
+			// Four independent lanes over 32 bytes stripes
+			std::uint64_t Lanes[4] = {Seed + detail::HASH_PRIME1 + detail::HASH_PRIME2, Seed + detail::HASH_PRIME2, Seed, Seed - detail::HASH_PRIME1};
+			for(; Bytes + 32 <= End; Bytes += 32)
+			{
+				Lanes[0] = detail::hash_round(Lanes[0], detail::hash_read64(Bytes));
+				Lanes[1] = detail::hash_round(Lanes[1], detail::hash_read64(Bytes + 8));
+				Lanes[2] = detail::hash_round(Lanes[2], detail::hash_read64(Bytes + 16));
+				Lanes[3] = detail::hash_round(Lanes[3], detail::hash_read64(Bytes + 24));
+			}
+
+			Hash = detail::hash_rotate(Lanes[0], 1) + detail::hash_rotate(Lanes[1], 7) + detail::hash_rotate(Lanes[2], 12) + detail::hash_rotate(Lanes[3], 18);
+			for(int Lane = 0; Lane < 4; ++Lane)
+				Hash = detail::hash_merge(Hash, Lanes[Lane]);
+		}
+		else
+			Hash = Seed + detail::HASH_PRIME5;
+
+		Hash += static_cast<std::uint64_t>(Size);
+
+		for(; Bytes + 8 <= End; Bytes += 8)
+			Hash = detail::hash_rotate(Hash ^ detail::hash_round(0, detail::hash_read64(Bytes)), 27) * detail::HASH_PRIME1 + detail::HASH_PRIME4;
+		if(Bytes + 4 <= End)
+		{
+			Hash = detail::hash_rotate(Hash ^ (detail::hash_read32(Bytes) * detail::HASH_PRIME1), 23) * detail::HASH_PRIME2 + detail::HASH_PRIME3;
+			Bytes += 4;
+		}
+		for(; Bytes < End; ++Bytes)
+			Hash = detail::hash_rotate(Hash ^ (*Bytes * detail::HASH_PRIME5), 11) * detail::HASH_PRIME1;
+
+		Hash ^= Hash >> 33;
+		Hash *= detail::HASH_PRIME2;
+		Hash ^= Hash >> 29;
+		Hash *= detail::HASH_PRIME3;
+		Hash ^= Hash >> 32;
+		return Hash;
+	}
+
+	inline texture_cache::texture_cache(std::string const& Directory, std::uint64_t Capacity)
+		: Directory(Directory)
+		, Capacity(Capacity)
+	{
+		detail::make_directory(Directory.c_str());
+	}
+
+	inline texture_cache::key_type texture_cache::key(void const* Data, std::size_t Size, cache_recipe const& Recipe)
+	{
+		std::uint32_t const Values[] =
+		{
+			detail::CACHE_VERSION,
+			static_cast<std::uint32_t>(Recipe.Format),
+			static_cast<std::uint32_t>(Recipe.GenerateMipmaps),
+			static_cast<std::uint32_t>(Recipe.MipmapFilter),
+			static_cast<std::uint32_t>(Recipe.Quality)
+		};
+
+		return hash(Values, sizeof(Values), hash(Data, Size));
+	}
+
+	inline std::string texture_cache::path(key_type Key) const
+	{
+		char Name[24];
+		std::snprintf(Name, sizeof(Name), "/%016llx.dds", static_cast<unsigned long long>(Key));
+		return this->Directory + Name;
+	}
+
+	inline texture texture_cache::find(key_type Key) const
+	{
+		std::string const Path(this->path(Key));
+
+		texture Texture(load_dds_mapped(Path));
+		if(!Texture.empty())
+			detail::touch_file(Path.c_str());
+		return Texture;
+	}
+
+	inline bool texture_cache::insert(key_type Key, texture const& Texture)
+	{
+		GLI_ASSERT(!Texture.empty());
+
+		std::vector<char> Memory;
+		if(!save_dds(Texture, Memory))
+			return false;
+
+		std::string const Path(this->path(Key));
+		std::string const Temporary(detail::temporary_path(Path));
+
+		FILE* File = detail::open_file(Temporary.c_str(), "wb");
+		if(!File)
+			return false;
+
+		bool const Written = std::fwrite(&Memory[0], 1, Memory.size(), File) == Memory.size();
+		bool const Closed = std::fclose(File) == 0;
+		if(!Written || !Closed || !detail::replace_file(Temporary.c_str(), Path.c_str()))
+		{
+			std::remove(Temporary.c_str());
+			return false;
+		}
+
+		this->evict(this->Capacity);
+		return true;
+	}
+
+	inline std::string texture_cache::fetch(char const* Path, cache_recipe const& Recipe)
+	{
+		std::shared_ptr<detail::mapped_file> Source(detail::map_file(Path));
+		if(!Source)
+			return std::string();
+
+		key_type const Key(key(Source->data(), Source->size(), Recipe));
+		std::string const CachePath(this->path(Key));
+		if(detail::touch_file(CachePath.c_str()))
+			return CachePath;
+
+		texture const Texture(gli::load(Source->data(), Source->size()));
+		if(Texture.empty())
+			return std::string();
+
+		texture const Processed(process(Texture, Recipe));
+		if(Processed.empty() || !this->insert(Key, Processed))
+			return std::string();
+		return CachePath;
+	}
+
+	inline texture texture_cache::load(char const* Path, cache_recipe const& Recipe)
+	{
+		std::shared_ptr<detail::mapped_file> Source(detail::map_file(Path));
+		if(!Source)
+			return texture();
+
+		key_type const Key(key(Source->data(), Source->size(), Recipe));
+		texture const Cached(this->find(Key));
+		if(!Cached.empty())
+			return Cached;
+
+		texture const Texture(gli::load(Source->data(), Source->size()));
+		if(Texture.empty())
+			return texture();
+
+		// A texture that can't be cached is still returned
+		texture const Processed(process(Texture, Recipe));
+		if(Processed.empty() || !this->insert(Key, Processed))
+			return Processed;
+
+		texture const Mapped(this->find(Key));
+		return Mapped.empty() ? Processed : Mapped;
+	}
+
+	inline std::uint64_t texture_cache::evict(std::uint64_t Capacity)
+	{
+		std::vector<detail::file_status> Files(detail::list_files(this->Directory.c_str()));
+		Files.erase(std::remove_if(Files.begin(), Files.end(), [](detail::file_status const& File)
+		{
+			return !detail::is_cache_file(File.Name);
+		}), Files.end());
+
+		std::uint64_t Size = 0;
+		for(std::size_t Index = 0; Index < Files.size(); ++Index)
+			Size += Files[Index].Size;
+
+		// Oldest files first
+		std::sort(Files.begin(), Files.end(), [](detail::file_status const& A, detail::file_status const& B)
+		{
+			return A.Time < B.Time;
+		});
+
+		// The most recently used file is kept, files still mapped can't be removed on Windows and are skipped
+		for(std::size_t Index = 0; Index + 1 < Files.size() && Size > Capacity; ++Index)
+		{
+			if(std::remove((this->Directory + "/" + Files[Index].Name).c_str()) == 0)
+				Size -= Files[Index].Size;
+		}
+
+		return Size;
+	}
+
+	inline std::uint64_t texture_cache::size() const
+	{
+		std::vector<detail::file_status> const Files(detail::list_files(this->Directory.c_str()));
+
+		std::uint64_t Size = 0;
+		for(std::size_t Index = 0; Index < Files.size(); ++Index)
+			if(detail::is_cache_file(Files[Index].Name))
+				Size += Files[Index].Size;
+		return Size;
+	}
+}//namespace gli
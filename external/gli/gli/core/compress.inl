@@ -0,0 +1,743 @@
+#include "../convert.hpp"
+#include "./bc.hpp"
+#include "./parallel.hpp"
+#include "./simd.hpp"
+#include <glm/gtc/packing.hpp>
+#include <algorithm>
+#include <cfloat>
+#include <vector>
+
+namespace gli{
+namespace detail
+{
+	inline simd_vec4 to_simd(glm::vec3 const& Color)
+	{
+		return simd_vec4(Color.r, Color.g, Color.b, 0.0f);
+	}
+
+	inline glm::vec3 to_vec3(simd_vec4 const& Color)
+	{
+		float Values[4];
+		Color.store(Values);
+		return glm::vec3(Values[0], Values[1], Values[2]);
+	}
+
+	/// Quantize a color to the R5G6B5 endpoint encoding expanded by dxt_color_palette
+	inline glm::uint16 quantize_565(glm::vec3 const& Color)
+	{
+		glm::u16vec3 const Bits(glm::round(glm::clamp(Color, 0.0f, 1.0f) * glm::vec3(31.0f, 63.0f, 31.0f)));
+		return static_cast<glm::uint16>((Bits.r << 11) | (Bits.g << 5) | Bits.b);
+	}
+
+	/// Texels of a block to encode with a BC1 or BC3 color block
+	struct color_block
+	{
+		glm::vec3 Texel[16];
+		// BC1 texels encoded with the transparent black entry of the three colors palette
+		bool Transparent[16];
+		bool HasTransparent;
+		// BC1 blocks select the three colors palette when Color0 <= Color1, BC3 color blocks always use four colors
+		bool Bc1;
+	};
+
+	struct color_block_fit
+	{
+		glm::uint16 Color0;
+		glm::uint16 Color1;
+		glm::uint8 Index[16];
+		float Error;
+	};
+
+	/// Select the closest palette entry of each texel, the palette is built like the reference decoders build it.
+	/// Returns the sum of the squared distances.
+	inline float color_indices(color_block const& Block, glm::uint16 Color0, glm::uint16 Color1, bool ThreeColor, glm::uint8* Index)
+	{
+		glm::vec3 Palette[4];
+		dxt_color_palette(Color0, Color1, Palette);
+		if(ThreeColor)
+			Palette[2] = (Palette[0] + Palette[1]) / 2.0f;
+
+		// The transparent entry is never the closest to an opaque texel
+		float const Excluded = ThreeColor ? 1e6f : 0.0f;
+		simd_vec4 const PaletteR(Palette[0].r, Palette[1].r, Palette[2].r, Palette[3].r + Excluded);
+		simd_vec4 const PaletteG(Palette[0].g, Palette[1].g, Palette[2].g, Palette[3].g);
+		simd_vec4 const PaletteB(Palette[0].b, Palette[1].b, Palette[2].b, Palette[3].b);
+
+		float Error = 0.0f;
+		for(int Texel = 0; Texel < 16; ++Texel)
+		{
+			if(Block.Transparent[Texel])
+			{
+				Index[Texel] = 3;
+				continue;
+			}
+
+			simd_vec4 const DistanceR(PaletteR - simd_vec4(Block.Texel[Texel].r));
+			simd_vec4 const DistanceG(PaletteG - simd_vec4(Block.Texel[Texel].g));
+			simd_vec4 const DistanceB(PaletteB - simd_vec4(Block.Texel[Texel].b));
+
+			float Distance[4];
+			(DistanceR * DistanceR + DistanceG * DistanceG + DistanceB * DistanceB).store(Distance);
+
+			int Closest = 0;
+			for(int Entry = 1; Entry < 4; ++Entry)
+				if(Distance[Entry] < Distance[Closest])
+					Closest = Entry;
+
+			Index[Texel] = static_cast<glm::uint8>(Closest);
+			Error += Distance[Closest];
+		}
+
+		return Error;
+	}
+
+	inline void try_color_codes(color_block const& Block, glm::uint16 Color0, glm::uint16 Color1, color_block_fit& Best)
+	{
+		bool const ThreeColor = Block.Bc1 && Color0 <= Color1;
+		if(Block.HasTransparent && !ThreeColor)
+			return;
+
+		color_block_fit Fit;
+		Fit.Color0 = Color0;
+		Fit.Color1 = Color1;
+		Fit.Error = color_indices(Block, Color0, Color1, ThreeColor, Fit.Index);
+
+		if(Fit.Error < Best.Error)
+			Best = Fit;
+	}
+
+	/// Quantize the endpoints and order them to select the four colors or the three colors palette of BC1 blocks
+	inline void try_color_endpoints(color_block const& Block, glm::vec3 const& Start, glm::vec3 const& End, bool ThreeColor, color_block_fit& Best)
+	{
+		glm::uint16 Color0 = quantize_565(Start);
+		glm::uint16 Color1 = quantize_565(End);
+		if(ThreeColor ? Color0 > Color1 : Color0 < Color1)
+			std::swap(Color0, Color1);
+
+		try_color_codes(Block, Color0, Color1, Best);
+	}
+
+	/// Endpoints pairs reproducing each 8 bits value the closest with 2/3 of the first endpoint and 1/3 of the second endpoint
+	struct single_color_table
+	{
+		single_color_table()
+		{
+			build(31, this->Match5);
+			build(63, this->Match6);
+		}
+
+		glm::u8vec2 Match5[256];
+		glm::u8vec2 Match6[256];
+
+	private:
+		static void build(int Max, glm::u8vec2* Match)
+		{
+			for(int Value = 0; Value < 256; ++Value)
+			{
+				float BestError = FLT_MAX;
+				for(int Endpoint0 = 0; Endpoint0 <= Max; ++Endpoint0)
+				for(int Endpoint1 = 0; Endpoint1 <= Max; ++Endpoint1)
+				{
+					float const Interpolated = (2.0f / 3.0f) * (static_cast<float>(Endpoint0) / Max) + (1.0f / 3.0f) * (static_cast<float>(Endpoint1) / Max);
+					float const Error = glm::abs(Interpolated * 255.0f - static_cast<float>(Value));
+					if(Error < BestError)
+					{
+						BestError = Error;
+						Match[Value] = glm::u8vec2(Endpoint0, Endpoint1);
+					}
+				}
+			}
+		}
+	};
+
+	inline single_color_table const& get_single_color_table()
+	{
+		static single_color_table const Table;
+		return Table;
+	}
+
+	/// A block of a single color is best encoded by the interpolated palette entry rather than by a quantized endpoint
+	inline void single_color_fit(color_block const& Block, glm::vec3 const& Color, color_block_fit& Best)
+	{
+		single_color_table const& Table = get_single_color_table();
+		glm::u8vec3 const Value(glm::round(Color * 255.0f));
+
+		glm::u8vec2 const R = Table.Match5[Value.r];
+		glm::u8vec2 const G = Table.Match6[Value.g];
+		glm::u8vec2 const B = Table.Match5[Value.b];
+
+		glm::uint16 Color0 = static_cast<glm::uint16>((R.x << 11) | (G.x << 5) | B.x);
+		glm::uint16 Color1 = static_cast<glm::uint16>((R.y << 11) | (G.y << 5) | B.y);
+		// Swapped endpoints interpolate the same color with the fourth palette entry
+		if(Color0 < Color1)
+			std::swap(Color0, Color1);
+
+		try_color_codes(Block, Color0, Color1, Best);
+	}
+
+	/// Principal axis of the colors, by power iteration on the covariance matrix
+	inline glm::vec3 principal_axis(glm::vec3 const* Points, int Count)
+	{
+		glm::vec3 Centroid(0.0f);
+		for(int Point = 0; Point < Count; ++Point)
+			Centroid += Points[Point];
+		Centroid /= static_cast<float>(Count);
+
+		glm::mat3 Covariance(0.0f);
+		for(int Point = 0; Point < Count; ++Point)
+		{
+			glm::vec3 const Delta(Points[Point] - Centroid);
+			Covariance += glm::outerProduct(Delta, Delta);
+		}
+
+		// Start from the row of the largest variance so that the iteration doesn't start orthogonal to the axis
+		glm::vec3 Axis(Covariance[0]);
+		if(Covariance[1][1] > Axis.x && Covariance[1][1] > Covariance[2][2])
+			Axis = Covariance[1];
+		else if(Covariance[2][2] > Axis.x)
+			Axis = Covariance[2];
+
+		for(int Iteration = 0; Iteration < 8; ++Iteration)
+		{
+			Axis = Covariance * Axis;
+			float const Length = glm::max(glm::abs(Axis.x), glm::max(glm::abs(Axis.y), glm::abs(Axis.z)));
+			if(Length <= 0.0f)
+				return glm::vec3(0.0f);
+			Axis /= Length;
+		}
+
+		return Axis;
+	}
+
+	/// Endpoints at the colors of the extreme projections on the principal axis
+	inline void range_fit(color_block const& Block, glm::vec3 const* Points, int Count, glm::vec3 const& Axis, bool ThreeColor, color_block_fit& Best)
+	{
+		int Min = 0;
+		int Max = 0;
+		float MinProjection = FLT_MAX;
+		float MaxProjection = -FLT_MAX;
+		for(int Point = 0; Point < Count; ++Point)
+		{
+			float const Projection = glm::dot(Points[Point], Axis);
+			if(Projection < MinProjection)
+			{
+				MinProjection = Projection;
+				Min = Point;
+			}
+			if(Projection > MaxProjection)
+			{
+				MaxProjection = Projection;
+				Max = Point;
+			}
+		}
+
+		try_color_endpoints(Block, Points[Max], Points[Min], ThreeColor, Best);
+	}
+
+	/// Solve the endpoints minimizing the squared error for the indices of the Best fit
+	inline void least_squares_fit(color_block const& Block, color_block_fit& Best)
+	{
+		bool const ThreeColor = Block.Bc1 && Best.Color0 <= Best.Color1;
+		float const Weights[2][4] = {{1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f}, {1.0f, 0.0f, 1.0f / 2.0f, 0.0f}};
+
+		float Alpha2 = 0.0f;
+		float Beta2 = 0.0f;
+		float AlphaBeta = 0.0f;
+		glm::vec3 AlphaX(0.0f);
+		glm::vec3 BetaX(0.0f);
+		for(int Texel = 0; Texel < 16; ++Texel)
+		{
+			if(Block.Transparent[Texel])
+				continue;
+
+			float const Alpha = Weights[ThreeColor ? 1 : 0][Best.Index[Texel]];
+			float const Beta = 1.0f - Alpha;
+			Alpha2 += Alpha * Alpha;
+			Beta2 += Beta * Beta;
+			AlphaBeta += Alpha * Beta;
+			AlphaX += Alpha * Block.Texel[Texel];
+			BetaX += Beta * Block.Texel[Texel];
+		}
+
+		float const Determinant = Alpha2 * Beta2 - AlphaBeta * AlphaBeta;
+		if(Determinant < 1e-4f)
+			return;
+
+		glm::vec3 const Start((AlphaX * Beta2 - BetaX * AlphaBeta) / Determinant);
+		glm::vec3 const End((BetaX * Alpha2 - AlphaX * AlphaBeta) / Determinant);
+
+		try_color_endpoints(Block, Start, End, ThreeColor, Best);
+	}
+
+	/// Evaluate every ordered partition of the points along the principal axis into the clusters of the palette entries,
+	/// solving the least squares endpoints of each partition on the R5G6B5 grid.
+	inline void cluster_fit(color_block const& Block, glm::vec3 const* Points, int Count, glm::vec3 const& Axis, bool ThreeColor, color_block_fit& Best)
+	{
+		int Order[16];
+		float Projection[16];
+		for(int Point = 0; Point < Count; ++Point)
+		{
+			float const Key = glm::dot(Points[Point], Axis);
+			int Insert = Point;
+			for(; Insert > 0 && Projection[Insert - 1] > Key; --Insert)
+			{
+				Projection[Insert] = Projection[Insert - 1];
+				Order[Insert] = Order[Insert - 1];
+			}
+			Projection[Insert] = Key;
+			Order[Insert] = Point;
+		}
+
+		simd_vec4 Sorted[16];
+		simd_vec4 Total(0.0f);
+		for(int Point = 0; Point < Count; ++Point)
+		{
+			Sorted[Point] = to_simd(Points[Order[Point]]);
+			Total = Total + Sorted[Point];
+		}
+
+		simd_vec4 const Zero(0.0f);
+		simd_vec4 const One(1.0f);
+		simd_vec4 const Two(2.0f);
+		simd_vec4 const Grid(31.0f, 63.0f, 31.0f, 0.0f);
+		simd_vec4 const GridRcp(1.0f / 31.0f, 1.0f / 63.0f, 1.0f / 31.0f, 0.0f);
+
+		float BestError = FLT_MAX;
+		simd_vec4 BestStart(0.0f);
+		simd_vec4 BestEnd(0.0f);
+
+		// Squared error of the endpoints solving the partition, minus the sum of the squared points that is the same for every partition
+		auto Evaluate = [&](simd_vec4 const& AlphaX, simd_vec4 const& BetaX, float Alpha2, float Beta2, float AlphaBeta)
+		{
+			float const Determinant = Alpha2 * Beta2 - AlphaBeta * AlphaBeta;
+			if(Determinant < 1e-4f)
+				return;
+
+			simd_vec4 const Factor(1.0f / Determinant);
+			simd_vec4 Start((AlphaX * simd_vec4(Beta2) - BetaX * simd_vec4(AlphaBeta)) * Factor);
+			simd_vec4 End((BetaX * simd_vec4(Alpha2) - AlphaX * simd_vec4(AlphaBeta)) * Factor);
+
+			Start = lane_round(lane_min(lane_max(Start, Zero), One) * Grid) * GridRcp;
+			End = lane_round(lane_min(lane_max(End, Zero), One) * Grid) * GridRcp;
+
+			simd_vec4 const Error(
+				Start * Start * simd_vec4(Alpha2) + End * End * simd_vec4(Beta2) +
+				(Start * End * simd_vec4(AlphaBeta) - Start * AlphaX - End * BetaX) * Two);
+
+			float const Sum = lane_sum3(Error);
+			if(Sum < BestError)
+			{
+				BestError = Sum;
+				BestStart = Start;
+				BestEnd = End;
+			}
+		};
+
+		if(ThreeColor)
+		{
+			// Points [0, i) on Start, [i, j) on the half point, [j, Count) on End
+			simd_vec4 Part0(0.0f);
+			for(int i = 0; i <= Count; ++i)
+			{
+				simd_vec4 Part1(0.0f);
+				for(int j = i; j <= Count; ++j)
+				{
+					simd_vec4 const Part2(Total - Part0 - Part1);
+					float const Count1 = static_cast<float>(j - i);
+					Evaluate(
+						Part0 + Part1 * simd_vec4(0.5f), Part2 + Part1 * simd_vec4(0.5f),
+						static_cast<float>(i) + 0.25f * Count1, static_cast<float>(Count - j) + 0.25f * Count1, 0.25f * Count1);
+
+					if(j < Count)
+						Part1 = Part1 + Sorted[j];
+				}
+				if(i < Count)
+					Part0 = Part0 + Sorted[i];
+			}
+		}
+		else
+		{
+			// Points [0, i) on Start, [i, j) on 2/3 Start + 1/3 End, [j, k) on 1/3 Start + 2/3 End, [k, Count) on End
+			simd_vec4 const TwoThirds(2.0f / 3.0f);
+			simd_vec4 const OneThird(1.0f / 3.0f);
+
+			simd_vec4 Part0(0.0f);
+			for(int i = 0; i <= Count; ++i)
+			{
+				simd_vec4 Part1(0.0f);
+				for(int j = i; j <= Count; ++j)
+				{
+					simd_vec4 Part2(0.0f);
+					for(int k = j; k <= Count; ++k)
+					{
+						simd_vec4 const Part3(Total - Part0 - Part1 - Part2);
+						float const Count1 = static_cast<float>(j - i);
+						float const Count2 = static_cast<float>(k - j);
+						Evaluate(
+							Part0 + Part1 * TwoThirds + Part2 * OneThird, Part3 + Part2 * TwoThirds + Part1 * OneThird,
+							static_cast<float>(i) + (4.0f / 9.0f) * Count1 + (1.0f / 9.0f) * Count2,
+							static_cast<float>(Count - k) + (4.0f / 9.0f) * Count2 + (1.0f / 9.0f) * Count1,
+							(2.0f / 9.0f) * (Count1 + Count2));
+
+						if(k < Count)
+							Part2 = Part2 + Sorted[k];
+					}
+					if(j < Count)
+						Part1 = Part1 + Sorted[j];
+				}
+				if(i < Count)
+					Part0 = Part0 + Sorted[i];
+			}
+		}
+
+		if(BestError < FLT_MAX)
+			try_color_endpoints(Block, to_vec3(BestStart), to_vec3(BestEnd), ThreeColor, Best);
+	}
+
+	inline color_block_fit fit_color_block(color_block const& Block, compress_quality Quality)
+	{
+		color_block_fit Best;
+		Best.Error = FLT_MAX;
+
+		glm::vec3 Points[16];
+		int Count = 0;
+		for(int Texel = 0; Texel < 16; ++Texel)
+			if(!Block.Transparent[Texel])
+				Points[Count++] = Block.Texel[Texel];
+
+		if(Count == 0)
+		{
+			Best.Color0 = Best.Color1 = 0;
+			std::fill(Best.Index, Best.Index + 16, glm::uint8(3));
+			return Best;
+		}
+
+		if(std::count(Points, Points + Count, Points[0]) == Count)
+		{
+			single_color_fit(Block, Points[0], Best);
+			try_color_endpoints(Block, Points[0], Points[0], Block.HasTransparent, Best);
+			return Best;
+		}
+
+		glm::vec3 const Axis(principal_axis(Points, Count));
+
+		// Transparent texels require the three colors palette
+		bool const FourColor = !Block.HasTransparent;
+		bool const ThreeColor = Block.Bc1 && (Block.HasTransparent || Quality >= COMPRESS_QUALITY_NORMAL);
+
+		if(FourColor)
+			range_fit(Block, Points, Count, Axis, false, Best);
+		if(ThreeColor)
+			range_fit(Block, Points, Count, Axis, true, Best);
+
+		if(Quality >= COMPRESS_QUALITY_HIGH)
+		{
+			if(FourColor)
+				cluster_fit(Block, Points, Count, Axis, false, Best);
+			if(ThreeColor)
+				cluster_fit(Block, Points, Count, Axis, true, Best);
+		}
+
+		if(Quality >= COMPRESS_QUALITY_NORMAL)
+			for(int Iteration = 0; Iteration < 2; ++Iteration)
+				least_squares_fit(Block, Best);
+
+		return Best;
+	}
+
+	inline void write_color_block(color_block_fit const& Fit, glm::uint16& Color0, glm::uint16& Color1, glm::uint8* Row)
+	{
+		Color0 = Fit.Color0;
+		Color1 = Fit.Color1;
+		for(int y = 0; y < 4; ++y)
+			Row[y] = static_cast<glm::uint8>(Fit.Index[y * 4 + 0] | (Fit.Index[y * 4 + 1] << 2) | (Fit.Index[y * 4 + 2] << 4) | (Fit.Index[y * 4 + 3] << 6));
+	}
+
+	struct channel_block_fit
+	{
+		glm::uint8 Endpoint0;
+		glm::uint8 Endpoint1;
+		glm::uint8 Index[16];
+		float Error;
+	};
+
+	/// Select the closest entry of the BC3 alpha and BC4 palette for each value
+	inline void try_channel_endpoints(glm::uint8 const* Values, int Endpoint0, int Endpoint1, channel_block_fit& Best)
+	{
+		float Palette[8];
+		dxt5_alpha_palette(static_cast<glm::uint8>(Endpoint0), static_cast<glm::uint8>(Endpoint1), Palette);
+
+		channel_block_fit Fit;
+		Fit.Endpoint0 = static_cast<glm::uint8>(Endpoint0);
+		Fit.Endpoint1 = static_cast<glm::uint8>(Endpoint1);
+		Fit.Error = 0.0f;
+
+		for(int Texel = 0; Texel < 16 && Fit.Error < Best.Error; ++Texel)
+		{
+			float const Value = Values[Texel] / 255.0f;
+			float ClosestDistance = FLT_MAX;
+			for(int Entry = 0; Entry < 8; ++Entry)
+			{
+				float const Distance = (Palette[Entry] - Value) * (Palette[Entry] - Value);
+				if(Distance < ClosestDistance)
+				{
+					ClosestDistance = Distance;
+					Fit.Index[Texel] = static_cast<glm::uint8>(Entry);
+				}
+			}
+			Fit.Error += ClosestDistance;
+		}
+
+		if(Fit.Error < Best.Error)
+			Best = Fit;
+	}
+
+	/// Endpoint0 > Endpoint1 selects eight interpolated values, otherwise six interpolated values plus 0 and 1
+	inline channel_block_fit fit_channel_block(glm::uint8 const* Values, compress_quality Quality)
+	{
+		channel_block_fit Best;
+		Best.Error = FLT_MAX;
+
+		int Min = 255;
+		int Max = 0;
+		// Range of the values not encoded by the 0 and 1 entries of the six values palette
+		int InnerMin = 255;
+		int InnerMax = 0;
+		for(int Texel = 0; Texel < 16; ++Texel)
+		{
+			Min = glm::min(Min, static_cast<int>(Values[Texel]));
+			Max = glm::max(Max, static_cast<int>(Values[Texel]));
+			if(Values[Texel] != 0 && Values[Texel] != 255)
+			{
+				InnerMin = glm::min(InnerMin, static_cast<int>(Values[Texel]));
+				InnerMax = glm::max(InnerMax, static_cast<int>(Values[Texel]));
+			}
+		}
+
+		if(Min == Max)
+		{
+			try_channel_endpoints(Values, Min, Max, Best);
+			return Best;
+		}
+
+		try_channel_endpoints(Values, Max, Min, Best);
+
+		if(Quality >= COMPRESS_QUALITY_NORMAL)
+		{
+			if(InnerMin > InnerMax)
+				InnerMin = InnerMax = 0;
+			try_channel_endpoints(Values, InnerMin, InnerMax, Best);
+		}
+
+		// Search endpoints around the ranges, interpolated values closer to the block values may outweigh the error of the extremes
+		if(Quality >= COMPRESS_QUALITY_HIGH)
+		{
+			int const Radius = 4;
+			for(int Delta0 = -Radius; Delta0 <= Radius; ++Delta0)
+			for(int Delta1 = -Radius; Delta1 <= Radius; ++Delta1)
+			{
+				int const Endpoint0 = glm::clamp(Max + Delta0, 0, 255);
+				int const Endpoint1 = glm::clamp(Min + Delta1, 0, 255);
+				if(Endpoint0 > Endpoint1)
+					try_channel_endpoints(Values, Endpoint0, Endpoint1, Best);
+
+				int const InnerEndpoint0 = glm::clamp(InnerMin + Delta0, 0, 255);
+				int const InnerEndpoint1 = glm::clamp(InnerMax + Delta1, 0, 255);
+				if(InnerEndpoint0 <= InnerEndpoint1)
+					try_channel_endpoints(Values, InnerEndpoint0, InnerEndpoint1, Best);
+			}
+		}
+
+		return Best;
+	}
+
+	inline void write_channel_block(channel_block_fit const& Fit, glm::uint8& Endpoint0, glm::uint8& Endpoint1, glm::uint8* Bitmap)
+	{
+		Endpoint0 = Fit.Endpoint0;
+		Endpoint1 = Fit.Endpoint1;
+
+		glm::uint64 Bits = 0;
+		for(int Texel = 0; Texel < 16; ++Texel)
+			Bits |= static_cast<glm::uint64>(Fit.Index[Texel]) << (Texel * 3);
+		for(int Byte = 0; Byte < 6; ++Byte)
+			Bitmap[Byte] = static_cast<glm::uint8>(Bits >> (Byte * 8));
+	}
+
+	inline color_block make_color_block(glm::u8vec4 const* Texels, bool Bc1, bool Alpha)
+	{
+		color_block Block;
+		Block.Bc1 = Bc1;
+		Block.HasTransparent = false;
+		for(int Texel = 0; Texel < 16; ++Texel)
+		{
+			Block.Texel[Texel] = glm::vec3(Texels[Texel]) / 255.0f;
+			Block.Transparent[Texel] = Alpha && Texels[Texel].a < 128;
+			Block.HasTransparent = Block.HasTransparent || Block.Transparent[Texel];
+		}
+		return Block;
+	}
+
+	inline void compress_bc1(glm::u8vec4 const* Texels, bool Alpha, compress_quality Quality, void* Data)
+	{
+		bc1_block& Block = *static_cast<bc1_block*>(Data);
+		write_color_block(fit_color_block(make_color_block(Texels, true, Alpha), Quality), Block.Color0, Block.Color1, Block.Row);
+	}
+
+	inline void compress_bc3(glm::u8vec4 const* Texels, compress_quality Quality, void* Data)
+	{
+		bc3_block& Block = *static_cast<bc3_block*>(Data);
+		write_color_block(fit_color_block(make_color_block(Texels, false, false), Quality), Block.Color0, Block.Color1, Block.Row);
+
+		glm::uint8 Alpha[16];
+		for(int Texel = 0; Texel < 16; ++Texel)
+			Alpha[Texel] = Texels[Texel].a;
+		write_channel_block(fit_channel_block(Alpha, Quality), Block.Alpha[0], Block.Alpha[1], Block.AlphaBitmap);
+	}
+
+	inline void compress_bc4(glm::u8vec4 const* Texels, compress_quality Quality, void* Data)
+	{
+		bc4_block& Block = *static_cast<bc4_block*>(Data);
+
+		glm::uint8 Red[16];
+		for(int Texel = 0; Texel < 16; ++Texel)
+			Red[Texel] = Texels[Texel].r;
+		write_channel_block(fit_channel_block(Red, Quality), Block.Red0, Block.Red1, Block.Bitmap);
+	}
+
+	inline void compress_bc5(glm::u8vec4 const* Texels, compress_quality Quality, void* Data)
+	{
+		bc5_block& Block = *static_cast<bc5_block*>(Data);
+
+		glm::uint8 Red[16];
+		glm::uint8 Green[16];
+		for(int Texel = 0; Texel < 16; ++Texel)
+		{
+			Red[Texel] = Texels[Texel].r;
+			Green[Texel] = Texels[Texel].g;
+		}
+		write_channel_block(fit_channel_block(Red, Quality), Block.Red0, Block.Red1, Block.RedBitmap);
+		write_channel_block(fit_channel_block(Green, Quality), Block.Green0, Block.Green1, Block.GreenBitmap);
+	}
+
+	inline void compress_block(format Format, compress_quality Quality, glm::u8vec4 const* Texels, void* Block)
+	{
+		switch(Format)
+		{
+		case FORMAT_RGB_DXT1_UNORM_BLOCK8:
+		case FORMAT_RGB_DXT1_SRGB_BLOCK8:
+			compress_bc1(Texels, false, Quality, Block);
+			break;
+		case FORMAT_RGBA_DXT1_UNORM_BLOCK8:
+		case FORMAT_RGBA_DXT1_SRGB_BLOCK8:
+			compress_bc1(Texels, true, Quality, Block);
+			break;
+		case FORMAT_RGBA_DXT5_UNORM_BLOCK16:
+		case FORMAT_RGBA_DXT5_SRGB_BLOCK16:
+			compress_bc3(Texels, Quality, Block);
+			break;
+		case FORMAT_R_ATI1N_UNORM_BLOCK8:
+			compress_bc4(Texels, Quality, Block);
+			break;
+		default:
+			compress_bc5(Texels, Quality, Block);
+			break;
+		}
+	}
+
+	/// Texels of partial blocks beyond the image edges replicate the last row and column
+	inline void compress_block_rows(texture const& Source, texture& Destination, compress_quality Quality, block_rows const& Job)
+	{
+		texture::extent_type const Extent(Source.extent(Job.Level));
+		texture::extent_type const BlockExtent(block_extent(Destination.format()));
+		texture::extent_type const BlockCount(glm::ceilMultiple(Extent, BlockExtent) / BlockExtent);
+		std::size_t const BlockSize = block_size(Destination.format());
+
+		glm::u8vec4 const* const SourceSlice = Source.data<glm::u8vec4>(Job.Layer, Job.Face, Job.Level) + static_cast<std::size_t>(Job.Slice) * Extent.x * Extent.y;
+		char* const DestinationSlice = Destination.data<char>(Job.Layer, Job.Face, Job.Level) + static_cast<std::size_t>(Job.Slice) * BlockCount.x * BlockCount.y * BlockSize;
+
+		glm::u8vec4 Texels[16];
+		for(int BlockY = Job.BlockRowBegin; BlockY < Job.BlockRowEnd; ++BlockY)
+		{
+			char* DestinationBlock = DestinationSlice + static_cast<std::size_t>(BlockY) * BlockCount.x * BlockSize;
+
+			for(int BlockX = 0; BlockX < BlockCount.x; ++BlockX, DestinationBlock += BlockSize)
+			{
+				for(int y = 0; y < 4; ++y)
+				{
+					glm::u8vec4 const* const SourceRow = SourceSlice + static_cast<std::size_t>(glm::min(BlockY * 4 + y, Extent.y - 1)) * Extent.x;
+					for(int x = 0; x < 4; ++x)
+						Texels[y * 4 + x] = SourceRow[glm::min(BlockX * 4 + x, Extent.x - 1)];
+				}
+
+				compress_block(Destination.format(), Quality, Texels, DestinationBlock);
+			}
+		}
+	}
+
+	/// Convert a texture of any target, the conversion functions are specialized per texture type
+	inline texture convert_texture(texture const& Texture, format Format)
+	{
+		switch(Texture.target())
+		{
+		case TARGET_1D:
+			return gli::convert(texture1d(Texture), Format);
+		case TARGET_1D_ARRAY:
+			return gli::convert(texture1d_array(Texture), Format);
+		case TARGET_2D:
+		case TARGET_RECT:
+			return gli::convert(texture2d(Texture), Format);
+		case TARGET_2D_ARRAY:
+		case TARGET_RECT_ARRAY:
+			return gli::convert(texture2d_array(Texture), Format);
+		case TARGET_3D:
+			return gli::convert(texture3d(Texture), Format);
+		case TARGET_CUBE:
+			return gli::convert(texture_cube(Texture), Format);
+		default:
+			return gli::convert(texture_cube_array(Texture), Format);
+		}
+	}
+}//namespace detail
+
+	inline bool is_compressible(format Format)
+	{
+		switch(Format)
+		{
+		case FORMAT_RGB_DXT1_UNORM_BLOCK8:
+		case FORMAT_RGB_DXT1_SRGB_BLOCK8:
+		case FORMAT_RGBA_DXT1_UNORM_BLOCK8:
+		case FORMAT_RGBA_DXT1_SRGB_BLOCK8:
+		case FORMAT_RGBA_DXT5_UNORM_BLOCK16:
+		case FORMAT_RGBA_DXT5_SRGB_BLOCK16:
+		case FORMAT_R_ATI1N_UNORM_BLOCK8:
+		case FORMAT_RG_ATI2N_UNORM_BLOCK16:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	template <typename texture_type>
+	inline texture_type compress(texture_type const& Texture, format Format, compress_quality Quality)
+	{
+		GLI_ASSERT(!Texture.empty());
+		GLI_ASSERT(!is_compressed(Texture.format()) && is_compressible(Format));
+
+		if(is_compressed(Texture.format()) || !is_compressible(Format))
+			return texture_type();
+
+		format const SourceFormat = is_srgb(Format) ? FORMAT_RGBA8_SRGB_PACK8 : FORMAT_RGBA8_UNORM_PACK8;
+		texture const Source(Texture.format() == SourceFormat ? texture(Texture) : detail::convert_texture(Texture, SourceFormat));
+		texture Destination(Texture.target(), Format, Texture.texture::extent(), Texture.layers(), Texture.faces(), Texture.levels(), Texture.swizzles());
+
+		// Smaller jobs than decompression, a block search costs much more than a block decoding
+		std::vector<detail::block_rows> const Jobs(detail::split_block_rows(Destination, 256));
+
+		detail::parallel_for(Jobs.size(), [&](std::size_t Index)
+		{
+			detail::compress_block_rows(Source, Destination, Quality, Jobs[Index]);
+		});
+
+		return texture_type(Destination);
+	}
+}//namespace gli
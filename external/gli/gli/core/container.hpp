@@ -0,0 +1,33 @@
+/// @brief Description of a texture stored in a DDS or KTX container
+/// @file gli/core/container.hpp
+
+#pragma once
+
+#include "../texture.hpp"
+
+namespace gli{
+namespace detail
+{
+	/// Texture parameters parsed from a container header and offset of the first texel byte from the beginning of the container.
+	struct container_desc
+	{
+		container_desc()
+			: Target(TARGET_2D)
+			, Format(FORMAT_UNDEFINED)
+			, Extent(1)
+			, Layers(1)
+			, Faces(1)
+			, Levels(1)
+			, Offset(0)
+		{}
+
+		target Target;
+		format Format;
+		texture::extent_type Extent;
+		texture::size_type Layers;
+		texture::size_type Faces;
+		texture::size_type Levels;
+		std::size_t Offset;
+	};
+}//namespace detail
+}//namespace gli
@@ -1,4 +1,5 @@
 #include "../core/convert_func.hpp"
+#include "./convert_kernel.hpp"
 
 namespace gli
 {
@@ -15,16 +16,24 @@ namespace gli
 		GLI_ASSERT(!Texture.empty());
 		GLI_ASSERT(!is_compressed(Texture.format()) && !is_compressed(Format));
 
+		// Every texel is written below
+		texture Storage(Texture.target(), Format, Texture.texture::extent(), Texture.layers(), Texture.faces(), Texture.levels(), uninitialized_allocator(), Texture.swizzles());
+		texture_type Copy(Storage);
+
+		if(detail::convert_kernel(Texture, Copy))
+			return Copy;
+
 		fetch_type Fetch = detail::convert<texture_type, T, defaultp>::call(Texture.format()).Fetch;
 		write_type Write = detail::convert<texture_type, T, defaultp>::call(Format).Write;
 
-		texture Storage(Texture.target(), Format, Texture.texture::extent(), Texture.layers(), Texture.faces(), Texture.levels(), Texture.swizzles());
-		texture_type Copy(Storage);
-
-		for(size_type Layer = 0; Layer < Texture.layers(); ++Layer)
-		for(size_type Face = 0; Face < Texture.faces(); ++Face)
-		for(size_type Level = 0; Level < Texture.levels(); ++Level)
+		// Each image is converted by a single thread
+		size_type const Images = Texture.layers() * Texture.faces() * Texture.levels();
+		detail::parallel_for(Images, [&](std::size_t Image)
 		{
+			size_type const Level = Image % Texture.levels();
+			size_type const Face = (Image / Texture.levels()) % Texture.faces();
+			size_type const Layer = Image / (Texture.levels() * Texture.faces());
+
 			extent_type const& Dimensions = Texture.texture::extent(Level);
 
 			for(component_type k = 0; k < Dimensions.z; ++k)
@@ -36,10 +45,9 @@ namespace gli
 					Copy, Texelcoord, Layer, Face, Level,
 					Fetch(Texture, Texelcoord, Layer, Face, Level));
 			}
-		}
+		});
 
 		return texture_type(Copy);
 	}
 
 }//namespace gli
-
@@ -53,6 +53,13 @@ namespace detail
 		CONVERT_MODE_BC5SNORM
 	};
 
+	/// Whether the texel data of a texture type is laid out in memory like storage_linear, as decoding block compressed formats requires
+	template <typename textureType>
+	struct is_linear_storage
+	{
+		static bool const value = true;
+	};
+
 	template <typename textureType, typename genType>
 	struct accessFunc
 	{};
@@ -817,14 +824,17 @@ namespace detail
 		template <length_t L, typename T, convertMode mode>
 		struct conv
 		{
+			// Block compressed formats are only decoded from texture types with linear storage
+			static convertMode const Mode = mode < CONVERT_MODE_DXT1UNORM || is_linear_storage<textureType>::value ? mode : CONVERT_MODE_DEFAULT;
+
 			static vec<4, samplerValType, P> fetch(textureType const& Texture, typename textureType::extent_type const& TexelCoord, typename textureType::size_type Layer, typename textureType::size_type Face, typename textureType::size_type Level)
 			{
-				return convertFunc<textureType, samplerValType, L, T, P, mode, std::numeric_limits<samplerValType>::is_iec559>::fetch(Texture, TexelCoord, Layer, Face, Level);
+				return convertFunc<textureType, samplerValType, L, T, P, Mode, std::numeric_limits<samplerValType>::is_iec559>::fetch(Texture, TexelCoord, Layer, Face, Level);
 			}
 
 			static void write(textureType& Texture, typename textureType::extent_type const& TexelCoord, typename textureType::size_type Layer, typename textureType::size_type Face, typename textureType::size_type Level, vec<4, samplerValType, P> const & Texel)
 			{
-				convertFunc<textureType, samplerValType, L, T, P, mode, std::numeric_limits<samplerValType>::is_iec559>::write(Texture, TexelCoord, Layer, Face, Level, Texel);
+				convertFunc<textureType, samplerValType, L, T, P, Mode, std::numeric_limits<samplerValType>::is_iec559>::write(Texture, TexelCoord, Layer, Face, Level, Texel);
 			}
 		};
 
@@ -0,0 +1,471 @@
+/// @brief Include to convert the rows of the common pairs of uncompressed formats with specialized kernels
+/// @file gli/core/convert_kernel.hpp
+
+#pragma once
+
+#include "../texture2d.hpp"
+#include "./convert_func.hpp"
+#include "./parallel.hpp"
+#include "./simd.hpp"
+#include <glm/gtc/packing.hpp>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+namespace gli{
+namespace detail
+{
+	struct convert_row_kernel;
+
+	/// Convert Texels contiguous texels from Source to Destination
+	typedef void (*convert_row_func)(convert_row_kernel const& Kernel, glm::uint8 const* Source, glm::uint8* Destination, std::size_t Texels);
+
+	struct convert_row_kernel
+	{
+		convert_row_func Row;
+
+		// Widest instruction set the row may use
+		cpu_arch Arch;
+
+		// Components of the float and half formats
+		int Components;
+
+		// Source component of each destination component of the 8 bits formats
+		int Map[4];
+
+		// Destination byte of each destination component for every byte of its source component.
+		// Components missing in the source are constant: every entry of their table is the same.
+		glm::uint8 Bytes[4][256];
+	};
+
+	// 8 bits per component formats
+
+	inline bool is_byte_format(format Format)
+	{
+		switch(Format)
+		{
+		case FORMAT_R8_UNORM_PACK8:
+		case FORMAT_R8_SRGB_PACK8:
+		case FORMAT_RG8_UNORM_PACK8:
+		case FORMAT_RG8_SRGB_PACK8:
+		case FORMAT_RGB8_UNORM_PACK8:
+		case FORMAT_RGB8_SRGB_PACK8:
+		case FORMAT_BGR8_UNORM_PACK8:
+		case FORMAT_BGR8_SRGB_PACK8:
+		case FORMAT_RGBA8_UNORM_PACK8:
+		case FORMAT_RGBA8_SRGB_PACK8:
+		case FORMAT_BGRA8_UNORM_PACK8:
+		case FORMAT_BGRA8_SRGB_PACK8:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	/// The generic conversion of every source byte: sRGB decoding and encoding become table lookups that match the generic path exactly
+	inline void make_byte_tables(format SourceFormat, format DestinationFormat, glm::uint8 Tables[4][256])
+	{
+		typedef convert<texture2d, float, defaultp> conversion;
+
+		texture2d Source(SourceFormat, texture2d::extent_type(256, 1), 1);
+		texture2d Destination(DestinationFormat, texture2d::extent_type(256, 1), 1);
+
+		std::size_t const SourceComponents = component_count(SourceFormat);
+		for(std::size_t Value = 0; Value < 256; ++Value)
+			std::memset(Source.data<glm::uint8>() + Value * SourceComponents, static_cast<int>(Value), SourceComponents);
+
+		conversion::fetchFunc const Fetch = conversion::call(SourceFormat).Fetch;
+		conversion::writeFunc const Write = conversion::call(DestinationFormat).Write;
+		for(int Value = 0; Value < 256; ++Value)
+		{
+			texture2d::extent_type const TexelCoord(Value, 0);
+			Write(Destination, TexelCoord, 0, 0, 0, Fetch(Source, TexelCoord, 0, 0, 0));
+		}
+
+		std::size_t const DestinationComponents = component_count(DestinationFormat);
+		for(std::size_t Component = 0; Component < DestinationComponents; ++Component)
+		for(std::size_t Value = 0; Value < 256; ++Value)
+			Tables[Component][Value] = Destination.data<glm::uint8>()[Value * DestinationComponents + Component];
+	}
+
+	inline bool is_identity(glm::uint8 const Table[256])
+	{
+		for(int Value = 0; Value < 256; ++Value)
+			if(Table[Value] != Value)
+				return false;
+		return true;
+	}
+
+	inline void convert_copy_row(convert_row_kernel const& Kernel, glm::uint8 const* Source, glm::uint8* Destination, std::size_t Texels)
+	{
+		std::memcpy(Destination, Source, Texels * static_cast<std::size_t>(Kernel.Components));
+	}
+
+	template <int SourceComponents, int DestinationComponents>
+	inline void convert_bytes_row(convert_row_kernel const& Kernel, glm::uint8 const* Source, glm::uint8* Destination, std::size_t Texels)
+	{
+		for(std::size_t Texel = 0; Texel < Texels; ++Texel, Source += SourceComponents, Destination += DestinationComponents)
+		for(int Component = 0; Component < DestinationComponents; ++Component)
+			Destination[Component] = Kernel.Bytes[Component][Source[Kernel.Map[Component]]];
+	}
+
+	// The SSSE3 shuffles are compiled whatever the compiler options and only run on the CPUs that support them.
+	// They return the number of texels converted, the scalar rows convert the remaining ones.
+#	if GLI_CPU_X86
+		GLI_TARGET_SSSE3 inline std::size_t convert_expand_row_ssse3(convert_row_kernel const& Kernel, glm::uint8 const* Source, glm::uint8* Destination, std::size_t Texels)
+		{
+			glm::int8 Mask[16];
+			for(int Index = 0; Index < 4; ++Index)
+			{
+				for(int Component = 0; Component < 3; ++Component)
+					Mask[Index * 4 + Component] = static_cast<glm::int8>(Index * 3 + Kernel.Map[Component]);
+				Mask[Index * 4 + 3] = -1;
+			}
+
+			__m128i const Shuffle = _mm_loadu_si128(reinterpret_cast<__m128i const*>(Mask));
+			__m128i const Alpha = _mm_set1_epi32(static_cast<int>(static_cast<glm::uint32>(Kernel.Bytes[3][0]) << 24));
+
+			// The 16 bytes load reads 4 bytes past the 4 texels: stop 2 texels before the end of the row
+			std::size_t Texel = 0;
+			for(; Texel + 6 <= Texels; Texel += 4)
+			{
+				__m128i const RGB = _mm_loadu_si128(reinterpret_cast<__m128i const*>(Source + Texel * 3));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(Destination + Texel * 4), _mm_or_si128(_mm_shuffle_epi8(RGB, Shuffle), Alpha));
+			}
+			return Texel;
+		}
+
+		GLI_TARGET_SSSE3 inline std::size_t convert_shrink_row_ssse3(convert_row_kernel const& Kernel, glm::uint8 const* Source, glm::uint8* Destination, std::size_t Texels)
+		{
+			glm::int8 Mask[16];
+			for(int Index = 0; Index < 4; ++Index)
+			for(int Component = 0; Component < 3; ++Component)
+				Mask[Index * 3 + Component] = static_cast<glm::int8>(Index * 4 + Kernel.Map[Component]);
+			for(int Index = 12; Index < 16; ++Index)
+				Mask[Index] = -1;
+
+			__m128i const Shuffle = _mm_loadu_si128(reinterpret_cast<__m128i const*>(Mask));
+
+			std::size_t Texel = 0;
+			for(; Texel + 4 <= Texels; Texel += 4)
+			{
+				__m128i const RGB = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<__m128i const*>(Source + Texel * 4)), Shuffle);
+				_mm_storel_epi64(reinterpret_cast<__m128i*>(Destination + Texel * 3), RGB);
+				glm::uint32 const Last = static_cast<glm::uint32>(_mm_cvtsi128_si32(_mm_srli_si128(RGB, 8)));
+				std::memcpy(Destination + Texel * 3 + 8, &Last, sizeof(Last));
+			}
+			return Texel;
+		}
+#	endif//GLI_CPU_X86
+
+	/// RGB to RGBA with unchanged RGB values, 4 texels per shuffle with SSSE3
+	inline void convert_expand_row(convert_row_kernel const& Kernel, glm::uint8 const* Source, glm::uint8* Destination, std::size_t Texels)
+	{
+		std::size_t Texel = 0;
+
+#		if GLI_CPU_X86
+			if(Kernel.Arch >= CPU_ARCH_SSSE3)
+				Texel = convert_expand_row_ssse3(Kernel, Source, Destination, Texels);
+#		endif//GLI_CPU_X86
+
+		convert_bytes_row<3, 4>(Kernel, Source + Texel * 3, Destination + Texel * 4, Texels - Texel);
+	}
+
+	/// RGBA to RGB with unchanged RGB values, 4 texels per shuffle with SSSE3
+	inline void convert_shrink_row(convert_row_kernel const& Kernel, glm::uint8 const* Source, glm::uint8* Destination, std::size_t Texels)
+	{
+		std::size_t Texel = 0;
+
+#		if GLI_CPU_X86
+			if(Kernel.Arch >= CPU_ARCH_SSSE3)
+				Texel = convert_shrink_row_ssse3(Kernel, Source, Destination, Texels);
+#		endif//GLI_CPU_X86
+
+		convert_bytes_row<4, 3>(Kernel, Source + Texel * 4, Destination + Texel * 3, Texels - Texel);
+	}
+
+	template <int SourceComponents>
+	inline convert_row_func make_bytes_row(int DestinationComponents)
+	{
+		switch(DestinationComponents)
+		{
+		case 1:
+			return convert_bytes_row<SourceComponents, 1>;
+		case 2:
+			return convert_bytes_row<SourceComponents, 2>;
+		case 3:
+			return convert_bytes_row<SourceComponents, 3>;
+		default:
+			return convert_bytes_row<SourceComponents, 4>;
+		}
+	}
+
+	inline void make_bytes_kernel(format SourceFormat, format DestinationFormat, convert_row_kernel& Kernel)
+	{
+		int const SourceComponents = static_cast<int>(component_count(SourceFormat));
+		int const DestinationComponents = static_cast<int>(component_count(DestinationFormat));
+
+		make_byte_tables(SourceFormat, DestinationFormat, Kernel.Bytes);
+		Kernel.Components = DestinationComponents;
+
+		// Components are converted in memory order, like the generic path: BGRA8 to RGBA8 keeps the bytes where they are.
+		// Constant components read the first source component, their table ignores it
+		bool Identity = true;
+		for(int Component = 0; Component < DestinationComponents; ++Component)
+		{
+			Kernel.Map[Component] = Component < SourceComponents ? Component : 0;
+
+			if(Component < SourceComponents)
+				Identity = Identity && is_identity(Kernel.Bytes[Component]);
+		}
+
+		if(Identity && SourceComponents == DestinationComponents)
+			Kernel.Row = convert_copy_row;
+		else if(Identity && SourceComponents == 3 && DestinationComponents == 4)
+			Kernel.Row = convert_expand_row;
+		else if(Identity && SourceComponents == 4 && DestinationComponents == 3)
+			Kernel.Row = convert_shrink_row;
+		else switch(SourceComponents)
+		{
+		case 1:
+			Kernel.Row = make_bytes_row<1>(DestinationComponents);
+			break;
+		case 2:
+			Kernel.Row = make_bytes_row<2>(DestinationComponents);
+			break;
+		case 3:
+			Kernel.Row = make_bytes_row<3>(DestinationComponents);
+			break;
+		default:
+			Kernel.Row = make_bytes_row<4>(DestinationComponents);
+			break;
+		}
+	}
+
+	// Half and float formats of the same component count
+
+	inline float const* half_to_float_table()
+	{
+		struct table
+		{
+			table() : Values(65536)
+			{
+				for(std::size_t Value = 0; Value < Values.size(); ++Value)
+					Values[Value] = glm::unpackHalf1x16(static_cast<glm::uint16>(Value));
+			}
+
+			std::vector<float> Values;
+		};
+
+		static table const Table;
+		return &Table.Values[0];
+	}
+
+	inline void convert_half_to_float_row(convert_row_kernel const& Kernel, glm::uint8 const* Source, glm::uint8* Destination, std::size_t Texels)
+	{
+		std::size_t const Count = Texels * static_cast<std::size_t>(Kernel.Components);
+		glm::uint16 const* const Halfs = reinterpret_cast<glm::uint16 const*>(Source);
+		float* const Floats = reinterpret_cast<float*>(Destination);
+
+		std::size_t Index = 0;
+
+#		if GLI_CPU_X86
+			if(Kernel.Arch >= CPU_ARCH_F16C)
+			{
+				Index = Count / 4 * 4;
+				halfs_to_floats_f16c(Halfs, Floats, Index);
+			}
+#		endif//GLI_CPU_X86
+
+		float const* const Table = half_to_float_table();
+		for(; Index < Count; ++Index)
+			Floats[Index] = Table[Halfs[Index]];
+	}
+
+	/// With F16C, the hardware rounds to nearest even where the scalar path rounds halfway cases up
+	inline void convert_float_to_half_row(convert_row_kernel const& Kernel, glm::uint8 const* Source, glm::uint8* Destination, std::size_t Texels)
+	{
+		std::size_t const Count = Texels * static_cast<std::size_t>(Kernel.Components);
+		float const* const Floats = reinterpret_cast<float const*>(Source);
+		glm::uint16* const Halfs = reinterpret_cast<glm::uint16*>(Destination);
+
+		std::size_t Index = 0;
+
+#		if GLI_CPU_X86
+			if(Kernel.Arch >= CPU_ARCH_F16C)
+			{
+				Index = Count / 4 * 4;
+				floats_to_halfs_f16c(Floats, Halfs, Index);
+			}
+#		endif//GLI_CPU_X86
+
+		for(; Index < Count; ++Index)
+			Halfs[Index] = glm::packHalf1x16(Floats[Index]);
+	}
+
+	// Shared exponent and packed float formats unpacked to RGB32F or RGBA32F
+
+	/// Unsigned float of 5 bits exponent and MantissaBits bits mantissa, without sign, denormals included
+	inline float unpack_ufloat(glm::uint32 Value, int MantissaBits)
+	{
+		glm::uint32 const Exponent = Value >> MantissaBits;
+		glm::uint32 const Mantissa = Value & ((1u << MantissaBits) - 1u);
+
+		if(Exponent == 0)
+			return std::ldexp(static_cast<float>(Mantissa), -14 - MantissaBits);
+		if(Exponent == 31)
+			return Mantissa == 0 ? std::numeric_limits<float>::infinity() : std::numeric_limits<float>::quiet_NaN();
+		return std::ldexp(static_cast<float>((1u << MantissaBits) + Mantissa), static_cast<int>(Exponent) - 15 - MantissaBits);
+	}
+
+	/// Values of the 11 bits floats followed by the values of the 10 bits floats
+	inline float const* ufloat_table()
+	{
+		struct table
+		{
+			table() : Values(2048 + 1024)
+			{
+				for(glm::uint32 Value = 0; Value < 2048; ++Value)
+					Values[Value] = unpack_ufloat(Value, 6);
+				for(glm::uint32 Value = 0; Value < 1024; ++Value)
+					Values[2048 + Value] = unpack_ufloat(Value, 5);
+			}
+
+			std::vector<float> Values;
+		};
+
+		static table const Table;
+		return &Table.Values[0];
+	}
+
+	template <int DestinationComponents>
+	inline void convert_rg11b10f_row(convert_row_kernel const&, glm::uint8 const* Source, glm::uint8* Destination, std::size_t Texels)
+	{
+		glm::uint32 const* const Packed = reinterpret_cast<glm::uint32 const*>(Source);
+		float* Floats = reinterpret_cast<float*>(Destination);
+		float const* const Table = ufloat_table();
+
+		for(std::size_t Texel = 0; Texel < Texels; ++Texel, Floats += DestinationComponents)
+		{
+			glm::uint32 const Value = Packed[Texel];
+			Floats[0] = Table[Value & 0x7ff];
+			Floats[1] = Table[(Value >> 11) & 0x7ff];
+			Floats[2] = Table[2048 + (Value >> 22)];
+			if(DestinationComponents == 4)
+				Floats[3] = 1.0f;
+		}
+	}
+
+	template <int DestinationComponents>
+	inline void convert_rgb9e5_row(convert_row_kernel const&, glm::uint8 const* Source, glm::uint8* Destination, std::size_t Texels)
+	{
+		glm::uint32 const* const Packed = reinterpret_cast<glm::uint32 const*>(Source);
+		float* Floats = reinterpret_cast<float*>(Destination);
+
+		// 2^(Exponent - 15 - 9) for every shared exponent
+		float Scales[32];
+		for(int Exponent = 0; Exponent < 32; ++Exponent)
+			Scales[Exponent] = std::ldexp(1.0f, Exponent - 15 - 9);
+
+		for(std::size_t Texel = 0; Texel < Texels; ++Texel, Floats += DestinationComponents)
+		{
+			glm::uint32 const Value = Packed[Texel];
+			float const Scale = Scales[Value >> 27];
+			Floats[0] = static_cast<float>(Value & 0x1ff) * Scale;
+			Floats[1] = static_cast<float>((Value >> 9) & 0x1ff) * Scale;
+			Floats[2] = static_cast<float>((Value >> 18) & 0x1ff) * Scale;
+			if(DestinationComponents == 4)
+				Floats[3] = 1.0f;
+		}
+	}
+
+	inline bool is_half_format(format Format)
+	{
+		return Format == FORMAT_R16_SFLOAT_PACK16 || Format == FORMAT_RG16_SFLOAT_PACK16 || Format == FORMAT_RGB16_SFLOAT_PACK16 || Format == FORMAT_RGBA16_SFLOAT_PACK16;
+	}
+
+	inline bool is_float_format(format Format)
+	{
+		return Format == FORMAT_R32_SFLOAT_PACK32 || Format == FORMAT_RG32_SFLOAT_PACK32 || Format == FORMAT_RGB32_SFLOAT_PACK32 || Format == FORMAT_RGBA32_SFLOAT_PACK32;
+	}
+
+	/// Select the row kernel of a pair of formats.
+	/// The instruction set is Arch, or the widest supported one below Arch.
+	/// Returns false for the pairs without kernel, those use the generic per texel conversion.
+	inline bool make_convert_row_kernel(format SourceFormat, format DestinationFormat, convert_row_kernel& Kernel, cpu_arch Arch = widest_cpu_arch())
+	{
+		Kernel.Arch = supported_cpu_arch(Arch);
+
+		if(is_byte_format(SourceFormat) && is_byte_format(DestinationFormat))
+		{
+			make_bytes_kernel(SourceFormat, DestinationFormat, Kernel);
+			return true;
+		}
+
+		bool const SameComponents = component_count(SourceFormat) == component_count(DestinationFormat);
+		Kernel.Components = static_cast<int>(component_count(SourceFormat));
+
+		if(is_half_format(SourceFormat) && is_float_format(DestinationFormat) && SameComponents)
+		{
+			Kernel.Row = convert_half_to_float_row;
+			return true;
+		}
+
+		if(is_float_format(SourceFormat) && is_half_format(DestinationFormat) && SameComponents)
+		{
+			Kernel.Row = convert_float_to_half_row;
+			return true;
+		}
+
+		if(DestinationFormat != FORMAT_RGB32_SFLOAT_PACK32 && DestinationFormat != FORMAT_RGBA32_SFLOAT_PACK32)
+			return false;
+
+		bool const Alpha = DestinationFormat == FORMAT_RGBA32_SFLOAT_PACK32;
+		if(SourceFormat == FORMAT_RG11B10_UFLOAT_PACK32)
+		{
+			Kernel.Row = Alpha ? convert_rg11b10f_row<4> : convert_rg11b10f_row<3>;
+			return true;
+		}
+		if(SourceFormat == FORMAT_RGB9E5_UFLOAT_PACK32)
+		{
+			Kernel.Row = Alpha ? convert_rgb9e5_row<4> : convert_rgb9e5_row<3>;
+			return true;
+		}
+
+		return false;
+	}
+
+	/// Convert every image of Source into Destination, which has the same layout in another format, with a row kernel.
+	/// Rows are spread across threads. Returns false without writing anything if the pair of formats has no row kernel.
+	inline bool convert_kernel(texture const& Source, texture& Destination)
+	{
+		GLI_ASSERT(Source.layers() == Destination.layers() && Source.faces() == Destination.faces() && Source.levels() == Destination.levels());
+
+		convert_row_kernel Kernel;
+		if(!make_convert_row_kernel(Source.format(), Destination.format(), Kernel))
+			return false;
+
+		std::size_t const SourceTexelSize = block_size(Source.format());
+		std::size_t const DestinationTexelSize = block_size(Destination.format());
+		std::vector<block_rows> const Jobs(split_block_rows(Source, 65536));
+
+		parallel_for(Jobs.size(), [&](std::size_t Index)
+		{
+			block_rows const& Job = Jobs[Index];
+			texture::extent_type const Extent(Source.extent(Job.Level));
+
+			// The rows of a job are contiguous
+			std::size_t const Texel = static_cast<std::size_t>(Job.Slice * Extent.y + Job.BlockRowBegin) * Extent.x;
+			std::size_t const Texels = static_cast<std::size_t>(Job.BlockRowEnd - Job.BlockRowBegin) * Extent.x;
+
+			Kernel.Row(Kernel,
+				Source.data<glm::uint8>(Job.Layer, Job.Face, Job.Level) + Texel * SourceTexelSize,
+				Destination.data<glm::uint8>(Job.Layer, Job.Face, Job.Level) + Texel * DestinationTexelSize,
+				Texels);
+		});
+
+		return true;
+	}
+}//namespace detail
+}//namespace gli
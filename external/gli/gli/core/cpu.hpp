@@ -0,0 +1,85 @@
+/// @brief Include to find at runtime the instruction sets of the CPU that the kernels of gli can use
+/// @file gli/core/cpu.hpp
+
+#pragma once
+
+#include <glm/glm.hpp>
+
+// The SSSE3 and F16C kernels are compiled for their instruction set whatever the compiler options, and only run when the CPU supports it
+#if (GLM_ARCH & GLM_ARCH_X86_BIT) && !defined(GLM_FORCE_PURE) && (GLM_COMPILER & (GLM_COMPILER_GCC | GLM_COMPILER_CLANG | GLM_COMPILER_VC))
+#	define GLI_CPU_X86 1
+#	include <immintrin.h>
+#	if GLM_COMPILER & GLM_COMPILER_VC
+#		include <intrin.h>
+#		define GLI_TARGET_SSSE3
+#		define GLI_TARGET_F16C
+#	else
+#		include <cpuid.h>
+#		define GLI_TARGET_SSSE3 __attribute__((target("ssse3")))
+#		define GLI_TARGET_F16C __attribute__((target("ssse3,f16c")))
+#	endif
+#else
+#	define GLI_CPU_X86 0
+#endif
+
+namespace gli{
+namespace detail
+{
+	/// Instruction sets of the kernels, from the narrowest to the widest.
+	/// Each one includes the previous ones: every CPU with F16C has SSSE3.
+	enum cpu_arch
+	{
+		CPU_ARCH_SCALAR,
+		CPU_ARCH_SSSE3,
+		CPU_ARCH_F16C
+	};
+
+	inline cpu_arch detect_cpu_arch()
+	{
+#		if GLI_CPU_X86
+			int Info[4] = {0, 0, 0, 0};
+#			if GLM_COMPILER & GLM_COMPILER_VC
+				__cpuid(Info, 1);
+#			else
+				unsigned int Registers[4] = {0, 0, 0, 0};
+				__get_cpuid(1, &Registers[0], &Registers[1], &Registers[2], &Registers[3]);
+				Info[2] = static_cast<int>(Registers[2]);
+#			endif
+
+			bool const SSSE3 = (Info[2] & (1 << 9)) != 0;
+			// F16C instructions are VEX encoded: the OS must also save the AVX registers on context switches
+			bool const OSXSAVE = (Info[2] & (1 << 27)) != 0 && (Info[2] & (1 << 28)) != 0;
+			bool F16C = false;
+			if(OSXSAVE && (Info[2] & (1 << 29)) != 0)
+			{
+#				if GLM_COMPILER & GLM_COMPILER_VC
+					F16C = (_xgetbv(0) & 6) == 6;
+#				else
+					unsigned int XCR0 = 0, XCR0High = 0;
+					__asm__ __volatile__("xgetbv" : "=a"(XCR0), "=d"(XCR0High) : "c"(0));
+					F16C = (XCR0 & 6) == 6;
+#				endif
+			}
+
+			return SSSE3 && F16C ? CPU_ARCH_F16C : SSSE3 ? CPU_ARCH_SSSE3 : CPU_ARCH_SCALAR;
+#		else
+			return CPU_ARCH_SCALAR;
+#		endif
+	}
+
+	/// Widest instruction set supported by the CPU and the compiler, detected once.
+	/// Always CPU_ARCH_SCALAR with GLM_FORCE_PURE or outside x86.
+	inline cpu_arch widest_cpu_arch()
+	{
+		static cpu_arch const Arch = detect_cpu_arch();
+		return Arch;
+	}
+
+	/// Arch, or the widest supported instruction set below Arch
+	inline cpu_arch supported_cpu_arch(cpu_arch Arch)
+	{
+		cpu_arch const Supported = widest_cpu_arch();
+		return Arch < Supported ? Arch : Supported;
+	}
+}//namespace detail
+}//namespace gli
@@ -0,0 +1,701 @@
+#include "../type.hpp"
+#include "./bc.hpp"
+#include "./parallel.hpp"
+#include "./cpu.hpp"
+#include <glm/gtc/packing.hpp>
+#include <cstring>
+#include <vector>
+
+namespace gli{
+namespace detail
+{
+	// Packers of decoded texels to a destination format.
+	// Packing is done per component and unused components pack to zero so that partial palettes can be merged.
+
+	struct decompress_rgba8_unorm
+	{
+		typedef glm::uint32 texel_type;
+
+		static texel_type pack(glm::vec4 const& Texel)
+		{
+			return glm::packUnorm4x8(Texel);
+		}
+
+		static texel_type merge(texel_type A, texel_type B)
+		{
+			return A | B;
+		}
+	};
+
+	struct decompress_rgba8_snorm
+	{
+		typedef glm::uint32 texel_type;
+
+		static texel_type pack(glm::vec4 const& Texel)
+		{
+			return glm::packSnorm4x8(Texel);
+		}
+
+		static texel_type merge(texel_type A, texel_type B)
+		{
+			return A | B;
+		}
+	};
+
+	struct decompress_rgba16_sfloat
+	{
+		typedef glm::uint64 texel_type;
+
+		static texel_type pack(glm::vec4 const& Texel)
+		{
+			return glm::packHalf4x16(Texel);
+		}
+
+		static texel_type merge(texel_type A, texel_type B)
+		{
+			return A | B;
+		}
+	};
+
+	struct decompress_rgba32_sfloat
+	{
+		typedef glm::vec4 texel_type;
+
+		static texel_type pack(glm::vec4 const& Texel)
+		{
+			return Texel;
+		}
+
+		// Palette values are never negative zero so adding a positive zero is exact
+		static texel_type merge(texel_type const& A, texel_type const& B)
+		{
+			return A + B;
+		}
+	};
+
+	/// Expand the palette indices of a block to 16 texels, rows of 4 texels stored contiguously.
+	template <typename packer, typename texel_type = typename packer::texel_type>
+	struct bc_lookup
+	{
+		/// 2 bits color indices, one byte per row
+		static void color(texel_type const* Palette, uint8_t const* Rows, texel_type* Texels)
+		{
+			for(int Row = 0; Row < 4; ++Row)
+			for(int Col = 0; Col < 4; ++Col)
+				Texels[Row * 4 + Col] = Palette[(Rows[Row] >> (Col * 2)) & 0x3];
+		}
+
+		/// 2 bits color indices merged with an alpha palette of AlphaCount entries indexed per texel
+		static void color_alpha(texel_type const* Palette, uint8_t const* Rows, texel_type const* AlphaPalette, std::size_t AlphaCount, uint8_t const* AlphaIndex, texel_type* Texels)
+		{
+			for(int Row = 0; Row < 4; ++Row)
+			for(int Col = 0; Col < 4; ++Col)
+				Texels[Row * 4 + Col] = packer::merge(Palette[(Rows[Row] >> (Col * 2)) & 0x3], AlphaPalette[AlphaIndex[Row * 4 + Col]]);
+		}
+
+		/// One channel palette of 8 entries indexed per texel
+		static void channel(texel_type const* Palette, uint8_t const* Index, texel_type* Texels)
+		{
+			for(int Texel = 0; Texel < 16; ++Texel)
+				Texels[Texel] = Palette[Index[Texel]];
+		}
+
+		/// Two channel palettes of 8 entries indexed per texel
+		static void channel2(texel_type const* PaletteR, uint8_t const* IndexR, texel_type const* PaletteG, uint8_t const* IndexG, texel_type* Texels)
+		{
+			for(int Texel = 0; Texel < 16; ++Texel)
+				Texels[Texel] = packer::merge(PaletteR[IndexR[Texel]], PaletteG[IndexG[Texel]]);
+		}
+	};
+
+	/// Lookup of the blocks decoded on the CPUs without the SIMD lookup
+	template <typename packer, typename texel_type = typename packer::texel_type>
+	struct bc_lookup_simd
+	{
+		typedef bc_lookup<packer> type;
+	};
+
+	// The SSSE3 shuffles are compiled whatever the compiler options and only run on the CPUs that support them
+#	if GLI_CPU_X86
+		struct bc_lookup_ssse3_tables
+		{
+			GLI_TARGET_SSSE3 bc_lookup_ssse3_tables()
+			{
+				for(int Bits = 0; Bits < 256; ++Bits)
+				{
+					glm::uint8 Mask[16];
+					for(int Col = 0; Col < 4; ++Col)
+					for(int Byte = 0; Byte < 4; ++Byte)
+						Mask[Col * 4 + Byte] = static_cast<glm::uint8>(((Bits >> (Col * 2)) & 0x3) * 4 + Byte);
+					this->ColorRow[Bits] = _mm_loadu_si128(reinterpret_cast<__m128i const*>(Mask));
+				}
+
+				for(int Channel = 0; Channel < 4; ++Channel)
+				{
+					glm::uint8 Holes[16];
+					for(int Byte = 0; Byte < 16; ++Byte)
+						Holes[Byte] = (Byte & 3) == Channel ? 0x00 : 0x80;
+					this->Holes[Channel] = _mm_loadu_si128(reinterpret_cast<__m128i const*>(Holes));
+
+					for(int Row = 0; Row < 4; ++Row)
+					{
+						glm::uint8 Spread[16];
+						for(int Byte = 0; Byte < 16; ++Byte)
+							Spread[Byte] = (Byte & 3) == Channel ? static_cast<glm::uint8>(Row * 4 + Byte / 4) : 0x80;
+						this->Spread[Row][Channel] = _mm_loadu_si128(reinterpret_cast<__m128i const*>(Spread));
+					}
+				}
+
+				for(int Bits = 0; Bits < 16; ++Bits)
+				for(int Half = 0; Half < 2; ++Half)
+				{
+					glm::uint8 Mask[16];
+					for(int Col = 0; Col < 2; ++Col)
+					for(int Byte = 0; Byte < 8; ++Byte)
+					{
+						int const Index = (Bits >> (Col * 2)) & 0x3;
+						Mask[Col * 8 + Byte] = Index / 2 == Half ? static_cast<glm::uint8>((Index & 1) * 8 + Byte) : 0x80;
+					}
+					this->ColorPair[Bits][Half] = _mm_loadu_si128(reinterpret_cast<__m128i const*>(Mask));
+				}
+
+				for(int Component = 0; Component < 4; ++Component)
+				for(int Pair = 0; Pair < 4; ++Pair)
+				{
+					glm::uint8 Gather[16];
+					for(int Byte = 0; Byte < 16; ++Byte)
+						Gather[Byte] = (Byte & 7) / 2 == Pair ? static_cast<glm::uint8>((Byte & 1) * 8 + Component * 2 + Byte / 8) : 0x80;
+					this->GatherPair[Component][Pair] = _mm_loadu_si128(reinterpret_cast<__m128i const*>(Gather));
+				}
+			}
+
+			// Shuffle a palette of 4 texels according to the 2 bits indices of a row
+			__m128i ColorRow[256];
+			// Move the index of each texel of a row in front of the byte of a channel
+			__m128i Spread[4][4];
+			// Mark the bytes of the other channels so that a palette shuffle zeroes them
+			__m128i Holes[4];
+
+			// Shuffle the low or high half of a palette of 4 texels of 8 bytes according to the 2 bits indices of 2 texels
+			__m128i ColorPair[16][2];
+			// Move the low and high bytes of a component of a pair of texels of 8 bytes to the low and high byte planes of 8 texels
+			__m128i GatherPair[4][4];
+		};
+
+		inline bc_lookup_ssse3_tables const& get_bc_lookup_ssse3_tables()
+		{
+			static bc_lookup_ssse3_tables const Tables;
+			return Tables;
+		}
+
+		// Byte Channel of each texel of a row is Lut[Index[texel]], the other bytes are zero
+		GLI_TARGET_SSSE3 inline __m128i lookup_channel_row(bc_lookup_ssse3_tables const& Tables, __m128i Lut, __m128i Index, int Row, int Channel)
+		{
+			__m128i const Mask = _mm_or_si128(_mm_shuffle_epi8(Index, Tables.Spread[Row][Channel]), Tables.Holes[Channel]);
+			return _mm_shuffle_epi8(Lut, Mask);
+		}
+
+		/// Packed 8 bits per component texels: a whole row of 4 texels is produced by a single byte shuffle
+		template <typename packer>
+		struct bc_lookup_ssse3
+		{
+			typedef glm::uint32 texel_type;
+
+			GLI_TARGET_SSSE3 static __m128i channel_lut(texel_type const* Palette, std::size_t Count, int Channel)
+			{
+				glm::uint8 Lut[16] = {0};
+				for(std::size_t Index = 0; Index < Count; ++Index)
+					Lut[Index] = static_cast<glm::uint8>(Palette[Index] >> (Channel * 8));
+				return _mm_loadu_si128(reinterpret_cast<__m128i const*>(Lut));
+			}
+
+			GLI_TARGET_SSSE3 static void color(texel_type const* Palette, uint8_t const* Rows, texel_type* Texels)
+			{
+				bc_lookup_ssse3_tables const& Tables = get_bc_lookup_ssse3_tables();
+				__m128i const Colors = _mm_loadu_si128(reinterpret_cast<__m128i const*>(Palette));
+
+				for(int Row = 0; Row < 4; ++Row)
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(Texels + Row * 4), _mm_shuffle_epi8(Colors, Tables.ColorRow[Rows[Row]]));
+			}
+
+			GLI_TARGET_SSSE3 static void color_alpha(texel_type const* Palette, uint8_t const* Rows, texel_type const* AlphaPalette, std::size_t AlphaCount, uint8_t const* AlphaIndex, texel_type* Texels)
+			{
+				bc_lookup_ssse3_tables const& Tables = get_bc_lookup_ssse3_tables();
+				__m128i const Colors = _mm_loadu_si128(reinterpret_cast<__m128i const*>(Palette));
+				__m128i const Alphas = channel_lut(AlphaPalette, AlphaCount, 3);
+				__m128i const Index = _mm_loadu_si128(reinterpret_cast<__m128i const*>(AlphaIndex));
+
+				for(int Row = 0; Row < 4; ++Row)
+				{
+					__m128i const Color = _mm_shuffle_epi8(Colors, Tables.ColorRow[Rows[Row]]);
+					__m128i const Alpha = lookup_channel_row(Tables, Alphas, Index, Row, 3);
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(Texels + Row * 4), _mm_or_si128(Color, Alpha));
+				}
+			}
+
+			GLI_TARGET_SSSE3 static void channel(texel_type const* Palette, uint8_t const* Index, texel_type* Texels)
+			{
+				bc_lookup_ssse3_tables const& Tables = get_bc_lookup_ssse3_tables();
+				__m128i const Reds = channel_lut(Palette, 8, 0);
+				__m128i const Indices = _mm_loadu_si128(reinterpret_cast<__m128i const*>(Index));
+				// Green, blue and alpha are the same for every palette entry
+				__m128i const Constant = _mm_set1_epi32(static_cast<int>(Palette[0] & 0xFFFFFF00));
+
+				for(int Row = 0; Row < 4; ++Row)
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(Texels + Row * 4), _mm_or_si128(lookup_channel_row(Tables, Reds, Indices, Row, 0), Constant));
+			}
+
+			GLI_TARGET_SSSE3 static void channel2(texel_type const* PaletteR, uint8_t const* IndexR, texel_type const* PaletteG, uint8_t const* IndexG, texel_type* Texels)
+			{
+				bc_lookup_ssse3_tables const& Tables = get_bc_lookup_ssse3_tables();
+				__m128i const Reds = channel_lut(PaletteR, 8, 0);
+				__m128i const Greens = channel_lut(PaletteG, 8, 1);
+				__m128i const IndicesR = _mm_loadu_si128(reinterpret_cast<__m128i const*>(IndexR));
+				__m128i const IndicesG = _mm_loadu_si128(reinterpret_cast<__m128i const*>(IndexG));
+				// Blue and alpha are the same for every palette entry
+				__m128i const Constant = _mm_set1_epi32(static_cast<int>(PaletteR[0] & 0xFFFF0000));
+
+				for(int Row = 0; Row < 4; ++Row)
+				{
+					__m128i const Red = lookup_channel_row(Tables, Reds, IndicesR, Row, 0);
+					__m128i const Green = lookup_channel_row(Tables, Greens, IndicesG, Row, 1);
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(Texels + Row * 4), _mm_or_si128(_mm_or_si128(Red, Green), Constant));
+				}
+			}
+		};
+
+		/// Packed 16 bits per component texels: a pair of texels is produced by a shuffle of each half of the color palette,
+		/// the components of the other palettes are looked up for the whole block one byte plane at a time
+		template <typename packer>
+		struct bc_lookup_ssse3_pair
+		{
+			typedef glm::uint64 texel_type;
+
+			// Low bytes of a component of 8 texels in the low 8 bytes, high bytes in the high 8 bytes
+			GLI_TARGET_SSSE3 static __m128i gather_planes(bc_lookup_ssse3_tables const& Tables, texel_type const* Palette, int Component)
+			{
+				__m128i Planes = _mm_setzero_si128();
+				for(int Pair = 0; Pair < 4; ++Pair)
+					Planes = _mm_or_si128(Planes, _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<__m128i const*>(Palette + Pair * 2)), Tables.GatherPair[Component][Pair]));
+				return Planes;
+			}
+
+			// Component Component of the 16 texels, 16 bits each: texels 0 to 7 in First, 8 to 15 in Second.
+			// Count is 8 or 16.
+			GLI_TARGET_SSSE3 static void lookup_component(bc_lookup_ssse3_tables const& Tables, texel_type const* Palette, std::size_t Count, int Component, __m128i Index, __m128i& First, __m128i& Second)
+			{
+				__m128i const Planes = gather_planes(Tables, Palette, Component);
+				__m128i const PlanesNext = Count > 8 ? gather_planes(Tables, Palette + 8, Component) : Planes;
+				__m128i const Low = _mm_shuffle_epi8(_mm_unpacklo_epi64(Planes, PlanesNext), Index);
+				__m128i const High = _mm_shuffle_epi8(_mm_unpackhi_epi64(Planes, PlanesNext), Index);
+				First = _mm_unpacklo_epi8(Low, High);
+				Second = _mm_unpackhi_epi8(Low, High);
+			}
+
+			GLI_TARGET_SSSE3 static __m128i lookup_color_pair(bc_lookup_ssse3_tables const& Tables, __m128i ColorsLow, __m128i ColorsHigh, int Bits)
+			{
+				return _mm_or_si128(_mm_shuffle_epi8(ColorsLow, Tables.ColorPair[Bits][0]), _mm_shuffle_epi8(ColorsHigh, Tables.ColorPair[Bits][1]));
+			}
+
+			// Interleave 8 red and green components with the blue and alpha components shared by the texels
+			GLI_TARGET_SSSE3 static void store_texels(__m128i Red, __m128i Green, __m128i BlueAlpha, texel_type* Texels)
+			{
+				__m128i const RedGreenLow = _mm_unpacklo_epi16(Red, Green);
+				__m128i const RedGreenHigh = _mm_unpackhi_epi16(Red, Green);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(Texels + 0), _mm_unpacklo_epi32(RedGreenLow, BlueAlpha));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(Texels + 2), _mm_unpackhi_epi32(RedGreenLow, BlueAlpha));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(Texels + 4), _mm_unpacklo_epi32(RedGreenHigh, BlueAlpha));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(Texels + 6), _mm_unpackhi_epi32(RedGreenHigh, BlueAlpha));
+			}
+
+			GLI_TARGET_SSSE3 static void color(texel_type const* Palette, uint8_t const* Rows, texel_type* Texels)
+			{
+				bc_lookup_ssse3_tables const& Tables = get_bc_lookup_ssse3_tables();
+				__m128i const ColorsLow = _mm_loadu_si128(reinterpret_cast<__m128i const*>(Palette));
+				__m128i const ColorsHigh = _mm_loadu_si128(reinterpret_cast<__m128i const*>(Palette + 2));
+
+				for(int Row = 0; Row < 4; ++Row)
+				{
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(Texels + Row * 4), lookup_color_pair(Tables, ColorsLow, ColorsHigh, Rows[Row] & 0xF));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(Texels + Row * 4 + 2), lookup_color_pair(Tables, ColorsLow, ColorsHigh, Rows[Row] >> 4));
+				}
+			}
+
+			GLI_TARGET_SSSE3 static void color_alpha(texel_type const* Palette, uint8_t const* Rows, texel_type const* AlphaPalette, std::size_t AlphaCount, uint8_t const* AlphaIndex, texel_type* Texels)
+			{
+				bc_lookup_ssse3_tables const& Tables = get_bc_lookup_ssse3_tables();
+				__m128i const ColorsLow = _mm_loadu_si128(reinterpret_cast<__m128i const*>(Palette));
+				__m128i const ColorsHigh = _mm_loadu_si128(reinterpret_cast<__m128i const*>(Palette + 2));
+				__m128i const Zero = _mm_setzero_si128();
+
+				__m128i Alphas[2];
+				lookup_component(Tables, AlphaPalette, AlphaCount, 3, _mm_loadu_si128(reinterpret_cast<__m128i const*>(AlphaIndex)), Alphas[0], Alphas[1]);
+
+				for(int Half = 0; Half < 2; ++Half)
+				{
+					// Alpha in the top 16 bits of each texel
+					__m128i const AlphaLow = _mm_unpacklo_epi16(Zero, Alphas[Half]);
+					__m128i const AlphaHigh = _mm_unpackhi_epi16(Zero, Alphas[Half]);
+					__m128i const Alpha[4] = {_mm_unpacklo_epi32(Zero, AlphaLow), _mm_unpackhi_epi32(Zero, AlphaLow), _mm_unpacklo_epi32(Zero, AlphaHigh), _mm_unpackhi_epi32(Zero, AlphaHigh)};
+
+					for(int Pair = 0; Pair < 4; ++Pair)
+					{
+						int const Row = Half * 2 + Pair / 2;
+						__m128i const Color = lookup_color_pair(Tables, ColorsLow, ColorsHigh, (Rows[Row] >> ((Pair & 1) * 4)) & 0xF);
+						_mm_storeu_si128(reinterpret_cast<__m128i*>(Texels + Row * 4 + (Pair & 1) * 2), _mm_or_si128(Color, Alpha[Pair]));
+					}
+				}
+			}
+
+			GLI_TARGET_SSSE3 static void channel(texel_type const* Palette, uint8_t const* Index, texel_type* Texels)
+			{
+				bc_lookup_ssse3_tables const& Tables = get_bc_lookup_ssse3_tables();
+				__m128i Reds[2];
+				lookup_component(Tables, Palette, 8, 0, _mm_loadu_si128(reinterpret_cast<__m128i const*>(Index)), Reds[0], Reds[1]);
+				// Green, blue and alpha are the same for every palette entry
+				__m128i const Green = _mm_set1_epi16(static_cast<short>(Palette[0] >> 16));
+				__m128i const BlueAlpha = _mm_set1_epi32(static_cast<int>(Palette[0] >> 32));
+
+				store_texels(Reds[0], Green, BlueAlpha, Texels);
+				store_texels(Reds[1], Green, BlueAlpha, Texels + 8);
+			}
+
+			GLI_TARGET_SSSE3 static void channel2(texel_type const* PaletteR, uint8_t const* IndexR, texel_type const* PaletteG, uint8_t const* IndexG, texel_type* Texels)
+			{
+				bc_lookup_ssse3_tables const& Tables = get_bc_lookup_ssse3_tables();
+				__m128i Reds[2];
+				__m128i Greens[2];
+				lookup_component(Tables, PaletteR, 8, 0, _mm_loadu_si128(reinterpret_cast<__m128i const*>(IndexR)), Reds[0], Reds[1]);
+				lookup_component(Tables, PaletteG, 8, 1, _mm_loadu_si128(reinterpret_cast<__m128i const*>(IndexG)), Greens[0], Greens[1]);
+				// Blue and alpha are the same for every palette entry
+				__m128i const BlueAlpha = _mm_set1_epi32(static_cast<int>(PaletteR[0] >> 32));
+
+				store_texels(Reds[0], Greens[0], BlueAlpha, Texels);
+				store_texels(Reds[1], Greens[1], BlueAlpha, Texels + 8);
+			}
+		};
+
+		template <typename packer>
+		struct bc_lookup_simd<packer, glm::uint32>
+		{
+			typedef bc_lookup_ssse3<packer> type;
+		};
+
+		template <typename packer>
+		struct bc_lookup_simd<packer, glm::uint64>
+		{
+			typedef bc_lookup_ssse3_pair<packer> type;
+		};
+#	endif//GLI_CPU_X86
+
+	inline void extract_indices_3bits(uint64_t Bitmap, uint8_t* Index)
+	{
+		for(int Texel = 0; Texel < 16; ++Texel)
+			Index[Texel] = static_cast<uint8_t>((Bitmap >> (Texel * 3)) & 0x7);
+	}
+
+	/// Decode BC blocks to packed texels.
+	/// Palettes are built with the same functions and expressions as the reference block decoders then packed once per block,
+	/// so every texel is bit-identical to packing the output of the reference decoders.
+	template <typename packer>
+	class bc_decoder
+	{
+	public:
+		typedef typename packer::texel_type texel_type;
+		typedef void (bc_decoder::*decode_func)(void const* Block, texel_type* Texels) const;
+
+		bc_decoder()
+		{
+			// Same expression as decompress_dxt3_block
+			for(int Value = 0; Value < 16; ++Value)
+				this->ExplicitAlpha[Value] = packer::pack(glm::vec4(0.0f, 0.0f, 0.0f, Value / 15.0f));
+		}
+
+		/// Decoder of the blocks of Format, nullptr if it isn't decompressible.
+		/// The instruction set is Arch, or the widest supported one below Arch: SSSE3 and above run the SIMD lookup.
+		static decode_func find(format Format, cpu_arch Arch = widest_cpu_arch())
+		{
+			if(supported_cpu_arch(Arch) >= CPU_ARCH_SSSE3)
+				return find<typename bc_lookup_simd<packer>::type>(Format);
+			return find<bc_lookup<packer> >(Format);
+		}
+
+		template <typename lookup>
+		static decode_func find(format Format)
+		{
+			switch(Format)
+			{
+			case FORMAT_RGB_DXT1_UNORM_BLOCK8:
+			case FORMAT_RGB_DXT1_SRGB_BLOCK8:
+			case FORMAT_RGBA_DXT1_UNORM_BLOCK8:
+			case FORMAT_RGBA_DXT1_SRGB_BLOCK8:
+				return &bc_decoder::decode_bc1<lookup>;
+			case FORMAT_RGBA_DXT3_UNORM_BLOCK16:
+			case FORMAT_RGBA_DXT3_SRGB_BLOCK16:
+				return &bc_decoder::decode_bc2<lookup>;
+			case FORMAT_RGBA_DXT5_UNORM_BLOCK16:
+			case FORMAT_RGBA_DXT5_SRGB_BLOCK16:
+				return &bc_decoder::decode_bc3<lookup>;
+			case FORMAT_R_ATI1N_UNORM_BLOCK8:
+				return &bc_decoder::decode_bc4unorm<lookup>;
+			case FORMAT_R_ATI1N_SNORM_BLOCK8:
+				return &bc_decoder::decode_bc4snorm<lookup>;
+			case FORMAT_RG_ATI2N_UNORM_BLOCK16:
+				return &bc_decoder::decode_bc5unorm<lookup>;
+			case FORMAT_RG_ATI2N_SNORM_BLOCK16:
+				return &bc_decoder::decode_bc5snorm<lookup>;
+			default:
+				return nullptr;
+			}
+		}
+
+		template <typename lookup>
+		void decode_bc1(void const* Data, texel_type* Texels) const
+		{
+			bc1_block const& Block = *static_cast<bc1_block const*>(Data);
+
+			glm::vec4 Color[4];
+			dxt1_palette(Block, Color);
+
+			texel_type Palette[4];
+			for(int Index = 0; Index < 4; ++Index)
+				Palette[Index] = packer::pack(Color[Index]);
+
+			lookup::color(Palette, Block.Row, Texels);
+		}
+
+		template <typename lookup>
+		void decode_bc2(void const* Data, texel_type* Texels) const
+		{
+			bc2_block const& Block = *static_cast<bc2_block const*>(Data);
+
+			glm::vec3 Color[4];
+			dxt_color_palette(Block.Color0, Block.Color1, Color);
+
+			texel_type Palette[4];
+			for(int Index = 0; Index < 4; ++Index)
+				Palette[Index] = packer::pack(glm::vec4(Color[Index], 0.0f));
+
+			uint8_t AlphaIndex[16];
+			for(int Row = 0; Row < 4; ++Row)
+			for(int Col = 0; Col < 4; ++Col)
+				AlphaIndex[Row * 4 + Col] = static_cast<uint8_t>((Block.AlphaRow[Row] >> (Col * 4)) & 0xF);
+
+			lookup::color_alpha(Palette, Block.Row, this->ExplicitAlpha, 16, AlphaIndex, Texels);
+		}
+
+		template <typename lookup>
+		void decode_bc3(void const* Data, texel_type* Texels) const
+		{
+			bc3_block const& Block = *static_cast<bc3_block const*>(Data);
+
+			glm::vec3 Color[4];
+			dxt_color_palette(Block.Color0, Block.Color1, Color);
+
+			float Alpha[8];
+			dxt5_alpha_palette(Block.Alpha[0], Block.Alpha[1], Alpha);
+
+			texel_type Palette[4];
+			for(int Index = 0; Index < 4; ++Index)
+				Palette[Index] = packer::pack(glm::vec4(Color[Index], 0.0f));
+
+			texel_type AlphaPalette[8];
+			for(int Index = 0; Index < 8; ++Index)
+				AlphaPalette[Index] = packer::pack(glm::vec4(0.0f, 0.0f, 0.0f, Alpha[Index]));
+
+			uint8_t AlphaIndex[16];
+			extract_indices_3bits(dxt5_alpha_bitmap(Block.AlphaBitmap), AlphaIndex);
+
+			lookup::color_alpha(Palette, Block.Row, AlphaPalette, 8, AlphaIndex, Texels);
+		}
+
+		template <typename lookup>
+		void decode_bc4unorm(void const* Data, texel_type* Texels) const
+		{
+			bc4_block const& Block = *static_cast<bc4_block const*>(Data);
+
+			float RedLUT[8];
+			uint64_t Bitmap;
+			single_channel_bitmap_data_unorm(Block.Red0, Block.Red1, Block.Bitmap, RedLUT, Bitmap);
+
+			this->template decode_bc4<lookup>(RedLUT, Bitmap, Texels);
+		}
+
+		template <typename lookup>
+		void decode_bc4snorm(void const* Data, texel_type* Texels) const
+		{
+			bc4_block const& Block = *static_cast<bc4_block const*>(Data);
+
+			float RedLUT[8];
+			uint64_t Bitmap;
+			single_channel_bitmap_data_snorm(Block.Red0, Block.Red1, Block.Bitmap, RedLUT, Bitmap);
+
+			this->template decode_bc4<lookup>(RedLUT, Bitmap, Texels);
+		}
+
+		template <typename lookup>
+		void decode_bc5unorm(void const* Data, texel_type* Texels) const
+		{
+			bc5_block const& Block = *static_cast<bc5_block const*>(Data);
+
+			float RedLUT[8];
+			uint64_t RedBitmap;
+			single_channel_bitmap_data_unorm(Block.Red0, Block.Red1, Block.RedBitmap, RedLUT, RedBitmap);
+
+			float GreenLUT[8];
+			uint64_t GreenBitmap;
+			single_channel_bitmap_data_unorm(Block.Green0, Block.Green1, Block.GreenBitmap, GreenLUT, GreenBitmap);
+
+			this->template decode_bc5<lookup>(RedLUT, RedBitmap, GreenLUT, GreenBitmap, Texels);
+		}
+
+		template <typename lookup>
+		void decode_bc5snorm(void const* Data, texel_type* Texels) const
+		{
+			bc5_block const& Block = *static_cast<bc5_block const*>(Data);
+
+			float RedLUT[8];
+			uint64_t RedBitmap;
+			single_channel_bitmap_data_snorm(Block.Red0, Block.Red1, Block.RedBitmap, RedLUT, RedBitmap);
+
+			// Same interpolation mode selection as decompress_bc5snorm_block
+			float GreenLUT[8];
+			uint64_t GreenBitmap;
+			single_channel_bitmap_data_snorm(Block.Green0, Block.Green1, Block.Red0 > Block.Red1, Block.GreenBitmap, GreenLUT, GreenBitmap);
+
+			this->template decode_bc5<lookup>(RedLUT, RedBitmap, GreenLUT, GreenBitmap, Texels);
+		}
+
+	private:
+		template <typename lookup>
+		void decode_bc4(float const* RedLUT, uint64_t Bitmap, texel_type* Texels) const
+		{
+			texel_type Palette[8];
+			for(int Index = 0; Index < 8; ++Index)
+				Palette[Index] = packer::pack(glm::vec4(RedLUT[Index], 0.0f, 0.0f, 1.0f));
+
+			uint8_t RedIndex[16];
+			extract_indices_3bits(Bitmap, RedIndex);
+
+			lookup::channel(Palette, RedIndex, Texels);
+		}
+
+		template <typename lookup>
+		void decode_bc5(float const* RedLUT, uint64_t RedBitmap, float const* GreenLUT, uint64_t GreenBitmap, texel_type* Texels) const
+		{
+			texel_type PaletteR[8];
+			texel_type PaletteG[8];
+			for(int Index = 0; Index < 8; ++Index)
+			{
+				PaletteR[Index] = packer::pack(glm::vec4(RedLUT[Index], 0.0f, 0.0f, 1.0f));
+				PaletteG[Index] = packer::pack(glm::vec4(0.0f, GreenLUT[Index], 0.0f, 0.0f));
+			}
+
+			uint8_t RedIndex[16];
+			extract_indices_3bits(RedBitmap, RedIndex);
+			uint8_t GreenIndex[16];
+			extract_indices_3bits(GreenBitmap, GreenIndex);
+
+			lookup::channel2(PaletteR, RedIndex, PaletteG, GreenIndex, Texels);
+		}
+
+		texel_type ExplicitAlpha[16];
+	};
+
+	template <typename packer>
+	inline void decompress_job_rows(texture const& Source, texture& Destination, bc_decoder<packer> const& Decoder, typename bc_decoder<packer>::decode_func Decode, block_rows const& Job)
+	{
+		typedef typename packer::texel_type texel_type;
+
+		texture::extent_type const Extent(Source.extent(Job.Level));
+		texture::extent_type const BlockExtent(block_extent(Source.format()));
+		texture::extent_type const BlockCount(glm::ceilMultiple(Extent, BlockExtent) / BlockExtent);
+		std::size_t const BlockSize = block_size(Source.format());
+
+		char const* const SourceSlice = static_cast<char const*>(Source.data(Job.Layer, Job.Face, Job.Level)) + static_cast<std::size_t>(Job.Slice) * BlockCount.x * BlockCount.y * BlockSize;
+		texel_type* const DestinationSlice = Destination.data<texel_type>(Job.Layer, Job.Face, Job.Level) + static_cast<std::size_t>(Job.Slice) * Extent.x * Extent.y;
+
+		texel_type Texels[16];
+		for(int BlockY = Job.BlockRowBegin; BlockY < Job.BlockRowEnd; ++BlockY)
+		{
+			int const Rows = glm::min(4, Extent.y - BlockY * 4);
+			char const* SourceBlock = SourceSlice + static_cast<std::size_t>(BlockY) * BlockCount.x * BlockSize;
+			texel_type* const DestinationRow = DestinationSlice + static_cast<std::size_t>(BlockY) * 4 * Extent.x;
+
+			for(int BlockX = 0; BlockX < BlockCount.x; ++BlockX, SourceBlock += BlockSize)
+			{
+				(Decoder.*Decode)(SourceBlock, Texels);
+
+				int const Cols = glm::min(4, Extent.x - BlockX * 4);
+				for(int Row = 0; Row < Rows; ++Row)
+					std::memcpy(DestinationRow + static_cast<std::size_t>(Row) * Extent.x + BlockX * 4, Texels + Row * 4, sizeof(texel_type) * Cols);
+			}
+		}
+	}
+
+	template <typename packer>
+	inline void decompress_texture(texture const& Source, texture& Destination)
+	{
+		bc_decoder<packer> const Decoder;
+		typename bc_decoder<packer>::decode_func const Decode = bc_decoder<packer>::find(Source.format());
+		GLI_ASSERT(Decode != nullptr);
+
+		std::vector<block_rows> const Jobs(split_block_rows(Source, 1024));
+
+		parallel_for(Jobs.size(), [&](std::size_t Index)
+		{
+			decompress_job_rows<packer>(Source, Destination, Decoder, Decode, Jobs[Index]);
+		});
+	}
+}//namespace detail
+
+	inline bool is_decompressible(format Source, format Destination)
+	{
+		if(detail::bc_decoder<detail::decompress_rgba8_unorm>::find(Source) == nullptr)
+			return false;
+
+		switch(Destination)
+		{
+		case FORMAT_RGBA8_UNORM_PACK8:
+		case FORMAT_RGBA8_SRGB_PACK8:
+		case FORMAT_RGBA8_SNORM_PACK8:
+		case FORMAT_RGBA16_SFLOAT_PACK16:
+		case FORMAT_RGBA32_SFLOAT_PACK32:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	template <typename texture_type>
+	inline texture_type decompress(texture_type const& Texture, format Format)
+	{
+		GLI_ASSERT(!Texture.empty());
+		GLI_ASSERT(is_decompressible(Texture.format(), Format));
+
+		if(!is_decompressible(Texture.format(), Format))
+			return texture_type();
+
+		texture const Source(Texture);
+		texture Destination(Texture.target(), Format, Texture.texture::extent(), Texture.layers(), Texture.faces(), Texture.levels(), Texture.swizzles());
+
+		switch(Format)
+		{
+		case FORMAT_RGBA8_UNORM_PACK8:
+		case FORMAT_RGBA8_SRGB_PACK8:
+			detail::decompress_texture<detail::decompress_rgba8_unorm>(Source, Destination);
+			break;
+		case FORMAT_RGBA8_SNORM_PACK8:
+			detail::decompress_texture<detail::decompress_rgba8_snorm>(Source, Destination);
+			break;
+		case FORMAT_RGBA16_SFLOAT_PACK16:
+			detail::decompress_texture<detail::decompress_rgba16_sfloat>(Source, Destination);
+			break;
+		default:
+			detail::decompress_texture<detail::decompress_rgba32_sfloat>(Source, Destination);
+			break;
+		}
+
+		return texture_type(Destination);
+	}
+}//namespace gli
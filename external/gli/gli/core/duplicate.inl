@@ -46,7 +46,8 @@ namespace detail
 			Texture.extent(),
 			Texture.layers(),
 			Texture.faces(),
-			Texture.levels());
+			Texture.levels(),
+			uninitialized_allocator());
 
 		detail::duplicate_images(
 			Texture, Duplicate,
@@ -66,7 +67,8 @@ namespace detail
 			Texture.texture::extent(),
 			Texture.layers(),
 			Texture.faces(),
-			Texture.levels());
+			Texture.levels(),
+			uninitialized_allocator());
 
 		detail::duplicate_images(
 			Texture, Duplicate,
@@ -88,7 +90,8 @@ namespace detail
 			Texture.extent(),
 			Texture.layers(),
 			Texture.faces(),
-			Texture.levels());
+			Texture.levels(),
+			uninitialized_allocator());
 
 		detail::duplicate_images(
 			Texture, Duplicate,
@@ -0,0 +1,196 @@
+#include "../convert.hpp"
+#include "../decompress.hpp"
+#include "../generate_mipmaps.hpp"
+#include "../render_cube.hpp"
+#include "../sampler_cube_batch.hpp"
+#include "./parallel.hpp"
+#include "./simd.hpp"
+#include <cmath>
+#include <vector>
+
+namespace gli{
+namespace detail
+{
+	/// Decoding of the texel Index of a panorama: the formats of sampler_cube_batch and the RGB float formats, of opaque alpha
+	template <format Format>
+	struct equirect_texel : public cube_texel<Format>
+	{};
+
+	template <>
+	struct equirect_texel<FORMAT_RGB32_SFLOAT_PACK32>
+	{
+		static simd_vec4 load(glm::uint8 const* Data, std::size_t Index)
+		{
+			float const* const Texel = reinterpret_cast<float const*>(Data) + Index * 3;
+			return simd_vec4(Texel[0], Texel[1], Texel[2], 1.0f);
+		}
+	};
+
+	template <>
+	struct equirect_texel<FORMAT_RGB16_SFLOAT_PACK16>
+	{
+		static simd_vec4 load(glm::uint8 const* Data, std::size_t Index)
+		{
+			glm::uint16 const* const Texel = reinterpret_cast<glm::uint16 const*>(Data) + Index * 3;
+			float const* const Table = half_to_float_table();
+			return simd_vec4(Table[Texel[0]], Table[Texel[1]], Table[Texel[2]], 1.0f);
+		}
+	};
+
+	/// Bilinear tap of a panorama at x, y in texels, with the texel centers at half integers. Wraps around horizontally, clamps vertically.
+	template <format Format>
+	inline simd_vec4 equirect_bilinear(glm::uint8 const* Data, int Width, int Height, float x, float y)
+	{
+		float const FloorX = std::floor(x - 0.5f);
+		float const FloorY = std::floor(y - 0.5f);
+		float const BlendX = x - 0.5f - FloorX;
+		float const BlendY = y - 0.5f - FloorY;
+
+		int x0 = static_cast<int>(FloorX) % Width;
+		x0 += x0 < 0 ? Width : 0;
+		int const x1 = x0 + 1 == Width ? 0 : x0 + 1;
+		int const y0 = glm::clamp(static_cast<int>(FloorY), 0, Height - 1);
+		int const y1 = glm::min(static_cast<int>(FloorY) + 1, Height - 1);
+		std::size_t const Row0 = static_cast<std::size_t>(glm::max(y0, 0)) * Width;
+		std::size_t const Row1 = static_cast<std::size_t>(glm::max(y1, 0)) * Width;
+
+		simd_vec4 const Top(lane_mix(equirect_texel<Format>::load(Data, Row0 + x0), equirect_texel<Format>::load(Data, Row0 + x1), BlendX));
+		simd_vec4 const Bottom(lane_mix(equirect_texel<Format>::load(Data, Row1 + x0), equirect_texel<Format>::load(Data, Row1 + x1), BlendX));
+		return lane_mix(Top, Bottom, BlendY);
+	}
+
+	struct equirect_func
+	{
+		texture2d const& Texture;
+		texture_cube& Result;
+		int Samples;
+
+		template <format Format>
+		void call()
+		{
+			glm::uint8 const* const Data = this->Texture.template data<glm::uint8>(0, 0, 0);
+			int const Width = this->Texture.extent().x;
+			int const Height = this->Texture.extent().y;
+			int const Size = this->Result.extent().x;
+			int const Samples = this->Samples;
+
+			// Segments of a row of a face
+			std::vector<glm::ivec2> const Faces(6, glm::ivec2(Size));
+			parallel_for_tiles(Faces, glm::ivec2(TEXEL_TILE_SIZE, 1), [&](texel_tile const& Tile)
+			{
+				int const Face = static_cast<int>(Tile.Image);
+				int const Count = Tile.Width;
+				float const TexelScale = 2.0f / static_cast<float>(Size);
+				float const SampleScale = TexelScale / static_cast<float>(Samples);
+				float const Weight = 1.0f / static_cast<float>(Samples * Samples);
+
+				// Panorama coordinates of the samples of one sub-texel position, four texels at once
+				float U[TEXEL_TILE_SIZE], V[TEXEL_TILE_SIZE];
+				simd_vec4 Sums[TEXEL_TILE_SIZE];
+				for(int x = 0; x < Count; ++x)
+					Sums[x] = simd_vec4(0.0f);
+
+				simd_vec4 const LongitudeScale(static_cast<float>(Width) / (2.0f * glm::pi<float>()));
+				simd_vec4 const LatitudeScale(static_cast<float>(Height) / glm::pi<float>());
+				simd_vec4 const HalfWidth(static_cast<float>(Width) * 0.5f);
+				simd_vec4 const HalfHeight(static_cast<float>(Height) * 0.5f);
+
+				for(int j = 0; j < Samples; ++j)
+				for(int i = 0; i < Samples; ++i)
+				{
+					simd_vec4 const Tc(static_cast<float>(Tile.y) * TexelScale + (static_cast<float>(j) + 0.5f) * SampleScale - 1.0f);
+					for(int x = 0; x < Count; x += 4)
+					{
+						float const Sc0 = static_cast<float>(Tile.x + x) * TexelScale + (static_cast<float>(i) + 0.5f) * SampleScale - 1.0f;
+						simd_vec4 const Sc(simd_vec4(Sc0) + simd_vec4(0.0f, 1.0f, 2.0f, 3.0f) * simd_vec4(TexelScale));
+
+						simd_vec4 X, Y, Z;
+						cube_face_directions(Face, Sc, Tc, X, Y, Z);
+
+						simd_vec4 const Longitude(lane_atan2(X, simd_vec4(0.0f) - Z));
+						simd_vec4 const Latitude(lane_atan2(Y, lane_sqrt(X * X + Z * Z)));
+
+						float LanesU[4], LanesV[4];
+						(HalfWidth + Longitude * LongitudeScale).store(LanesU);
+						(HalfHeight - Latitude * LatitudeScale).store(LanesV);
+						for(int Lane = 0; Lane < 4 && x + Lane < Count; ++Lane)
+						{
+							U[x + Lane] = LanesU[Lane];
+							V[x + Lane] = LanesV[Lane];
+						}
+					}
+
+					for(int x = 0; x < Count; ++x)
+						Sums[x] = Sums[x] + equirect_bilinear<Format>(Data, Width, Height, U[x], V[x]);
+				}
+
+				vec4 Texels[TEXEL_TILE_SIZE];
+				for(int x = 0; x < Count; ++x)
+					store(Sums[x] * simd_vec4(Weight), Texels[x]);
+
+				std::size_t const Offset = (static_cast<std::size_t>(Tile.y) * Size + Tile.x) * block_size(this->Result.format());
+				write_rgba_row(Texels, static_cast<std::size_t>(Count), this->Result.format(), this->Result.template data<glm::uint8>(0, Face, 0) + Offset);
+			});
+		}
+	};
+
+	/// Texture itself when equirect_func decodes its format, otherwise a copy converted or decompressed to a decoded format.
+	/// Returns an empty texture for the compressed formats that can't be decompressed.
+	inline texture2d make_equirect_texture(texture2d const& Texture)
+	{
+		switch(Texture.format())
+		{
+		case FORMAT_RGB32_SFLOAT_PACK32:
+		case FORMAT_RGB16_SFLOAT_PACK16:
+		case FORMAT_RGBA8_UNORM_PACK8:
+		case FORMAT_RGBA8_SRGB_PACK8:
+		case FORMAT_RGBA16_SFLOAT_PACK16:
+		case FORMAT_RGBA32_SFLOAT_PACK32:
+		case FORMAT_RG11B10_UFLOAT_PACK32:
+		case FORMAT_RGB9E5_UFLOAT_PACK32:
+			return Texture;
+		default:
+			break;
+		}
+
+		format const Sampled = is_srgb(Texture.format()) ? FORMAT_RGBA8_SRGB_PACK8 : FORMAT_RGBA8_UNORM_PACK8;
+		if(is_compressed(Texture.format()))
+			return is_decompressible(Texture.format(), Sampled) ? gli::decompress(Texture, Sampled) : texture2d();
+		return gli::convert(Texture, is_srgb(Texture.format()) ? Sampled : FORMAT_RGBA32_SFLOAT_PACK32);
+	}
+}//namespace detail
+
+	inline texture_cube equirect_to_cube(texture2d const& Texture, texture_cube::extent_type::value_type Size, format Format, int Samples, texture_cube::size_type Levels)
+	{
+		GLI_ASSERT(!Texture.empty());
+		GLI_ASSERT(Size > 0 && Samples > 0);
+		GLI_ASSERT(Levels > 0 && Levels <= static_cast<texture_cube::size_type>(levels(texture_cube::extent_type(Size))));
+
+		if(Format != FORMAT_RGBA8_UNORM_PACK8 && Format != FORMAT_RGBA8_SRGB_PACK8 && Format != FORMAT_RGBA16_SFLOAT_PACK16 && Format != FORMAT_RGBA32_SFLOAT_PACK32)
+			return texture_cube();
+
+		texture2d const Source(detail::make_equirect_texture(texture2d(Texture, Texture.base_level(), Texture.base_level())));
+		if(Source.empty())
+			return texture_cube();
+
+		// Every texel of the first level is written, the other ones by generate_mipmaps
+		texture_cube Result(texture(TARGET_CUBE, Format, texture::extent_type(Size, Size, 1), 1, 6, Levels, uninitialized_allocator()));
+		detail::equirect_func Func = {Source, Result, Samples};
+		switch(Source.format())
+		{
+		case FORMAT_RGB32_SFLOAT_PACK32:
+			Func.call<FORMAT_RGB32_SFLOAT_PACK32>();
+			break;
+		case FORMAT_RGB16_SFLOAT_PACK16:
+			Func.call<FORMAT_RGB16_SFLOAT_PACK16>();
+			break;
+		default:
+			detail::dispatch_cube_batch(Source.format(), Func);
+			break;
+		}
+
+		if(Levels > 1)
+			Result = generate_mipmaps(Result, FILTER_LINEAR);
+		return Result;
+	}
+}//namespace gli
@@ -4,11 +4,77 @@
 #pragma once
 
 #include <cstdio>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <glm/simd/platform.h>
 
 namespace gli{
 namespace detail
 {
 	FILE* open_file(const char *Filename, const char *mode);
+
+	/// Move the position of File to Offset bytes from its beginning. Offsets are 64 bits on every platform, long is 32 bits on Windows.
+	bool seek_file(FILE* File, std::uint64_t Offset);
+
+	/// Size in bytes of File, -1 in case of failure. The position of File moves back to its beginning.
+	std::int64_t file_size(FILE* File);
+
+	/// Whole file mapped in the process address space.
+	/// Pages are read from the file on first access and writes are private to the process: they never reach the file.
+	class mapped_file
+	{
+	public:
+		mapped_file();
+		~mapped_file();
+
+		/// Map the file identified by Filename. Returns false if the file can't be opened, is empty or can't be mapped.
+		bool open(char const* Filename);
+
+		/// Unmap the file
+		void close();
+
+		bool empty() const;
+		char* data() const;
+		std::size_t size() const;
+
+	private:
+		mapped_file(mapped_file const&) = delete;
+		mapped_file& operator=(mapped_file const&) = delete;
+
+		char* Data;
+		std::size_t Size;
+#		if GLM_PLATFORM & GLM_PLATFORM_WINDOWS
+			void* File;
+			void* Mapping;
+#		endif
+	};
+
+	/// Map the file identified by Filename. Returns nullptr in case of failure.
+	std::shared_ptr<mapped_file> map_file(char const* Filename);
+
+	/// Regular file of a directory with its size and last modification time, in nanoseconds since an unspecified epoch
+	struct file_status
+	{
+		std::string Name;
+		std::uint64_t Size;
+		std::int64_t Time;
+	};
+
+	/// Create the directory identified by Path. Returns true if the directory exists afterward.
+	bool make_directory(char const* Path);
+
+	/// Regular files of the directory identified by Path, not recursive
+	std::vector<file_status> list_files(char const* Path);
+
+	/// Set the modification time of the file identified by Path to the current time
+	bool touch_file(char const* Path);
+
+	/// Rename the file Source to Destination, replacing Destination if it exists.
+	/// The replacement is atomic on the same volume: other processes open either the previous or the new file.
+	bool replace_file(char const* Source, char const* Destination);
 }//namespace detail
 }//namespace gli
 
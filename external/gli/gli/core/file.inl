@@ -2,6 +2,25 @@
 
 #include <glm/simd/platform.h>
 
+#if GLM_PLATFORM & GLM_PLATFORM_WINDOWS
+#	ifndef NOMINMAX
+#		define NOMINMAX
+#	endif
+#	ifndef WIN32_LEAN_AND_MEAN
+#		define WIN32_LEAN_AND_MEAN
+#	endif
+#	include <windows.h>
+#else
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <sys/time.h>
+#	include <dirent.h>
+#	include <fcntl.h>
+#	include <unistd.h>
+#endif
+#include <cerrno>
+#include <limits>
+
 namespace gli{
 namespace detail
 {
@@ -13,6 +32,231 @@ namespace detail
 			return File;
 #		else
 			return std::fopen(Filename, Mode);
+#		endif
+	}
+
+	inline bool seek_file(FILE* File, std::uint64_t Offset)
+	{
+		if(Offset > static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max()))
+			return false;
+
+#		if GLM_PLATFORM & GLM_PLATFORM_WINDOWS
+			return _fseeki64(File, static_cast<__int64>(Offset), SEEK_SET) == 0;
+#		else
+			return fseeko(File, static_cast<off_t>(Offset), SEEK_SET) == 0;
+#		endif
+	}
+
+	inline std::int64_t file_size(FILE* File)
+	{
+#		if GLM_PLATFORM & GLM_PLATFORM_WINDOWS
+			if(_fseeki64(File, 0, SEEK_END) != 0)
+				return -1;
+			std::int64_t const Size = static_cast<std::int64_t>(_ftelli64(File));
+#		else
+			if(fseeko(File, 0, SEEK_END) != 0)
+				return -1;
+			std::int64_t const Size = static_cast<std::int64_t>(ftello(File));
+#		endif
+
+		return seek_file(File, 0) ? Size : -1;
+	}
+
+	inline mapped_file::mapped_file()
+		: Data(nullptr)
+		, Size(0)
+#		if GLM_PLATFORM & GLM_PLATFORM_WINDOWS
+			, File(INVALID_HANDLE_VALUE)
+			, Mapping(nullptr)
+#		endif
+	{}
+
+	inline mapped_file::~mapped_file()
+	{
+		this->close();
+	}
+
+	inline bool mapped_file::open(char const* Filename)
+	{
+		this->close();
+
+#		if GLM_PLATFORM & GLM_PLATFORM_WINDOWS
+			this->File = CreateFileA(Filename, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, nullptr);
+			if(this->File == INVALID_HANDLE_VALUE)
+				return false;
+
+			LARGE_INTEGER FileSize;
+			if(!GetFileSizeEx(this->File, &FileSize) || FileSize.QuadPart <= 0)
+			{
+				this->close();
+				return false;
+			}
+
+			this->Mapping = CreateFileMappingA(this->File, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+			if(!this->Mapping)
+			{
+				this->close();
+				return false;
+			}
+
+			this->Data = static_cast<char*>(MapViewOfFile(this->Mapping, FILE_MAP_COPY, 0, 0, 0));
+			if(!this->Data)
+			{
+				this->close();
+				return false;
+			}
+			this->Size = static_cast<std::size_t>(FileSize.QuadPart);
+#		else
+			int const File = ::open(Filename, O_RDONLY);
+			if(File == -1)
+				return false;
+
+			struct stat Stat;
+			if(fstat(File, &Stat) != 0 || Stat.st_size <= 0)
+			{
+				::close(File);
+				return false;
+			}
+
+			// MAP_PRIVATE: writing into the texture copies the page instead of modifying the file
+			void* const Pointer = mmap(nullptr, static_cast<std::size_t>(Stat.st_size), PROT_READ | PROT_WRITE, MAP_PRIVATE, File, 0);
+			::close(File);
+			if(Pointer == MAP_FAILED)
+				return false;
+
+			this->Data = static_cast<char*>(Pointer);
+			this->Size = static_cast<std::size_t>(Stat.st_size);
+#		endif
+
+		return true;
+	}
+
+	inline void mapped_file::close()
+	{
+#		if GLM_PLATFORM & GLM_PLATFORM_WINDOWS
+			if(this->Data)
+				UnmapViewOfFile(this->Data);
+			if(this->Mapping)
+				CloseHandle(this->Mapping);
+			if(this->File != INVALID_HANDLE_VALUE)
+				CloseHandle(this->File);
+			this->Mapping = nullptr;
+			this->File = INVALID_HANDLE_VALUE;
+#		else
+			if(this->Data)
+				munmap(this->Data, this->Size);
+#		endif
+
+		this->Data = nullptr;
+		this->Size = 0;
+	}
+
+	inline bool mapped_file::empty() const
+	{
+		return this->Data == nullptr;
+	}
+
+	inline char* mapped_file::data() const
+	{
+		return this->Data;
+	}
+
+	inline std::size_t mapped_file::size() const
+	{
+		return this->Size;
+	}
+
+	inline std::shared_ptr<mapped_file> map_file(char const* Filename)
+	{
+		std::shared_ptr<mapped_file> Mapping = std::make_shared<mapped_file>();
+		if(!Mapping->open(Filename))
+			return std::shared_ptr<mapped_file>();
+		return Mapping;
+	}
+
+	inline bool make_directory(char const* Path)
+	{
+#		if GLM_PLATFORM & GLM_PLATFORM_WINDOWS
+			return CreateDirectoryA(Path, nullptr) || GetLastError() == ERROR_ALREADY_EXISTS;
+#		else
+			return mkdir(Path, 0755) == 0 || errno == EEXIST;
+#		endif
+	}
+
+	inline std::vector<file_status> list_files(char const* Path)
+	{
+		std::vector<file_status> Files;
+
+#		if GLM_PLATFORM & GLM_PLATFORM_WINDOWS
+			WIN32_FIND_DATAA Data;
+			HANDLE const Find = FindFirstFileA((std::string(Path) + "\\*").c_str(), &Data);
+			if(Find == INVALID_HANDLE_VALUE)
+				return Files;
+
+			do
+			{
+				if(Data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+					continue;
+
+				// FILETIME counts 100 nanoseconds intervals
+				file_status File;
+				File.Name = Data.cFileName;
+				File.Size = (static_cast<std::uint64_t>(Data.nFileSizeHigh) << 32) | Data.nFileSizeLow;
+				File.Time = static_cast<std::int64_t>((static_cast<std::uint64_t>(Data.ftLastWriteTime.dwHighDateTime) << 32) | Data.ftLastWriteTime.dwLowDateTime) * 100;
+				Files.push_back(File);
+			}
+			while(FindNextFileA(Find, &Data));
+			FindClose(Find);
+#		else
+			DIR* const Directory = opendir(Path);
+			if(!Directory)
+				return Files;
+
+			while(dirent const* Entry = readdir(Directory))
+			{
+				struct stat Stat;
+				if(stat((std::string(Path) + "/" + Entry->d_name).c_str(), &Stat) != 0 || !S_ISREG(Stat.st_mode))
+					continue;
+
+				file_status File;
+				File.Name = Entry->d_name;
+				File.Size = static_cast<std::uint64_t>(Stat.st_size);
+#				if GLM_PLATFORM & GLM_PLATFORM_APPLE
+					File.Time = static_cast<std::int64_t>(Stat.st_mtimespec.tv_sec) * 1000000000 + Stat.st_mtimespec.tv_nsec;
+#				else
+					File.Time = static_cast<std::int64_t>(Stat.st_mtim.tv_sec) * 1000000000 + Stat.st_mtim.tv_nsec;
+#				endif
+				Files.push_back(File);
+			}
+			closedir(Directory);
+#		endif
+
+		return Files;
+	}
+
+	inline bool touch_file(char const* Path)
+	{
+#		if GLM_PLATFORM & GLM_PLATFORM_WINDOWS
+			HANDLE const File = CreateFileA(Path, FILE_WRITE_ATTRIBUTES, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+			if(File == INVALID_HANDLE_VALUE)
+				return false;
+
+			FILETIME Time;
+			GetSystemTimeAsFileTime(&Time);
+			bool const Result = SetFileTime(File, nullptr, nullptr, &Time) != 0;
+			CloseHandle(File);
+			return Result;
+#		else
+			return utimes(Path, nullptr) == 0;
+#		endif
+	}
+
+	inline bool replace_file(char const* Source, char const* Destination)
+	{
+#		if GLM_PLATFORM & GLM_PLATFORM_WINDOWS
+			return MoveFileExA(Source, Destination, MOVEFILE_REPLACE_EXISTING) != 0;
+#		else
+			return std::rename(Source, Destination) == 0;
 #		endif
 	}
 }//namespace detail
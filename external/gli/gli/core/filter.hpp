@@ -18,6 +18,14 @@ namespace gli
 		FILTER_COUNT = FILTER_LAST - FILTER_FIRST + 1,
 		FILTER_INVALID = -1
 	};
+
+	/// Separable downsampling filters of 3 destination texels radius, only supported by generate_mipmaps and update_mipmaps.
+	/// They are not sampler filters.
+	enum mipmap_filter
+	{
+		MIPMAP_FILTER_KAISER,
+		MIPMAP_FILTER_LANCZOS
+	};
 }//namespace gli
 
 #include "filter.inl"
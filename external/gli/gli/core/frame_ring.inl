@@ -0,0 +1,177 @@
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace gli
+{
+	inline manual_fence_backend::manual_fence_backend()
+		: Inserted(0)
+		, Completed(0)
+		, Pending(0)
+	{}
+
+	inline std::uint64_t manual_fence_backend::insert()
+	{
+		std::lock_guard<std::mutex> Lock(this->Mutex);
+		++this->Pending;
+		return ++this->Inserted;
+	}
+
+	inline bool manual_fence_backend::wait(std::uint64_t Fence, std::uint64_t Timeout)
+	{
+		std::unique_lock<std::mutex> Lock(this->Mutex);
+		if(Fence <= this->Completed || Timeout == 0)
+			return Fence <= this->Completed;
+
+		// Timeouts past the range of the clock are infinite
+		if(Timeout >= static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max()))
+		{
+			this->Signaled.wait(Lock, [this, Fence]{return Fence <= this->Completed;});
+			return true;
+		}
+
+		return this->Signaled.wait_for(Lock, std::chrono::nanoseconds(Timeout), [this, Fence]{return Fence <= this->Completed;});
+	}
+
+	inline void manual_fence_backend::release(std::uint64_t)
+	{
+		std::lock_guard<std::mutex> Lock(this->Mutex);
+		GLI_ASSERT(this->Pending > 0);
+		--this->Pending;
+	}
+
+	inline void manual_fence_backend::signal(std::uint64_t Fence)
+	{
+		{
+			std::lock_guard<std::mutex> Lock(this->Mutex);
+			this->Completed = std::max(this->Completed, std::min(Fence, this->Inserted));
+		}
+		this->Signaled.notify_all();
+	}
+
+	inline void manual_fence_backend::signal_all()
+	{
+		{
+			std::lock_guard<std::mutex> Lock(this->Mutex);
+			this->Completed = this->Inserted;
+		}
+		this->Signaled.notify_all();
+	}
+
+	inline std::size_t manual_fence_backend::pending() const
+	{
+		std::lock_guard<std::mutex> Lock(this->Mutex);
+		return this->Pending;
+	}
+
+	inline frame_ring::frame_ring(void* Data, std::size_t Size, std::size_t Frames, std::size_t Alignment, fence_backend& Fences)
+		: Data(static_cast<unsigned char*>(Data))
+		, Alignment(std::max<std::size_t>(Alignment, 1))
+		, Capacity(Size / std::max<std::size_t>(Frames, 1) / std::max<std::size_t>(Alignment, 1) * std::max<std::size_t>(Alignment, 1))
+		, Fences(Fences)
+		, Frame(0)
+		, Offset(0)
+		, Active(false)
+		, Stalls(0)
+		, Overflows(0)
+	{
+		region const Region = {0, false};
+		this->Regions.resize(std::max<std::size_t>(Frames, 1), Region);
+	}
+
+	inline frame_ring::~frame_ring()
+	{
+		for(std::size_t Index = 0; Index < this->Regions.size(); ++Index)
+			if(this->Regions[Index].Guarded)
+				this->Fences.release(this->Regions[Index].Fence);
+	}
+
+	inline bool frame_ring::begin_frame(std::uint64_t Timeout)
+	{
+		GLI_ASSERT(!this->Active);
+
+		region& Region = this->Regions[this->Frame];
+		if(Region.Guarded)
+		{
+			if(!this->Fences.wait(Region.Fence, 0))
+			{
+				++this->Stalls;
+				if(!this->Fences.wait(Region.Fence, Timeout))
+					return false;
+			}
+
+			this->Fences.release(Region.Fence);
+			Region.Guarded = false;
+		}
+
+		this->Offset = 0;
+		this->Active = true;
+		return true;
+	}
+
+	inline frame_allocation frame_ring::allocate(std::size_t Size)
+	{
+		frame_allocation Allocation = {0, Size, nullptr};
+		if(!this->Active)
+			return Allocation;
+
+		std::size_t const Begin = (this->Offset + this->Alignment - 1) / this->Alignment * this->Alignment;
+		if(Begin > this->Capacity || Size > this->Capacity - Begin)
+		{
+			++this->Overflows;
+			return Allocation;
+		}
+
+		Allocation.Offset = this->Frame * this->Capacity + Begin;
+		Allocation.Data = this->Data + Allocation.Offset;
+		this->Offset = Begin + Size;
+		return Allocation;
+	}
+
+	template <typename T>
+	inline frame_allocation frame_ring::push(T const& Value)
+	{
+		frame_allocation const Allocation = this->allocate(sizeof(T));
+		if(Allocation.Data)
+			std::memcpy(Allocation.Data, &Value, sizeof(T));
+		return Allocation;
+	}
+
+	inline void frame_ring::end_frame()
+	{
+		if(!this->Active)
+			return;
+
+		region& Region = this->Regions[this->Frame];
+		Region.Fence = this->Fences.insert();
+		Region.Guarded = true;
+
+		this->Frame = (this->Frame + 1) % this->Regions.size();
+		this->Active = false;
+	}
+
+	inline std::size_t frame_ring::frames() const
+	{
+		return this->Regions.size();
+	}
+
+	inline std::size_t frame_ring::frame_capacity() const
+	{
+		return this->Capacity;
+	}
+
+	inline std::size_t frame_ring::used() const
+	{
+		return this->Active ? this->Offset : 0;
+	}
+
+	inline std::size_t frame_ring::stalls() const
+	{
+		return this->Stalls;
+	}
+
+	inline std::size_t frame_ring::overflows() const
+	{
+		return this->Overflows;
+	}
+}//namespace gli
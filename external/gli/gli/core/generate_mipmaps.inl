@@ -5,6 +5,7 @@
 #include "../sampler3d.hpp"
 #include "../sampler_cube.hpp"
 #include "../sampler_cube_array.hpp"
+#include "./mipmaps_kernel.hpp"
 
 namespace gli
 {
@@ -34,6 +35,10 @@ namespace gli
 		texture2d::size_type BaseLevel, texture2d::size_type MaxLevel,
 		filter Minification)
 	{
+		texture2d Result(Texture);
+		if(detail::generate_mipmaps_kernel(Result, 0, 0, 0, 0, BaseLevel, MaxLevel, detail::make_mipmap_kernel_filter(Minification)))
+			return Result;
+
 		fsampler2D Sampler(Texture, WRAP_CLAMP_TO_EDGE);
 		Sampler.generate_mipmaps(BaseLevel, MaxLevel, Minification);
 		return Sampler();
@@ -45,6 +50,10 @@ namespace gli
 		texture2d_array::size_type BaseLevel, texture2d_array::size_type MaxLevel,
 		filter Minification)
 	{
+		texture2d_array Result(Texture);
+		if(detail::generate_mipmaps_kernel(Result, BaseLayer, MaxLayer, 0, 0, BaseLevel, MaxLevel, detail::make_mipmap_kernel_filter(Minification)))
+			return Result;
+
 		fsampler2DArray Sampler(Texture, WRAP_CLAMP_TO_EDGE);
 		Sampler.generate_mipmaps(BaseLayer, MaxLayer, BaseLevel, MaxLevel, Minification);
 		return Sampler();
@@ -66,6 +75,10 @@ namespace gli
 		texture_cube::size_type BaseLevel, texture_cube::size_type MaxLevel,
 		filter Minification)
 	{
+		texture_cube Result(Texture);
+		if(detail::generate_mipmaps_kernel(Result, 0, 0, BaseFace, MaxFace, BaseLevel, MaxLevel, detail::make_mipmap_kernel_filter(Minification)))
+			return Result;
+
 		fsamplerCube Sampler(Texture, WRAP_CLAMP_TO_EDGE);
 		Sampler.generate_mipmaps(BaseFace, MaxFace, BaseLevel, MaxLevel, Minification);
 		return Sampler();
@@ -78,11 +91,201 @@ namespace gli
 		texture_cube_array::size_type BaseLevel, texture_cube_array::size_type MaxLevel,
 		filter Minification)
 	{
+		texture_cube_array Result(Texture);
+		if(detail::generate_mipmaps_kernel(Result, BaseLayer, MaxLayer, BaseFace, MaxFace, BaseLevel, MaxLevel, detail::make_mipmap_kernel_filter(Minification)))
+			return Result;
+
 		fsamplerCubeArray Sampler(Texture, WRAP_CLAMP_TO_EDGE);
 		Sampler.generate_mipmaps(BaseLayer, MaxLayer, BaseFace, MaxFace, BaseLevel, MaxLevel, Minification);
 		return Sampler();
 	}
 
+	inline texture2d generate_mipmaps(
+		texture2d const& Texture,
+		texture2d::size_type BaseLevel, texture2d::size_type MaxLevel,
+		mipmap_filter Filter)
+	{
+		texture2d Result(Texture);
+		if(!detail::generate_mipmaps_kernel(Result, 0, 0, 0, 0, BaseLevel, MaxLevel, detail::make_mipmap_kernel_filter(Filter)))
+			return texture2d();
+		return Result;
+	}
+
+	inline texture2d_array generate_mipmaps(
+		texture2d_array const& Texture,
+		texture2d_array::size_type BaseLayer, texture2d_array::size_type MaxLayer,
+		texture2d_array::size_type BaseLevel, texture2d_array::size_type MaxLevel,
+		mipmap_filter Filter)
+	{
+		texture2d_array Result(Texture);
+		if(!detail::generate_mipmaps_kernel(Result, BaseLayer, MaxLayer, 0, 0, BaseLevel, MaxLevel, detail::make_mipmap_kernel_filter(Filter)))
+			return texture2d_array();
+		return Result;
+	}
+
+	inline texture_cube generate_mipmaps(
+		texture_cube const& Texture,
+		texture_cube::size_type BaseFace, texture_cube::size_type MaxFace,
+		texture_cube::size_type BaseLevel, texture_cube::size_type MaxLevel,
+		mipmap_filter Filter)
+	{
+		texture_cube Result(Texture);
+		if(!detail::generate_mipmaps_kernel(Result, 0, 0, BaseFace, MaxFace, BaseLevel, MaxLevel, detail::make_mipmap_kernel_filter(Filter)))
+			return texture_cube();
+		return Result;
+	}
+
+	inline texture_cube_array generate_mipmaps(
+		texture_cube_array const& Texture,
+		texture_cube_array::size_type BaseLayer, texture_cube_array::size_type MaxLayer,
+		texture_cube_array::size_type BaseFace, texture_cube_array::size_type MaxFace,
+		texture_cube_array::size_type BaseLevel, texture_cube_array::size_type MaxLevel,
+		mipmap_filter Filter)
+	{
+		texture_cube_array Result(Texture);
+		if(!detail::generate_mipmaps_kernel(Result, BaseLayer, MaxLayer, BaseFace, MaxFace, BaseLevel, MaxLevel, detail::make_mipmap_kernel_filter(Filter)))
+			return texture_cube_array();
+		return Result;
+	}
+
+namespace detail
+{
+	/// Replace the regions that overlap or touch by their bounding rectangle, per face
+	inline void merge_regions(std::vector<cube_region>& Regions)
+	{
+		for(bool Merged = true; Merged;)
+		{
+			Merged = false;
+			for(std::size_t i = 0; i < Regions.size(); ++i)
+			for(std::size_t j = i + 1; j < Regions.size(); ++j)
+			{
+				cube_region& A = Regions[i];
+				cube_region const& B = Regions[j];
+				if(A.Face != B.Face || glm::any(glm::greaterThan(A.Offset, B.Offset + B.Extent)) || glm::any(glm::greaterThan(B.Offset, A.Offset + A.Extent)))
+					continue;
+
+				texture_cube::extent_type const Max(glm::max(A.Offset + A.Extent, B.Offset + B.Extent));
+				A.Offset = glm::min(A.Offset, B.Offset);
+				A.Extent = Max - A.Offset;
+				Regions.erase(Regions.begin() + static_cast<std::ptrdiff_t>(j));
+				Merged = true;
+				--j;
+			}
+		}
+	}
+
+	/// Update the mipmaps of the regions with the row kernels of Filter, or with the sampler and Minification when Filter is MIPMAP_KERNEL_NONE
+	inline std::vector<cube_region> update_mipmaps(
+		texture_cube& Texture,
+		std::vector<cube_region> const& Regions,
+		mipmap_kernel_filter Filter,
+		filter Minification)
+	{
+		typedef texture_cube::size_type size_type;
+		typedef texture_cube::extent_type extent_type;
+
+		fsamplerCube Sampler(Texture, WRAP_CLAMP_TO_EDGE);
+
+		std::vector<cube_region> Result;
+		std::vector<cube_region> Dirty;
+		for(size_type Level = 0; Level < Texture.levels(); ++Level)
+		{
+			for(std::size_t Index = 0; Index < Regions.size(); ++Index)
+			{
+				cube_region const& Region = Regions[Index];
+				GLI_ASSERT(Region.Face < Texture.faces() && Region.Level < Texture.levels());
+				GLI_ASSERT(glm::all(glm::lessThanEqual(Region.Offset + Region.Extent, Texture.extent(Region.Level))));
+				if(Region.Level == Level && Region.Extent.x > 0 && Region.Extent.y > 0)
+					Dirty.push_back(Region);
+			}
+			merge_regions(Dirty);
+			Result.insert(Result.end(), Dirty.begin(), Dirty.end());
+			if(Dirty.empty() || Level + 1 == Texture.levels())
+				continue;
+
+			// Texels of the next level that read a changed texel of this level
+			extent_type const SourceExtent(Texture.extent(Level));
+			extent_type const Extent(Texture.extent(Level + 1));
+			std::vector<cube_region> Next;
+			for(std::size_t Index = 0; Index < Dirty.size(); ++Index)
+			{
+				cube_region const& Region = Dirty[Index];
+				glm::ivec2 const X(mipmap_footprint(Region.Offset.x, Region.Offset.x + Region.Extent.x - 1, SourceExtent.x, Extent.x, Filter));
+				glm::ivec2 const Y(mipmap_footprint(Region.Offset.y, Region.Offset.y + Region.Extent.y - 1, SourceExtent.y, Extent.y, Filter));
+				cube_region const Footprint = {Region.Face, Level + 1, extent_type(X.x, Y.x), extent_type(X.y - X.x + 1, Y.y - Y.x + 1)};
+				Next.push_back(Footprint);
+			}
+			merge_regions(Next);
+
+			// Like generate_mipmaps, the rows of the footprints of a level are generated in parallel, unless they are too few texels to be worth it
+			std::size_t const TexelsPerJob = 65536;
+			std::size_t Texels = 0;
+			std::vector<block_rows> Jobs;
+			std::vector<std::size_t> JobRegions;
+			for(std::size_t Index = 0; Index < Next.size(); ++Index)
+			{
+				cube_region const& Region = Next[Index];
+				Texels += static_cast<std::size_t>(Region.Extent.x) * static_cast<std::size_t>(Region.Extent.y);
+				int const RowsPerJob = glm::max(1, static_cast<int>(TexelsPerJob) / Region.Extent.x);
+				for(int Row = Region.Offset.y; Row < Region.Offset.y + Region.Extent.y; Row += RowsPerJob)
+				{
+					block_rows const Job = {0, Region.Face, Level, 0, Row, glm::min(Row + RowsPerJob, Region.Offset.y + Region.Extent.y)};
+					Jobs.push_back(Job);
+					JobRegions.push_back(Index);
+				}
+			}
+
+			auto const Generate = [&](std::size_t Index)
+			{
+				block_rows const& Job = Jobs[Index];
+				cube_region const& Region = Next[JobRegions[Index]];
+				if(Filter != MIPMAP_KERNEL_NONE)
+					generate_mipmaps_kernel_rows(Texture, Job, Region.Offset.x, Region.Offset.x + Region.Extent.x, Filter);
+				else
+					Sampler.generate_mipmaps(Job.Face, Job.Level + 1, extent_type(Region.Offset.x, Job.BlockRowBegin), extent_type(Region.Extent.x, Job.BlockRowEnd - Job.BlockRowBegin), Minification);
+			};
+
+			if(Texels < TexelsPerJob)
+			{
+				for(std::size_t Index = 0; Index < Jobs.size(); ++Index)
+					Generate(Index);
+			}
+			else
+				parallel_for(Jobs.size(), Generate);
+
+			Dirty.swap(Next);
+		}
+
+		return Result;
+	}
+}//namespace detail
+
+	inline std::vector<cube_region> update_mipmaps(
+		texture_cube& Texture,
+		std::vector<cube_region> const& Regions,
+		filter Minification)
+	{
+		GLI_ASSERT(!Texture.empty());
+		GLI_ASSERT(!is_compressed(Texture.format()));
+
+		// Same choice of the row kernels or the sampler as generate_mipmaps for the whole chain
+		detail::mipmap_kernel_filter const Filter = detail::make_mipmap_kernel_filter(Minification);
+		return detail::update_mipmaps(Texture, Regions, detail::has_mipmaps_kernel(Texture, 0, Filter) ? Filter : detail::MIPMAP_KERNEL_NONE, Minification);
+	}
+
+	inline std::vector<cube_region> update_mipmaps(
+		texture_cube& Texture,
+		std::vector<cube_region> const& Regions,
+		mipmap_filter Filter)
+	{
+		GLI_ASSERT(!Texture.empty());
+
+		detail::mipmap_kernel_filter const KernelFilter = detail::make_mipmap_kernel_filter(Filter);
+		if(!detail::has_mipmaps_kernel(Texture, 0, KernelFilter))
+			return std::vector<cube_region>();
+		return detail::update_mipmaps(Texture, Regions, KernelFilter, FILTER_LINEAR);
+	}
+
 	template <>
 	inline texture1d generate_mipmaps<texture1d>(texture1d const& Texture, filter Minification)
 	{
@@ -124,4 +327,24 @@ namespace gli
 	{
 		return generate_mipmaps(Texture, Texture.base_layer(), Texture.max_layer(), Texture.base_face(), Texture.max_face(), Texture.base_level(), Texture.max_level(), Minification);
 	}
+
+	inline texture2d generate_mipmaps(texture2d const& Texture, mipmap_filter Filter)
+	{
+		return generate_mipmaps(Texture, Texture.base_level(), Texture.max_level(), Filter);
+	}
+
+	inline texture2d_array generate_mipmaps(texture2d_array const& Texture, mipmap_filter Filter)
+	{
+		return generate_mipmaps(Texture, Texture.base_layer(), Texture.max_layer(), Texture.base_level(), Texture.max_level(), Filter);
+	}
+
+	inline texture_cube generate_mipmaps(texture_cube const& Texture, mipmap_filter Filter)
+	{
+		return generate_mipmaps(Texture, Texture.base_face(), Texture.max_face(), Texture.base_level(), Texture.max_level(), Filter);
+	}
+
+	inline texture_cube_array generate_mipmaps(texture_cube_array const& Texture, mipmap_filter Filter)
+	{
+		return generate_mipmaps(Texture, Texture.base_layer(), Texture.max_layer(), Texture.base_face(), Texture.max_face(), Texture.base_level(), Texture.max_level(), Filter);
+	}
 }//namespace gli
@@ -0,0 +1,154 @@
+namespace gli{
+namespace detail
+{
+	/// Job system and queue of the worker running on the calling thread, if any
+	struct job_worker
+	{
+		void const* System;
+		std::size_t Queue;
+	};
+
+	inline job_worker& current_job_worker()
+	{
+		static thread_local job_worker Worker = {nullptr, 0};
+		return Worker;
+	}
+}//namespace detail
+
+	inline job_system::job_system(std::size_t Threads)
+		: Queued(0)
+		, Pending(0)
+		, Next(0)
+		, Stop(false)
+	{
+		Threads = std::max<std::size_t>(Threads, 1);
+
+		for(std::size_t Queue = 0; Queue < Threads; ++Queue)
+			this->Queues.push_back(std::unique_ptr<job_queue>(new job_queue));
+
+		this->Workers.reserve(Threads);
+		for(std::size_t Queue = 0; Queue < Threads; ++Queue)
+			this->Workers.push_back(std::thread(&job_system::run, this, Queue));
+	}
+
+	inline job_system::~job_system()
+	{
+		{
+			std::lock_guard<std::mutex> Lock(this->Mutex);
+			this->Stop = true;
+		}
+		this->Wake.notify_all();
+
+		for(std::size_t Thread = 0; Thread < this->Workers.size(); ++Thread)
+			this->Workers[Thread].join();
+	}
+
+	inline void job_system::submit(job const& Job)
+	{
+		detail::job_worker const& Worker = detail::current_job_worker();
+		std::size_t const Queue = Worker.System == this ? Worker.Queue : this->Next++ % this->Queues.size();
+
+		++this->Pending;
+
+		// Counted under the lock of the queue, like pop and steal uncount it: a job is never taken before it is counted
+		{
+			std::lock_guard<std::mutex> Lock(this->Queues[Queue]->Mutex);
+			this->Queues[Queue]->Jobs.push_back(Job);
+			++this->Queued;
+		}
+
+		// A worker checks Queued then sleeps under the lock: taking it orders the notification after its check, it can't miss the job
+		{
+			std::lock_guard<std::mutex> Lock(this->Mutex);
+		}
+		this->Wake.notify_one();
+		this->Idle.notify_all();
+	}
+
+	inline void job_system::wait()
+	{
+		while(this->Pending > 0)
+		{
+			job Job;
+			if(this->steal(0, Job))
+			{
+				this->execute(Job);
+				continue;
+			}
+
+			std::unique_lock<std::mutex> Lock(this->Mutex);
+			this->Idle.wait(Lock, [this]{return this->Pending == 0 || this->Queued > 0;});
+		}
+	}
+
+	inline std::size_t job_system::threads() const
+	{
+		return this->Workers.size();
+	}
+
+	inline bool job_system::pop(std::size_t Queue, job& Job)
+	{
+		std::lock_guard<std::mutex> Lock(this->Queues[Queue]->Mutex);
+		if(this->Queues[Queue]->Jobs.empty())
+			return false;
+
+		Job = std::move(this->Queues[Queue]->Jobs.back());
+		this->Queues[Queue]->Jobs.pop_back();
+		--this->Queued;
+		return true;
+	}
+
+	inline bool job_system::steal(std::size_t Thief, job& Job)
+	{
+		for(std::size_t Offset = 1; Offset <= this->Queues.size(); ++Offset)
+		{
+			job_queue& Queue = *this->Queues[(Thief + Offset) % this->Queues.size()];
+
+			std::lock_guard<std::mutex> Lock(Queue.Mutex);
+			if(Queue.Jobs.empty())
+				continue;
+
+			Job = std::move(Queue.Jobs.front());
+			Queue.Jobs.pop_front();
+			--this->Queued;
+			return true;
+		}
+
+		return false;
+	}
+
+	inline void job_system::execute(job const& Job)
+	{
+		Job();
+
+		if(--this->Pending == 0)
+		{
+			std::lock_guard<std::mutex> Lock(this->Mutex);
+			this->Idle.notify_all();
+		}
+	}
+
+	inline void job_system::run(std::size_t Queue)
+	{
+		detail::job_worker& Worker = detail::current_job_worker();
+		Worker.System = this;
+		Worker.Queue = Queue;
+
+		for(;;)
+		{
+			job Job;
+			if(this->pop(Queue, Job) || this->steal(Queue, Job))
+			{
+				this->execute(Job);
+				continue;
+			}
+
+			std::unique_lock<std::mutex> Lock(this->Mutex);
+			this->Wake.wait(Lock, [this]{return this->Stop || this->Queued > 0;});
+			if(this->Stop && this->Queued == 0)
+				break;
+		}
+
+		Worker.System = nullptr;
+	}
+}//namespace gli
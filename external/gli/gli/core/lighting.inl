@@ -0,0 +1,365 @@
+#include "../copy.hpp"
+#include "../generate_mipmaps.hpp"
+#include "../levels.hpp"
+#include "../render_cube.hpp"
+#include "../sampler_cube_batch.hpp"
+#include "./parallel.hpp"
+#include "./simd.hpp"
+#include <glm/gtc/constants.hpp>
+#include <cmath>
+#include <vector>
+
+namespace gli{
+namespace detail
+{
+	/// Spherical harmonics basis functions of four normalized directions
+	inline void sh_basis(simd_vec4 const& X, simd_vec4 const& Y, simd_vec4 const& Z, simd_vec4 Basis[9])
+	{
+		Basis[0] = simd_vec4(0.282095f);
+		Basis[1] = simd_vec4(0.488603f) * Y;
+		Basis[2] = simd_vec4(0.488603f) * Z;
+		Basis[3] = simd_vec4(0.488603f) * X;
+		Basis[4] = simd_vec4(1.092548f) * X * Y;
+		Basis[5] = simd_vec4(1.092548f) * Y * Z;
+		Basis[6] = simd_vec4(0.315392f) * (simd_vec4(3.0f) * Z * Z - simd_vec4(1.0f));
+		Basis[7] = simd_vec4(1.092548f) * X * Z;
+		Basis[8] = simd_vec4(0.546274f) * (X * X - Y * Y);
+	}
+
+	/// Add the texels of the row y of a face, weighted by their solid angle and each basis function, to Sums, and their solid angles to SolidAngleSum
+	template <format Format>
+	inline void project_sh_row(glm::uint8 const* Data, int Face, int Size, int y, simd_vec4 Sums[9], float& SolidAngleSum)
+	{
+		float const TexelScale = 2.0f / static_cast<float>(Size);
+		simd_vec4 const Tc((static_cast<float>(y) + 0.5f) * TexelScale - 1.0f);
+
+		for(int x = 0; x < Size; x += 4)
+		{
+			float const TexelX = static_cast<float>(x);
+			simd_vec4 const Sc(simd_vec4(TexelX + 0.5f, TexelX + 1.5f, TexelX + 2.5f, TexelX + 3.5f) * simd_vec4(TexelScale) - simd_vec4(1.0f));
+
+			simd_vec4 X, Y, Z;
+			cube_face_directions(Face, Sc, Tc, X, Y, Z);
+			simd_vec4 const InvLength(simd_vec4(1.0f) / lane_sqrt(X * X + Y * Y + Z * Z));
+
+			// Solid angle of a texel: its area on the face divided by the cube of its distance to the center
+			simd_vec4 const SolidAngle(simd_vec4(TexelScale * TexelScale) * InvLength * InvLength * InvLength);
+
+			simd_vec4 Basis[9];
+			sh_basis(X * InvLength, Y * InvLength, Z * InvLength, Basis);
+
+			float Weights[9][4];
+			for(int Index = 0; Index < 9; ++Index)
+				(Basis[Index] * SolidAngle).store(Weights[Index]);
+
+			float SolidAngles[4];
+			SolidAngle.store(SolidAngles);
+
+			int const Lanes = glm::min(4, Size - x);
+			for(int Lane = 0; Lane < Lanes; ++Lane)
+			{
+				simd_vec4 const Texel(cube_texel<Format>::load(Data, static_cast<std::size_t>(y) * Size + x + Lane));
+				for(int Index = 0; Index < 9; ++Index)
+					Sums[Index] = Sums[Index] + Texel * simd_vec4(Weights[Index][Lane]);
+				SolidAngleSum += SolidAngles[Lane];
+			}
+		}
+	}
+
+	struct project_sh_func
+	{
+		texture_cube const& Texture;
+		texture_cube::size_type Level;
+		spherical_harmonics& Result;
+
+		template <format Format>
+		void call()
+		{
+			int const Size = this->Texture.extent(this->Level).x;
+			std::size_t const Rows = static_cast<std::size_t>(6 * Size);
+
+			std::vector<vec4> Sums(Rows * 9);
+			std::vector<float> SolidAngles(Rows);
+
+			parallel_for(Rows, [&](std::size_t Row)
+			{
+				int const Face = static_cast<int>(Row) / Size;
+				int const y = static_cast<int>(Row) % Size;
+
+				simd_vec4 RowSums[9];
+				for(int Index = 0; Index < 9; ++Index)
+					RowSums[Index] = simd_vec4(0.0f);
+
+				project_sh_row<Format>(this->Texture.template data<glm::uint8>(0, Face, this->Level), Face, Size, y, RowSums, SolidAngles[Row]);
+
+				for(int Index = 0; Index < 9; ++Index)
+					store(RowSums[Index], Sums[Row * 9 + Index]);
+			});
+
+			// Rows are added in double precision, then scaled so that the texel solid angles add up to exactly 4 pi
+			dvec3 Totals[9];
+			for(int Index = 0; Index < 9; ++Index)
+				Totals[Index] = dvec3(0.0);
+			double SolidAngle = 0.0;
+			for(std::size_t Row = 0; Row < Rows; ++Row)
+			{
+				for(int Index = 0; Index < 9; ++Index)
+					Totals[Index] += dvec3(Sums[Row * 9 + Index]);
+				SolidAngle += SolidAngles[Row];
+			}
+
+			double const Scale = 4.0 * glm::pi<double>() / SolidAngle;
+			for(int Index = 0; Index < 9; ++Index)
+				this->Result.Coefficients[Index] = vec3(Totals[Index] * Scale);
+		}
+	};
+
+	/// Van der Corput radical inverse in base 2 of Bits, the second coordinate of the Hammersley points
+	inline float radical_inverse(glm::uint32 Bits)
+	{
+		Bits = (Bits << 16u) | (Bits >> 16u);
+		Bits = ((Bits & 0x55555555u) << 1u) | ((Bits & 0xAAAAAAAAu) >> 1u);
+		Bits = ((Bits & 0x33333333u) << 2u) | ((Bits & 0xCCCCCCCCu) >> 2u);
+		Bits = ((Bits & 0x0F0F0F0Fu) << 4u) | ((Bits & 0xF0F0F0F0u) >> 4u);
+		Bits = ((Bits & 0x00FF00FFu) << 8u) | ((Bits & 0xFF00FF00u) >> 8u);
+		return static_cast<float>(Bits) * 2.3283064365386963e-10f;
+	}
+
+	/// Light directions importance sampling a GGX lobe around the normal (0, 0, 1) of the tangent frame,
+	/// with their weights and the source level matching the solid angle of each sample.
+	/// The sample count is rounded up to a multiple of 4 with samples of null weight.
+	struct ggx_samples
+	{
+		std::vector<float> X;
+		std::vector<float> Y;
+		std::vector<float> Z;
+		std::vector<float> Weights;
+		std::vector<float> Levels;
+	};
+
+	inline ggx_samples make_ggx_samples(float Roughness, std::size_t SampleCount, int SourceSize)
+	{
+		float const Alpha2 = Roughness * Roughness * Roughness * Roughness;
+		float const TexelSolidAngle = 4.0f * glm::pi<float>() / (6.0f * static_cast<float>(SourceSize) * static_cast<float>(SourceSize));
+
+		ggx_samples Samples;
+		float WeightSum = 0.0f;
+		for(std::size_t Sample = 0; Sample < SampleCount; ++Sample)
+		{
+			float const Phi = 2.0f * glm::pi<float>() * static_cast<float>(Sample) / static_cast<float>(SampleCount);
+			float const U = radical_inverse(static_cast<glm::uint32>(Sample));
+			float const CosTheta = std::sqrt((1.0f - U) / (1.0f + (Alpha2 - 1.0f) * U));
+			float const SinTheta = std::sqrt(1.0f - CosTheta * CosTheta);
+
+			// With the view direction along the normal, L = 2 * dot(N, H) * H - N
+			float const NdotL = 2.0f * CosTheta * CosTheta - 1.0f;
+			if(NdotL <= 0.0f)
+				continue;
+
+			// Probability density of L: D(H) * dot(N, H) / (4 * dot(V, H)) with dot(N, H) equal to dot(V, H)
+			float const Denominator = (Alpha2 - 1.0f) * CosTheta * CosTheta + 1.0f;
+			float const Pdf = Alpha2 / (glm::pi<float>() * Denominator * Denominator) * 0.25f;
+			float const SampleSolidAngle = 1.0f / (static_cast<float>(SampleCount) * Pdf);
+
+			Samples.X.push_back(2.0f * CosTheta * SinTheta * std::cos(Phi));
+			Samples.Y.push_back(2.0f * CosTheta * SinTheta * std::sin(Phi));
+			Samples.Z.push_back(NdotL);
+			Samples.Weights.push_back(NdotL);
+			Samples.Levels.push_back(glm::max(0.5f * std::log2(SampleSolidAngle / TexelSolidAngle) + 1.0f, 0.0f));
+			WeightSum += NdotL;
+		}
+
+		for(std::size_t Sample = 0; Sample < Samples.Weights.size(); ++Sample)
+			Samples.Weights[Sample] /= WeightSum;
+
+		while(Samples.X.size() % 4)
+		{
+			Samples.X.push_back(0.0f);
+			Samples.Y.push_back(0.0f);
+			Samples.Z.push_back(1.0f);
+			Samples.Weights.push_back(0.0f);
+			Samples.Levels.push_back(0.0f);
+		}
+
+		return Samples;
+	}
+
+	struct prefilter_ggx_func
+	{
+		texture_cube const& Texture;
+		texture_cube& Result;
+		std::size_t SampleCount;
+
+		template <format Format>
+		void call()
+		{
+			sampler_cube_batch<Format> const Sampler(this->Texture, FILTER_LINEAR, FILTER_LINEAR, true);
+			int const SourceSize = this->Texture.extent().x;
+			int const Levels = static_cast<int>(this->Result.levels());
+
+			std::vector<ggx_samples> Samples(Levels);
+			for(int Level = 1; Level < Levels; ++Level)
+				Samples[Level] = make_ggx_samples(static_cast<float>(Level) / static_cast<float>(Levels - 1), this->SampleCount, SourceSize);
+
+			// Segments of a row of a face of a level, the image Level * 6 + Face
+			std::vector<glm::ivec2> Images;
+			for(int Level = 0; Level < Levels; ++Level)
+				Images.insert(Images.end(), 6, glm::ivec2(this->Result.extent(Level)));
+
+			parallel_for_tiles(Images, glm::ivec2(TEXEL_TILE_SIZE, 1), [&](texel_tile const& Tile)
+			{
+				int const Level = static_cast<int>(Tile.Image / 6);
+				int const Face = static_cast<int>(Tile.Image % 6);
+				int const Size = this->Result.extent(Level).x;
+				int const Width = Tile.Width;
+				float const TexelScale = 2.0f / static_cast<float>(Size);
+				float const Tc = (static_cast<float>(Tile.y) + 0.5f) * TexelScale - 1.0f;
+
+				// Normals of the tile texels
+				std::vector<float> NormalX(Width), NormalY(Width), NormalZ(Width);
+				for(int x = 0; x < Width; ++x)
+				{
+					vec3 const Normal(normalize(cube_direction(Face, (static_cast<float>(Tile.x + x) + 0.5f) * TexelScale - 1.0f, Tc)));
+					NormalX[x] = Normal.x;
+					NormalY[x] = Normal.y;
+					NormalZ[x] = Normal.z;
+				}
+
+				std::vector<vec4> Texels(Width);
+				if(Level == 0)
+				{
+					// The first level, of null roughness, resamples the source
+					cube_directions const Directions = {&NormalX[0], &NormalY[0], &NormalZ[0], static_cast<std::size_t>(Width)};
+					Sampler.texture_lod(Directions, glm::max(std::log2(static_cast<float>(SourceSize) / static_cast<float>(Size)), 0.0f), &Texels[0]);
+				}
+				else
+				{
+					ggx_samples const& Lobe = Samples[Level];
+					std::size_t const Count = Lobe.X.size();
+
+					std::vector<float> X(Count * Width), Y(Count * Width), Z(Count * Width), SampleLevels(Count * Width);
+					std::vector<vec4> SampleTexels(Count * Width);
+
+					// Samples of the lobe rotated in the tangent frame of each normal, four at once
+					for(int x = 0; x < Width; ++x)
+					{
+						vec3 const Normal(NormalX[x], NormalY[x], NormalZ[x]);
+						vec3 const Up(glm::abs(Normal.z) < 0.999f ? vec3(0.0f, 0.0f, 1.0f) : vec3(1.0f, 0.0f, 0.0f));
+						vec3 const Tangent(normalize(cross(Up, Normal)));
+						vec3 const Bitangent(cross(Normal, Tangent));
+
+						std::size_t const First = static_cast<std::size_t>(x) * Count;
+						for(std::size_t Sample = 0; Sample < Count; Sample += 4)
+						{
+							simd_vec4 const SampleX(simd_vec4::load(&Lobe.X[Sample]));
+							simd_vec4 const SampleY(simd_vec4::load(&Lobe.Y[Sample]));
+							simd_vec4 const SampleZ(simd_vec4::load(&Lobe.Z[Sample]));
+
+							(simd_vec4(Tangent.x) * SampleX + simd_vec4(Bitangent.x) * SampleY + simd_vec4(Normal.x) * SampleZ).store(&X[First + Sample]);
+							(simd_vec4(Tangent.y) * SampleX + simd_vec4(Bitangent.y) * SampleY + simd_vec4(Normal.y) * SampleZ).store(&Y[First + Sample]);
+							(simd_vec4(Tangent.z) * SampleX + simd_vec4(Bitangent.z) * SampleY + simd_vec4(Normal.z) * SampleZ).store(&Z[First + Sample]);
+						}
+						std::copy(Lobe.Levels.begin(), Lobe.Levels.end(), SampleLevels.begin() + First);
+					}
+
+					cube_directions const Directions = {&X[0], &Y[0], &Z[0], Count * Width};
+					Sampler.texture_lod(Directions, &SampleLevels[0], &SampleTexels[0]);
+
+					for(int x = 0; x < Width; ++x)
+					{
+						simd_vec4 Sum(0.0f);
+						for(std::size_t Sample = 0; Sample < Count; ++Sample)
+							Sum = Sum + load(SampleTexels[x * Count + Sample]) * simd_vec4(Lobe.Weights[Sample]);
+						store(Sum, Texels[x]);
+					}
+				}
+
+				std::size_t const Offset = (static_cast<std::size_t>(Tile.y) * Size + Tile.x) * block_size(this->Result.format());
+				write_rgba_row(&Texels[0], Texels.size(), this->Result.format(), this->Result.template data<glm::uint8>(0, Face, Level) + Offset);
+			});
+		}
+	};
+}//namespace detail
+
+	inline vec3 spherical_harmonics::evaluate(vec3 const& Direction) const
+	{
+		float const Basis[9] =
+		{
+			0.282095f,
+			0.488603f * Direction.y,
+			0.488603f * Direction.z,
+			0.488603f * Direction.x,
+			1.092548f * Direction.x * Direction.y,
+			1.092548f * Direction.y * Direction.z,
+			0.315392f * (3.0f * Direction.z * Direction.z - 1.0f),
+			1.092548f * Direction.x * Direction.z,
+			0.546274f * (Direction.x * Direction.x - Direction.y * Direction.y)
+		};
+
+		vec3 Result(0.0f);
+		for(int Index = 0; Index < 9; ++Index)
+			Result += this->Coefficients[Index] * Basis[Index];
+		return Result;
+	}
+
+	inline vec3 spherical_harmonics::irradiance(vec3 const& Normal) const
+	{
+		// Convolution with the clamped cosine: each band is scaled by pi, 2 pi / 3 and pi / 4 (Ramamoorthi and Hanrahan)
+		float const Bands[3] = {glm::pi<float>(), 2.0f * glm::pi<float>() / 3.0f, glm::pi<float>() / 4.0f};
+
+		spherical_harmonics Convolved;
+		for(int Index = 0; Index < 9; ++Index)
+			Convolved.Coefficients[Index] = this->Coefficients[Index] * Bands[Index == 0 ? 0 : (Index < 4 ? 1 : 2)];
+		return Convolved.evaluate(Normal);
+	}
+
+	inline spherical_harmonics project_spherical_harmonics(texture_cube const& Texture, texture_cube::extent_type::value_type MaxExtent)
+	{
+		GLI_ASSERT(!Texture.empty() && Texture.faces() == 6);
+
+		spherical_harmonics Result;
+		for(int Index = 0; Index < 9; ++Index)
+			Result.Coefficients[Index] = vec3(0.0f);
+
+		texture_cube const Source(detail::make_cube_batch_texture(Texture));
+		if(Source.empty())
+			return Result;
+
+		texture_cube::size_type Level = 0;
+		while(Level + 1 < Source.levels() && Source.extent(Level).x > MaxExtent)
+			++Level;
+
+		detail::project_sh_func Func = {Source, Level, Result};
+		detail::dispatch_cube_batch(Source.format(), Func);
+
+		return Result;
+	}
+
+	inline texture_cube prefilter_ggx(texture_cube const& Texture, format Format, texture_cube::extent_type const& Extent, texture_cube::size_type Levels, size_t SampleCount)
+	{
+		GLI_ASSERT(!Texture.empty() && Texture.faces() == 6);
+		GLI_ASSERT(Levels > 0 && Levels <= static_cast<texture_cube::size_type>(levels(Extent)));
+		GLI_ASSERT(SampleCount > 0);
+
+		if(Format != FORMAT_RGBA8_UNORM_PACK8 && Format != FORMAT_RGBA8_SRGB_PACK8 && Format != FORMAT_RGBA16_SFLOAT_PACK16 && Format != FORMAT_RGBA32_SFLOAT_PACK32)
+			return texture_cube();
+
+		texture_cube Source(detail::make_cube_batch_texture(Texture));
+		if(Source.empty())
+			return texture_cube();
+
+		// Filtered importance sampling reads the mipmaps of the source
+		if(Source.levels() == 1 && Source.extent().x > 1)
+		{
+			texture_cube Mipmaps(Source.format(), Source.extent());
+			copy_level(Source, 0, Mipmaps, 0);
+			Source = generate_mipmaps(Mipmaps, FILTER_LINEAR);
+		}
+
+		texture_cube Result(Format, Extent, Levels);
+		detail::prefilter_ggx_func Func = {Source, Result, SampleCount};
+		detail::dispatch_cube_batch(Source.format(), Func);
+
+		return Result;
+	}
+}//namespace gli
@@ -6,20 +6,20 @@
 namespace gli
 {
 	/// Load a texture (DDS, KTX or KMG) from memory
-	inline texture load(char const * Data, std::size_t Size)
+	inline texture load(char const * Data, std::size_t Size, storage_allocator& Allocator)
 	{
 		{
-			texture Texture = load_dds(Data, Size);
+			texture Texture = load_dds(Data, Size, Allocator);
 			if(!Texture.empty())
 				return Texture;
 		}
 		{
-			texture Texture = load_kmg(Data, Size);
+			texture Texture = load_kmg(Data, Size, Allocator);
 			if(!Texture.empty())
 				return Texture;
 		}
 		{
-			texture Texture = load_ktx(Data, Size);
+			texture Texture = load_ktx(Data, Size, Allocator);
 			if(!Texture.empty())
 				return Texture;
 		}
@@ -28,7 +28,7 @@ namespace gli
 	}
 
 	/// Load a texture (DDS, KTX or KMG) from file
-	inline texture load(char const * Filename)
+	inline texture load(char const * Filename, storage_allocator& Allocator)
 	{
 		FILE* File = detail::open_file(Filename, "rb");
 		if(!File)
@@ -44,12 +44,48 @@ namespace gli
 		std::fread(&Data[0], 1, Data.size(), File);
 		std::fclose(File);
 
-		return load(&Data[0], Data.size());
+		return load(&Data[0], Data.size(), Allocator);
 	}
 
 	/// Load a texture (DDS, KTX or KMG) from file
-	inline texture load(std::string const & Filename)
+	inline texture load(std::string const & Filename, storage_allocator& Allocator)
+	{
+		return load(Filename.c_str(), Allocator);
+	}
+
+	/// Load a texture (DDS, KTX or KMG) from a file mapped in memory
+	inline texture load_mapped(char const * Filename)
+	{
+		std::shared_ptr<detail::mapped_file> const Mapping = detail::map_file(Filename);
+		if(!Mapping || Mapping->size() < sizeof(detail::FOURCC_DDS))
+			return texture();
+
+		char const* const Data = Mapping->data();
+		std::size_t const Size = Mapping->size();
+
+		if(std::memcmp(Data, detail::FOURCC_DDS, sizeof(detail::FOURCC_DDS)) == 0)
+			return detail::load_dds(Data, Size, Mapping);
+
+		if(Size >= sizeof(detail::FOURCC_KMG100) + sizeof(detail::kmgHeader10))
+		{
+			texture Texture = load_kmg(Data, Size);
+			if(!Texture.empty())
+				return Texture;
+		}
+
+		if(Size >= sizeof(detail::FOURCC_KTX10) + sizeof(detail::ktx_header10))
+		{
+			texture Texture = load_ktx(Data, Size);
+			if(!Texture.empty())
+				return Texture;
+		}
+
+		return texture();
+	}
+
+	/// Load a texture (DDS, KTX or KMG) from a file mapped in memory
+	inline texture load_mapped(std::string const & Filename)
 	{
-		return load(Filename.c_str());
+		return load_mapped(Filename.c_str());
 	}
 }//namespace gli
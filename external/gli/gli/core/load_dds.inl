@@ -1,7 +1,9 @@
 #include "../dx.hpp"
 #include "file.hpp"
+#include "container.hpp"
 #include <cstdio>
 #include <cassert>
+#include <cstdint>
 
 namespace gli{
 namespace detail
@@ -158,17 +160,27 @@ namespace detail
 			return dx::D3DFMT_AT2N;
 		}
 	}
-}//namespace detail
 
-	inline texture load_dds(char const * Data, std::size_t Size)
+	// Alignment of the texel data required to access it in place
+	inline std::size_t mapped_alignment(format Format)
 	{
-		GLI_ASSERT(Data && (Size >= sizeof(detail::FOURCC_DDS)));
+		std::size_t const BlockSize = block_size(Format);
 
-		if(strncmp(Data, detail::FOURCC_DDS, 4) != 0)
-			return texture();
-		std::size_t Offset = sizeof(detail::FOURCC_DDS);
+		// 64 bits per component formats are accessed through 64 bits types, anything else through at most 32 bits types
+		if(!is_compressed(Format) && BlockSize == component_count(Format) * 8)
+			return 8;
+		return std::min<std::size_t>(BlockSize & (~BlockSize + 1), 4);
+	}
 
-		GLI_ASSERT(Size >= sizeof(detail::dds_header));
+	/// Parse the header of a DDS container. Only the header bytes need to be available in Data.
+	/// Returns false if Data doesn't start with a DDS header.
+	inline bool parse_dds(char const * Data, std::size_t Size, container_desc& Desc)
+	{
+		GLI_ASSERT(Data);
+
+		if(Size < sizeof(detail::FOURCC_DDS) + sizeof(detail::dds_header) || strncmp(Data, detail::FOURCC_DDS, 4) != 0)
+			return false;
+		std::size_t Offset = sizeof(detail::FOURCC_DDS);
 
 		detail::dds_header const & Header(*reinterpret_cast<detail::dds_header const *>(Data + Offset));
 		Offset += sizeof(detail::dds_header);
@@ -176,6 +188,8 @@ namespace detail
 		detail::dds_header10 Header10;
 		if((Header.Format.flags & dx::DDPF_FOURCC) && (Header.Format.fourCC == dx::D3DFMT_DX10 || Header.Format.fourCC == dx::D3DFMT_GLI1))
 		{
+			if(Size < Offset + sizeof(detail::dds_header10))
+				return false;
 			std::memcpy(&Header10, Data + Offset, sizeof(Header10));
 			Offset += sizeof(detail::dds_header10);
 		}
@@ -275,8 +289,11 @@ namespace detail
 			Format = DX.find(Header.Format.fourCC, Header10.Format);
 
 		GLI_ASSERT(Format != gli::FORMAT_UNDEFINED);
+		if(Format == gli::FORMAT_UNDEFINED)
+			return false;
 
-		size_t const MipMapCount = (Header.Flags & detail::DDSD_MIPMAPCOUNT) ? Header.MipMapLevels : 1;
+		// Writers often store 0 levels along with DDSD_MIPMAPCOUNT for a single level
+		size_t const MipMapCount = (Header.Flags & detail::DDSD_MIPMAPCOUNT) ? std::max<size_t>(Header.MipMapLevels, 1) : 1;
 		size_t FaceCount = 1;
 		if(Header.CubemapFlags & detail::DDSCAPS2_CUBEMAP)
 			FaceCount = int(glm::bitCount(Header.CubemapFlags & detail::DDSCAPS2_CUBEMAP_ALLFACES));
@@ -287,20 +304,60 @@ namespace detail
 		if(Header.CubemapFlags & detail::DDSCAPS2_VOLUME)
 			DepthCount = Header.Depth;
 
-		texture Texture(
-			get_target(Header, Header10), Format,
-			texture::extent_type(Header.Width, Header.Height, DepthCount),
-			std::max<texture::size_type>(Header10.ArraySize, 1), FaceCount, MipMapCount);
+		Desc.Target = get_target(Header, Header10);
+		Desc.Format = Format;
+		Desc.Extent = texture::extent_type(Header.Width, Header.Height, DepthCount);
+		Desc.Layers = std::max<texture::size_type>(Header10.ArraySize, 1);
+		Desc.Faces = FaceCount;
+		Desc.Levels = MipMapCount;
+		Desc.Offset = Offset;
+
+		return true;
+	}
+
+	/// Parse a DDS container. When Mapping is not null, Data points into the mapping and the texture borrows its texel data
+	/// from the mapping instead of copying it, as the DDS layout matches the storage_linear layout. Otherwise the texel data is copied into memory from Allocator.
+	inline texture load_dds(char const * Data, std::size_t Size, std::shared_ptr<mapped_file> const& Mapping, storage_allocator& Allocator = uninitialized_allocator())
+	{
+		GLI_ASSERT(Data && (Size >= sizeof(detail::FOURCC_DDS)));
+
+		container_desc Desc;
+		if(!parse_dds(Data, Size, Desc))
+			return texture();
+		std::size_t const Offset = Desc.Offset;
+
+		// Data points into the mapping, recover a writable pointer on the texel data
+		char* const MappedData = Mapping ? Mapping->data() + (Data - Mapping->data()) + Offset : nullptr;
+
+		if(MappedData && reinterpret_cast<std::uintptr_t>(MappedData) % mapped_alignment(Desc.Format) == 0)
+		{
+			std::shared_ptr<texture::data_type> const Memory(Mapping, reinterpret_cast<texture::data_type*>(MappedData));
+			texture Texture(Desc.Target, Desc.Format, Desc.Extent, Desc.Layers, Desc.Faces, Desc.Levels, Memory);
+
+			// Never hand out a texture reading past the end of a truncated file
+			if(Offset + Texture.size() > Size)
+				return texture();
+			return Texture;
+		}
 
-		std::size_t const SourceSize = Offset + Texture.size();
-		GLI_ASSERT(SourceSize == Size);
+		texture Texture(Desc.Target, Desc.Format, Desc.Extent, Desc.Layers, Desc.Faces, Desc.Levels, Allocator);
+
+		// Never copy past the end of a truncated file
+		if(Offset + Texture.size() > Size)
+			return texture();
 
 		std::memcpy(Texture.data(), Data + Offset, Texture.size());
 
 		return Texture;
 	}
+}//namespace detail
+
+	inline texture load_dds(char const * Data, std::size_t Size, storage_allocator& Allocator)
+	{
+		return detail::load_dds(Data, Size, std::shared_ptr<detail::mapped_file>(), Allocator);
+	}
 
-	inline texture load_dds(char const * Filename)
+	inline texture load_dds(char const * Filename, storage_allocator& Allocator)
 	{
 		FILE* File = detail::open_file(Filename, "rb");
 		if(!File)
@@ -316,11 +373,25 @@ namespace detail
 		std::fread(&Data[0], 1, Data.size(), File);
 		std::fclose(File);
 
-		return load_dds(&Data[0], Data.size());
+		return load_dds(&Data[0], Data.size(), Allocator);
+	}
+
+	inline texture load_dds(std::string const & Filename, storage_allocator& Allocator)
+	{
+		return load_dds(Filename.c_str(), Allocator);
+	}
+
+	inline texture load_dds_mapped(char const * Filename)
+	{
+		std::shared_ptr<detail::mapped_file> const Mapping = detail::map_file(Filename);
+		if(!Mapping || Mapping->size() < sizeof(detail::FOURCC_DDS))
+			return texture();
+
+		return detail::load_dds(Mapping->data(), Mapping->size(), Mapping);
 	}
 
-	inline texture load_dds(std::string const & Filename)
+	inline texture load_dds_mapped(std::string const & Filename)
 	{
-		return load_dds(Filename.c_str());
+		return load_dds_mapped(Filename.c_str());
 	}
 }//namespace gli
@@ -27,7 +27,7 @@ namespace detail
 		std::uint32_t MaxLevel;
 	};
 
-	inline texture load_kmg100(char const * Data, std::size_t Size)
+	inline texture load_kmg100(char const * Data, std::size_t Size, storage_allocator& Allocator)
 	{
 		detail::kmgHeader10 const & Header(*reinterpret_cast<detail::kmgHeader10 const *>(Data));
 
@@ -40,6 +40,7 @@ namespace detail
 			Header.Layers,
 			Header.Faces,
 			Header.Levels,
+			Allocator,
 			texture::swizzles_type(Header.SwizzleRed, Header.SwizzleGreen, Header.SwizzleBlue, Header.SwizzleAlpha));
 
 		for(texture::size_type Layer = 0, Layers = Texture.layers(); Layer < Layers; ++Layer)
@@ -48,10 +49,12 @@ namespace detail
 			texture::size_type const FaceSize = static_cast<texture::size_type>(Texture.size(Level));
 			for(texture::size_type Face = 0, Faces = Texture.faces(); Face < Faces; ++Face)
 			{
+				// Never copy past the end of a truncated file
+				if(Offset + FaceSize > Size)
+					return texture();
 				std::memcpy(Texture.data(Layer, Face, Level), Data + Offset, FaceSize);
 
 				Offset += FaceSize;
-				GLI_ASSERT(Offset <= Size);
 			}
 		}
 
@@ -64,20 +67,20 @@ namespace detail
 	}
 }//namespace detail
 
-	inline texture load_kmg(char const * Data, std::size_t Size)
+	inline texture load_kmg(char const * Data, std::size_t Size, storage_allocator& Allocator)
 	{
 		GLI_ASSERT(Data && (Size >= sizeof(detail::kmgHeader10)));
 
 		// KMG100
 		{
 			if(memcmp(Data, detail::FOURCC_KMG100, sizeof(detail::FOURCC_KMG100)) == 0)
-				return detail::load_kmg100(Data + sizeof(detail::FOURCC_KMG100), Size - sizeof(detail::FOURCC_KMG100));
+				return detail::load_kmg100(Data + sizeof(detail::FOURCC_KMG100), Size - sizeof(detail::FOURCC_KMG100), Allocator);
 		}
 
 		return texture();
 	}
 
-	inline texture load_kmg(char const * Filename)
+	inline texture load_kmg(char const * Filename, storage_allocator& Allocator)
 	{
 		FILE* File = detail::open_file(Filename, "rb");
 		if(!File)
@@ -93,11 +96,11 @@ namespace detail
 		std::fread(&Data[0], 1, Data.size(), File);
 		std::fclose(File);
 
-		return load_kmg(&Data[0], Data.size());
+		return load_kmg(&Data[0], Data.size(), Allocator);
 	}
 
-	inline texture load_kmg(std::string const & Filename)
+	inline texture load_kmg(std::string const & Filename, storage_allocator& Allocator)
 	{
-		return load_kmg(Filename.c_str());
+		return load_kmg(Filename.c_str(), Allocator);
 	}
 }//namespace gli
@@ -1,5 +1,6 @@
 #include "../gl.hpp"
 #include "file.hpp"
+#include "container.hpp"
 #include <cstdio>
 #include <cassert>
 
@@ -50,11 +51,18 @@ namespace detail
 			return TARGET_2D;
 	}
 
-	inline texture load_ktx10(char const* Data, std::size_t Size)
+	/// Parse the header of a KTX 1.0 container. Only the header bytes need to be available in Data.
+	/// Returns false if Data doesn't start with a KTX 1.0 header.
+	inline bool parse_ktx10(char const* Data, std::size_t Size, container_desc& Desc)
 	{
-		detail::ktx_header10 const & Header(*reinterpret_cast<detail::ktx_header10 const*>(Data));
+		GLI_ASSERT(Data);
 
-		size_t Offset = sizeof(detail::ktx_header10);
+		if(Size < sizeof(detail::FOURCC_KTX10) + sizeof(detail::ktx_header10) || memcmp(Data, detail::FOURCC_KTX10, sizeof(detail::FOURCC_KTX10)) != 0)
+			return false;
+
+		detail::ktx_header10 const & Header(*reinterpret_cast<detail::ktx_header10 const*>(Data + sizeof(detail::FOURCC_KTX10)));
+
+		size_t Offset = sizeof(detail::FOURCC_KTX10) + sizeof(detail::ktx_header10);
 
 		// Skip key value data
 		Offset += Header.BytesOfKeyValueData;
@@ -65,22 +73,40 @@ namespace detail
 			static_cast<gli::gl::external_format>(Header.GLFormat),
 			static_cast<gli::gl::type_format>(Header.GLType));
 		GLI_ASSERT(Format != gli::FORMAT_UNDEFINED);
+		if(Format == gli::FORMAT_UNDEFINED)
+			return false;
+
+		Desc.Target = detail::get_target(Header);
+		Desc.Format = Format;
+		Desc.Extent = texture::extent_type(
+			Header.PixelWidth,
+			std::max<texture::size_type>(Header.PixelHeight, 1),
+			std::max<texture::size_type>(Header.PixelDepth, 1));
+		Desc.Layers = std::max<texture::size_type>(Header.NumberOfArrayElements, 1);
+		Desc.Faces = std::max<texture::size_type>(Header.NumberOfFaces, 1);
+		Desc.Levels = std::max<texture::size_type>(Header.NumberOfMipmapLevels, 1);
+		Desc.Offset = Offset;
+
+		return true;
+	}
+
+	/// Size in a KTX container of one image of a level, including the padding that follows it
+	inline texture::size_type ktx_image_stride(format Format, texture::size_type ImageSize)
+	{
+		return std::max(block_size(Format), glm::ceilMultiple(ImageSize, static_cast<texture::size_type>(4)));
+	}
 
-		texture::size_type const BlockSize = block_size(Format);
+	inline texture load_ktx10(char const* Data, std::size_t Size, container_desc const& Desc, storage_allocator& Allocator)
+	{
+		size_t Offset = Desc.Offset;
 
-		texture Texture(
-			detail::get_target(Header),
-			Format,
-			texture::extent_type(
-				Header.PixelWidth,
-				std::max<texture::size_type>(Header.PixelHeight, 1),
-				std::max<texture::size_type>(Header.PixelDepth, 1)),
-			std::max<texture::size_type>(Header.NumberOfArrayElements, 1),
-			std::max<texture::size_type>(Header.NumberOfFaces, 1),
-			std::max<texture::size_type>(Header.NumberOfMipmapLevels, 1));
+		texture Texture(Desc.Target, Desc.Format, Desc.Extent, Desc.Layers, Desc.Faces, Desc.Levels, Allocator);
 
 		for(texture::size_type Level = 0, Levels = Texture.levels(); Level < Levels; ++Level)
 		{
+			// Never read the image size of a level past the end of a truncated file
+			if(Offset + sizeof(std::uint32_t) > Size)
+				return texture();
 			Offset += sizeof(std::uint32_t);
 
 			for(texture::size_type Layer = 0, Layers = Texture.layers(); Layer < Layers; ++Layer)
@@ -88,9 +114,12 @@ namespace detail
 			{
 				texture::size_type const FaceSize = Texture.size(Level);
 
+				// Never copy past the end of a truncated file
+				if(Offset + FaceSize > Size)
+					return texture();
 				std::memcpy(Texture.data(Layer, Face, Level), Data + Offset, FaceSize);
 
-				Offset += std::max(BlockSize, glm::ceilMultiple(FaceSize, static_cast<texture::size_type>(4)));
+				Offset += ktx_image_stride(Desc.Format, FaceSize);
 			}
 		}
 
@@ -98,20 +127,21 @@ namespace detail
 	}
 }//namespace detail
 
-	inline texture load_ktx(char const* Data, std::size_t Size)
+	inline texture load_ktx(char const* Data, std::size_t Size, storage_allocator& Allocator)
 	{
 		GLI_ASSERT(Data && (Size >= sizeof(detail::ktx_header10)));
 
 		// KTX10
 		{
-			if(memcmp(Data, detail::FOURCC_KTX10, sizeof(detail::FOURCC_KTX10)) == 0)
-				return detail::load_ktx10(Data + sizeof(detail::FOURCC_KTX10), Size - sizeof(detail::FOURCC_KTX10));
+			detail::container_desc Desc;
+			if(detail::parse_ktx10(Data, Size, Desc))
+				return detail::load_ktx10(Data, Size, Desc, Allocator);
 		}
 
 		return texture();
 	}
 
-	inline texture load_ktx(char const* Filename)
+	inline texture load_ktx(char const* Filename, storage_allocator& Allocator)
 	{
 		FILE* File = detail::open_file(Filename, "rb");
 		if(!File)
@@ -127,11 +157,25 @@ namespace detail
 		std::fread(&Data[0], 1, Data.size(), File);
 		std::fclose(File);
 
-		return load_ktx(&Data[0], Data.size());
+		return load_ktx(&Data[0], Data.size(), Allocator);
+	}
+
+	inline texture load_ktx(std::string const& Filename, storage_allocator& Allocator)
+	{
+		return load_ktx(Filename.c_str(), Allocator);
+	}
+
+	inline texture load_ktx_mapped(char const* Filename)
+	{
+		std::shared_ptr<detail::mapped_file> const Mapping = detail::map_file(Filename);
+		if(!Mapping || Mapping->size() < sizeof(detail::FOURCC_KTX10) + sizeof(detail::ktx_header10))
+			return texture();
+
+		return load_ktx(Mapping->data(), Mapping->size());
 	}
 
-	inline texture load_ktx(std::string const& Filename)
+	inline texture load_ktx_mapped(std::string const& Filename)
 	{
-		return load_ktx(Filename.c_str());
+		return load_ktx_mapped(Filename.c_str());
 	}
 }//namespace gli
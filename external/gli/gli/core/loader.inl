@@ -0,0 +1,216 @@
+#include "../load.hpp"
+#include "./file.hpp"
+
+namespace gli{
+namespace detail
+{
+	inline bool is_default_recipe(cache_recipe const& Recipe)
+	{
+		return Recipe.Format == FORMAT_UNDEFINED && !Recipe.GenerateMipmaps;
+	}
+
+	/// Read one byte of each page of the texel data, so that the pages of a mapped file are read from disk by the calling thread
+	/// rather than by the thread that uploads the images. Returns the sum of the bytes read, so that the reads aren't optimized out.
+	inline std::size_t prefault(texture const& Texture)
+	{
+		// Smallest page size of the supported platforms
+		std::size_t const PageSize = 4096;
+
+		char const* const Data = Texture.data<char>();
+		std::size_t Sum = 0;
+		for(std::size_t Offset = 0; Offset < Texture.size(); Offset += PageSize)
+			Sum += static_cast<unsigned char>(static_cast<char const volatile*>(Data)[Offset]);
+		if(Texture.size() > 0)
+			Sum += static_cast<unsigned char>(static_cast<char const volatile*>(Data)[Texture.size() - 1]);
+		return Sum;
+	}
+
+	/// Upload commands of a loaded texture: storage creation then, with Images, images from the smallest level to the largest
+	inline void stage_texture(std::size_t Asset, texture const& Texture, bool Images, std::vector<upload_command>& Commands)
+	{
+		upload_command Command;
+		Command.Kind = UPLOAD_TEXTURE;
+		Command.Asset = Asset;
+		Command.Texture = Texture;
+		Commands.push_back(Command);
+
+		Command.Kind = UPLOAD_IMAGE;
+		for(texture::size_type Level = Images ? Texture.levels() : 0; Level-- > 0;)
+		for(texture::size_type Layer = 0; Layer < Texture.layers(); ++Layer)
+		for(texture::size_type Face = 0; Face < Texture.faces(); ++Face)
+		{
+			Command.Layer = Layer;
+			Command.Face = Face;
+			Command.Level = Level;
+			Commands.push_back(Command);
+		}
+
+		Command.Kind = UPLOAD_DONE;
+		Command.Texture = texture();
+		Command.Layer = Command.Face = Command.Level = 0;
+		Commands.push_back(Command);
+	}
+
+	inline std::shared_ptr<std::vector<char>> read_file(char const* Path)
+	{
+		FILE* File = open_file(Path, "rb");
+		if(!File)
+			return std::shared_ptr<std::vector<char>>();
+
+		std::int64_t const Size = file_size(File);
+
+		std::shared_ptr<std::vector<char>> Data(std::make_shared<std::vector<char>>(Size > 0 ? static_cast<std::size_t>(Size) : 0));
+		bool const Read = Size >= 0 && (Data->empty() || std::fread(&(*Data)[0], 1, Data->size(), File) == Data->size());
+		std::fclose(File);
+
+		return Read ? Data : std::shared_ptr<std::vector<char>>();
+	}
+}//namespace detail
+
+	inline asset_loader::asset_loader(job_system& Jobs, texture_cache* Cache)
+		: Jobs(Jobs)
+		, Cache(Cache)
+		, NextAsset(0)
+		, Pending(0)
+		, Running(0)
+	{}
+
+	inline asset_loader::~asset_loader()
+	{
+		std::unique_lock<std::mutex> Lock(this->Mutex);
+		this->Ready.wait(Lock, [this]{return this->Running == 0;});
+	}
+
+	inline asset_loader::asset_type asset_loader::load_texture(std::string const& Path, cache_recipe const& Recipe, bool Images)
+	{
+		asset_type Asset = 0;
+		{
+			std::lock_guard<std::mutex> Lock(this->Mutex);
+			Asset = this->NextAsset++;
+			++this->Pending;
+			++this->Running;
+		}
+
+		this->Jobs.submit([this, Asset, Path, Recipe, Images]()
+		{
+			texture Texture;
+			if(detail::is_default_recipe(Recipe))
+				Texture = load_mapped(Path);
+			else if(this->Cache)
+				Texture = this->Cache->load(Path.c_str(), Recipe);
+			else
+			{
+				texture const Source(load_mapped(Path));
+				if(!Source.empty())
+					Texture = process(Source, Recipe);
+			}
+
+			std::vector<upload_command> Commands;
+			if(Texture.empty())
+			{
+				upload_command Failed;
+				Failed.Asset = Asset;
+				Commands.push_back(Failed);
+			}
+			else
+			{
+				// Textures loaded from DDS files borrow the file mapping: page faults happen here rather than during the uploads
+				detail::prefault(Texture);
+				detail::stage_texture(Asset, Texture, Images, Commands);
+			}
+
+			this->queue(Commands);
+		});
+
+		return Asset;
+	}
+
+	inline asset_loader::asset_type asset_loader::load_file(std::string const& Path)
+	{
+		asset_type Asset = 0;
+		{
+			std::lock_guard<std::mutex> Lock(this->Mutex);
+			Asset = this->NextAsset++;
+			++this->Pending;
+			++this->Running;
+		}
+
+		this->Jobs.submit([this, Asset, Path]()
+		{
+			upload_command Command;
+			Command.Asset = Asset;
+			Command.Data = detail::read_file(Path.c_str());
+
+			std::vector<upload_command> Commands;
+			if(Command.Data)
+			{
+				Command.Kind = UPLOAD_FILE;
+				Commands.push_back(Command);
+				Command.Kind = UPLOAD_DONE;
+				Command.Data.reset();
+			}
+			Commands.push_back(Command);
+
+			this->queue(Commands);
+		});
+
+		return Asset;
+	}
+
+	template <typename func>
+	inline std::size_t asset_loader::drain(func& Func, std::chrono::steady_clock::duration Budget)
+	{
+		std::chrono::steady_clock::time_point const Start(std::chrono::steady_clock::now());
+
+		std::size_t Count = 0;
+		for(;;)
+		{
+			upload_command Command;
+			{
+				std::lock_guard<std::mutex> Lock(this->Mutex);
+				if(this->Commands.empty())
+					break;
+				Command = std::move(this->Commands.front());
+				this->Commands.pop_front();
+			}
+
+			Func(static_cast<upload_command const&>(Command));
+			++Count;
+
+			if(Command.Kind == UPLOAD_DONE || Command.Kind == UPLOAD_FAILED)
+			{
+				std::lock_guard<std::mutex> Lock(this->Mutex);
+				if(--this->Pending == 0)
+					this->Ready.notify_all();
+			}
+
+			if(std::chrono::steady_clock::now() - Start >= Budget)
+				break;
+		}
+
+		return Count;
+	}
+
+	inline std::size_t asset_loader::pending() const
+	{
+		std::lock_guard<std::mutex> Lock(this->Mutex);
+		return this->Pending;
+	}
+
+	inline void asset_loader::wait() const
+	{
+		std::unique_lock<std::mutex> Lock(this->Mutex);
+		this->Ready.wait(Lock, [this]{return this->Pending == 0 || !this->Commands.empty();});
+	}
+
+	inline void asset_loader::queue(std::vector<upload_command>& Commands)
+	{
+		std::lock_guard<std::mutex> Lock(this->Mutex);
+		for(std::size_t Index = 0; Index < Commands.size(); ++Index)
+			this->Commands.push_back(std::move(Commands[Index]));
+		--this->Running;
+
+		// Notified under the lock: the destructor may run as soon as Running is seen at zero
+		this->Ready.notify_all();
+	}
+}//namespace gli
@@ -40,39 +40,57 @@ namespace detail
 		}
 	}
 
+	/// Generate the texels of the box Offset, Extent of the Level from the Level - 1
 	template <typename texture_type, typename sampler_value_type, typename fetch_func, typename write_func, typename normalized_type, typename texel_type>
-	inline void generate_mipmaps_2d
+	inline void generate_mipmaps_2d_region
 	(
 		texture_type & Texture, fetch_func Fetch, write_func Write,
-		typename texture_type::size_type BaseLayer, typename texture_type::size_type MaxLayer,
-		typename texture_type::size_type BaseFace, typename texture_type::size_type MaxFace,
-		typename texture_type::size_type BaseLevel, typename texture_type::size_type MaxLevel,
+		typename texture_type::size_type Layer, typename texture_type::size_type Face, typename texture_type::size_type Level,
+		typename texture_type::extent_type const& Offset, typename texture_type::extent_type const& Extent,
 		filter Min
 	)
 	{
 		typedef typename detail::interpolate<sampler_value_type>::type interpolate_type;
 		typedef typename texture_type::extent_type extent_type;
-		typedef typename texture_type::size_type size_type;
 		typedef typename extent_type::value_type component_type;
 		typedef typename detail::filterBase<detail::DIMENSION_2D, texture_type, interpolate_type, normalized_type, fetch_func, texel_type>::filterFunc filter_func;
 
+		GLI_ASSERT(Level > 0);
+
 		filter_func const Filter = detail::get_filter<filter_func, detail::DIMENSION_2D, texture_type, interpolate_type, normalized_type, fetch_func, texel_type, sampler_value_type>(FILTER_NEAREST, Min, false);
 		GLI_ASSERT(Filter);
 
+		extent_type const& ExtentDst = Texture.extent(Level);
+		normalized_type const& Scale = normalized_type(1) / normalized_type(max(ExtentDst - extent_type(1), extent_type(1)));
+
+		for(component_type j = Offset.y; j < Offset.y + Extent.y; ++j)
+		for(component_type i = Offset.x; i < Offset.x + Extent.x; ++i)
+		{
+			normalized_type const& SamplePosition(normalized_type(i, j) * Scale);
+			texel_type const& Texel = Filter(Texture, Fetch, SamplePosition, Layer, Face, static_cast<sampler_value_type>(Level - 1), texel_type(0));
+			Write(Texture, extent_type(i, j), Layer, Face, Level, Texel);
+		}
+	}
+
+	template <typename texture_type, typename sampler_value_type, typename fetch_func, typename write_func, typename normalized_type, typename texel_type>
+	inline void generate_mipmaps_2d
+	(
+		texture_type & Texture, fetch_func Fetch, write_func Write,
+		typename texture_type::size_type BaseLayer, typename texture_type::size_type MaxLayer,
+		typename texture_type::size_type BaseFace, typename texture_type::size_type MaxFace,
+		typename texture_type::size_type BaseLevel, typename texture_type::size_type MaxLevel,
+		filter Min
+	)
+	{
+		typedef typename texture_type::extent_type extent_type;
+		typedef typename texture_type::size_type size_type;
+
 		for(size_type Layer = BaseLayer; Layer <= MaxLayer; ++Layer)
 		for(size_type Face = BaseFace; Face <= MaxFace; ++Face)
 		for(size_type Level = BaseLevel; Level < MaxLevel; ++Level)
 		{
-			extent_type const& ExtentDst = Texture.extent(Level + 1);
-			normalized_type const& Scale = normalized_type(1) / normalized_type(max(ExtentDst - extent_type(1), extent_type(1)));
-
-			for(component_type j = 0; j < ExtentDst.y; ++j)
-			for(component_type i = 0; i < ExtentDst.x; ++i)
-			{
-				normalized_type const& SamplePosition(normalized_type(i, j) * Scale);
-				texel_type const& Texel = Filter(Texture, Fetch, SamplePosition, Layer, Face, static_cast<sampler_value_type>(Level), texel_type(0));
-				Write(Texture, extent_type(i, j), Layer, Face, Level + 1, Texel);
-			}
+			generate_mipmaps_2d_region<texture_type, sampler_value_type, fetch_func, write_func, normalized_type, texel_type>(
+				Texture, Fetch, Write, Layer, Face, Level + 1, extent_type(0), Texture.extent(Level + 1), Min);
 		}
 	}
 
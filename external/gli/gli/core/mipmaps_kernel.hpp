@@ -0,0 +1,510 @@
+/// @brief Include to generate the mipmaps of power of two RGBA8, RGBA16F and RGBA32F 2d images with row kernels
+/// @file gli/core/mipmaps_kernel.hpp
+
+#pragma once
+
+#include "../texture.hpp"
+#include "./filter.hpp"
+#include "./parallel.hpp"
+#include "./simd.hpp"
+#include <glm/gtc/packing.hpp>
+#include <glm/gtc/round.hpp>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace gli{
+namespace detail
+{
+	/// 2x2 box of float RGBA rows.
+	/// StepX is 2 when the source rows are twice as wide as the destination row and 1 when both are a single texel wide.
+	inline void box_row_float(glm::vec4 const* Row0, glm::vec4 const* Row1, int StepX, int Width, glm::vec4* Destination)
+	{
+		simd_vec4 const Quarter(0.25f);
+		int const Last = StepX - 1;
+
+		for(int x = 0; x < Width; ++x)
+		{
+			glm::vec4 const* const A = Row0 + x * StepX;
+			glm::vec4 const* const B = Row1 + x * StepX;
+			store((load(A[0]) + load(A[Last]) + load(B[0]) + load(B[Last])) * Quarter, Destination[x]);
+		}
+	}
+
+	// Row conversions between a texel format and float RGBA, and 2x2 box of two rows in the texel format.
+	// ScratchRows is the number of float RGBA source rows that box_row needs as temporary storage.
+
+	struct mipmap_rgba32_sfloat
+	{
+		typedef glm::vec4 texel_type;
+		enum {ScratchRows = 0};
+
+		static void load_row(texel_type const* Source, int Width, glm::vec4* Destination)
+		{
+			std::memcpy(Destination, Source, sizeof(glm::vec4) * Width);
+		}
+
+		static void store_row(glm::vec4 const* Source, int Width, texel_type* Destination)
+		{
+			std::memcpy(Destination, Source, sizeof(glm::vec4) * Width);
+		}
+
+		static void box_row(texel_type const* Row0, texel_type const* Row1, int StepX, int Width, texel_type* Destination, glm::vec4*)
+		{
+			box_row_float(Row0, Row1, StepX, Width, Destination);
+		}
+	};
+
+	struct mipmap_rgba16_sfloat
+	{
+		typedef glm::uint64 texel_type;
+		enum {ScratchRows = 3};
+
+		/// F16C converts the rows when Arch and the CPU support it
+		static void load_row(texel_type const* Source, int Width, glm::vec4* Destination, cpu_arch Arch = widest_cpu_arch())
+		{
+#			if GLI_CPU_X86
+				if(supported_cpu_arch(Arch) >= CPU_ARCH_F16C)
+				{
+					halfs_to_floats_f16c(reinterpret_cast<glm::uint16 const*>(Source), &Destination[0][0], static_cast<std::size_t>(Width) * 4);
+					return;
+				}
+#			endif//GLI_CPU_X86
+
+			for(int x = 0; x < Width; ++x)
+				Destination[x] = glm::unpackHalf4x16(Source[x]);
+		}
+
+		static void store_row(glm::vec4 const* Source, int Width, texel_type* Destination, cpu_arch Arch = widest_cpu_arch())
+		{
+#			if GLI_CPU_X86
+				if(supported_cpu_arch(Arch) >= CPU_ARCH_F16C)
+				{
+					floats_to_halfs_f16c(&Source[0][0], reinterpret_cast<glm::uint16*>(Destination), static_cast<std::size_t>(Width) * 4);
+					return;
+				}
+#			endif//GLI_CPU_X86
+
+			for(int x = 0; x < Width; ++x)
+				Destination[x] = glm::packHalf4x16(Source[x]);
+		}
+
+		static void box_row(texel_type const* Row0, texel_type const* Row1, int StepX, int Width, texel_type* Destination, glm::vec4* Scratch)
+		{
+			int const SourceWidth = Width * StepX;
+			glm::vec4* const Float0 = Scratch;
+			glm::vec4* const Float1 = Scratch + SourceWidth;
+			glm::vec4* const Output = Scratch + SourceWidth * 2;
+
+			load_row(Row0, SourceWidth, Float0);
+			load_row(Row1, SourceWidth, Float1);
+			box_row_float(Float0, Float1, StepX, Width, Output);
+			store_row(Output, Width, Destination);
+		}
+	};
+
+	struct mipmap_rgba8_unorm
+	{
+		typedef glm::u8vec4 texel_type;
+		enum {ScratchRows = 0};
+
+		static void load_row(texel_type const* Source, int Width, glm::vec4* Destination)
+		{
+			for(int x = 0; x < Width; ++x)
+				Destination[x] = glm::vec4(Source[x]) * (1.0f / 255.0f);
+		}
+
+		static void store_row(glm::vec4 const* Source, int Width, texel_type* Destination)
+		{
+			for(int x = 0; x < Width; ++x)
+				Destination[x] = texel_type(glm::round(glm::clamp(Source[x], 0.0f, 1.0f) * 255.0f));
+		}
+
+		/// Rounded average of the 4 source texels, computed on 16 bits integers
+		static void box_row(texel_type const* Row0, texel_type const* Row1, int StepX, int Width, texel_type* Destination, glm::vec4*)
+		{
+			int x = 0;
+
+#			if GLM_ARCH & GLM_ARCH_SSE2_BIT
+				if(StepX == 2)
+				{
+					__m128i const Zero = _mm_setzero_si128();
+					__m128i const Two = _mm_set1_epi16(2);
+
+					// 4 source texels of each row give 2 destination texels
+					for(; x + 2 <= Width; x += 2)
+					{
+						__m128i const A = _mm_loadu_si128(reinterpret_cast<__m128i const*>(Row0 + x * 2));
+						__m128i const B = _mm_loadu_si128(reinterpret_cast<__m128i const*>(Row1 + x * 2));
+						__m128i const Low = _mm_add_epi16(_mm_unpacklo_epi8(A, Zero), _mm_unpacklo_epi8(B, Zero));
+						__m128i const High = _mm_add_epi16(_mm_unpackhi_epi8(A, Zero), _mm_unpackhi_epi8(B, Zero));
+						__m128i const Sum = _mm_add_epi16(_mm_unpacklo_epi64(Low, High), _mm_unpackhi_epi64(Low, High));
+						__m128i const Average = _mm_srli_epi16(_mm_add_epi16(Sum, Two), 2);
+						_mm_storel_epi64(reinterpret_cast<__m128i*>(Destination + x), _mm_packus_epi16(Average, Average));
+					}
+				}
+#			endif//GLM_ARCH & GLM_ARCH_SSE2_BIT
+
+			int const Last = StepX - 1;
+			for(; x < Width; ++x)
+			{
+				texel_type const* const A = Row0 + x * StepX;
+				texel_type const* const B = Row1 + x * StepX;
+				glm::u16vec4 const Sum(glm::u16vec4(A[0]) + glm::u16vec4(A[Last]) + glm::u16vec4(B[0]) + glm::u16vec4(B[Last]) + glm::u16vec4(2));
+				Destination[x] = texel_type(Sum / glm::u16vec4(4));
+			}
+		}
+	};
+
+	/// Filters of the row kernels: the 2x2 box that FILTER_LINEAR selects and the separable filters of mipmap_filter
+	enum mipmap_kernel_filter
+	{
+		MIPMAP_KERNEL_NONE,
+		MIPMAP_KERNEL_BOX,
+		MIPMAP_KERNEL_KAISER,
+		MIPMAP_KERNEL_LANCZOS
+	};
+
+	/// Only FILTER_LINEAR has a row kernel, the other sampler filters take the sampler path
+	inline mipmap_kernel_filter make_mipmap_kernel_filter(filter Minification)
+	{
+		return Minification == FILTER_LINEAR ? MIPMAP_KERNEL_BOX : MIPMAP_KERNEL_NONE;
+	}
+
+	inline mipmap_kernel_filter make_mipmap_kernel_filter(mipmap_filter Filter)
+	{
+		return Filter == MIPMAP_FILTER_LANCZOS ? MIPMAP_KERNEL_LANCZOS : MIPMAP_KERNEL_KAISER;
+	}
+
+	/// Weights of a separable downsampling filter, Offset is relative to the first of the two source texels covered by a destination texel
+	struct mipmap_taps
+	{
+		int Count;
+		int Offset[12];
+		float Weight[12];
+	};
+
+	inline double mipmap_sinc(double x)
+	{
+		double const Pi = 3.14159265358979323846;
+		return glm::abs(x) < 1e-9 ? 1.0 : std::sin(Pi * x) / (Pi * x);
+	}
+
+	/// Modified Bessel function of the first kind of order 0
+	inline double mipmap_bessel_i0(double x)
+	{
+		double Sum = 1.0;
+		double Term = 1.0;
+		for(int k = 1; Term > Sum * 1e-12; ++k)
+		{
+			Term *= (x * x / 4.0) / (k * k);
+			Sum += Term;
+		}
+		return Sum;
+	}
+
+	/// Filters of 3 destination texels radius, x is the distance in destination texels
+	inline double mipmap_filter_weight(mipmap_kernel_filter Filter, double x)
+	{
+		double const Radius = 3.0;
+		if(glm::abs(x) >= Radius)
+			return 0.0;
+
+		if(Filter == MIPMAP_KERNEL_LANCZOS)
+			return mipmap_sinc(x) * mipmap_sinc(x / Radius);
+
+		// Kaiser window of alpha 4 applied to the sinc
+		double const Alpha = 4.0;
+		double const t = x / Radius;
+		return mipmap_sinc(x) * mipmap_bessel_i0(Alpha * std::sqrt(1.0 - t * t)) / mipmap_bessel_i0(Alpha);
+	}
+
+	inline mipmap_taps make_mipmap_taps(mipmap_kernel_filter Filter)
+	{
+		mipmap_taps Taps;
+		Taps.Count = 12;
+
+		double Weights[12];
+		double Sum = 0.0;
+		for(int Tap = 0; Tap < Taps.Count; ++Tap)
+		{
+			Taps.Offset[Tap] = Tap - 5;
+			// Source texel centers are 0.5 source texel, 0.25 destination texel, away from the destination texel center
+			Weights[Tap] = mipmap_filter_weight(Filter, (Taps.Offset[Tap] - 0.5) / 2.0);
+			Sum += Weights[Tap];
+		}
+
+		for(int Tap = 0; Tap < Taps.Count; ++Tap)
+			Taps.Weight[Tap] = static_cast<float>(Weights[Tap] / Sum);
+
+		return Taps;
+	}
+
+	/// Filter a row of Width destination texels starting at the texel First, taps beyond the edges clamp to the edge texels
+	inline void filter_row(glm::vec4 const* Source, int SourceWidth, mipmap_taps const& Taps, int Step, int First, int Width, glm::vec4* Destination)
+	{
+		simd_vec4 Weights[12];
+		for(int Tap = 0; Tap < Taps.Count; ++Tap)
+			Weights[Tap] = simd_vec4(Taps.Weight[Tap]);
+
+		for(int x = 0; x < Width; ++x)
+		{
+			int const Center = (First + x) * Step;
+			simd_vec4 Sum(0.0f);
+
+			if(Center + Taps.Offset[0] >= 0 && Center + Taps.Offset[Taps.Count - 1] < SourceWidth)
+			{
+				for(int Tap = 0; Tap < Taps.Count; ++Tap)
+					Sum = Sum + load(Source[Center + Taps.Offset[Tap]]) * Weights[Tap];
+			}
+			else
+			{
+				for(int Tap = 0; Tap < Taps.Count; ++Tap)
+					Sum = Sum + load(Source[glm::clamp(Center + Taps.Offset[Tap], 0, SourceWidth - 1)]) * Weights[Tap];
+			}
+
+			store(Sum, Destination[x]);
+		}
+	}
+
+	/// Filter Width texels across one row per tap
+	inline void filter_column(glm::vec4 const* const* Rows, mipmap_taps const& Taps, int Width, glm::vec4* Destination)
+	{
+		simd_vec4 Weights[12];
+		for(int Tap = 0; Tap < Taps.Count; ++Tap)
+			Weights[Tap] = simd_vec4(Taps.Weight[Tap]);
+
+		for(int x = 0; x < Width; ++x)
+		{
+			simd_vec4 Sum(0.0f);
+			for(int Tap = 0; Tap < Taps.Count; ++Tap)
+				Sum = Sum + load(Rows[Tap][x]) * Weights[Tap];
+			store(Sum, Destination[x]);
+		}
+	}
+
+	/// Destination columns [ColumnBegin, ColumnEnd) of the rows [Job.BlockRowBegin, Job.BlockRowEnd) of the level Job.Level + 1 by 2x2 box of the level Job.Level
+	template <typename codec>
+	inline void box_rows(texture& Texture, block_rows const& Job, int ColumnBegin, int ColumnEnd)
+	{
+		typedef typename codec::texel_type texel_type;
+
+		texture::extent_type const SourceExtent(Texture.extent(Job.Level));
+		texture::extent_type const Extent(Texture.extent(Job.Level + 1));
+		int const StepX = SourceExtent.x / Extent.x;
+		int const StepY = SourceExtent.y / Extent.y;
+
+		texel_type const* const Source = Texture.data<texel_type>(Job.Layer, Job.Face, Job.Level);
+		texel_type* const Destination = Texture.data<texel_type>(Job.Layer, Job.Face, Job.Level + 1);
+
+		std::vector<glm::vec4> Scratch(static_cast<std::size_t>(codec::ScratchRows) * SourceExtent.x);
+
+		for(int y = Job.BlockRowBegin; y < Job.BlockRowEnd; ++y)
+		{
+			texel_type const* const Row0 = Source + static_cast<std::size_t>(y * StepY) * SourceExtent.x + ColumnBegin * StepX;
+			texel_type const* const Row1 = Row0 + static_cast<std::size_t>(StepY - 1) * SourceExtent.x;
+			codec::box_row(Row0, Row1, StepX, ColumnEnd - ColumnBegin, Destination + static_cast<std::size_t>(y) * Extent.x + ColumnBegin, Scratch.data());
+		}
+	}
+
+	/// Destination columns [ColumnBegin, ColumnEnd) of the rows [Job.BlockRowBegin, Job.BlockRowEnd) of the level Job.Level + 1 by separable filtering of the level Job.Level.
+	/// The source rows covered by the vertical taps of the job are filtered horizontally once, then combined vertically.
+	template <typename codec>
+	inline void separable_rows(texture& Texture, block_rows const& Job, mipmap_taps const& Taps, int ColumnBegin, int ColumnEnd)
+	{
+		typedef typename codec::texel_type texel_type;
+
+		texture::extent_type const SourceExtent(Texture.extent(Job.Level));
+		texture::extent_type const Extent(Texture.extent(Job.Level + 1));
+		int const StepX = SourceExtent.x / Extent.x;
+		int const StepY = SourceExtent.y / Extent.y;
+
+		// A dimension of a single texel is copied
+		mipmap_taps const Identity = {1, {0}, {1.0f}};
+		mipmap_taps const& TapsX = StepX == 2 ? Taps : Identity;
+		mipmap_taps const& TapsY = StepY == 2 ? Taps : Identity;
+
+		texel_type const* const Source = Texture.data<texel_type>(Job.Layer, Job.Face, Job.Level);
+		texel_type* const Destination = Texture.data<texel_type>(Job.Layer, Job.Face, Job.Level + 1);
+
+		int const First = glm::max(Job.BlockRowBegin * StepY + TapsY.Offset[0], 0);
+		int const Last = glm::min((Job.BlockRowEnd - 1) * StepY + TapsY.Offset[TapsY.Count - 1], SourceExtent.y - 1);
+
+		// Only the source columns covered by the horizontal taps of the destination columns are loaded
+		int const Left = glm::max(ColumnBegin * StepX + TapsX.Offset[0], 0);
+		int const Right = glm::min((ColumnEnd - 1) * StepX + TapsX.Offset[TapsX.Count - 1], SourceExtent.x - 1);
+		int const Width = ColumnEnd - ColumnBegin;
+
+		std::vector<glm::vec4> Line(static_cast<std::size_t>(SourceExtent.x));
+		std::vector<glm::vec4> Filtered(static_cast<std::size_t>(Last - First + 1) * Width);
+		for(int y = First; y <= Last; ++y)
+		{
+			codec::load_row(Source + static_cast<std::size_t>(y) * SourceExtent.x + Left, Right - Left + 1, &Line[Left]);
+			filter_row(&Line[0], SourceExtent.x, TapsX, StepX, ColumnBegin, Width, &Filtered[static_cast<std::size_t>(y - First) * Width]);
+		}
+
+		std::vector<glm::vec4> Output(static_cast<std::size_t>(Width));
+		glm::vec4 const* Rows[12];
+		for(int y = Job.BlockRowBegin; y < Job.BlockRowEnd; ++y)
+		{
+			for(int Tap = 0; Tap < TapsY.Count; ++Tap)
+				Rows[Tap] = &Filtered[static_cast<std::size_t>(glm::clamp(y * StepY + TapsY.Offset[Tap], 0, SourceExtent.y - 1) - First) * Width];
+
+			filter_column(Rows, TapsY, Width, &Output[0]);
+			codec::store_row(&Output[0], Width, Destination + static_cast<std::size_t>(y) * Extent.x + ColumnBegin);
+		}
+	}
+
+	template <typename codec>
+	inline void generate_mipmaps_kernel(
+		texture& Texture,
+		texture::size_type BaseLayer, texture::size_type MaxLayer,
+		texture::size_type BaseFace, texture::size_type MaxFace,
+		texture::size_type BaseLevel, texture::size_type MaxLevel,
+		mipmap_kernel_filter Filter)
+	{
+		mipmap_taps const Taps(make_mipmap_taps(Filter));
+
+		// Each level reads the previous one: levels are generated in order, the faces and the rows of a level in parallel
+		for(texture::size_type Level = BaseLevel; Level < MaxLevel; ++Level)
+		{
+			int const Height = Texture.extent(Level + 1).y;
+			int const RowsPerJob = glm::max(1, 65536 / Texture.extent(Level + 1).x);
+
+			std::vector<block_rows> Jobs;
+			for(texture::size_type Layer = BaseLayer; Layer <= MaxLayer; ++Layer)
+			for(texture::size_type Face = BaseFace; Face <= MaxFace; ++Face)
+			for(int Row = 0; Row < Height; Row += RowsPerJob)
+			{
+				block_rows const Job = {Layer, Face, Level, 0, Row, glm::min(Row + RowsPerJob, Height)};
+				Jobs.push_back(Job);
+			}
+
+			int const Width = Texture.extent(Level + 1).x;
+			parallel_for(Jobs.size(), [&](std::size_t Index)
+			{
+				if(Filter == MIPMAP_KERNEL_BOX)
+					box_rows<codec>(Texture, Jobs[Index], 0, Width);
+				else
+					separable_rows<codec>(Texture, Jobs[Index], Taps, 0, Width);
+			});
+		}
+	}
+
+	/// Whether the row kernels generate the mipmaps of Texture from BaseLevel with Filter:
+	/// the separable filters are clamped to the edges of each image.
+	/// The kernels handle RGBA8 UNORM, RGBA16 SFLOAT and RGBA32 SFLOAT images of power of two extents.
+	inline bool has_mipmaps_kernel(texture const& Texture, texture::size_type BaseLevel, mipmap_kernel_filter Filter)
+	{
+		if(Filter == MIPMAP_KERNEL_NONE)
+			return false;
+
+		texture::extent_type const Extent(Texture.extent(BaseLevel));
+		if(Extent.z != 1 || !glm::isPowerOfTwo(Extent.x) || !glm::isPowerOfTwo(Extent.y))
+			return false;
+
+		switch(Texture.format())
+		{
+		case FORMAT_RGBA8_UNORM_PACK8:
+		case FORMAT_RGBA16_SFLOAT_PACK16:
+		case FORMAT_RGBA32_SFLOAT_PACK32:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	/// Generate the mipmaps of the 2d images of Texture with the row kernels.
+	/// Returns false without writing anything if has_mipmaps_kernel is false.
+	inline bool generate_mipmaps_kernel(
+		texture& Texture,
+		texture::size_type BaseLayer, texture::size_type MaxLayer,
+		texture::size_type BaseFace, texture::size_type MaxFace,
+		texture::size_type BaseLevel, texture::size_type MaxLevel,
+		mipmap_kernel_filter Filter)
+	{
+		if(!has_mipmaps_kernel(Texture, BaseLevel, Filter))
+			return false;
+
+		switch(Texture.format())
+		{
+		case FORMAT_RGBA8_UNORM_PACK8:
+			generate_mipmaps_kernel<mipmap_rgba8_unorm>(Texture, BaseLayer, MaxLayer, BaseFace, MaxFace, BaseLevel, MaxLevel, Filter);
+			break;
+		case FORMAT_RGBA16_SFLOAT_PACK16:
+			generate_mipmaps_kernel<mipmap_rgba16_sfloat>(Texture, BaseLayer, MaxLayer, BaseFace, MaxFace, BaseLevel, MaxLevel, Filter);
+			break;
+		default:
+			generate_mipmaps_kernel<mipmap_rgba32_sfloat>(Texture, BaseLayer, MaxLayer, BaseFace, MaxFace, BaseLevel, MaxLevel, Filter);
+			break;
+		}
+		return true;
+	}
+
+	template <typename codec>
+	inline void generate_mipmaps_kernel_rows(texture& Texture, block_rows const& Job, int ColumnBegin, int ColumnEnd, mipmap_kernel_filter Filter)
+	{
+		if(Filter == MIPMAP_KERNEL_BOX)
+			box_rows<codec>(Texture, Job, ColumnBegin, ColumnEnd);
+		else
+			separable_rows<codec>(Texture, Job, make_mipmap_taps(Filter), ColumnBegin, ColumnEnd);
+	}
+
+	/// Generate the destination columns [ColumnBegin, ColumnEnd) of the rows of Job with the row kernels, has_mipmaps_kernel must be true
+	inline void generate_mipmaps_kernel_rows(texture& Texture, block_rows const& Job, int ColumnBegin, int ColumnEnd, mipmap_kernel_filter Filter)
+	{
+		switch(Texture.format())
+		{
+		case FORMAT_RGBA8_UNORM_PACK8:
+			generate_mipmaps_kernel_rows<mipmap_rgba8_unorm>(Texture, Job, ColumnBegin, ColumnEnd, Filter);
+			break;
+		case FORMAT_RGBA16_SFLOAT_PACK16:
+			generate_mipmaps_kernel_rows<mipmap_rgba16_sfloat>(Texture, Job, ColumnBegin, ColumnEnd, Filter);
+			break;
+		default:
+			GLI_ASSERT(Texture.format() == FORMAT_RGBA32_SFLOAT_PACK32);
+			generate_mipmaps_kernel_rows<mipmap_rgba32_sfloat>(Texture, Job, ColumnBegin, ColumnEnd, Filter);
+			break;
+		}
+	}
+
+	/// Rounded down quotient of a division by a positive Denominator
+	inline int mipmap_floor_div(int Numerator, int Denominator)
+	{
+		return Numerator >= 0 ? Numerator / Denominator : -((Denominator - 1 - Numerator) / Denominator);
+	}
+
+	/// Range of the texels of a destination row of Width texels that read at least one of the texels [First, Last] of the source row of SourceWidth texels,
+	/// with the row kernels of Filter, or with the sampler path when Filter is MIPMAP_KERNEL_NONE.
+	inline glm::ivec2 mipmap_footprint(int First, int Last, int SourceWidth, int Width, mipmap_kernel_filter Filter)
+	{
+		int Begin = 0;
+		int End = 0;
+		if(Filter != MIPMAP_KERNEL_NONE)
+		{
+			// The destination texel x reads the source texels [x * Step + Low, x * Step + High]
+			int const Step = SourceWidth / Width;
+			int Low = 0;
+			int High = 0;
+			if(Step == 2 && Filter == MIPMAP_KERNEL_BOX)
+				High = 1;
+			else if(Step == 2)
+			{
+				mipmap_taps const Taps(make_mipmap_taps(Filter));
+				Low = Taps.Offset[0];
+				High = Taps.Offset[Taps.Count - 1];
+			}
+			Begin = -mipmap_floor_div(High - First, Step);
+			End = mipmap_floor_div(Last - Low, Step);
+		}
+		else if(SourceWidth > 1)
+		{
+			// The destination texel x samples around the source texel x * (SourceWidth - 1) / (Width - 1) and its neighbors,
+			// a texel of margin on each side covers the rounding of the normalized coordinates
+			Begin = mipmap_floor_div((First - 1) * (Width - 1), SourceWidth - 1) - 1;
+			End = -mipmap_floor_div(-(Last + 1) * (Width - 1), SourceWidth - 1) + 1;
+		}
+		return glm::ivec2(glm::max(Begin, 0), glm::min(End, Width - 1));
+	}
+}//namespace detail
+}//namespace gli
@@ -0,0 +1,110 @@
+/// @brief Include to split texture processing work across the hardware threads
+/// @file gli/core/parallel.hpp
+
+#pragma once
+
+#include "../texture.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace gli{
+namespace detail
+{
+	/// Number of threads used by parallel_for, at least 1
+	std::size_t thread_count();
+
+	/// Calls of a parallel_for shared by the threads that help with it
+	struct parallel_batch
+	{
+		std::size_t Count;
+		std::atomic<std::size_t> Next;
+
+		/// Number of pool threads running calls of the batch, guarded by the mutex of the pool
+		std::size_t Helpers;
+
+		void const* Func;
+		void (*Call)(void const* Func, std::size_t Index);
+
+		/// Run calls until none is left
+		void run();
+	};
+
+	/// thread_count() - 1 threads, created on the first parallel_for that needs them and kept until the program exits,
+	/// that help the threads calling parallel_for
+	class parallel_pool
+	{
+	public:
+		static parallel_pool& instance();
+
+		~parallel_pool();
+
+		/// Run the batch from the calling thread and up to Helpers threads of the pool, returns when every call completed
+		void run(parallel_batch& Batch, std::size_t Helpers);
+
+		/// Whether the calling thread is a thread of the pool
+		static bool is_worker();
+
+	private:
+		parallel_pool();
+		parallel_pool(parallel_pool const&) = delete;
+		parallel_pool& operator=(parallel_pool const&) = delete;
+
+		void work();
+
+		std::mutex Mutex;
+		std::condition_variable Wake;
+		std::condition_variable Done;
+		std::deque<parallel_batch*> Batches;
+		std::vector<std::thread> Workers;
+		bool Stop;
+	};
+
+	/// Call Func(Index) for every Index in [0, Count) from up to thread_count() threads, including the calling thread.
+	/// Indices are handed out one at a time so that uneven work items balance across threads.
+	/// The other threads are the threads of a pool created once, not threads created for each call.
+	/// Fewer than MinCount calls, and the calls of a parallel_for nested in another one, run on the calling thread only.
+	/// Returns when every call completed. Func must be safe to call concurrently for different indices.
+	template <typename func>
+	void parallel_for(std::size_t Count, func const& Func, std::size_t MinCount = 4);
+
+	/// A range of block rows of one slice of one image
+	struct block_rows
+	{
+		texture::size_type Layer;
+		texture::size_type Face;
+		texture::size_type Level;
+		int Slice;
+		int BlockRowBegin;
+		int BlockRowEnd;
+	};
+
+	/// Split every slice of every image of Texture into ranges of whole block rows of about BlocksPerJob blocks of the texture format,
+	/// so that small levels don't spawn tiny jobs and large levels spread across every thread
+	std::vector<block_rows> split_block_rows(texture const& Texture, std::size_t BlocksPerJob);
+
+	/// Width, and height for the kernels processing whole tiles, of the texel tiles handed out to the threads by parallel_for_tiles
+	int const TEXEL_TILE_SIZE = 64;
+
+	/// A tile of texels of one of the images passed to parallel_for_tiles
+	struct texel_tile
+	{
+		std::size_t Image;
+		int x;
+		int y;
+		int Width;
+		int Height;
+	};
+
+	/// Call Func(texel_tile) for every tile of TileExtent texels of each image of Extents, in parallel, the tiles on the edges cropped to the images.
+	/// The tile of each call is computed from its index: the work list takes one entry per image, not one per tile.
+	template <typename func>
+	void parallel_for_tiles(std::vector<glm::ivec2> const& Extents, glm::ivec2 const& TileExtent, func const& Func);
+}//namespace detail
+}//namespace gli
+
+#include "./parallel.inl"
@@ -0,0 +1,177 @@
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace gli{
+namespace detail
+{
+	inline std::size_t thread_count()
+	{
+		return std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+	}
+
+	inline void parallel_batch::run()
+	{
+		for(std::size_t Index = this->Next++; Index < this->Count; Index = this->Next++)
+			this->Call(this->Func, Index);
+	}
+
+	inline parallel_pool& parallel_pool::instance()
+	{
+		static parallel_pool Pool;
+		return Pool;
+	}
+
+	inline parallel_pool::parallel_pool()
+		: Stop(false)
+	{
+		for(std::size_t Thread = 1; Thread < thread_count(); ++Thread)
+			this->Workers.push_back(std::thread(&parallel_pool::work, this));
+	}
+
+	inline parallel_pool::~parallel_pool()
+	{
+		{
+			std::lock_guard<std::mutex> Lock(this->Mutex);
+			this->Stop = true;
+		}
+		this->Wake.notify_all();
+
+		for(std::size_t Thread = 0; Thread < this->Workers.size(); ++Thread)
+			this->Workers[Thread].join();
+	}
+
+	inline bool& parallel_worker()
+	{
+		static thread_local bool Worker = false;
+		return Worker;
+	}
+
+	inline bool parallel_pool::is_worker()
+	{
+		return parallel_worker();
+	}
+
+	inline void parallel_pool::run(parallel_batch& Batch, std::size_t Helpers)
+	{
+		Helpers = std::min(Helpers, this->Workers.size());
+		{
+			std::lock_guard<std::mutex> Lock(this->Mutex);
+			this->Batches.insert(this->Batches.end(), Helpers, &Batch);
+		}
+		if(Helpers == 1)
+			this->Wake.notify_one();
+		else if(Helpers > 1)
+			this->Wake.notify_all();
+
+		Batch.run();
+
+		// The calls are all taken: the threads that didn't start helping yet won't, the ones that did finish their last call
+		std::unique_lock<std::mutex> Lock(this->Mutex);
+		this->Batches.erase(std::remove(this->Batches.begin(), this->Batches.end(), &Batch), this->Batches.end());
+		this->Done.wait(Lock, [&Batch]{return Batch.Helpers == 0;});
+	}
+
+	inline void parallel_pool::work()
+	{
+		parallel_worker() = true;
+
+		std::unique_lock<std::mutex> Lock(this->Mutex);
+		for(;;)
+		{
+			this->Wake.wait(Lock, [this]{return this->Stop || !this->Batches.empty();});
+			if(this->Stop)
+				return;
+
+			parallel_batch* Batch = this->Batches.front();
+			this->Batches.pop_front();
+			++Batch->Helpers;
+
+			Lock.unlock();
+			Batch->run();
+			Lock.lock();
+
+			if(--Batch->Helpers == 0)
+				this->Done.notify_all();
+		}
+	}
+
+	template <typename func>
+	inline void parallel_for(std::size_t Count, func const& Func, std::size_t MinCount)
+	{
+		std::size_t const Threads = std::min(thread_count(), Count);
+		if(Threads <= 1 || Count < MinCount || parallel_pool::is_worker())
+		{
+			for(std::size_t Index = 0; Index < Count; ++Index)
+				Func(Index);
+			return;
+		}
+
+		parallel_batch Batch;
+		Batch.Count = Count;
+		Batch.Next = 0;
+		Batch.Helpers = 0;
+		Batch.Func = &Func;
+		Batch.Call = [](void const* Callee, std::size_t Index)
+		{
+			(*static_cast<func const*>(Callee))(Index);
+		};
+
+		parallel_pool::instance().run(Batch, Threads - 1);
+	}
+
+	inline std::vector<block_rows> split_block_rows(texture const& Texture, std::size_t BlocksPerJob)
+	{
+		std::vector<block_rows> Jobs;
+
+		texture::extent_type const BlockExtent(block_extent(Texture.format()));
+		for(texture::size_type Layer = 0; Layer < Texture.layers(); ++Layer)
+		for(texture::size_type Face = 0; Face < Texture.faces(); ++Face)
+		for(texture::size_type Level = 0; Level < Texture.levels(); ++Level)
+		{
+			texture::extent_type const Extent(Texture.extent(Level));
+			texture::extent_type const BlockCount(glm::ceilMultiple(Extent, BlockExtent) / BlockExtent);
+			int const RowsPerJob = glm::max(1, static_cast<int>(BlocksPerJob) / BlockCount.x);
+
+			for(int Slice = 0; Slice < Extent.z; ++Slice)
+			for(int BlockRow = 0; BlockRow < BlockCount.y; BlockRow += RowsPerJob)
+			{
+				block_rows const Job = {Layer, Face, Level, Slice, BlockRow, glm::min(BlockRow + RowsPerJob, BlockCount.y)};
+				Jobs.push_back(Job);
+			}
+		}
+
+		return Jobs;
+	}
+
+	template <typename func>
+	inline void parallel_for_tiles(std::vector<glm::ivec2> const& Extents, glm::ivec2 const& TileExtent, func const& Func)
+	{
+		// Index of the first tile of each image, followed by the number of tiles
+		std::vector<std::size_t> FirstTiles(Extents.size() + 1, 0);
+		for(std::size_t Image = 0; Image < Extents.size(); ++Image)
+		{
+			glm::ivec2 const TileCount((Extents[Image] + TileExtent - 1) / TileExtent);
+			FirstTiles[Image + 1] = FirstTiles[Image] + static_cast<std::size_t>(TileCount.x) * static_cast<std::size_t>(TileCount.y);
+		}
+
+		parallel_for(FirstTiles.back(), [&](std::size_t Index)
+		{
+			// Images without tiles share their first index with the next image: the last match is the image of the tile
+			std::size_t const Image = static_cast<std::size_t>(std::upper_bound(FirstTiles.begin(), FirstTiles.end(), Index) - FirstTiles.begin()) - 1;
+			glm::ivec2 const& Extent = Extents[Image];
+			int const TileCountX = (Extent.x + TileExtent.x - 1) / TileExtent.x;
+			int const Tile = static_cast<int>(Index - FirstTiles[Image]);
+
+			texel_tile Result;
+			Result.Image = Image;
+			Result.x = Tile % TileCountX * TileExtent.x;
+			Result.y = Tile / TileCountX * TileExtent.y;
+			Result.Width = glm::min(TileExtent.x, Extent.x - Result.x);
+			Result.Height = glm::min(TileExtent.y, Extent.y - Result.y);
+			Func(Result);
+		});
+	}
+}//namespace detail
+}//namespace gli
@@ -0,0 +1,380 @@
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+
+namespace gli{
+namespace detail
+{
+	/// Ring of the calling thread for the profiler of identifier Profiler, if any
+	struct profile_thread
+	{
+		std::uint64_t Profiler;
+		profile_ring* Ring;
+	};
+
+	inline profile_thread& current_profile_thread()
+	{
+		static thread_local profile_thread Thread = {0, nullptr};
+		return Thread;
+	}
+
+	/// Profilers are identified by a counter rather than their address, which a later profiler may reuse
+	inline std::uint64_t next_profiler_id()
+	{
+		static std::atomic<std::uint64_t> Id(0);
+		return ++Id;
+	}
+
+	inline std::size_t round_up_power_of_two(std::size_t Value)
+	{
+		std::size_t Result = 1;
+		while(Result < Value)
+			Result <<= 1;
+		return Result;
+	}
+
+	inline profile_ring::profile_ring(std::size_t Capacity, std::uint32_t Thread)
+		: Events(round_up_power_of_two(std::max<std::size_t>(Capacity, 1)))
+		, Mask(Events.size() - 1)
+		, Thread(Thread)
+		, Head(0)
+		, Tail(0)
+		, Dropped(0)
+	{}
+
+	inline bool profile_ring::push(profile_event const& Event)
+	{
+		std::size_t const Write = this->Head.load(std::memory_order_relaxed);
+		if(Write - this->Tail.load(std::memory_order_acquire) == this->Events.size())
+		{
+			this->Dropped.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+
+		this->Events[Write & this->Mask] = Event;
+		this->Head.store(Write + 1, std::memory_order_release);
+		return true;
+	}
+
+	template <typename func>
+	inline void profile_ring::collect(func& Func)
+	{
+		std::size_t const End = this->Head.load(std::memory_order_acquire);
+		std::size_t Read = this->Tail.load(std::memory_order_relaxed);
+		for(; Read != End; ++Read)
+			Func(this->Events[Read & this->Mask]);
+		this->Tail.store(Read, std::memory_order_release);
+	}
+
+	inline profile_window::profile_window(std::size_t Capacity)
+		: Capacity(std::max<std::size_t>(Capacity, 1))
+		, Next(0)
+	{}
+
+	inline void profile_window::push(std::uint64_t Duration)
+	{
+		if(this->Durations.size() < this->Capacity)
+			this->Durations.push_back(Duration);
+		else
+			this->Durations[this->Next] = Duration;
+		this->Next = (this->Next + 1) % this->Capacity;
+	}
+
+	inline profile_statistics profile_window::statistics() const
+	{
+		profile_statistics Statistics;
+		if(this->Durations.empty())
+			return Statistics;
+
+		std::vector<std::uint64_t> Sorted(this->Durations);
+		std::sort(Sorted.begin(), Sorted.end());
+
+		std::uint64_t Sum = 0;
+		for(std::size_t Index = 0; Index < Sorted.size(); ++Index)
+			Sum += Sorted[Index];
+
+		Statistics.Count = Sorted.size();
+		Statistics.Mean = Sum / Sorted.size();
+		Statistics.P50 = Sorted[(Sorted.size() - 1) * 50 / 100];
+		Statistics.P99 = Sorted[(Sorted.size() - 1) * 99 / 100];
+		Statistics.Max = Sorted.back();
+		return Statistics;
+	}
+
+	/// Microseconds with a nanosecond precision, without floating point rounding
+	inline void write_trace_time(std::ostream& Stream, std::uint64_t Time)
+	{
+		Stream << Time / 1000 << '.' << std::setw(3) << std::setfill('0') << Time % 1000 << std::setfill(' ');
+	}
+
+	inline void write_trace_string(std::ostream& Stream, char const* String)
+	{
+		Stream << '"';
+		for(; *String; ++String)
+		{
+			if(*String == '"' || *String == '\\')
+				Stream << '\\' << *String;
+			else if(static_cast<unsigned char>(*String) < 0x20)
+				Stream << ' ';
+			else
+				Stream << *String;
+		}
+		Stream << '"';
+	}
+}//namespace detail
+
+	inline std::uint64_t cpu_gpu_timer::now()
+	{
+		return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+	}
+
+	inline std::uint64_t cpu_gpu_timer::timestamp()
+	{
+		return this->now();
+	}
+
+	inline bool cpu_gpu_timer::resolve(std::uint64_t Timestamp, std::uint64_t& Time)
+	{
+		Time = Timestamp;
+		return true;
+	}
+
+	inline profiler::profiler(gpu_timer* Timer, std::size_t RingCapacity, std::size_t TraceCapacity, std::size_t Window)
+		: Id(detail::next_profiler_id())
+		, Start(std::chrono::steady_clock::now())
+		, Timer(Timer)
+		, RingCapacity(RingCapacity)
+		, TraceCapacity(TraceCapacity)
+		, Window(Window)
+		, Enabled(true)
+		, GpuScopesResolved(0)
+		, GpuOffset(0)
+		, GpuCalibrated(false)
+		, FrameBegin(std::numeric_limits<std::uint64_t>::max())
+		, GpuDropped(0)
+		, Frames(Window)
+	{}
+
+	inline void profiler::enable(bool Enabled)
+	{
+		this->Enabled.store(Enabled, std::memory_order_relaxed);
+	}
+
+	inline bool profiler::enabled() const
+	{
+		return this->Enabled.load(std::memory_order_relaxed);
+	}
+
+	inline std::uint64_t profiler::now() const
+	{
+		return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - this->Start).count());
+	}
+
+	inline detail::profile_ring& profiler::ring()
+	{
+		detail::profile_thread& Thread = detail::current_profile_thread();
+		if(Thread.Profiler == this->Id)
+			return *Thread.Ring;
+
+		std::lock_guard<std::mutex> Lock(this->Mutex);
+		std::unique_ptr<detail::profile_ring>& Ring = this->Rings[std::this_thread::get_id()];
+		if(!Ring)
+			Ring.reset(new detail::profile_ring(this->RingCapacity, static_cast<std::uint32_t>(this->Rings.size())));
+
+		Thread.Profiler = this->Id;
+		Thread.Ring = Ring.get();
+		return *Ring;
+	}
+
+	inline void profiler::record(char const* Name, std::uint64_t Begin, std::uint64_t End)
+	{
+		detail::profile_ring& Ring = this->ring();
+		profile_event const Event = {Name, Begin, End, Ring.Thread};
+		Ring.push(Event);
+	}
+
+	inline std::size_t profiler::begin_gpu(char const* Name)
+	{
+		if(!this->Timer || !this->enabled())
+			return std::numeric_limits<std::size_t>::max();
+
+		if(!this->GpuCalibrated)
+		{
+			this->GpuOffset = static_cast<std::int64_t>(this->now()) - static_cast<std::int64_t>(this->Timer->now());
+			this->GpuCalibrated = true;
+		}
+
+		// Timestamps the backend never resolves don't pile up
+		if(this->GpuScopes.size() >= this->RingCapacity)
+		{
+			this->GpuScopes.pop_front();
+			++this->GpuScopesResolved;
+			++this->GpuDropped;
+		}
+
+		gpu_scope const Scope = {Name, this->Timer->timestamp(), 0, 0, false, false};
+		this->GpuScopes.push_back(Scope);
+		return this->GpuScopesResolved + this->GpuScopes.size() - 1;
+	}
+
+	inline void profiler::end_gpu(std::size_t Handle)
+	{
+		if(Handle < this->GpuScopesResolved || Handle - this->GpuScopesResolved >= this->GpuScopes.size())
+			return;
+
+		gpu_scope& Scope = this->GpuScopes[Handle - this->GpuScopesResolved];
+		Scope.End = this->Timer->timestamp();
+		Scope.Ended = true;
+	}
+
+	inline void profiler::collect(profile_event const& Event)
+	{
+		this->Trace.push_back(Event);
+		if(this->Trace.size() > this->TraceCapacity)
+			this->Trace.pop_front();
+
+		std::pair<std::string, bool> const Key(Event.Name, Event.Thread == 0);
+		std::map<std::pair<std::string, bool>, detail::profile_window>::iterator It = this->Scopes.find(Key);
+		if(It == this->Scopes.end())
+			It = this->Scopes.insert(std::make_pair(Key, detail::profile_window(this->Window))).first;
+		It->second.push(Event.End - Event.Begin);
+	}
+
+	inline void profiler::end_frame()
+	{
+		std::uint64_t const Now = this->now();
+
+		{
+			std::lock_guard<std::mutex> Lock(this->Mutex);
+			for(std::map<std::thread::id, std::unique_ptr<detail::profile_ring>>::iterator It = this->Rings.begin(); It != this->Rings.end(); ++It)
+			{
+				auto Collect = [this](profile_event const& Event){this->collect(Event);};
+				It->second->collect(Collect);
+			}
+		}
+
+		// GPU scopes complete in submission order, a few frames late
+		while(!this->GpuScopes.empty() && this->GpuScopes.front().Ended)
+		{
+			gpu_scope& Scope = this->GpuScopes.front();
+			if(!Scope.BeginResolved)
+			{
+				if(!this->Timer->resolve(Scope.Begin, Scope.BeginTime))
+					break;
+				Scope.BeginResolved = true;
+			}
+
+			std::uint64_t EndTime = 0;
+			if(!this->Timer->resolve(Scope.End, EndTime))
+				break;
+
+			std::int64_t const Begin = static_cast<std::int64_t>(Scope.BeginTime) + this->GpuOffset;
+			std::int64_t const End = static_cast<std::int64_t>(EndTime) + this->GpuOffset;
+			profile_event const Event = {Scope.Name, static_cast<std::uint64_t>(std::max<std::int64_t>(Begin, 0)), static_cast<std::uint64_t>(std::max<std::int64_t>(End, Begin)), 0};
+			this->collect(Event);
+
+			this->GpuScopes.pop_front();
+			++this->GpuScopesResolved;
+		}
+
+		if(this->enabled() && this->FrameBegin != std::numeric_limits<std::uint64_t>::max())
+		{
+			profile_event const Frame = {"Frame", this->FrameBegin, Now, this->ring().Thread};
+			this->Frames.push(Now - this->FrameBegin);
+			this->collect(Frame);
+		}
+		this->FrameBegin = Now;
+	}
+
+	inline profile_statistics profiler::frame_statistics() const
+	{
+		return this->Frames.statistics();
+	}
+
+	inline profile_statistics profiler::scope_statistics(std::string const& Name, bool Gpu) const
+	{
+		std::map<std::pair<std::string, bool>, detail::profile_window>::const_iterator It = this->Scopes.find(std::make_pair(Name, Gpu));
+		return It == this->Scopes.end() ? profile_statistics() : It->second.statistics();
+	}
+
+	inline std::vector<profile_event> profiler::events() const
+	{
+		return std::vector<profile_event>(this->Trace.begin(), this->Trace.end());
+	}
+
+	inline std::size_t profiler::dropped() const
+	{
+		std::lock_guard<std::mutex> Lock(this->Mutex);
+
+		std::size_t Dropped = this->GpuDropped;
+		for(std::map<std::thread::id, std::unique_ptr<detail::profile_ring>>::const_iterator It = this->Rings.begin(); It != this->Rings.end(); ++It)
+			Dropped += It->second->Dropped.load(std::memory_order_relaxed);
+		return Dropped;
+	}
+
+	inline void profiler::write_chrome_trace(std::ostream& Stream) const
+	{
+		Stream << "{\"traceEvents\":[\n";
+		Stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"GPU\"}}";
+
+		std::uint32_t Threads = 0;
+		{
+			std::lock_guard<std::mutex> Lock(this->Mutex);
+			Threads = static_cast<std::uint32_t>(this->Rings.size());
+		}
+		for(std::uint32_t Thread = 1; Thread <= Threads; ++Thread)
+			Stream << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << Thread << ",\"args\":{\"name\":\"Thread " << Thread << "\"}}";
+
+		for(std::deque<profile_event>::const_iterator It = this->Trace.begin(); It != this->Trace.end(); ++It)
+		{
+			Stream << ",\n{\"name\":";
+			detail::write_trace_string(Stream, It->Name);
+			Stream << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << It->Thread << ",\"ts\":";
+			detail::write_trace_time(Stream, It->Begin);
+			Stream << ",\"dur\":";
+			detail::write_trace_time(Stream, It->End - It->Begin);
+			Stream << "}";
+		}
+
+		Stream << "\n],\"displayTimeUnit\":\"ns\"}\n";
+	}
+
+	inline bool profiler::write_chrome_trace(char const* Path) const
+	{
+		std::ofstream File(Path);
+		if(!File)
+			return false;
+
+		this->write_chrome_trace(File);
+		return static_cast<bool>(File);
+	}
+
+	inline profile_scope::profile_scope(profiler& Profiler, char const* Name)
+		: Profiler(Profiler)
+		, Name(Name)
+		, Begin(0)
+		, Enabled(Profiler.enabled())
+	{
+		if(this->Enabled)
+			this->Begin = Profiler.now();
+	}
+
+	inline profile_scope::~profile_scope()
+	{
+		if(this->Enabled)
+			this->Profiler.record(this->Name, this->Begin, this->Profiler.now());
+	}
+
+	inline gpu_profile_scope::gpu_profile_scope(profiler& Profiler, char const* Name)
+		: Profiler(Profiler)
+		, Handle(Profiler.begin_gpu(Name))
+		, Enabled(Profiler.enabled())
+	{}
+
+	inline gpu_profile_scope::~gpu_profile_scope()
+	{
+		if(this->Enabled)
+			this->Profiler.end_gpu(this->Handle);
+	}
+}//namespace gli
@@ -0,0 +1,238 @@
+#include "../load_dds.hpp"
+#include "../load_ktx.hpp"
+#include "file.hpp"
+#include "container.hpp"
+#include <cstring>
+
+namespace gli
+{
+	inline reader::reader()
+		: Target(TARGET_2D)
+		, Format(FORMAT_UNDEFINED)
+		, Extent(0)
+		, Layers(0)
+		, Faces(0)
+		, Levels(0)
+	{}
+
+	inline reader::reader(char const* Filename)
+		: reader()
+	{
+		this->open(Filename);
+	}
+
+	inline reader::reader(std::string const& Filename)
+		: reader()
+	{
+		this->open(Filename.c_str());
+	}
+
+	inline bool reader::open(char const* Filename)
+	{
+		this->close();
+
+		std::shared_ptr<FILE> File(detail::open_file(Filename, "rb"), [](FILE* File){ if(File) std::fclose(File); });
+		if(!File)
+			return false;
+
+		std::int64_t const FileSize = detail::file_size(File.get());
+		if(FileSize <= 0)
+			return false;
+
+		// Large enough for the biggest DDS header, KTX headers are smaller
+		char Header[sizeof(detail::FOURCC_DDS) + sizeof(detail::dds_header) + sizeof(detail::dds_header10)];
+		std::size_t const HeaderSize = std::fread(Header, 1, std::min(sizeof(Header), static_cast<std::size_t>(FileSize)), File.get());
+
+		detail::container_desc Desc;
+		bool const IsDDS = detail::parse_dds(Header, HeaderSize, Desc);
+		if(!IsDDS && !detail::parse_ktx10(Header, HeaderSize, Desc))
+			return false;
+
+		// Reject the headers without images or with more levels than the extent has before indexing the images
+		if(glm::any(glm::equal(Desc.Extent, extent_type(0))) || Desc.Layers == 0 || Desc.Faces == 0 || Desc.Levels == 0)
+			return false;
+		if(Desc.Levels > static_cast<size_type>(gli::levels(Desc.Extent)))
+			return false;
+
+		extent_type const BlockExtent = block_extent(Desc.Format);
+		size_type const BlockSize = block_size(Desc.Format);
+		size_type const ImageCount = Desc.Layers * Desc.Faces * Desc.Levels;
+
+		std::vector<size_type> Sizes(Desc.Levels);
+		for(size_type Level = 0; Level < Desc.Levels; ++Level)
+		{
+			extent_type const LevelExtent = glm::max(Desc.Extent >> extent_type(static_cast<extent_type::value_type>(Level)), extent_type(1));
+			Sizes[Level] = BlockSize * glm::compMul(glm::ceilMultiple(LevelExtent, BlockExtent) / BlockExtent);
+		}
+
+		// DDS stores the images layer by layer, face by face then level by level, like storage_linear.
+		// KTX stores them level by level, each level prefixed by its size and each image padded to 4 bytes.
+		std::vector<size_type> Offsets(ImageCount);
+		size_type Offset = Desc.Offset;
+		if(IsDDS)
+		{
+			for(size_type Layer = 0; Layer < Desc.Layers; ++Layer)
+			for(size_type Face = 0; Face < Desc.Faces; ++Face)
+			for(size_type Level = 0; Level < Desc.Levels; ++Level)
+			{
+				Offsets[(Layer * Desc.Faces + Face) * Desc.Levels + Level] = Offset;
+				Offset += Sizes[Level];
+			}
+		}
+		else
+		{
+			for(size_type Level = 0; Level < Desc.Levels; ++Level)
+			{
+				Offset += sizeof(std::uint32_t);
+
+				for(size_type Layer = 0; Layer < Desc.Layers; ++Layer)
+				for(size_type Face = 0; Face < Desc.Faces; ++Face)
+				{
+					Offsets[(Layer * Desc.Faces + Face) * Desc.Levels + Level] = Offset;
+					Offset += detail::ktx_image_stride(Desc.Format, Sizes[Level]);
+				}
+			}
+		}
+
+		// Reject truncated files now rather than failing in the middle of streaming
+		std::size_t const LastImage = ImageCount - 1;
+		if(Offsets[LastImage] + Sizes[LastImage % Desc.Levels] > static_cast<size_type>(FileSize))
+			return false;
+
+		this->File = File;
+		this->Target = Desc.Target;
+		this->Format = Desc.Format;
+		this->Extent = Desc.Extent;
+		this->Layers = Desc.Layers;
+		this->Faces = Desc.Faces;
+		this->Levels = Desc.Levels;
+		this->Sizes.swap(Sizes);
+		this->Offsets.swap(Offsets);
+
+		return true;
+	}
+
+	inline void reader::close()
+	{
+		*this = reader();
+	}
+
+	inline bool reader::empty() const
+	{
+		return this->File == nullptr;
+	}
+
+	inline reader::target_type reader::target() const
+	{
+		return this->Target;
+	}
+
+	inline reader::format_type reader::format() const
+	{
+		return this->Format;
+	}
+
+	inline reader::extent_type reader::extent(size_type Level) const
+	{
+		GLI_ASSERT(Level < this->Levels);
+
+		return glm::max(this->Extent >> extent_type(static_cast<extent_type::value_type>(Level)), extent_type(1));
+	}
+
+	inline reader::size_type reader::layers() const
+	{
+		return this->Layers;
+	}
+
+	inline reader::size_type reader::faces() const
+	{
+		return this->Faces;
+	}
+
+	inline reader::size_type reader::levels() const
+	{
+		return this->Levels;
+	}
+
+	inline reader::size_type reader::size(size_type Level) const
+	{
+		GLI_ASSERT(Level < this->Levels);
+
+		return this->Sizes[Level];
+	}
+
+	inline reader::size_type reader::image_index(size_type Layer, size_type Face, size_type Level) const
+	{
+		GLI_ASSERT(Layer < this->Layers && Face < this->Faces && Level < this->Levels);
+
+		return (Layer * this->Faces + Face) * this->Levels + Level;
+	}
+
+	inline reader::size_type reader::offset(size_type Layer, size_type Face, size_type Level) const
+	{
+		return this->Offsets[this->image_index(Layer, Face, Level)];
+	}
+
+	inline texture reader::create_texture() const
+	{
+		GLI_ASSERT(!this->empty());
+
+		return texture(this->Target, this->Format, this->Extent, this->Layers, this->Faces, this->Levels);
+	}
+
+	inline bool reader::read(size_type Layer, size_type Face, size_type Level, void* Data)
+	{
+		GLI_ASSERT(!this->empty() && Data);
+
+		if(!detail::seek_file(this->File.get(), this->offset(Layer, Face, Level)))
+			return false;
+
+		return std::fread(Data, 1, this->Sizes[Level], this->File.get()) == this->Sizes[Level];
+	}
+
+	inline bool reader::read(size_type Layer, size_type Face, size_type Level, extent_type const& Offset, extent_type const& Extent, void* Data)
+	{
+		GLI_ASSERT(!this->empty() && Data);
+		GLI_ASSERT(glm::all(glm::lessThanEqual(Offset + Extent, this->extent(Level))));
+
+		extent_type const BlockExtent = block_extent(this->Format);
+		size_type const BlockSize = block_size(this->Format);
+		extent_type const ImageBlocks = glm::ceilMultiple(this->extent(Level), BlockExtent) / BlockExtent;
+		extent_type const Begin = Offset / BlockExtent;
+		extent_type const End = glm::ceilMultiple(Offset + Extent, BlockExtent) / BlockExtent;
+		size_type const RowSize = static_cast<size_type>(End.x - Begin.x) * BlockSize;
+
+		size_type const ImageOffset = this->offset(Layer, Face, Level);
+		size_type Position = 0;
+		char* Destination = static_cast<char*>(Data);
+		for(extent_type::value_type z = Begin.z; z < End.z; ++z)
+		for(extent_type::value_type y = Begin.y; y < End.y; ++y)
+		{
+			size_type const RowOffset = ImageOffset + ((static_cast<size_type>(z) * ImageBlocks.y + y) * ImageBlocks.x + Begin.x) * BlockSize;
+			if(RowOffset != Position && !detail::seek_file(this->File.get(), RowOffset))
+				return false;
+			if(std::fread(Destination, 1, RowSize, this->File.get()) != RowSize)
+				return false;
+
+			Position = RowOffset + RowSize;
+			Destination += RowSize;
+		}
+
+		return true;
+	}
+
+	inline bool reader::read(size_type Level, texture& Texture)
+	{
+		GLI_ASSERT(!Texture.empty());
+		GLI_ASSERT(Texture.format() == this->Format && Texture.layers() == this->Layers && Texture.faces() == this->Faces && Texture.levels() == this->Levels);
+
+		for(size_type Layer = 0; Layer < this->Layers; ++Layer)
+		for(size_type Face = 0; Face < this->Faces; ++Face)
+		{
+			if(!this->read(Layer, Face, Level, Texture.data(Layer, Face, Level)))
+				return false;
+		}
+
+		return true;
+	}
+}//namespace gli
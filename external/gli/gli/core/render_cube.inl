@@ -0,0 +1,239 @@
+#include "../convert.hpp"
+#include "../decompress.hpp"
+#include "../sampler_cube_batch.hpp"
+#include "./convert_kernel.hpp"
+#include "./parallel.hpp"
+#include "./simd.hpp"
+#include <glm/gtc/color_space.hpp>
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace gli{
+namespace detail
+{
+	/// sRGB encoding of linear values quantized to 12 bits
+	inline glm::uint8 const* linear_to_srgb_table()
+	{
+		struct table
+		{
+			table()
+			{
+				for(int Value = 0; Value < 4096; ++Value)
+					Values[Value] = static_cast<glm::uint8>(convertLinearToSRGB(vec3(static_cast<float>(Value) / 4095.0f)).x * 255.0f + 0.5f);
+			}
+
+			glm::uint8 Values[4096];
+		};
+
+		static table const Table;
+		return Table.Values;
+	}
+
+	/// Write a row of RGBA texels in FORMAT_RGBA8_UNORM_PACK8, FORMAT_RGBA8_SRGB_PACK8, FORMAT_RGBA16_SFLOAT_PACK16 or FORMAT_RGBA32_SFLOAT_PACK32
+	inline void write_rgba_row(vec4 const* Texels, std::size_t Count, format Format, glm::uint8* Destination)
+	{
+		switch(Format)
+		{
+		case FORMAT_RGBA32_SFLOAT_PACK32:
+			std::memcpy(Destination, Texels, Count * sizeof(vec4));
+			break;
+		case FORMAT_RGBA16_SFLOAT_PACK16:
+		{
+			convert_row_kernel Kernel;
+			Kernel.Arch = widest_cpu_arch();
+			Kernel.Components = 4;
+			convert_float_to_half_row(Kernel, reinterpret_cast<glm::uint8 const*>(Texels), Destination, Count);
+			break;
+		}
+		case FORMAT_RGBA8_SRGB_PACK8:
+		{
+			glm::uint8 const* const Table = linear_to_srgb_table();
+			for(std::size_t Index = 0; Index < Count; ++Index, Destination += 4)
+			{
+				float Values[4];
+				lane_round(lane_min(lane_max(load(Texels[Index]), simd_vec4(0.0f)), simd_vec4(1.0f)) * simd_vec4(4095.0f)).store(Values);
+				Destination[0] = Table[static_cast<int>(Values[0])];
+				Destination[1] = Table[static_cast<int>(Values[1])];
+				Destination[2] = Table[static_cast<int>(Values[2])];
+				Destination[3] = static_cast<glm::uint8>(glm::clamp(Texels[Index].w, 0.0f, 1.0f) * 255.0f + 0.5f);
+			}
+			break;
+		}
+		default:
+			for(std::size_t Index = 0; Index < Count; ++Index, Destination += 4)
+			{
+				float Values[4];
+				lane_round(lane_min(lane_max(load(Texels[Index]), simd_vec4(0.0f)), simd_vec4(1.0f)) * simd_vec4(255.0f)).store(Values);
+				for(int Component = 0; Component < 4; ++Component)
+					Destination[Component] = static_cast<glm::uint8>(Values[Component]);
+			}
+			break;
+		}
+	}
+
+	/// View ray directions of the pixel centers of a framebuffer row, four pixels at once.
+	/// The clip space position of the far plane under the pixels, InverseViewProjection * (x, y, 1, 1), is linear along the row.
+	inline void render_cube_rays(mat4 const& InverseViewProjection, ivec2 const& Extent, int x, int y, int Count, float* X, float* Y, float* Z)
+	{
+		float const ClipY = 1.0f - (static_cast<float>(y) + 0.5f) * 2.0f / static_cast<float>(Extent.y);
+		vec4 const Row(InverseViewProjection[1] * ClipY + InverseViewProjection[2] + InverseViewProjection[3]);
+		vec4 const& Step = InverseViewProjection[0];
+		float const PixelScale = 2.0f / static_cast<float>(Extent.x);
+
+		for(int Pixel = 0; Pixel < Count; Pixel += 4)
+		{
+			float const PixelX = static_cast<float>(x + Pixel);
+			simd_vec4 const ClipX(simd_vec4(PixelX + 0.5f, PixelX + 1.5f, PixelX + 2.5f, PixelX + 3.5f) * simd_vec4(PixelScale) - simd_vec4(1.0f));
+			simd_vec4 const InvW(simd_vec4(1.0f) / (simd_vec4(Row.w) + simd_vec4(Step.w) * ClipX));
+
+			((simd_vec4(Row.x) + simd_vec4(Step.x) * ClipX) * InvW).store(X + Pixel);
+			((simd_vec4(Row.y) + simd_vec4(Step.y) * ClipX) * InvW).store(Y + Pixel);
+			((simd_vec4(Row.z) + simd_vec4(Step.z) * ClipX) * InvW).store(Z + Pixel);
+		}
+	}
+
+	/// Differences of the directions of neighboring pixels, four pixels at once
+	inline void render_cube_derivatives(float const* A, float const* B, int Count, float* Derivatives)
+	{
+		for(int Pixel = 0; Pixel < Count; Pixel += 4)
+			(simd_vec4::load(B + Pixel) - simd_vec4::load(A + Pixel)).store(Derivatives + Pixel);
+	}
+
+	template <format TextureFormat>
+	inline void render_cube_tiles(texture_cube const& Texture, mat4 const& InverseViewProjection, texture2d& Framebuffer)
+	{
+		sampler_cube_batch<TextureFormat> const Sampler(Texture, FILTER_LINEAR, FILTER_LINEAR, true);
+
+		ivec2 const Extent(Framebuffer.extent());
+		std::size_t const PixelSize = block_size(Framebuffer.format());
+
+		// Rays of the tile rows, one pixel past the tile for the horizontal derivatives and rounded up to four pixels
+		int const RowSize = TEXEL_TILE_SIZE + 4;
+
+		std::vector<ivec2> const Images(1, Extent);
+		parallel_for_tiles(Images, ivec2(TEXEL_TILE_SIZE), [&](texel_tile const& Tile)
+		{
+			int const TileX = Tile.x;
+			int const TileY = Tile.y;
+			int const Width = Tile.Width;
+			int const Height = Tile.Height;
+
+			std::vector<float> Rays(RowSize * 3 * 2);
+			std::vector<float> Derivatives(RowSize * 3 * 2);
+			std::vector<vec4> Texels(static_cast<std::size_t>(Width));
+
+			float* Current = &Rays[0];
+			float* Next = &Rays[RowSize * 3];
+			float* const DerivativesX = &Derivatives[0];
+			float* const DerivativesY = &Derivatives[RowSize * 3];
+
+			render_cube_rays(InverseViewProjection, Extent, TileX, TileY, Width + 1, Current, Current + RowSize, Current + RowSize * 2);
+			for(int y = TileY; y < TileY + Height; ++y)
+			{
+				render_cube_rays(InverseViewProjection, Extent, TileX, y + 1, Width + 1, Next, Next + RowSize, Next + RowSize * 2);
+				for(int Axis = 0; Axis < 3; ++Axis)
+				{
+					render_cube_derivatives(Current + RowSize * Axis, Current + RowSize * Axis + 1, Width, DerivativesX + RowSize * Axis);
+					render_cube_derivatives(Current + RowSize * Axis, Next + RowSize * Axis, Width, DerivativesY + RowSize * Axis);
+				}
+
+				cube_directions const Directions = {Current, Current + RowSize, Current + RowSize * 2, static_cast<std::size_t>(Width)};
+				cube_directions const DirectionsDx = {DerivativesX, DerivativesX + RowSize, DerivativesX + RowSize * 2, static_cast<std::size_t>(Width)};
+				cube_directions const DirectionsDy = {DerivativesY, DerivativesY + RowSize, DerivativesY + RowSize * 2, static_cast<std::size_t>(Width)};
+				Sampler.texture_grad(Directions, DirectionsDx, DirectionsDy, &Texels[0]);
+
+				glm::uint8* const Destination = Framebuffer.data<glm::uint8>() + (static_cast<std::size_t>(y) * Extent.x + TileX) * PixelSize;
+				write_rgba_row(&Texels[0], Texels.size(), Framebuffer.format(), Destination);
+
+				std::swap(Current, Next);
+			}
+		});
+	}
+
+	/// Texture itself when sampler_cube_batch supports its format, otherwise a copy converted or decompressed to a supported format.
+	/// Returns an empty texture for the compressed formats that can't be decompressed.
+	inline texture_cube make_cube_batch_texture(texture_cube const& Texture)
+	{
+		switch(Texture.format())
+		{
+		case FORMAT_RGBA8_UNORM_PACK8:
+		case FORMAT_RGBA8_SRGB_PACK8:
+		case FORMAT_RGBA16_SFLOAT_PACK16:
+		case FORMAT_RGBA32_SFLOAT_PACK32:
+		case FORMAT_RG11B10_UFLOAT_PACK32:
+		case FORMAT_RGB9E5_UFLOAT_PACK32:
+			return Texture;
+		default:
+			break;
+		}
+
+		format const Sampled = is_srgb(Texture.format()) ? FORMAT_RGBA8_SRGB_PACK8 : FORMAT_RGBA8_UNORM_PACK8;
+		if(is_compressed(Texture.format()))
+			return is_decompressible(Texture.format(), Sampled) ? gli::decompress(Texture, Sampled) : texture_cube();
+		return gli::convert(Texture, is_srgb(Texture.format()) ? Sampled : FORMAT_RGBA32_SFLOAT_PACK32);
+	}
+
+	/// Call Func.template call<Format>() with the format of a texture returned by make_cube_batch_texture
+	template <typename func>
+	inline void dispatch_cube_batch(format Format, func& Func)
+	{
+		switch(Format)
+		{
+		case FORMAT_RGBA8_UNORM_PACK8:
+			Func.template call<FORMAT_RGBA8_UNORM_PACK8>();
+			break;
+		case FORMAT_RGBA8_SRGB_PACK8:
+			Func.template call<FORMAT_RGBA8_SRGB_PACK8>();
+			break;
+		case FORMAT_RGBA16_SFLOAT_PACK16:
+			Func.template call<FORMAT_RGBA16_SFLOAT_PACK16>();
+			break;
+		case FORMAT_RGBA32_SFLOAT_PACK32:
+			Func.template call<FORMAT_RGBA32_SFLOAT_PACK32>();
+			break;
+		case FORMAT_RG11B10_UFLOAT_PACK32:
+			Func.template call<FORMAT_RG11B10_UFLOAT_PACK32>();
+			break;
+		case FORMAT_RGB9E5_UFLOAT_PACK32:
+			Func.template call<FORMAT_RGB9E5_UFLOAT_PACK32>();
+			break;
+		default:
+			GLI_ASSERT(0);
+			break;
+		}
+	}
+
+	struct render_cube_func
+	{
+		texture_cube const& Texture;
+		mat4 const& InverseViewProjection;
+		texture2d& Framebuffer;
+
+		template <format TextureFormat>
+		void call()
+		{
+			render_cube_tiles<TextureFormat>(this->Texture, this->InverseViewProjection, this->Framebuffer);
+		}
+	};
+}//namespace detail
+
+	inline texture2d render_cube(texture_cube const& Texture, mat4 const& InverseViewProjection, texture2d::extent_type const& Extent, format Format)
+	{
+		GLI_ASSERT(!Texture.empty() && Texture.faces() == 6);
+		GLI_ASSERT(Extent.x > 0 && Extent.y > 0);
+
+		if(Format != FORMAT_RGBA8_UNORM_PACK8 && Format != FORMAT_RGBA8_SRGB_PACK8 && Format != FORMAT_RGBA16_SFLOAT_PACK16 && Format != FORMAT_RGBA32_SFLOAT_PACK32)
+			return texture2d();
+
+		texture_cube const Sampled(detail::make_cube_batch_texture(Texture));
+		if(Sampled.empty())
+			return texture2d();
+
+		texture2d Framebuffer(Format, Extent, 1);
+		detail::render_cube_func Func = {Sampled, InverseViewProjection, Framebuffer};
+		detail::dispatch_cube_batch(Sampled.format(), Func);
+
+		return Framebuffer;
+	}
+}//namespace gli
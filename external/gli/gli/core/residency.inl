@@ -0,0 +1,301 @@
+#include <algorithm>
+
+namespace gli{
+namespace detail
+{
+	/// Bytes of the levels [BaseLevel, Texture.levels()) of all the layers and faces of a texture
+	inline std::uint64_t levels_size(texture const& Texture, texture::size_type BaseLevel)
+	{
+		std::uint64_t Size = 0;
+		for(texture::size_type Level = BaseLevel; Level < Texture.levels(); ++Level)
+			Size += static_cast<std::uint64_t>(Texture.size(Level)) * Texture.layers() * Texture.faces();
+		return Size;
+	}
+}//namespace detail
+
+	inline simulated_residency_backend::simulated_residency_backend(std::uint64_t Capacity)
+		: Capacity(Capacity)
+		, Used(0)
+		, Uploads(0)
+	{}
+
+	inline bool simulated_residency_backend::resident(std::size_t Id, texture const& Texture, size_type BaseLevel, size_type PreviousBaseLevel)
+	{
+		GLI_ASSERT(BaseLevel <= Texture.levels() && PreviousBaseLevel <= Texture.levels());
+
+		if(Id >= this->BaseLevels.size())
+			this->BaseLevels.resize(Id + 1, std::numeric_limits<size_type>::max());
+		GLI_ASSERT(this->BaseLevels[Id] == (PreviousBaseLevel == Texture.levels() ? std::numeric_limits<size_type>::max() : PreviousBaseLevel));
+
+		std::uint64_t const Previous = detail::levels_size(Texture, PreviousBaseLevel);
+		std::uint64_t const Next = detail::levels_size(Texture, BaseLevel);
+		if(Next > Previous && this->Used - Previous + Next > this->Capacity)
+			return false;
+
+		this->Used = this->Used - Previous + Next;
+		this->Uploads += BaseLevel < PreviousBaseLevel ? PreviousBaseLevel - BaseLevel : 0;
+		this->BaseLevels[Id] = BaseLevel == Texture.levels() ? std::numeric_limits<size_type>::max() : BaseLevel;
+		return true;
+	}
+
+	inline std::uint64_t simulated_residency_backend::capacity() const
+	{
+		return this->Capacity;
+	}
+
+	inline std::uint64_t simulated_residency_backend::used() const
+	{
+		return this->Used;
+	}
+
+	inline std::size_t simulated_residency_backend::uploads() const
+	{
+		return this->Uploads;
+	}
+
+	inline bool simulated_residency_backend::is_resident(std::size_t Id, size_type Level) const
+	{
+		return Id < this->BaseLevels.size() && Level >= this->BaseLevels[Id];
+	}
+
+	inline residency_manager::residency_manager(residency_backend& Backend, std::uint64_t Budget)
+		: Backend(Backend)
+		, Budget(Budget)
+		, Frame(1)
+		, Resident(0)
+		, Loads(0)
+		, Evictions(0)
+		, Misses(0)
+	{}
+
+	inline residency_manager::~residency_manager()
+	{
+		for(id_type Id = 0; Id < this->Entries.size(); ++Id)
+			if(this->valid(Id))
+				this->erase(Id);
+	}
+
+	inline residency_manager::id_type residency_manager::insert(texture const& Texture, float Priority)
+	{
+		GLI_ASSERT(!Texture.empty());
+
+		entry Entry;
+		Entry.Texture = Texture;
+		Entry.Priority = Priority;
+		Entry.LastUse = 0;
+		Entry.Wanted = Texture.levels() - 1;
+		Entry.BaseLevel = Texture.levels();
+		for(size_type Level = 0; Level < Texture.levels(); ++Level)
+			Entry.LevelSizes.push_back(static_cast<std::uint64_t>(Texture.size(Level)) * Texture.layers() * Texture.faces());
+
+		if(this->FreeIds.empty())
+		{
+			this->Entries.push_back(Entry);
+			return this->Entries.size() - 1;
+		}
+
+		id_type const Id = this->FreeIds.back();
+		this->FreeIds.pop_back();
+		this->Entries[Id] = Entry;
+		return Id;
+	}
+
+	inline void residency_manager::erase(id_type Id)
+	{
+		GLI_ASSERT(this->valid(Id));
+
+		bool const Released = this->resident(Id, this->Entries[Id].Texture.levels());
+		GLI_ASSERT(Released);
+		(void)Released;
+
+		// An empty texture marks the identifier free
+		entry& Entry = this->Entries[Id];
+		Entry.Texture = texture();
+		Entry.LevelSizes.clear();
+		Entry.Priority = 0.0f;
+		Entry.LastUse = 0;
+		Entry.Wanted = 0;
+		Entry.BaseLevel = 0;
+		this->FreeIds.push_back(Id);
+	}
+
+	inline void residency_manager::priority(id_type Id, float Priority)
+	{
+		GLI_ASSERT(this->valid(Id));
+
+		this->Entries[Id].Priority = Priority;
+	}
+
+	inline residency_manager::size_type residency_manager::request(id_type Id, size_type Level)
+	{
+		GLI_ASSERT(this->valid(Id) && Level < this->Entries[Id].Texture.levels());
+
+		// The finest level requested in the frame
+		entry& Entry = this->Entries[Id];
+		Entry.Wanted = Entry.LastUse == this->Frame ? std::min(Entry.Wanted, Level) : Level;
+		Entry.LastUse = this->Frame;
+
+		if(Level < Entry.BaseLevel)
+			++this->Misses;
+		return Entry.BaseLevel;
+	}
+
+	inline void residency_manager::update(std::uint64_t LoadBudget)
+	{
+		// The textures requested the most recently first, then the ones of the highest priority
+		std::vector<id_type> Order;
+		for(id_type Id = 0; Id < this->Entries.size(); ++Id)
+			if(this->valid(Id))
+				Order.push_back(Id);
+		std::sort(Order.begin(), Order.end(), [this](id_type A, id_type B)
+		{
+			entry const& EntryA = this->Entries[A];
+			entry const& EntryB = this->Entries[B];
+			if(EntryA.LastUse != EntryB.LastUse)
+				return EntryA.LastUse > EntryB.LastUse;
+			if(EntryA.Priority != EntryB.Priority)
+				return EntryA.Priority > EntryB.Priority;
+			return A < B;
+		});
+
+		// The smallest level of every texture, then the finer levels of each texture in order, down to the finest level requested
+		std::vector<size_type> Targets(this->Entries.size(), 0);
+		std::uint64_t Remaining = this->Budget;
+		for(std::size_t Index = 0; Index < Order.size(); ++Index)
+		{
+			entry const& Entry = this->Entries[Order[Index]];
+			size_type const Last = Entry.Texture.levels() - 1;
+			bool const Fits = Entry.LevelSizes[Last] <= Remaining;
+			Remaining -= Fits ? Entry.LevelSizes[Last] : 0;
+			Targets[Order[Index]] = Fits ? Last : Last + 1;
+		}
+		for(std::size_t Index = 0; Index < Order.size(); ++Index)
+		{
+			entry const& Entry = this->Entries[Order[Index]];
+			size_type& Target = Targets[Order[Index]];
+			while(Target < Entry.Texture.levels() && Target > Entry.Wanted && Entry.LevelSizes[Target - 1] <= Remaining)
+				Remaining -= Entry.LevelSizes[--Target];
+		}
+
+		// Resident levels finer than the requested ones stay while the budget allows
+		for(std::size_t Index = 0; Index < Order.size(); ++Index)
+		{
+			entry const& Entry = this->Entries[Order[Index]];
+			size_type& Target = Targets[Order[Index]];
+			while(Target < Entry.Texture.levels() && Target > Entry.BaseLevel && Entry.LevelSizes[Target - 1] <= Remaining)
+				Remaining -= Entry.LevelSizes[--Target];
+		}
+
+		// Evictions first, so that the loads fit in the device memory
+		for(std::size_t Index = 0; Index < Order.size(); ++Index)
+		{
+			id_type const Id = Order[Index];
+			size_type const BaseLevel = this->Entries[Id].BaseLevel;
+			if(Targets[Id] > BaseLevel && this->resident(Id, Targets[Id]))
+				this->Evictions += Targets[Id] - BaseLevel;
+		}
+
+		// Loads from the smallest level to the largest, fewer levels when the device can't allocate them all
+		std::uint64_t Loaded = 0;
+		for(std::size_t Index = 0; Index < Order.size(); ++Index)
+		{
+			id_type const Id = Order[Index];
+			entry const& Entry = this->Entries[Id];
+			size_type const BaseLevel = Entry.BaseLevel;
+
+			size_type Level = BaseLevel;
+			while(Level > Targets[Id] && (Loaded == 0 || Loaded + Entry.LevelSizes[Level - 1] <= LoadBudget))
+				Loaded += Entry.LevelSizes[--Level];
+
+			while(Level < BaseLevel && !this->resident(Id, Level))
+				++Level;
+			this->Loads += BaseLevel - Level;
+		}
+
+		++this->Frame;
+	}
+
+	inline residency_manager::size_type residency_manager::base_level(id_type Id) const
+	{
+		GLI_ASSERT(this->valid(Id));
+
+		return this->Entries[Id].BaseLevel;
+	}
+
+	inline texture const& residency_manager::host_texture(id_type Id) const
+	{
+		GLI_ASSERT(this->valid(Id));
+
+		return this->Entries[Id].Texture;
+	}
+
+	inline std::uint64_t residency_manager::level_size(id_type Id, size_type Level) const
+	{
+		GLI_ASSERT(this->valid(Id) && Level < this->Entries[Id].Texture.levels());
+
+		return this->Entries[Id].LevelSizes[Level];
+	}
+
+	inline std::uint64_t residency_manager::resident_size(id_type Id) const
+	{
+		GLI_ASSERT(this->valid(Id));
+
+		entry const& Entry = this->Entries[Id];
+		std::uint64_t Size = 0;
+		for(size_type Level = Entry.BaseLevel; Level < Entry.Texture.levels(); ++Level)
+			Size += Entry.LevelSizes[Level];
+		return Size;
+	}
+
+	inline std::uint64_t residency_manager::budget() const
+	{
+		return this->Budget;
+	}
+
+	inline std::uint64_t residency_manager::host_size() const
+	{
+		std::uint64_t Size = 0;
+		for(id_type Id = 0; Id < this->Entries.size(); ++Id)
+			Size += this->valid(Id) ? this->Entries[Id].Texture.size() : 0;
+		return Size;
+	}
+
+	inline std::uint64_t residency_manager::resident_size() const
+	{
+		return this->Resident;
+	}
+
+	inline std::size_t residency_manager::loads() const
+	{
+		return this->Loads;
+	}
+
+	inline std::size_t residency_manager::evictions() const
+	{
+		return this->Evictions;
+	}
+
+	inline std::size_t residency_manager::misses() const
+	{
+		return this->Misses;
+	}
+
+	inline bool residency_manager::valid(id_type Id) const
+	{
+		return Id < this->Entries.size() && !this->Entries[Id].Texture.empty();
+	}
+
+	inline bool residency_manager::resident(id_type Id, size_type BaseLevel)
+	{
+		entry& Entry = this->Entries[Id];
+		if(BaseLevel == Entry.BaseLevel)
+			return true;
+		if(!this->Backend.resident(Id, Entry.Texture, BaseLevel, Entry.BaseLevel))
+			return false;
+
+		this->Resident -= this->resident_size(Id);
+		Entry.BaseLevel = BaseLevel;
+		this->Resident += this->resident_size(Id);
+		return true;
+	}
+}//namespace gli
@@ -33,6 +33,11 @@ namespace gli
 			glm::vec4 Texel[4][4];
 		};
 		
+		void dxt1_palette(const dxt1_block &Block, glm::vec4 *Color);
+		void dxt_color_palette(uint16_t Color0, uint16_t Color1, glm::vec3 *Color);
+		void dxt5_alpha_palette(uint8_t Alpha0, uint8_t Alpha1, float *Alpha);
+		uint64_t dxt5_alpha_bitmap(const uint8_t *AlphaBitmap);
+
 		glm::vec4 decompress_dxt1(const dxt1_block &Block, const extent2d &BlockTexelCoord);
 		texel_block4x4 decompress_dxt1_block(const dxt1_block &Block);
 
@@ -3,11 +3,11 @@
 
 namespace gli
 {
-	template <typename T, qualifier P>
-	inline sampler_cube<T, P>::sampler_cube(texture_cube const & Texture, gli::wrap Wrap, filter Mip, filter Min, texel_type const & BorderColor)
+	template <typename T, qualifier P, typename texture_cube_type>
+	inline sampler_cube<T, P, texture_cube_type>::sampler_cube(texture_type const & Texture, gli::wrap Wrap, filter Mip, filter Min, texel_type const & BorderColor)
 		: sampler(Wrap, Texture.levels() > 1 ? Mip : FILTER_NEAREST, Min)
 		, Texture(Texture)
-		, Convert(detail::convert<texture_cube, T, P>::call(this->Texture.format()))
+		, Convert(detail::convert<texture_type, T, P>::call(this->Texture.format()))
 		, BorderColor(BorderColor)
 		, Filter(detail::get_filter<filter_type, detail::DIMENSION_2D, texture_type, interpolate_type, normalized_type, fetch_type, texel_type, T>(Mip, Min, is_border(Wrap)))
 	{
@@ -16,14 +16,14 @@ namespace gli
 		GLI_ASSERT((!std::numeric_limits<T>::is_iec559 && Mip == FILTER_NEAREST && Min == FILTER_NEAREST) || std::numeric_limits<T>::is_iec559);
 	}
 
-	template <typename T, qualifier P>
-	inline texture_cube const & sampler_cube<T, P>::operator()() const
+	template <typename T, qualifier P, typename texture_cube_type>
+	inline typename sampler_cube<T, P, texture_cube_type>::texture_type const & sampler_cube<T, P, texture_cube_type>::operator()() const
 	{
 		return this->Texture;
 	}
 
-	template <typename T, qualifier P>
-	inline typename sampler_cube<T, P>::texel_type sampler_cube<T, P>::texel_fetch(extent_type const & TexelCoord, size_type Face, size_type Level) const
+	template <typename T, qualifier P, typename texture_cube_type>
+	inline typename sampler_cube<T, P, texture_cube_type>::texel_type sampler_cube<T, P, texture_cube_type>::texel_fetch(extent_type const & TexelCoord, size_type Face, size_type Level) const
 	{
 		GLI_ASSERT(!this->Texture.empty());
 		GLI_ASSERT(this->Convert.Fetch);
@@ -31,8 +31,8 @@ namespace gli
 		return this->Convert.Fetch(this->Texture, TexelCoord, 0, Face, Level);
 	}
 
-	template <typename T, qualifier P>
-	inline void sampler_cube<T, P>::texel_write(extent_type const & TexelCoord, size_type Face, size_type Level, texel_type const & Texel)
+	template <typename T, qualifier P, typename texture_cube_type>
+	inline void sampler_cube<T, P, texture_cube_type>::texel_write(extent_type const & TexelCoord, size_type Face, size_type Level, texel_type const & Texel)
 	{
 		GLI_ASSERT(!this->Texture.empty());
 		GLI_ASSERT(this->Convert.Write);
@@ -40,8 +40,8 @@ namespace gli
 		this->Convert.Write(this->Texture, TexelCoord, 0, Face, Level, Texel);
 	}
 
-	template <typename T, qualifier P>
-	inline void sampler_cube<T, P>::clear(texel_type const & Color)
+	template <typename T, qualifier P, typename texture_cube_type>
+	inline void sampler_cube<T, P, texture_cube_type>::clear(texel_type const & Color)
 	{
 		GLI_ASSERT(!this->Texture.empty());
 		GLI_ASSERT(this->Convert.Write);
@@ -49,8 +49,8 @@ namespace gli
 		detail::clear<texture_type, T, P>::call(this->Texture, this->Convert.Write, Color);
 	}
 
-	template <typename T, qualifier P>
-	inline typename sampler_cube<T, P>::texel_type sampler_cube<T, P>::texture_lod(normalized_type const & SampleCoord, size_type Face, level_type Level) const
+	template <typename T, qualifier P, typename texture_cube_type>
+	inline typename sampler_cube<T, P, texture_cube_type>::texel_type sampler_cube<T, P, texture_cube_type>::texture_lod(normalized_type const & SampleCoord, size_type Face, level_type Level) const
 	{
 		GLI_ASSERT(!this->Texture.empty());
 		GLI_ASSERT(std::numeric_limits<T>::is_iec559);
@@ -61,14 +61,14 @@ namespace gli
 		return this->Filter(this->Texture, this->Convert.Fetch, SampleCoordWrap, size_type(0), Face, Level, this->BorderColor);
 	}
 
-	template <typename T, qualifier P>
-	inline void sampler_cube<T, P>::generate_mipmaps(filter Minification)
+	template <typename T, qualifier P, typename texture_cube_type>
+	inline void sampler_cube<T, P, texture_cube_type>::generate_mipmaps(filter Minification)
 	{
 		this->generate_mipmaps(this->Texture.base_face(), this->Texture.max_face(), this->Texture.base_level(), this->Texture.max_level(), Minification);
 	}
 
-	template <typename T, qualifier P>
-	inline void sampler_cube<T, P>::generate_mipmaps(size_type BaseFace, size_type MaxFace, size_type BaseLevel, size_type MaxLevel, filter Minification)
+	template <typename T, qualifier P, typename texture_cube_type>
+	inline void sampler_cube<T, P, texture_cube_type>::generate_mipmaps(size_type BaseFace, size_type MaxFace, size_type BaseLevel, size_type MaxLevel, filter Minification)
 	{
 		GLI_ASSERT(!this->Texture.empty());
 		GLI_ASSERT(!is_compressed(this->Texture.format()));
@@ -80,5 +80,19 @@ namespace gli
 		detail::generate_mipmaps_2d<texture_type, T, fetch_type, write_type, normalized_type, texel_type>(
 			this->Texture, this->Convert.Fetch, this->Convert.Write, 0, 0, BaseFace, MaxFace, BaseLevel, MaxLevel, Minification);
 	}
+
+	template <typename T, qualifier P, typename texture_cube_type>
+	inline void sampler_cube<T, P, texture_cube_type>::generate_mipmaps(size_type Face, size_type Level, extent_type const& Offset, extent_type const& Extent, filter Minification)
+	{
+		GLI_ASSERT(!this->Texture.empty());
+		GLI_ASSERT(!is_compressed(this->Texture.format()));
+		GLI_ASSERT(Face <= this->Texture.max_face() && Level > 0 && Level <= this->Texture.max_level());
+		GLI_ASSERT(glm::all(glm::lessThanEqual(Offset + Extent, this->Texture.extent(Level))));
+		GLI_ASSERT(this->Convert.Fetch && this->Convert.Write);
+		GLI_ASSERT(Minification >= FILTER_FIRST && Minification <= FILTER_LAST);
+
+		detail::generate_mipmaps_2d_region<texture_type, T, fetch_type, write_type, normalized_type, texel_type>(
+			this->Texture, this->Convert.Fetch, this->Convert.Write, 0, Face, Level, Offset, Extent, Minification);
+	}
 }//namespace gli
 
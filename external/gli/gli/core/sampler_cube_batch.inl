@@ -0,0 +1,412 @@
+#include "./convert_kernel.hpp"
+#include "./simd.hpp"
+#include <glm/gtc/color_space.hpp>
+#include <cmath>
+
+namespace gli{
+namespace detail
+{
+	/// Decoding of the texel Index of an image, specialized for each format supported by sampler_cube_batch
+	template <format Format>
+	struct cube_texel;
+
+	template <>
+	struct cube_texel<FORMAT_RGBA8_UNORM_PACK8>
+	{
+		static simd_vec4 load(glm::uint8 const* Data, std::size_t Index)
+		{
+			glm::uint8 const* const Texel = Data + Index * 4;
+			return simd_vec4(Texel[0], Texel[1], Texel[2], Texel[3]) * simd_vec4(1.0f / 255.0f);
+		}
+	};
+
+	inline float const* srgb_to_linear_table()
+	{
+		struct table
+		{
+			table()
+			{
+				for(int Value = 0; Value < 256; ++Value)
+					Values[Value] = convertSRGBToLinear(vec3(static_cast<float>(Value) / 255.0f)).x;
+			}
+
+			float Values[256];
+		};
+
+		static table const Table;
+		return Table.Values;
+	}
+
+	template <>
+	struct cube_texel<FORMAT_RGBA8_SRGB_PACK8>
+	{
+		static simd_vec4 load(glm::uint8 const* Data, std::size_t Index)
+		{
+			float const* const Table = srgb_to_linear_table();
+			glm::uint8 const* const Texel = Data + Index * 4;
+			return simd_vec4(Table[Texel[0]], Table[Texel[1]], Table[Texel[2]], static_cast<float>(Texel[3]) / 255.0f);
+		}
+	};
+
+	template <>
+	struct cube_texel<FORMAT_RGBA16_SFLOAT_PACK16>
+	{
+		static simd_vec4 load(glm::uint8 const* Data, std::size_t Index)
+		{
+			glm::uint16 const* const Texel = reinterpret_cast<glm::uint16 const*>(Data) + Index * 4;
+			float const* const Table = half_to_float_table();
+			return simd_vec4(Table[Texel[0]], Table[Texel[1]], Table[Texel[2]], Table[Texel[3]]);
+		}
+	};
+
+	template <>
+	struct cube_texel<FORMAT_RGBA32_SFLOAT_PACK32>
+	{
+		static simd_vec4 load(glm::uint8 const* Data, std::size_t Index)
+		{
+			return simd_vec4::load(reinterpret_cast<float const*>(Data) + Index * 4);
+		}
+	};
+
+	template <>
+	struct cube_texel<FORMAT_RG11B10_UFLOAT_PACK32>
+	{
+		static simd_vec4 load(glm::uint8 const* Data, std::size_t Index)
+		{
+			glm::uint32 const Value = reinterpret_cast<glm::uint32 const*>(Data)[Index];
+			float const* const Table = ufloat_table();
+			return simd_vec4(Table[Value & 0x7ff], Table[(Value >> 11) & 0x7ff], Table[2048 + (Value >> 22)], 1.0f);
+		}
+	};
+
+	template <>
+	struct cube_texel<FORMAT_RGB9E5_UFLOAT_PACK32>
+	{
+		static simd_vec4 load(glm::uint8 const* Data, std::size_t Index)
+		{
+			glm::uint32 const Value = reinterpret_cast<glm::uint32 const*>(Data)[Index];
+			float const Scale = std::ldexp(1.0f, static_cast<int>(Value >> 27) - 15 - 9);
+			return simd_vec4(static_cast<float>(Value & 0x1ff) * Scale, static_cast<float>((Value >> 9) & 0x1ff) * Scale, static_cast<float>((Value >> 18) & 0x1ff) * Scale, 1.0f);
+		}
+	};
+
+	/// Major axis of 4 directions: selection masks and sign of the major axis component
+	struct cube_major
+	{
+		simd_vec4 XMajor;
+		simd_vec4 YMajor;
+		simd_vec4 Sign;
+		simd_vec4 Face;
+	};
+
+	inline cube_major make_cube_major(simd_vec4 const& X, simd_vec4 const& Y, simd_vec4 const& Z)
+	{
+		simd_vec4 const AbsX = lane_abs(X);
+		simd_vec4 const AbsY = lane_abs(Y);
+		simd_vec4 const AbsZ = lane_abs(Z);
+
+		cube_major Major;
+		Major.XMajor = lane_and(lane_greater_equal(AbsX, AbsY), lane_greater_equal(AbsX, AbsZ));
+		Major.YMajor = lane_andnot(Major.XMajor, lane_greater_equal(AbsY, AbsZ));
+
+		simd_vec4 const Negative = lane_less(lane_select(Major.XMajor, X, lane_select(Major.YMajor, Y, Z)), simd_vec4(0.0f));
+		Major.Sign = lane_select(Negative, simd_vec4(-1.0f), simd_vec4(1.0f));
+		Major.Face = lane_select(Major.XMajor, simd_vec4(0.0f), lane_select(Major.YMajor, simd_vec4(2.0f), simd_vec4(4.0f))) + lane_select(Negative, simd_vec4(1.0f), simd_vec4(0.0f));
+		return Major;
+	}
+
+	/// Face axes of a vector, linear in the vector for a given major axis so that it applies to the derivatives of the directions:
+	/// +X: (-z, -y, x), -X: (z, -y, -x), +Y: (x, z, y), -Y: (x, -z, -y), +Z: (x, -y, z), -Z: (-x, -y, -z)
+	inline void cube_project(cube_major const& Major, simd_vec4 const& X, simd_vec4 const& Y, simd_vec4 const& Z, simd_vec4& Sc, simd_vec4& Tc, simd_vec4& Ma)
+	{
+		simd_vec4 const Zero(0.0f);
+		Sc = lane_select(Major.XMajor, Zero - Major.Sign * Z, lane_select(Major.YMajor, X, Major.Sign * X));
+		Tc = lane_select(Major.YMajor, Major.Sign * Z, Zero - Y);
+		Ma = Major.Sign * lane_select(Major.XMajor, X, lane_select(Major.YMajor, Y, Z));
+	}
+
+	/// Direction of the face coordinates Sc and Tc in [-1, 1] of Face, the inverse of cube_project with a major axis component of 1
+	inline vec3 cube_direction(int Face, float Sc, float Tc)
+	{
+		switch(Face)
+		{
+		case 0:
+			return vec3(1.0f, -Tc, -Sc);
+		case 1:
+			return vec3(-1.0f, -Tc, Sc);
+		case 2:
+			return vec3(Sc, 1.0f, Tc);
+		case 3:
+			return vec3(Sc, -1.0f, -Tc);
+		case 4:
+			return vec3(Sc, -Tc, 1.0f);
+		default:
+			return vec3(-Sc, -Tc, -1.0f);
+		}
+	}
+
+	/// Directions of the face coordinates Sc and Tc of four texels of Face, see cube_direction
+	inline void cube_face_directions(int Face, simd_vec4 const& Sc, simd_vec4 const& Tc, simd_vec4& X, simd_vec4& Y, simd_vec4& Z)
+	{
+		simd_vec4 const One(1.0f);
+		simd_vec4 const Zero(0.0f);
+
+		switch(Face)
+		{
+		case 0:
+			X = One, Y = Zero - Tc, Z = Zero - Sc;
+			break;
+		case 1:
+			X = Zero - One, Y = Zero - Tc, Z = Sc;
+			break;
+		case 2:
+			X = Sc, Y = One, Z = Tc;
+			break;
+		case 3:
+			X = Sc, Y = Zero - One, Z = Zero - Tc;
+			break;
+		case 4:
+			X = Sc, Y = Zero - Tc, Z = One;
+			break;
+		default:
+			X = Zero - Sc, Y = Zero - Tc, Z = Zero - One;
+			break;
+		}
+	}
+
+	/// Texel at x, y of a level of Face, where x and y may be one texel past the face edges.
+	/// Past an edge, the texel center is projected on the cube and the texel of the adjacent face under it is used, so that filtering is seamless.
+	/// At the cube corners, where the GPU averages three faces, one of the two adjacent faces is used.
+	inline std::size_t cube_seamless_texel(int& Face, int Size, int x, int y)
+	{
+		if(x >= 0 && x < Size && y >= 0 && y < Size)
+			return static_cast<std::size_t>(y) * Size + x;
+
+		float const InvSize = 1.0f / static_cast<float>(Size);
+		vec3 const Direction(cube_direction(Face, static_cast<float>(2 * x + 1) * InvSize - 1.0f, static_cast<float>(2 * y + 1) * InvSize - 1.0f));
+		vec3 const Abs(glm::abs(Direction));
+
+		float Sc, Tc, Ma;
+		if(Abs.x >= Abs.y && Abs.x >= Abs.z)
+		{
+			Face = Direction.x >= 0.0f ? 0 : 1;
+			Sc = Direction.x >= 0.0f ? -Direction.z : Direction.z;
+			Tc = -Direction.y;
+			Ma = Abs.x;
+		}
+		else if(Abs.y >= Abs.z)
+		{
+			Face = Direction.y >= 0.0f ? 2 : 3;
+			Sc = Direction.x;
+			Tc = Direction.y >= 0.0f ? Direction.z : -Direction.z;
+			Ma = Abs.y;
+		}
+		else
+		{
+			Face = Direction.z >= 0.0f ? 4 : 5;
+			Sc = Direction.z >= 0.0f ? Direction.x : -Direction.x;
+			Tc = -Direction.y;
+			Ma = Abs.z;
+		}
+
+		int const AdjacentX = glm::clamp(static_cast<int>((Sc / Ma * 0.5f + 0.5f) * static_cast<float>(Size)), 0, Size - 1);
+		int const AdjacentY = glm::clamp(static_cast<int>((Tc / Ma * 0.5f + 0.5f) * static_cast<float>(Size)), 0, Size - 1);
+		return static_cast<std::size_t>(AdjacentY) * Size + AdjacentX;
+	}
+
+	/// Filter a level of a face at the face coordinates S and T in [0, 1].
+	/// Images holds the first texel of each level of each face, indexed by Face * Levels + Level.
+	/// Bilinear taps past the face edges are clamped to the edges, or read from the adjacent faces when Seamless is true.
+	template <format Format>
+	inline simd_vec4 cube_filter(glm::uint8 const* const* Images, int Levels, int Face, int Level, int Size, float S, float T, filter Min, bool Seamless)
+	{
+		typedef cube_texel<Format> texel;
+
+		glm::uint8 const* const Data = Images[Face * Levels + Level];
+		float const U = S * static_cast<float>(Size);
+		float const V = T * static_cast<float>(Size);
+
+		if(Min == FILTER_NEAREST)
+		{
+			int const x = glm::clamp(static_cast<int>(U), 0, Size - 1);
+			int const y = glm::clamp(static_cast<int>(V), 0, Size - 1);
+			return texel::load(Data, static_cast<std::size_t>(y) * Size + x);
+		}
+
+		float const FloorU = std::floor(U - 0.5f);
+		float const FloorV = std::floor(V - 0.5f);
+		float const BlendU = U - 0.5f - FloorU;
+		float const BlendV = V - 0.5f - FloorV;
+
+		int const x0 = static_cast<int>(FloorU);
+		int const y0 = static_cast<int>(FloorV);
+
+		// Taps past the face edges on the adjacent faces, only for the texels along the edges
+		if(Seamless && (x0 < 0 || y0 < 0 || x0 + 1 >= Size || y0 + 1 >= Size))
+		{
+			simd_vec4 Texels[4];
+			for(int Tap = 0; Tap < 4; ++Tap)
+			{
+				int TapFace = Face;
+				std::size_t const TapIndex = cube_seamless_texel(TapFace, Size, x0 + (Tap & 1), y0 + (Tap >> 1));
+				Texels[Tap] = texel::load(Images[TapFace * Levels + Level], TapIndex);
+			}
+			return lane_mix(lane_mix(Texels[0], Texels[1], BlendU), lane_mix(Texels[2], Texels[3], BlendU), BlendV);
+		}
+
+		int const x0Clamped = glm::clamp(x0, 0, Size - 1);
+		int const x1Clamped = glm::clamp(x0 + 1, 0, Size - 1);
+		std::size_t const Row0 = static_cast<std::size_t>(glm::clamp(y0, 0, Size - 1)) * Size;
+		std::size_t const Row1 = static_cast<std::size_t>(glm::clamp(y0 + 1, 0, Size - 1)) * Size;
+
+		simd_vec4 const Texel0 = lane_mix(texel::load(Data, Row0 + x0Clamped), texel::load(Data, Row0 + x1Clamped), BlendU);
+		simd_vec4 const Texel1 = lane_mix(texel::load(Data, Row1 + x0Clamped), texel::load(Data, Row1 + x1Clamped), BlendU);
+		return lane_mix(Texel0, Texel1, BlendV);
+	}
+}//namespace detail
+
+	template <format Format>
+	inline sampler_cube_batch<Format>::sampler_cube_batch(texture_type const& Texture, filter Mip, filter Min, bool Seamless)
+		: Texture(Texture)
+		, Mip(Texture.levels() > 1 ? Mip : FILTER_NEAREST)
+		, Min(Min)
+		, Seamless(Seamless)
+	{
+		GLI_ASSERT(!Texture.empty());
+		GLI_ASSERT(Texture.format() == Format);
+		GLI_ASSERT(Texture.faces() == 6);
+		GLI_ASSERT(Mip == FILTER_NEAREST || Mip == FILTER_LINEAR);
+		GLI_ASSERT(Min == FILTER_NEAREST || Min == FILTER_LINEAR);
+
+		for(size_type Face = 0; Face < Texture.faces(); ++Face)
+		for(size_type Level = 0; Level < Texture.levels(); ++Level)
+			this->Images.push_back(Texture.data<glm::uint8>(0, Face, Level));
+
+		for(size_type Level = 0; Level < Texture.levels(); ++Level)
+			this->Sizes.push_back(Texture.extent(Level).x);
+	}
+
+	template <format Format>
+	inline texture_cube const& sampler_cube_batch<Format>::operator()() const
+	{
+		return this->Texture;
+	}
+
+	template <format Format>
+	inline void sampler_cube_batch<Format>::texture_lod(cube_directions const& Directions, float Level, vec4* Texels) const
+	{
+		this->sample(Directions, nullptr, Level, nullptr, nullptr, Texels);
+	}
+
+	template <format Format>
+	inline void sampler_cube_batch<Format>::texture_lod(cube_directions const& Directions, float const* Levels, vec4* Texels) const
+	{
+		GLI_ASSERT(Levels);
+		this->sample(Directions, Levels, 0.0f, nullptr, nullptr, Texels);
+	}
+
+	template <format Format>
+	inline void sampler_cube_batch<Format>::texture_grad(cube_directions const& Directions, cube_directions const& DirectionsDx, cube_directions const& DirectionsDy, vec4* Texels) const
+	{
+		GLI_ASSERT(DirectionsDx.Count >= Directions.Count && DirectionsDy.Count >= Directions.Count);
+		this->sample(Directions, nullptr, 0.0f, &DirectionsDx, &DirectionsDy, Texels);
+	}
+
+	template <format Format>
+	inline void sampler_cube_batch<Format>::sample(cube_directions const& Directions, float const* Levels, float Level, cube_directions const* DirectionsDx, cube_directions const* DirectionsDy, vec4* Texels) const
+	{
+		using detail::simd_vec4;
+
+		GLI_ASSERT(Directions.Count == 0 || (Directions.X && Directions.Y && Directions.Z && Texels));
+
+		int const Levels_ = static_cast<int>(this->Texture.levels());
+		float const MaxLevel = static_cast<float>(Levels_ - 1);
+		simd_vec4 const Half(0.5f);
+
+		// Face selection and face coordinates of 4 directions at once, then filtering of each direction
+		for(std::size_t Index = 0; Index < Directions.Count; Index += 4)
+		{
+			std::size_t const Lanes = glm::min<std::size_t>(4, Directions.Count - Index);
+
+			// Past the end of the arrays, lanes sample the +X direction and are discarded
+			float X[4] = {1.0f, 1.0f, 1.0f, 1.0f}, Y[4] = {0.0f, 0.0f, 0.0f, 0.0f}, Z[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+			for(std::size_t Lane = 0; Lane < Lanes; ++Lane)
+			{
+				X[Lane] = Directions.X[Index + Lane];
+				Y[Lane] = Directions.Y[Index + Lane];
+				Z[Lane] = Directions.Z[Index + Lane];
+			}
+
+			detail::cube_major const Major = detail::make_cube_major(simd_vec4::load(X), simd_vec4::load(Y), simd_vec4::load(Z));
+
+			simd_vec4 Sc, Tc, Ma;
+			detail::cube_project(Major, simd_vec4::load(X), simd_vec4::load(Y), simd_vec4::load(Z), Sc, Tc, Ma);
+			simd_vec4 const InvMa = simd_vec4(1.0f) / Ma;
+			simd_vec4 const ScMa = Sc * InvMa;
+			simd_vec4 const TcMa = Tc * InvMa;
+
+			float Face[4], S[4], T[4], Lod[4] = {Level, Level, Level, Level};
+			Major.Face.store(Face);
+			(ScMa * Half + Half).store(S);
+			(TcMa * Half + Half).store(T);
+
+			if(Levels)
+			{
+				for(std::size_t Lane = 0; Lane < Lanes; ++Lane)
+					Lod[Lane] = Levels[Index + Lane];
+			}
+			else if(DirectionsDx && DirectionsDy)
+			{
+				// Derivatives of the face coordinates: d(sc / ma) = (dsc - sc / ma * dma) / ma, in texels of the base level
+				cube_directions const* const Derivatives[2] = {DirectionsDx, DirectionsDy};
+				simd_vec4 Footprint(0.0f);
+				for(int Axis = 0; Axis < 2; ++Axis)
+				{
+					float DX[4] = {0.0f, 0.0f, 0.0f, 0.0f}, DY[4] = {0.0f, 0.0f, 0.0f, 0.0f}, DZ[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+					for(std::size_t Lane = 0; Lane < Lanes; ++Lane)
+					{
+						DX[Lane] = Derivatives[Axis]->X[Index + Lane];
+						DY[Lane] = Derivatives[Axis]->Y[Index + Lane];
+						DZ[Lane] = Derivatives[Axis]->Z[Index + Lane];
+					}
+
+					simd_vec4 dSc, dTc, dMa;
+					detail::cube_project(Major, simd_vec4::load(DX), simd_vec4::load(DY), simd_vec4::load(DZ), dSc, dTc, dMa);
+					simd_vec4 const dS = (dSc - ScMa * dMa) * InvMa * Half;
+					simd_vec4 const dT = (dTc - TcMa * dMa) * InvMa * Half;
+					Footprint = detail::lane_max(Footprint, dS * dS + dT * dT);
+				}
+
+				float Footprints[4];
+				(Footprint * simd_vec4(static_cast<float>(this->Sizes[0] * this->Sizes[0]))).store(Footprints);
+				for(std::size_t Lane = 0; Lane < Lanes; ++Lane)
+					Lod[Lane] = Footprints[Lane] > 0.0f ? 0.5f * std::log2(Footprints[Lane]) : 0.0f;
+			}
+
+			for(std::size_t Lane = 0; Lane < Lanes; ++Lane)
+			{
+				int const FaceIndex = static_cast<int>(Face[Lane]);
+				float const LevelClamped = glm::clamp(Lod[Lane], 0.0f, MaxLevel);
+
+				simd_vec4 Texel;
+				if(this->Mip == FILTER_NEAREST)
+				{
+					int const LevelIndex = static_cast<int>(LevelClamped + 0.5f);
+					Texel = detail::cube_filter<Format>(&this->Images[0], Levels_, FaceIndex, LevelIndex, this->Sizes[LevelIndex], S[Lane], T[Lane], this->Min, this->Seamless);
+				}
+				else
+				{
+					int const LevelFloor = static_cast<int>(LevelClamped);
+					int const LevelCeil = glm::min(LevelFloor + 1, Levels_ - 1);
+					simd_vec4 const Texel0 = detail::cube_filter<Format>(&this->Images[0], Levels_, FaceIndex, LevelFloor, this->Sizes[LevelFloor], S[Lane], T[Lane], this->Min, this->Seamless);
+					if(LevelCeil == LevelFloor || LevelClamped == static_cast<float>(LevelFloor))
+						Texel = Texel0;
+					else
+						Texel = detail::lane_mix(Texel0, detail::cube_filter<Format>(&this->Images[0], Levels_, FaceIndex, LevelCeil, this->Sizes[LevelCeil], S[Lane], T[Lane], this->Min, this->Seamless), LevelClamped - static_cast<float>(LevelFloor));
+				}
+
+				detail::store(Texel, Texels[Index + Lane]);
+			}
+		}
+	}
+}//namespace gli
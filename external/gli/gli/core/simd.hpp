@@ -0,0 +1,293 @@
+/// @brief Include to use four float lanes mapped on SSE registers when available
+/// @file gli/core/simd.hpp
+
+#pragma once
+
+#include "./cpu.hpp"
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cmath>
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+#	include <emmintrin.h>
+#endif
+
+namespace gli{
+namespace detail
+{
+	/// Four float lanes: one per RGBA channel of a texel, or one per entry of a palette.
+	/// Mapped on SSE registers when available so that every lane is computed at once, plain floats otherwise.
+#	if GLM_ARCH & GLM_ARCH_SSE2_BIT
+		struct simd_vec4
+		{
+			simd_vec4() {}
+			explicit simd_vec4(float Scalar) : Data(_mm_set1_ps(Scalar)) {}
+			simd_vec4(float X, float Y, float Z, float W) : Data(_mm_setr_ps(X, Y, Z, W)) {}
+			explicit simd_vec4(__m128 Value) : Data(Value) {}
+
+			static simd_vec4 load(float const* Values)
+			{
+				return simd_vec4(_mm_loadu_ps(Values));
+			}
+
+			void store(float* Values) const
+			{
+				_mm_storeu_ps(Values, this->Data);
+			}
+
+			__m128 Data;
+		};
+
+		inline simd_vec4 operator+(simd_vec4 const& A, simd_vec4 const& B)
+		{
+			return simd_vec4(_mm_add_ps(A.Data, B.Data));
+		}
+
+		inline simd_vec4 operator-(simd_vec4 const& A, simd_vec4 const& B)
+		{
+			return simd_vec4(_mm_sub_ps(A.Data, B.Data));
+		}
+
+		inline simd_vec4 operator*(simd_vec4 const& A, simd_vec4 const& B)
+		{
+			return simd_vec4(_mm_mul_ps(A.Data, B.Data));
+		}
+
+		inline simd_vec4 lane_min(simd_vec4 const& A, simd_vec4 const& B)
+		{
+			return simd_vec4(_mm_min_ps(A.Data, B.Data));
+		}
+
+		inline simd_vec4 lane_max(simd_vec4 const& A, simd_vec4 const& B)
+		{
+			return simd_vec4(_mm_max_ps(A.Data, B.Data));
+		}
+
+		/// Round positive lanes to the nearest integer
+		inline simd_vec4 lane_round(simd_vec4 const& A)
+		{
+			return simd_vec4(_mm_cvtepi32_ps(_mm_cvttps_epi32(_mm_add_ps(A.Data, _mm_set1_ps(0.5f)))));
+		}
+
+		inline simd_vec4 operator/(simd_vec4 const& A, simd_vec4 const& B)
+		{
+			return simd_vec4(_mm_div_ps(A.Data, B.Data));
+		}
+
+		inline simd_vec4 lane_abs(simd_vec4 const& A)
+		{
+			return simd_vec4(_mm_andnot_ps(_mm_set1_ps(-0.0f), A.Data));
+		}
+
+		inline simd_vec4 lane_sqrt(simd_vec4 const& A)
+		{
+			return simd_vec4(_mm_sqrt_ps(A.Data));
+		}
+
+		/// Comparisons return masks: lanes with every bit set where the comparison holds, zero elsewhere
+		inline simd_vec4 lane_less(simd_vec4 const& A, simd_vec4 const& B)
+		{
+			return simd_vec4(_mm_cmplt_ps(A.Data, B.Data));
+		}
+
+		inline simd_vec4 lane_greater_equal(simd_vec4 const& A, simd_vec4 const& B)
+		{
+			return simd_vec4(_mm_cmpge_ps(A.Data, B.Data));
+		}
+
+		inline simd_vec4 lane_and(simd_vec4 const& MaskA, simd_vec4 const& MaskB)
+		{
+			return simd_vec4(_mm_and_ps(MaskA.Data, MaskB.Data));
+		}
+
+		/// Lanes of MaskB where MaskA is not set
+		inline simd_vec4 lane_andnot(simd_vec4 const& MaskA, simd_vec4 const& MaskB)
+		{
+			return simd_vec4(_mm_andnot_ps(MaskA.Data, MaskB.Data));
+		}
+
+		/// Lanes of A where Mask is set, lanes of B elsewhere
+		inline simd_vec4 lane_select(simd_vec4 const& Mask, simd_vec4 const& A, simd_vec4 const& B)
+		{
+			return simd_vec4(_mm_or_ps(_mm_and_ps(Mask.Data, A.Data), _mm_andnot_ps(Mask.Data, B.Data)));
+		}
+#	else
+		struct simd_vec4
+		{
+			simd_vec4() {}
+			explicit simd_vec4(float Scalar)
+			{
+				this->Data[0] = this->Data[1] = this->Data[2] = this->Data[3] = Scalar;
+			}
+			simd_vec4(float X, float Y, float Z, float W)
+			{
+				this->Data[0] = X;
+				this->Data[1] = Y;
+				this->Data[2] = Z;
+				this->Data[3] = W;
+			}
+
+			static simd_vec4 load(float const* Values)
+			{
+				return simd_vec4(Values[0], Values[1], Values[2], Values[3]);
+			}
+
+			void store(float* Values) const
+			{
+				std::copy(this->Data, this->Data + 4, Values);
+			}
+
+			float Data[4];
+		};
+
+		template <typename func>
+		inline simd_vec4 lane_apply(simd_vec4 const& A, simd_vec4 const& B, func const& Func)
+		{
+			return simd_vec4(Func(A.Data[0], B.Data[0]), Func(A.Data[1], B.Data[1]), Func(A.Data[2], B.Data[2]), Func(A.Data[3], B.Data[3]));
+		}
+
+		inline simd_vec4 operator+(simd_vec4 const& A, simd_vec4 const& B)
+		{
+			return lane_apply(A, B, [](float a, float b){return a + b;});
+		}
+
+		inline simd_vec4 operator-(simd_vec4 const& A, simd_vec4 const& B)
+		{
+			return lane_apply(A, B, [](float a, float b){return a - b;});
+		}
+
+		inline simd_vec4 operator*(simd_vec4 const& A, simd_vec4 const& B)
+		{
+			return lane_apply(A, B, [](float a, float b){return a * b;});
+		}
+
+		inline simd_vec4 lane_min(simd_vec4 const& A, simd_vec4 const& B)
+		{
+			return lane_apply(A, B, [](float a, float b){return a < b ? a : b;});
+		}
+
+		inline simd_vec4 lane_max(simd_vec4 const& A, simd_vec4 const& B)
+		{
+			return lane_apply(A, B, [](float a, float b){return a > b ? a : b;});
+		}
+
+		inline simd_vec4 lane_round(simd_vec4 const& A)
+		{
+			return lane_apply(A, A, [](float a, float){return static_cast<float>(static_cast<int>(a + 0.5f));});
+		}
+
+		inline simd_vec4 operator/(simd_vec4 const& A, simd_vec4 const& B)
+		{
+			return lane_apply(A, B, [](float a, float b){return a / b;});
+		}
+
+		inline simd_vec4 lane_abs(simd_vec4 const& A)
+		{
+			return lane_apply(A, A, [](float a, float){return a < 0.0f ? -a : a;});
+		}
+
+		inline simd_vec4 lane_sqrt(simd_vec4 const& A)
+		{
+			return lane_apply(A, A, [](float a, float){return std::sqrt(a);});
+		}
+
+		/// Comparisons return masks: lanes of 1 where the comparison holds, 0 elsewhere
+		inline simd_vec4 lane_less(simd_vec4 const& A, simd_vec4 const& B)
+		{
+			return lane_apply(A, B, [](float a, float b){return a < b ? 1.0f : 0.0f;});
+		}
+
+		inline simd_vec4 lane_greater_equal(simd_vec4 const& A, simd_vec4 const& B)
+		{
+			return lane_apply(A, B, [](float a, float b){return a >= b ? 1.0f : 0.0f;});
+		}
+
+		inline simd_vec4 lane_and(simd_vec4 const& MaskA, simd_vec4 const& MaskB)
+		{
+			return lane_apply(MaskA, MaskB, [](float a, float b){return a != 0.0f && b != 0.0f ? 1.0f : 0.0f;});
+		}
+
+		/// Lanes of MaskB where MaskA is not set
+		inline simd_vec4 lane_andnot(simd_vec4 const& MaskA, simd_vec4 const& MaskB)
+		{
+			return lane_apply(MaskA, MaskB, [](float a, float b){return a == 0.0f && b != 0.0f ? 1.0f : 0.0f;});
+		}
+
+		/// Lanes of A where Mask is set, lanes of B elsewhere
+		inline simd_vec4 lane_select(simd_vec4 const& Mask, simd_vec4 const& A, simd_vec4 const& B)
+		{
+			return simd_vec4(
+				Mask.Data[0] != 0.0f ? A.Data[0] : B.Data[0], Mask.Data[1] != 0.0f ? A.Data[1] : B.Data[1],
+				Mask.Data[2] != 0.0f ? A.Data[2] : B.Data[2], Mask.Data[3] != 0.0f ? A.Data[3] : B.Data[3]);
+		}
+#	endif//GLM_ARCH & GLM_ARCH_SSE2_BIT
+
+	inline simd_vec4 load(glm::vec4 const& Texel)
+	{
+		return simd_vec4::load(&Texel[0]);
+	}
+
+	inline void store(simd_vec4 const& Value, glm::vec4& Texel)
+	{
+		Value.store(&Texel[0]);
+	}
+
+	/// Blend of A and B by Blend, the same for every lane
+	inline simd_vec4 lane_mix(simd_vec4 const& A, simd_vec4 const& B, float Blend)
+	{
+		return A + (B - A) * simd_vec4(Blend);
+	}
+
+	inline float lane_sum3(simd_vec4 const& A)
+	{
+		float Values[4];
+		A.store(Values);
+		return Values[0] + Values[1] + Values[2];
+	}
+
+	/// Arc tangent of Y / X in [-pi, pi] using the signs of both to select the quadrant, like std::atan2, within 3e-7 radians.
+	/// Polynomial of Abramowitz and Stegun 4.4.49 on [0, 1], extended by symmetries.
+	inline simd_vec4 lane_atan2(simd_vec4 const& Y, simd_vec4 const& X)
+	{
+		simd_vec4 const Zero(0.0f);
+		simd_vec4 const AbsX(lane_abs(X));
+		simd_vec4 const AbsY(lane_abs(Y));
+		simd_vec4 const Swap(lane_less(AbsX, AbsY));
+
+		// Ratio in [0, 1], 0 when both are null
+		simd_vec4 const Ratio(lane_min(AbsX, AbsY) / lane_max(lane_max(AbsX, AbsY), simd_vec4(1e-30f)));
+		simd_vec4 const Square(Ratio * Ratio);
+
+		simd_vec4 Poly(0.0028662257f);
+		Poly = Poly * Square + simd_vec4(-0.0161657367f);
+		Poly = Poly * Square + simd_vec4(0.0429096138f);
+		Poly = Poly * Square + simd_vec4(-0.0752896400f);
+		Poly = Poly * Square + simd_vec4(0.1065626393f);
+		Poly = Poly * Square + simd_vec4(-0.1420889944f);
+		Poly = Poly * Square + simd_vec4(0.1999355085f);
+		Poly = Poly * Square + simd_vec4(-0.3333314528f);
+		simd_vec4 Angle(Ratio + Ratio * Square * Poly);
+
+		Angle = lane_select(Swap, simd_vec4(1.57079632679f) - Angle, Angle);
+		Angle = lane_select(lane_less(X, Zero), simd_vec4(3.14159265359f) - Angle, Angle);
+		return lane_select(lane_less(Y, Zero), Zero - Angle, Angle);
+	}
+
+#	if GLI_CPU_X86
+		/// Convert Count halfs to floats 4 at a time, Count is a multiple of 4.
+		/// Only call when widest_cpu_arch() is CPU_ARCH_F16C. The floats are the same as glm::unpackHalf1x16.
+		GLI_TARGET_F16C inline void halfs_to_floats_f16c(glm::uint16 const* Halfs, float* Floats, std::size_t Count)
+		{
+			for(std::size_t Index = 0; Index < Count; Index += 4)
+				_mm_storeu_ps(Floats + Index, _mm_cvtph_ps(_mm_loadl_epi64(reinterpret_cast<__m128i const*>(Halfs + Index))));
+		}
+
+		/// Convert Count floats to halfs 4 at a time, Count is a multiple of 4.
+		/// Only call when widest_cpu_arch() is CPU_ARCH_F16C. The hardware rounds to nearest even where glm::packHalf1x16 rounds halfway cases up.
+		GLI_TARGET_F16C inline void floats_to_halfs_f16c(float const* Floats, glm::uint16* Halfs, std::size_t Count)
+		{
+			for(std::size_t Index = 0; Index < Count; Index += 4)
+				_mm_storel_epi64(reinterpret_cast<__m128i*>(Halfs + Index), _mm_cvtps_ph(_mm_loadu_ps(Floats + Index), 0));
+		}
+#	endif//GLI_CPU_X86
+}//namespace detail
+}//namespace gli
@@ -11,6 +11,7 @@
 
 #include "../type.hpp"
 #include "../format.hpp"
+#include "../allocator.hpp"
 
 // GLM
 #include <glm/gtc/round.hpp>
@@ -42,6 +43,25 @@ namespace gli
 			size_type Faces,
 			size_type Levels);
 
+		/// Create a storage whose memory comes from Allocator, such as uninitialized_allocator() when every texel is written before it is read
+		storage_linear(
+			format_type Format,
+			extent_type const & Extent,
+			size_type Layers,
+			size_type Faces,
+			size_type Levels,
+			storage_allocator& Allocator);
+
+		/// Create a storage which reads and writes the texel data in an existing memory block instead of allocating one.
+		/// Memory must hold at least layer_size() * Layers bytes laid out as the storage expects and it is kept alive as long as the storage.
+		storage_linear(
+			format_type Format,
+			extent_type const & Extent,
+			size_type Layers,
+			size_type Faces,
+			size_type Levels,
+			std::shared_ptr<data_type> const& Memory);
+
 		bool empty() const;
 		size_type size() const; // Express is bytes
 		size_type layers() const;
@@ -91,7 +111,8 @@ namespace gli
 		extent_type const BlockCount;
 		extent_type const BlockExtent;
 		extent_type const Extent;
-		std::vector<data_type> Data;
+		size_type const Size;
+		std::shared_ptr<data_type> Data;
 	};
 }//namespace gli
 
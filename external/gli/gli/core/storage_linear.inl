@@ -8,6 +8,7 @@ namespace gli
 		, BlockCount(0)
 		, BlockExtent(0)
 		, Extent(0)
+		, Size(0)
 	{}
 
 	inline storage_linear::storage_linear(format_type Format, extent_type const& Extent, size_type Layers, size_type Faces, size_type Levels)
@@ -18,18 +19,53 @@ namespace gli
 		, BlockCount(glm::ceilMultiple(Extent, gli::block_extent(Format)) / gli::block_extent(Format))
 		, BlockExtent(gli::block_extent(Format))
 		, Extent(Extent)
+		, Size(this->layer_size(0, Faces - 1, 0, Levels - 1) * Layers)
+		, Data(default_allocator().allocate(Size))
 	{
 		GLI_ASSERT(Layers > 0);
 		GLI_ASSERT(Faces > 0);
 		GLI_ASSERT(Levels > 0);
 		GLI_ASSERT(glm::all(glm::greaterThan(Extent, extent_type(0))));
+	}
 
-		this->Data.resize(this->layer_size(0, Faces - 1, 0, Levels - 1) * Layers, 0);
+	inline storage_linear::storage_linear(format_type Format, extent_type const& Extent, size_type Layers, size_type Faces, size_type Levels, storage_allocator& Allocator)
+		: Layers(Layers)
+		, Faces(Faces)
+		, Levels(Levels)
+		, BlockSize(gli::block_size(Format))
+		, BlockCount(glm::ceilMultiple(Extent, gli::block_extent(Format)) / gli::block_extent(Format))
+		, BlockExtent(gli::block_extent(Format))
+		, Extent(Extent)
+		, Size(this->layer_size(0, Faces - 1, 0, Levels - 1) * Layers)
+		, Data(Allocator.allocate(Size))
+	{
+		GLI_ASSERT(Layers > 0);
+		GLI_ASSERT(Faces > 0);
+		GLI_ASSERT(Levels > 0);
+		GLI_ASSERT(glm::all(glm::greaterThan(Extent, extent_type(0))));
+	}
+
+	inline storage_linear::storage_linear(format_type Format, extent_type const& Extent, size_type Layers, size_type Faces, size_type Levels, std::shared_ptr<data_type> const& Memory)
+		: Layers(Layers)
+		, Faces(Faces)
+		, Levels(Levels)
+		, BlockSize(gli::block_size(Format))
+		, BlockCount(glm::ceilMultiple(Extent, gli::block_extent(Format)) / gli::block_extent(Format))
+		, BlockExtent(gli::block_extent(Format))
+		, Extent(Extent)
+		, Size(this->layer_size(0, Faces - 1, 0, Levels - 1) * Layers)
+		, Data(Memory)
+	{
+		GLI_ASSERT(Layers > 0);
+		GLI_ASSERT(Faces > 0);
+		GLI_ASSERT(Levels > 0);
+		GLI_ASSERT(glm::all(glm::greaterThan(Extent, extent_type(0))));
+		GLI_ASSERT(Memory);
 	}
 
 	inline bool storage_linear::empty() const
 	{
-		return this->Data.empty();
+		return this->Data.get() == nullptr;
 	}
 
 	inline storage_linear::size_type storage_linear::layers() const
@@ -75,21 +111,21 @@ namespace gli
 	{
 		GLI_ASSERT(!this->empty());
 
-		return static_cast<size_type>(this->Data.size());
+		return this->Size;
 	}
 
 	inline storage_linear::data_type* storage_linear::data()
 	{
 		GLI_ASSERT(!this->empty());
 
-		return &this->Data[0];
+		return this->Data.get();
 	}
 
 	inline storage_linear::data_type const* const storage_linear::data() const
 	{
 		GLI_ASSERT(!this->empty());
 
-		return &this->Data[0];
+		return this->Data.get();
 	}
 
 	inline storage_linear::size_type storage_linear::base_offset(size_type Layer, size_type Face, size_type Level) const
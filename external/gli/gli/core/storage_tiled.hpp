@@ -0,0 +1,128 @@
+#pragma once
+
+#include "../reader.hpp"
+#include <glm/gtc/bitfield.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace gli
+{
+	/// Texel data of the images of a DDS or KTX file paged in memory one tile at a time, for files too large to be resident.
+	/// Each image is split into square tiles numbered in Morton order, so that the page table entries of neighbor tiles are close.
+	/// Tiles are read from the file with their rows where they are in the images: Morton order only applies to the page table.
+	/// A tile is read from the file the first time one of its texels is accessed. At most capacity() tiles are resident:
+	/// past it, the least recently used tile is evicted to make room. Texels are read only.
+	/// Accesses of resident tiles take no lock, they only pin their tile while they copy a texel. Misses choose a tile to evict
+	/// under a mutex, then read the tile from the file outside of it, so that accesses of other tiles proceed meanwhile.
+	/// Threads missing the tile being read wait for it. Reads of the file are serialized: they go through the same file handle.
+	class storage_tiled
+	{
+	public:
+		typedef extent3d extent_type;
+		typedef size_t size_type;
+		typedef gli::format format_type;
+		typedef gli::target target_type;
+		typedef gli::byte data_type;
+
+	public:
+		/// Create an empty storage
+		storage_tiled();
+
+		/// Open a DDS or KTX file of an uncompressed 1D, 2D or cube map texture or texture array. The storage is empty in case of failure.
+		/// @param Path Path of the file to open including filaname and filename extension
+		/// @param Budget Size in bytes of the resident tiles. At least four tiles are resident, enough for a bilinear footprint.
+		/// @param TileSize Width and height of the tiles in texels, a power of two
+		storage_tiled(char const* Path, size_type Budget, size_type TileSize);
+
+		bool empty() const;
+		target_type target() const;
+		format_type format() const;
+		size_type layers() const;
+		size_type faces() const;
+		size_type levels() const;
+		extent_type extent(size_type Level) const;
+
+		/// Width and height of the tiles in texels
+		size_type tile_size() const;
+
+		/// Size in bytes of the memory of a resident tile
+		size_type tile_bytes() const;
+
+		/// Maximum number of resident tiles
+		size_type capacity() const;
+
+		/// Number of resident tiles
+		size_type resident() const;
+
+		/// Number of tiles read from the file
+		size_type loads() const;
+
+		/// Number of resident tiles evicted to make room for other ones
+		size_type evictions() const;
+
+		/// Copy the texel at TexelCoord of the image identified by Layer, Face and Level into Texel, reading its tile first if it isn't resident.
+		/// Returns false if the tile can't be read from the file.
+		bool load(extent_type const& TexelCoord, size_type Layer, size_type Face, size_type Level, void* Texel);
+
+	private:
+		/// Memory of a tile
+		struct slot
+		{
+			slot();
+
+			/// Page of the tile, InvalidSlot when the slot is free
+			std::atomic<size_type> Page;
+
+			/// Number of threads copying a texel of the tile, Claimed added while the tile is read from the file
+			std::atomic<int> Pins;
+
+			/// Clock of the last access of the tile
+			std::atomic<std::uint64_t> LastUse;
+
+			std::shared_ptr<data_type> Data;
+		};
+
+		size_type page_index(extent_type const& TexelCoord, size_type Layer, size_type Face, size_type Level) const;
+
+		/// Pin the slot if it holds the page and isn't being read, returns whether it did
+		bool pin(std::size_t Slot, size_type Page) const;
+
+		/// Claim a free slot, otherwise the least recently used slot that no thread pins, evicting its page. Returns InvalidSlot if every slot is pinned.
+		std::size_t claim();
+
+		/// Make the page resident in a claimed slot. Returns the slot pinned, or InvalidSlot if the tile can't be read.
+		std::size_t page_in(size_type Page, extent_type const& TexelCoord, size_type Layer, size_type Face, size_type Level);
+
+		static std::size_t const InvalidSlot = static_cast<std::size_t>(-1);
+		static int const Claimed = -(1 << 30);
+
+		reader Reader;
+		size_type TileSize;
+		size_type BlockSize;
+		size_type Capacity;
+
+		/// First page of each image, then the slot of each page or InvalidSlot when it isn't resident
+		std::vector<size_type> ImagePages;
+		std::unique_ptr<std::atomic<std::size_t>[]> Pages;
+
+		std::unique_ptr<slot[]> Slots;
+		std::size_t Used;
+
+		/// Incremented by every miss. Accesses between two misses are equally recent, so that hits only read it.
+		std::atomic<std::uint64_t> Clock;
+
+		size_type Loads;
+		size_type Evictions;
+
+		/// Guards the page table changes and the statistics
+		mutable std::mutex Mutex;
+		std::condition_variable Loaded;
+		std::mutex FileMutex;
+	};
+}//namespace gli
+
+#include "storage_tiled.inl"
@@ -0,0 +1,282 @@
+#include "../allocator.hpp"
+#include <cstring>
+#include <limits>
+#include <thread>
+
+namespace gli
+{
+	inline storage_tiled::slot::slot()
+		: Page(InvalidSlot)
+		, Pins(0)
+		, LastUse(0)
+	{}
+
+	inline storage_tiled::storage_tiled()
+		: TileSize(0)
+		, BlockSize(0)
+		, Capacity(0)
+		, Used(0)
+		, Clock(0)
+		, Loads(0)
+		, Evictions(0)
+	{}
+
+	inline storage_tiled::storage_tiled(char const* Path, size_type Budget, size_type TileSize)
+		: storage_tiled()
+	{
+		GLI_ASSERT(TileSize > 0 && (TileSize & (TileSize - 1)) == 0);
+
+		reader Reader(Path);
+		if(Reader.empty() || is_compressed(Reader.format()) || Reader.extent().z != 1)
+			return;
+
+		// The page table covers a power of two square of tiles per image, the range of the Morton codes of its tiles
+		std::vector<size_type> ImagePages(Reader.layers() * Reader.faces() * Reader.levels() + 1, 0);
+		for(size_type Layer = 0; Layer < Reader.layers(); ++Layer)
+		for(size_type Face = 0; Face < Reader.faces(); ++Face)
+		for(size_type Level = 0; Level < Reader.levels(); ++Level)
+		{
+			size_type const Image = (Layer * Reader.faces() + Face) * Reader.levels() + Level;
+			extent_type const Extent = Reader.extent(Level);
+			size_type const Tiles = (static_cast<size_type>(glm::max(Extent.x, Extent.y)) + TileSize - 1) / TileSize;
+			size_type const Span = static_cast<size_type>(glm::ceilPowerOfTwo(static_cast<glm::uint>(Tiles)));
+			ImagePages[Image + 1] = ImagePages[Image] + Span * Span;
+		}
+
+		this->Reader = Reader;
+		this->TileSize = TileSize;
+		this->BlockSize = block_size(Reader.format());
+		this->Capacity = glm::max(Budget / (TileSize * TileSize * this->BlockSize), static_cast<size_type>(4));
+		this->ImagePages.swap(ImagePages);
+		this->Pages.reset(new std::atomic<std::size_t>[this->ImagePages.back()]);
+		for(size_type Page = 0; Page < this->ImagePages.back(); ++Page)
+			this->Pages[Page].store(InvalidSlot, std::memory_order_relaxed);
+		this->Slots.reset(new slot[this->Capacity]);
+	}
+
+	inline bool storage_tiled::empty() const
+	{
+		return this->Reader.empty();
+	}
+
+	inline storage_tiled::target_type storage_tiled::target() const
+	{
+		return this->Reader.target();
+	}
+
+	inline storage_tiled::format_type storage_tiled::format() const
+	{
+		return this->Reader.format();
+	}
+
+	inline storage_tiled::size_type storage_tiled::layers() const
+	{
+		return this->Reader.layers();
+	}
+
+	inline storage_tiled::size_type storage_tiled::faces() const
+	{
+		return this->Reader.faces();
+	}
+
+	inline storage_tiled::size_type storage_tiled::levels() const
+	{
+		return this->Reader.levels();
+	}
+
+	inline storage_tiled::extent_type storage_tiled::extent(size_type Level) const
+	{
+		return this->Reader.extent(Level);
+	}
+
+	inline storage_tiled::size_type storage_tiled::tile_size() const
+	{
+		return this->TileSize;
+	}
+
+	inline storage_tiled::size_type storage_tiled::tile_bytes() const
+	{
+		return this->TileSize * this->TileSize * this->BlockSize;
+	}
+
+	inline storage_tiled::size_type storage_tiled::capacity() const
+	{
+		return this->Capacity;
+	}
+
+	inline storage_tiled::size_type storage_tiled::resident() const
+	{
+		std::lock_guard<std::mutex> Lock(this->Mutex);
+
+		// Slots being read from the file aren't resident yet
+		size_type Count = 0;
+		for(std::size_t Slot = 0; Slot < this->Used; ++Slot)
+			Count += this->Slots[Slot].Page != InvalidSlot && this->Slots[Slot].Pins >= 0 ? 1 : 0;
+		return Count;
+	}
+
+	inline storage_tiled::size_type storage_tiled::loads() const
+	{
+		std::lock_guard<std::mutex> Lock(this->Mutex);
+		return this->Loads;
+	}
+
+	inline storage_tiled::size_type storage_tiled::evictions() const
+	{
+		std::lock_guard<std::mutex> Lock(this->Mutex);
+		return this->Evictions;
+	}
+
+	inline storage_tiled::size_type storage_tiled::page_index(extent_type const& TexelCoord, size_type Layer, size_type Face, size_type Level) const
+	{
+		size_type const Image = (Layer * this->Reader.faces() + Face) * this->Reader.levels() + Level;
+		glm::uint16 const TileX = static_cast<glm::uint16>(static_cast<size_type>(TexelCoord.x) / this->TileSize);
+		glm::uint16 const TileY = static_cast<glm::uint16>(static_cast<size_type>(TexelCoord.y) / this->TileSize);
+		return this->ImagePages[Image] + glm::bitfieldInterleave(TileX, TileY);
+	}
+
+	inline bool storage_tiled::pin(std::size_t Slot, size_type Page) const
+	{
+		slot& Node = this->Slots[Slot];
+		if(Node.Pins.fetch_add(1) >= 0 && Node.Page.load() == Page)
+			return true;
+
+		Node.Pins.fetch_sub(1);
+		return false;
+	}
+
+	inline std::size_t storage_tiled::claim()
+	{
+		if(this->Used < this->Capacity)
+		{
+			slot& Node = this->Slots[this->Used];
+			Node.Data = uninitialized_allocator().allocate(this->tile_bytes());
+			Node.Pins.store(Claimed);
+			return this->Used++;
+		}
+
+		for(;;)
+		{
+			// Slots that failed to read their tile have no page and the oldest use: they are the first ones reused
+			std::size_t Oldest = InvalidSlot;
+			std::uint64_t OldestUse = std::numeric_limits<std::uint64_t>::max();
+			for(std::size_t Slot = 0; Slot < this->Capacity; ++Slot)
+			{
+				std::uint64_t const LastUse = this->Slots[Slot].LastUse.load(std::memory_order_relaxed);
+				if(this->Slots[Slot].Pins.load() == 0 && LastUse < OldestUse)
+				{
+					Oldest = Slot;
+					OldestUse = LastUse;
+				}
+			}
+			if(Oldest == InvalidSlot)
+				return InvalidSlot;
+
+			// A hit pinned the slot since the scan
+			int Unpinned = 0;
+			slot& Node = this->Slots[Oldest];
+			if(!Node.Pins.compare_exchange_strong(Unpinned, Claimed))
+				continue;
+
+			size_type const Page = Node.Page.load();
+			if(Page != InvalidSlot)
+			{
+				this->Pages[Page].store(InvalidSlot);
+				Node.Page.store(InvalidSlot);
+				++this->Evictions;
+			}
+			return Oldest;
+		}
+	}
+
+	inline std::size_t storage_tiled::page_in(size_type Page, extent_type const& TexelCoord, size_type Layer, size_type Face, size_type Level)
+	{
+		std::unique_lock<std::mutex> Lock(this->Mutex);
+
+		std::size_t Slot = InvalidSlot;
+		while(Slot == InvalidSlot)
+		{
+			// Another thread read the tile since the miss, or is reading it
+			std::size_t const Resident = this->Pages[Page].load();
+			if(Resident != InvalidSlot)
+			{
+				if(this->pin(Resident, Page))
+					return Resident;
+				this->Loaded.wait(Lock);
+				continue;
+			}
+
+			Slot = this->claim();
+			if(Slot != InvalidSlot)
+				break;
+
+			// Every slot is pinned by the copy of a texel or by the read of a tile
+			Lock.unlock();
+			std::this_thread::yield();
+			Lock.lock();
+		}
+
+		slot& Node = this->Slots[Slot];
+		Node.Page.store(Page);
+		Node.LastUse.store(++this->Clock, std::memory_order_relaxed);
+		this->Pages[Page].store(Slot);
+		Lock.unlock();
+
+		extent_type const Tile(extent_type::value_type(this->TileSize));
+		extent_type const Offset = TexelCoord / Tile * Tile;
+		extent_type const Extent = glm::min(this->Reader.extent(Level) - Offset, Tile);
+		bool Read = false;
+		{
+			std::lock_guard<std::mutex> FileLock(this->FileMutex);
+			Read = this->Reader.read(Layer, Face, Level, extent_type(Offset.x, Offset.y, 0), extent_type(Extent.x, Extent.y, 1), Node.Data.get());
+		}
+
+		Lock.lock();
+		if(Read)
+		{
+			++this->Loads;
+			Node.Pins.fetch_sub(Claimed - 1);
+		}
+		else
+		{
+			this->Pages[Page].store(InvalidSlot);
+			Node.Page.store(InvalidSlot);
+			Node.LastUse.store(0, std::memory_order_relaxed);
+			Node.Pins.fetch_sub(Claimed);
+		}
+		Lock.unlock();
+		this->Loaded.notify_all();
+
+		return Read ? Slot : InvalidSlot;
+	}
+
+	inline bool storage_tiled::load(extent_type const& TexelCoord, size_type Layer, size_type Face, size_type Level, void* Texel)
+	{
+		GLI_ASSERT(!this->empty() && Texel);
+		GLI_ASSERT(Layer < this->layers() && Face < this->faces() && Level < this->levels());
+		GLI_ASSERT(glm::all(glm::lessThan(TexelCoord, this->extent(Level))));
+
+		size_type const Page = this->page_index(TexelCoord, Layer, Face, Level);
+		std::size_t Slot = this->Pages[Page].load();
+		if(Slot == InvalidSlot || !this->pin(Slot, Page))
+		{
+			Slot = this->page_in(Page, TexelCoord, Layer, Face, Level);
+			if(Slot == InvalidSlot)
+				return false;
+		}
+
+		slot& Node = this->Slots[Slot];
+		std::uint64_t const Now = this->Clock.load(std::memory_order_relaxed);
+		if(Node.LastUse.load(std::memory_order_relaxed) != Now)
+			Node.LastUse.store(Now, std::memory_order_relaxed);
+
+		// Tiles are stored without padding: the tiles of the right and bottom edges can be narrower
+		extent_type::value_type const Tile = static_cast<extent_type::value_type>(this->TileSize);
+		extent_type::value_type const Width = glm::min(this->Reader.extent(Level).x - TexelCoord.x / Tile * Tile, Tile);
+		size_type const Index = static_cast<size_type>(TexelCoord.y % Tile) * Width + TexelCoord.x % Tile;
+		std::memcpy(Texel, Node.Data.get() + Index * this->BlockSize, this->BlockSize);
+
+		Node.Pins.fetch_sub(1);
+		return true;
+	}
+}//namespace gli
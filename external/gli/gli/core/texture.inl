@@ -36,6 +36,54 @@ namespace gli
 		GLI_ASSERT(Target != TARGET_CUBE_ARRAY || (Target == TARGET_CUBE_ARRAY && Extent.x == Extent.y));
 	}
 
+	inline texture::texture
+	(
+		target_type Target,
+		format_type Format,
+		extent_type const& Extent,
+		size_type Layers,
+		size_type Faces,
+		size_type Levels,
+		storage_allocator& Allocator,
+		swizzles_type const& Swizzles
+	)
+		: Storage(std::make_shared<storage_type>(Format, Extent, Layers, Faces, Levels, Allocator))
+		, Target(Target)
+		, Format(Format)
+		, BaseLayer(0), MaxLayer(Layers - 1)
+		, BaseFace(0), MaxFace(Faces - 1)
+		, BaseLevel(0), MaxLevel(Levels - 1)
+		, Swizzles(Swizzles)
+		, Cache(*Storage, Format, this->base_layer(), this->layers(), this->base_face(), this->max_face(), this->base_level(), this->max_level())
+	{
+		GLI_ASSERT(Target != TARGET_CUBE || (Target == TARGET_CUBE && Extent.x == Extent.y));
+		GLI_ASSERT(Target != TARGET_CUBE_ARRAY || (Target == TARGET_CUBE_ARRAY && Extent.x == Extent.y));
+	}
+
+	inline texture::texture
+	(
+		target_type Target,
+		format_type Format,
+		extent_type const& Extent,
+		size_type Layers,
+		size_type Faces,
+		size_type Levels,
+		std::shared_ptr<data_type> const& Memory,
+		swizzles_type const& Swizzles
+	)
+		: Storage(std::make_shared<storage_type>(Format, Extent, Layers, Faces, Levels, Memory))
+		, Target(Target)
+		, Format(Format)
+		, BaseLayer(0), MaxLayer(Layers - 1)
+		, BaseFace(0), MaxFace(Faces - 1)
+		, BaseLevel(0), MaxLevel(Levels - 1)
+		, Swizzles(Swizzles)
+		, Cache(*Storage, Format, this->base_layer(), this->layers(), this->base_face(), this->max_face(), this->base_level(), this->max_level())
+	{
+		GLI_ASSERT(Target != TARGET_CUBE || (Target == TARGET_CUBE && Extent.x == Extent.y));
+		GLI_ASSERT(Target != TARGET_CUBE_ARRAY || (Target == TARGET_CUBE_ARRAY && Extent.x == Extent.y));
+	}
+
 	inline texture::texture
 	(
 		texture const& Texture,
@@ -0,0 +1,88 @@
+namespace gli
+{
+	inline texture_cube_tiled::texture_cube_tiled()
+	{}
+
+	inline texture_cube_tiled::texture_cube_tiled(char const* Path, size_type Budget, size_type TileSize)
+	{
+		std::shared_ptr<storage_tiled> const Storage(new storage_tiled(Path, Budget, TileSize));
+		if(!Storage->empty() && Storage->target() == TARGET_CUBE)
+			this->Storage = Storage;
+	}
+
+	inline texture_cube_tiled::texture_cube_tiled(std::string const& Path, size_type Budget, size_type TileSize)
+		: texture_cube_tiled(Path.c_str(), Budget, TileSize)
+	{}
+
+	inline bool texture_cube_tiled::empty() const
+	{
+		return this->Storage == nullptr;
+	}
+
+	inline texture_cube_tiled::target_type texture_cube_tiled::target() const
+	{
+		return TARGET_CUBE;
+	}
+
+	inline texture_cube_tiled::format_type texture_cube_tiled::format() const
+	{
+		return this->empty() ? FORMAT_UNDEFINED : this->Storage->format();
+	}
+
+	inline texture_cube_tiled::size_type texture_cube_tiled::base_face() const
+	{
+		return 0;
+	}
+
+	inline texture_cube_tiled::size_type texture_cube_tiled::max_face() const
+	{
+		return this->faces() - 1;
+	}
+
+	inline texture_cube_tiled::size_type texture_cube_tiled::faces() const
+	{
+		return this->empty() ? 0 : this->Storage->faces();
+	}
+
+	inline texture_cube_tiled::size_type texture_cube_tiled::base_level() const
+	{
+		return 0;
+	}
+
+	inline texture_cube_tiled::size_type texture_cube_tiled::max_level() const
+	{
+		return this->levels() - 1;
+	}
+
+	inline texture_cube_tiled::size_type texture_cube_tiled::levels() const
+	{
+		return this->empty() ? 0 : this->Storage->levels();
+	}
+
+	inline texture_cube_tiled::extent_type texture_cube_tiled::extent(size_type Level) const
+	{
+		GLI_ASSERT(!this->empty());
+
+		return extent_type(this->Storage->extent(Level));
+	}
+
+	inline storage_tiled const& texture_cube_tiled::storage() const
+	{
+		GLI_ASSERT(!this->empty());
+
+		return *this->Storage;
+	}
+
+	template <typename gen_type>
+	inline gen_type texture_cube_tiled::load(extent_type const& TexelCoord, size_type Face, size_type Level) const
+	{
+		GLI_ASSERT(!this->empty());
+		GLI_ASSERT(block_size(this->format()) == sizeof(gen_type));
+
+		// Texels of tiles that can't be read from the file are null
+		gen_type Texel;
+		if(!this->Storage->load(storage_tiled::extent_type(TexelCoord, 0), 0, Face, Level, &Texel))
+			std::memset(&Texel, 0, sizeof(Texel));
+		return Texel;
+	}
+}//namespace gli
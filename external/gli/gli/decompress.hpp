@@ -0,0 +1,30 @@
+/// @brief Include to decompress BC1 to BC5 textures on the CPU.
+/// @file gli/decompress.hpp
+
+#pragma once
+
+#include "texture1d.hpp"
+#include "texture1d_array.hpp"
+#include "texture2d.hpp"
+#include "texture2d_array.hpp"
+#include "texture3d.hpp"
+#include "texture_cube.hpp"
+#include "texture_cube_array.hpp"
+
+namespace gli
+{
+	/// Decompress every layer, face and level of a BC1 to BC5 (DXT1, DXT3, DXT5, ATI1N, ATI2N) texture.
+	/// Each block is decoded once and written straight into the destination rows, blocks rows are spread across the hardware threads.
+	/// The result is bit-identical to packing the texels returned by the reference block decoders of gli/core/bc.hpp.
+	/// Returns an empty texture if the source format or destination format is not supported.
+	///
+	/// @param Texture Source texture, the format must be one of the BC1 to BC5 formats.
+	/// @param Format Destination texture format: FORMAT_RGBA8_UNORM_PACK8, FORMAT_RGBA8_SRGB_PACK8, FORMAT_RGBA8_SNORM_PACK8, FORMAT_RGBA16_SFLOAT_PACK16 or FORMAT_RGBA32_SFLOAT_PACK32.
+	template <typename texture_type>
+	texture_type decompress(texture_type const& Texture, format Format);
+
+	/// Return whether decompress supports decompressing a texture of format Source to the format Destination
+	bool is_decompressible(format Source, format Destination);
+}//namespace gli
+
+#include "./core/decompress.inl"
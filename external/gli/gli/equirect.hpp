@@ -0,0 +1,35 @@
+/// @brief Include to resample equirectangular (latitude-longitude) panoramas into cube maps.
+/// @file gli/equirect.hpp
+
+#pragma once
+
+#include "texture2d.hpp"
+#include "texture_cube.hpp"
+
+namespace gli
+{
+	/// Resample an equirectangular panorama into a cube map with the face layout of sampler_cube_batch.
+	/// The panorama covers the longitudes from left to right and the latitudes from +Y on the first row to -Y on the last one:
+	/// the direction (x, y, z) is at u = 0.5 + atan2(x, -z) / (2 pi) and v = 0.5 - asin(y) / pi, so the center of the panorama faces -Z.
+	///
+	/// Each texel of the result averages Samples x Samples bilinear taps of the panorama spread over the texel, which wrap around
+	/// horizontally. A single sample is enough when the faces have about as many texels as the panorama covers; more samples
+	/// avoid aliasing when the faces are smaller. Tiles of texels of every face are spread across the hardware threads,
+	/// their directions and panorama coordinates are computed four texels at once.
+	///
+	/// @param Texture Panorama, FORMAT_RGBA32_SFLOAT_PACK32, FORMAT_RGB32_SFLOAT_PACK32, FORMAT_RGBA16_SFLOAT_PACK16 or FORMAT_RGB16_SFLOAT_PACK16
+	/// without conversion, or any other uncompressed format supported by convert or compressed format supported by decompress.
+	/// @param Size Size of the faces of the first level of the result.
+	/// @param Format Result format: FORMAT_RGBA16_SFLOAT_PACK16, FORMAT_RGBA32_SFLOAT_PACK32, FORMAT_RGBA8_UNORM_PACK8 or FORMAT_RGBA8_SRGB_PACK8.
+	/// @param Samples Number of samples of each texel along each axis, at least 1.
+	/// @param Levels Number of levels of the result, at most levels(Size). The levels after the first one are generated with a box filter.
+	/// Returns an empty texture if the texture format or the result format is not supported.
+	texture_cube equirect_to_cube(
+		texture2d const& Texture,
+		texture_cube::extent_type::value_type Size,
+		format Format = FORMAT_RGBA16_SFLOAT_PACK16,
+		int Samples = 1,
+		texture_cube::size_type Levels = 1);
+}//namespace gli
+
+#include "./core/equirect.inl"
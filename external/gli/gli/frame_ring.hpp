@@ -0,0 +1,142 @@
+/// @brief Include to sub-allocate transient per-frame data, such as uniform blocks, in a buffer shared by the frames in flight.
+/// @file gli/frame_ring.hpp
+
+#pragma once
+
+#include "type.hpp"
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <vector>
+
+namespace gli
+{
+	/// Backend of the frame fences: a fence is signaled once the GPU executed the commands submitted before it
+	class fence_backend
+	{
+	public:
+		virtual ~fence_backend() {}
+
+		/// Insert a fence after the commands submitted so far, returns its handle
+		virtual std::uint64_t insert() = 0;
+
+		/// Wait at most Timeout nanoseconds for the fence Fence, returns whether it is signaled. A zero timeout polls.
+		virtual bool wait(std::uint64_t Fence, std::uint64_t Timeout) = 0;
+
+		/// Delete the fence Fence, which is no longer waited on
+		virtual void release(std::uint64_t Fence) = 0;
+	};
+
+	/// Fences signaled explicitly, in insertion order, by any thread: the backend of renderers running on the CPU and of tests
+	class manual_fence_backend : public fence_backend
+	{
+	public:
+		manual_fence_backend();
+
+		std::uint64_t insert();
+		bool wait(std::uint64_t Fence, std::uint64_t Timeout);
+		void release(std::uint64_t Fence);
+
+		/// Signal the fences inserted up to Fence included
+		void signal(std::uint64_t Fence);
+
+		/// Signal every fence inserted so far
+		void signal_all();
+
+		/// Number of fences inserted and not released yet
+		std::size_t pending() const;
+
+	private:
+		mutable std::mutex Mutex;
+		std::condition_variable Signaled;
+		std::uint64_t Inserted;
+		std::uint64_t Completed;
+		std::size_t Pending;
+	};
+
+	/// Sub-allocation of a frame ring
+	struct frame_allocation
+	{
+		/// Offset in the buffer, to bind the range
+		std::size_t Offset;
+
+		/// Size in bytes
+		std::size_t Size;
+
+		/// Mapped memory of the allocation, nullptr when the allocation failed
+		void* Data;
+	};
+
+	/// Linear allocator of transient per-frame data in a persistently mapped buffer, split in a region per frame in flight.
+	/// Each frame allocates in the next region. The fence inserted by end_frame guards the region until the GPU consumed it,
+	/// and begin_frame waits for that fence before the region is reused, Frames frames later.
+	/// The ring doesn't map, flush nor bind the buffer so that it doesn't depend on the graphics API.
+	class frame_ring
+	{
+	public:
+		/// @param Data Persistently mapped memory of the buffer
+		/// @param Size Size of the buffer in bytes
+		/// @param Frames Number of frames in flight, at least one
+		/// @param Alignment Alignment of the allocation offsets, such as GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT
+		/// @param Fences Fence backend, which must outlive the ring
+		frame_ring(void* Data, std::size_t Size, std::size_t Frames, std::size_t Alignment, fence_backend& Fences);
+
+		/// Release the fences still pending
+		~frame_ring();
+
+		/// Begin the next frame, waiting at most Timeout nanoseconds for the GPU to consume its region.
+		/// On timeout, returns false and allocations fail until a later begin_frame succeeds.
+		bool begin_frame(std::uint64_t Timeout = std::numeric_limits<std::uint64_t>::max());
+
+		/// Allocate Size bytes at an aligned offset of the region of the current frame.
+		/// Fails with a nullptr Data outside of a frame or when the region is full.
+		frame_allocation allocate(std::size_t Size);
+
+		/// Allocate and copy Value, a trivially copyable object
+		template <typename T>
+		frame_allocation push(T const& Value);
+
+		/// End the current frame, inserting the fence that guards its region
+		void end_frame();
+
+		/// Number of frames in flight
+		std::size_t frames() const;
+
+		/// Size in bytes of the region of each frame
+		std::size_t frame_capacity() const;
+
+		/// Bytes allocated in the current frame, including the alignment padding
+		std::size_t used() const;
+
+		/// Number of begin_frame calls that had to wait for the GPU
+		std::size_t stalls() const;
+
+		/// Number of allocations that failed because the region of their frame was full
+		std::size_t overflows() const;
+
+	private:
+		frame_ring(frame_ring const&) = delete;
+		frame_ring& operator=(frame_ring const&) = delete;
+
+		struct region
+		{
+			std::uint64_t Fence;
+			bool Guarded;
+		};
+
+		unsigned char* const Data;
+		std::size_t const Alignment;
+		std::size_t const Capacity;
+		fence_backend& Fences;
+		std::vector<region> Regions;
+		std::size_t Frame;
+		std::size_t Offset;
+		bool Active;
+		std::size_t Stalls;
+		std::size_t Overflows;
+	};
+}//namespace gli
+
+#include "./core/frame_ring.inl"
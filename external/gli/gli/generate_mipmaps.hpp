@@ -11,6 +11,7 @@
 #include "texture_cube.hpp"
 #include "texture_cube_array.hpp"
 #include "sampler.hpp"
+#include <vector>
 
 namespace gli
 {
@@ -64,6 +65,76 @@ namespace gli
 		texture_cube_array::size_type BaseFace, texture_cube_array::size_type MaxFace,
 		texture_cube_array::size_type BaseLevel, texture_cube_array::size_type MaxLevel,
 		filter Minification);
+
+	/// Allocate a texture and generate the mipmaps of the texture from the BaseLevel to the MaxLevel included using a separable downsampling filter.
+	/// Only power of two images of RGBA8_UNORM, RGBA16_SFLOAT and RGBA32_SFLOAT formats are supported, other textures return an empty texture.
+	texture2d generate_mipmaps(
+		texture2d const& Texture,
+		texture2d::size_type BaseLevel, texture2d::size_type MaxLevel,
+		mipmap_filter Filter);
+
+	/// Allocate a texture and generate the mipmaps of the texture from the BaseLayer to the MaxLayer and from the BaseLevel to the MaxLevel included levels using a separable downsampling filter.
+	/// Only power of two images of RGBA8_UNORM, RGBA16_SFLOAT and RGBA32_SFLOAT formats are supported, other textures return an empty texture.
+	texture2d_array generate_mipmaps(
+		texture2d_array const& Texture,
+		texture2d_array::size_type BaseLayer, texture2d_array::size_type MaxLayer,
+		texture2d_array::size_type BaseLevel, texture2d_array::size_type MaxLevel,
+		mipmap_filter Filter);
+
+	/// Allocate a texture and generate the mipmaps of the texture from the BaseFace to the MaxFace and from the BaseLevel to the MaxLevel included levels using a separable downsampling filter.
+	/// Only power of two images of RGBA8_UNORM, RGBA16_SFLOAT and RGBA32_SFLOAT formats are supported, other textures return an empty texture.
+	texture_cube generate_mipmaps(
+		texture_cube const& Texture,
+		texture_cube::size_type BaseFace, texture_cube::size_type MaxFace,
+		texture_cube::size_type BaseLevel, texture_cube::size_type MaxLevel,
+		mipmap_filter Filter);
+
+	/// Allocate a texture and generate the mipmaps of the texture from the BaseLayer to the MaxLayer, from the BaseFace to the MaxFace and from the BaseLevel to the MaxLevel included levels using a separable downsampling filter.
+	/// Only power of two images of RGBA8_UNORM, RGBA16_SFLOAT and RGBA32_SFLOAT formats are supported, other textures return an empty texture.
+	texture_cube_array generate_mipmaps(
+		texture_cube_array const& Texture,
+		texture_cube_array::size_type BaseLayer, texture_cube_array::size_type MaxLayer,
+		texture_cube_array::size_type BaseFace, texture_cube_array::size_type MaxFace,
+		texture_cube_array::size_type BaseLevel, texture_cube_array::size_type MaxLevel,
+		mipmap_filter Filter);
+
+	/// Allocate a texture and generate all the mipmaps of the texture using a separable downsampling filter, an empty texture if the texture isn't supported.
+	texture2d generate_mipmaps(texture2d const& Texture, mipmap_filter Filter);
+
+	/// Allocate a texture and generate all the mipmaps of the texture using a separable downsampling filter, an empty texture if the texture isn't supported.
+	texture2d_array generate_mipmaps(texture2d_array const& Texture, mipmap_filter Filter);
+
+	/// Allocate a texture and generate all the mipmaps of the texture using a separable downsampling filter, an empty texture if the texture isn't supported.
+	texture_cube generate_mipmaps(texture_cube const& Texture, mipmap_filter Filter);
+
+	/// Allocate a texture and generate all the mipmaps of the texture using a separable downsampling filter, an empty texture if the texture isn't supported.
+	texture_cube_array generate_mipmaps(texture_cube_array const& Texture, mipmap_filter Filter);
+
+	/// Rectangle of texels of a face and a level of a cube map
+	struct cube_region
+	{
+		texture_cube::size_type Face;
+		texture_cube::size_type Level;
+		texture_cube::extent_type Offset;
+		texture_cube::extent_type Extent;
+	};
+
+	/// Update in place the mipmaps of a cube map after the texels of Regions changed, using the Minification filter.
+	/// Only the texels of the levels below whose filter footprint reads a changed texel are generated again, level by level,
+	/// with the same results as generate_mipmaps(Texture, Minification): the cost is proportional to the regions, not to the texture.
+	/// Returns the regions of texels written, the changed Regions included, merged per face and level, to upload only these.
+	std::vector<cube_region> update_mipmaps(
+		texture_cube& Texture,
+		std::vector<cube_region> const& Regions,
+		filter Minification);
+
+	/// Update in place the mipmaps of a cube map after the texels of Regions changed, using a separable downsampling filter,
+	/// with the same results as generate_mipmaps(Texture, Filter).
+	/// Returns an empty list without writing anything if generate_mipmaps(Texture, Filter) doesn't support the texture.
+	std::vector<cube_region> update_mipmaps(
+		texture_cube& Texture,
+		std::vector<cube_region> const& Regions,
+		mipmap_filter Filter);
 }//namespace gli
 
 #include "./core/generate_mipmaps.inl"
@@ -49,6 +49,7 @@ namespace gli
 #include "texture3d.hpp"
 #include "texture_cube.hpp"
 #include "texture_cube_array.hpp"
+#include "texture_cube_tiled.hpp"
 
 #include "sampler1d.hpp"
 #include "sampler1d_array.hpp"
@@ -57,9 +58,12 @@ namespace gli
 #include "sampler3d.hpp"
 #include "sampler_cube.hpp"
 #include "sampler_cube_array.hpp"
+#include "sampler_cube_batch.hpp"
 
 #include "duplicate.hpp"
 #include "convert.hpp"
+#include "decompress.hpp"
+#include "compress.hpp"
 #include "view.hpp"
 #include "comparison.hpp"
 
@@ -67,6 +71,17 @@ namespace gli
 #include "transform.hpp"
 
 #include "load.hpp"
+#include "allocator.hpp"
+#include "cache.hpp"
+#include "frame_ring.hpp"
+#include "job_system.hpp"
+#include "loader.hpp"
+#include "profiler.hpp"
+#include "residency.hpp"
+#include "reader.hpp"
+#include "render_cube.hpp"
+#include "lighting.hpp"
+#include "equirect.hpp"
 #include "save.hpp"
 
 #include "gl.hpp"
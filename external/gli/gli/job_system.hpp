@@ -0,0 +1,76 @@
+/// @brief Include to run jobs on a pool of worker threads that steal work from each other.
+/// @file gli/job_system.hpp
+
+#pragma once
+
+#include "./core/parallel.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace gli
+{
+	/// Pool of worker threads running jobs submitted by any thread.
+	/// Each worker owns a queue: jobs submitted by a worker go to its own queue and run last in first out,
+	/// jobs submitted by other threads are spread across the queues. A worker with an empty queue steals
+	/// the oldest job of another queue, so that long jobs don't hold back the jobs queued behind them.
+	class job_system
+	{
+	public:
+		typedef std::function<void()> job;
+
+		/// Start Threads worker threads, at least one
+		explicit job_system(std::size_t Threads = detail::thread_count());
+
+		/// Run the jobs still queued then stop the worker threads
+		~job_system();
+
+		/// Queue a job. Jobs may submit other jobs.
+		void submit(job const& Job);
+
+		/// Run queued jobs on the calling thread until every submitted job completed, including the jobs they submit.
+		/// Must not be called from a job.
+		void wait();
+
+		/// Number of worker threads
+		std::size_t threads() const;
+
+	private:
+		job_system(job_system const&) = delete;
+		job_system& operator=(job_system const&) = delete;
+
+		struct job_queue
+		{
+			std::mutex Mutex;
+			std::deque<job> Jobs;
+		};
+
+		/// Take the newest job of the queue Queue
+		bool pop(std::size_t Queue, job& Job);
+
+		/// Take the oldest job of any queue, starting after the queue Thief
+		bool steal(std::size_t Thief, job& Job);
+
+		void execute(job const& Job);
+		void run(std::size_t Queue);
+
+		std::vector<std::unique_ptr<job_queue>> Queues;
+		std::vector<std::thread> Workers;
+		std::mutex Mutex;
+		std::condition_variable Wake;
+		std::condition_variable Idle;
+		/// Number of jobs in the queues, changed under the lock of the queue of the job
+		std::atomic<std::size_t> Queued;
+		std::atomic<std::size_t> Pending;
+		std::atomic<std::size_t> Next;
+		bool Stop;
+	};
+}//namespace gli
+
+#include "./core/job_system.inl"
@@ -0,0 +1,47 @@
+/// @brief Include to precompute image based lighting from cube map textures: spherical harmonics irradiance and GGX prefiltered mipmaps.
+/// @file gli/lighting.hpp
+
+#pragma once
+
+#include "texture_cube.hpp"
+
+namespace gli
+{
+	/// Third order spherical harmonics of an RGB signal on the sphere: the 9 coefficients of the bands 0 to 2.
+	/// Coefficients are ordered by band then by order: Y00, Y1-1, Y10, Y11, Y2-2, Y2-1, Y20, Y21, Y22.
+	struct spherical_harmonics
+	{
+		vec3 Coefficients[9];
+
+		/// Value of the band limited signal in the normalized direction Direction
+		vec3 evaluate(vec3 const& Direction) const;
+
+		/// Irradiance received by a surface of normalized normal Normal: the signal convolved with the clamped cosine lobe.
+		/// The radiance reflected by a lambertian surface of albedo Albedo is Albedo * irradiance(Normal) / pi.
+		vec3 irradiance(vec3 const& Normal) const;
+	};
+
+	/// Project the radiance of a cube map on third order spherical harmonics, each texel weighted by its solid angle.
+	/// The projection reads the first level at most MaxExtent texels wide: spherical harmonics of band 2 don't carry
+	/// the details of the larger levels, and mipmaps keep the mean of the texels. Rows of texels are spread across the
+	/// hardware threads, texel directions and basis functions are computed four texels at once.
+	///
+	/// @param Texture Cube map of an uncompressed format supported by convert, or of a BC1 to BC5 format. sRGB texels are linearized.
+	spherical_harmonics project_spherical_harmonics(texture_cube const& Texture, texture_cube::extent_type::value_type MaxExtent = 256);
+
+	/// Prefilter a cube map with the GGX distribution for split sum image based lighting: the level Level of the result holds
+	/// the radiance convolved with a GGX lobe of roughness Level / (Levels - 1) around the view direction, taken as the normal.
+	/// Each texel importance samples the lobe with SampleCount directions. Samples read a source level matching their solid
+	/// angle (filtered importance sampling), so the source needs mipmaps; they are generated when Texture has a single level.
+	/// Tiles of texels of every level and face are spread across the hardware threads.
+	/// Returns an empty texture if the texture format or the result format is not supported.
+	///
+	/// @param Texture Cube map of an uncompressed format supported by convert, or of a BC1 to BC5 format. sRGB texels are linearized.
+	/// @param Format Result format: FORMAT_RGBA8_UNORM_PACK8, FORMAT_RGBA8_SRGB_PACK8, FORMAT_RGBA16_SFLOAT_PACK16 or FORMAT_RGBA32_SFLOAT_PACK32.
+	/// @param Extent Size of the faces of the first level of the result.
+	/// @param Levels Number of levels of the result, at most levels(Extent).
+	/// @param SampleCount Number of GGX samples of each texel of the levels after the first one.
+	texture_cube prefilter_ggx(texture_cube const& Texture, format Format, texture_cube::extent_type const& Extent, texture_cube::size_type Levels, size_t SampleCount = 128);
+}//namespace gli
+
+#include "./core/lighting.inl"
@@ -10,18 +10,32 @@ namespace gli
 	/// Loads a texture storage_linear from file. Returns an empty storage_linear in case of failure.
 	///
 	/// @param Path Path of the file to open including filaname and filename extension
-	texture load(char const* Path);
+	/// @param Allocator Source of the memory of the texel data, left uninitialized by default as the loader overwrites all of it
+	texture load(char const* Path, storage_allocator& Allocator = uninitialized_allocator());
 
 	/// Loads a texture storage_linear from file. Returns an empty storage_linear in case of failure.
 	///
 	/// @param Path Path of the file to open including filaname and filename extension
-	texture load(std::string const& Path);
+	/// @param Allocator Source of the memory of the texel data, left uninitialized by default as the loader overwrites all of it
+	texture load(std::string const& Path, storage_allocator& Allocator = uninitialized_allocator());
 
 	/// Loads a texture storage_linear from memory. Returns an empty storage_linear in case of failure.
 	///
 	/// @param Data Data of a texture
 	/// @param Size Size of the data
-	texture load(char const* Data, std::size_t Size);
+	/// @param Allocator Source of the memory of the texel data, left uninitialized by default as the loader overwrites all of it
+	texture load(char const* Data, std::size_t Size, storage_allocator& Allocator = uninitialized_allocator());
+
+	/// Loads a texture storage_linear from a file mapped in memory. Returns an empty storage_linear in case of failure.
+	/// DDS texel data is borrowed from the mapping without copy, KTX and KMG are copied once from the mapping.
+	///
+	/// @param Path Path of the file to open including filaname and filename extension
+	texture load_mapped(char const* Path);
+
+	/// Loads a texture storage_linear from a file mapped in memory. Returns an empty storage_linear in case of failure.
+	///
+	/// @param Path Path of the file to open including filaname and filename extension
+	texture load_mapped(std::string const& Path);
 }//namespace gli
 
 #include "./core/load.inl"
@@ -10,18 +10,34 @@ namespace gli
 	/// Loads a texture storage_linear from DDS file. Returns an empty storage_linear in case of failure.
 	///
 	/// @param Path Path of the file to open including filaname and filename extension
-	texture load_dds(char const* Path);
+	/// @param Allocator Source of the memory of the texel data, left uninitialized by default as the loader overwrites all of it
+	texture load_dds(char const* Path, storage_allocator& Allocator = uninitialized_allocator());
 
 	/// Loads a texture storage_linear from DDS file. Returns an empty storage_linear in case of failure.
 	///
 	/// @param Path Path of the file to open including filaname and filename extension
-	texture load_dds(std::string const& Path);
+	/// @param Allocator Source of the memory of the texel data, left uninitialized by default as the loader overwrites all of it
+	texture load_dds(std::string const& Path, storage_allocator& Allocator = uninitialized_allocator());
 
 	/// Loads a texture storage_linear from DDS memory. Returns an empty storage_linear in case of failure.
 	///
 	/// @param Data Pointer to the beginning of the texture container data to read
 	/// @param Size Size of texture container Data to read
-	texture load_dds(char const* Data, std::size_t Size);
+	/// @param Allocator Source of the memory of the texel data, left uninitialized by default as the loader overwrites all of it
+	texture load_dds(char const* Data, std::size_t Size, storage_allocator& Allocator = uninitialized_allocator());
+
+	/// Loads a texture storage_linear from a DDS file mapped in memory. Returns an empty storage_linear in case of failure.
+	/// The texture borrows the texel data from the mapping so that only the header is parsed at load time and
+	/// the pages of each image are read from the file when they are first accessed.
+	/// The mapping stays alive as long as the texture or any of its views. Writing into the texture never modifies the file.
+	///
+	/// @param Path Path of the file to open including filaname and filename extension
+	texture load_dds_mapped(char const* Path);
+
+	/// Loads a texture storage_linear from a DDS file mapped in memory. Returns an empty storage_linear in case of failure.
+	///
+	/// @param Path Path of the file to open including filaname and filename extension
+	texture load_dds_mapped(std::string const& Path);
 }//namespace gli
 
 #include "./core/load_dds.inl"
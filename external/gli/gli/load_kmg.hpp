@@ -10,18 +10,21 @@ namespace gli
 	/// Loads a texture storage_linear from KMG (Khronos Image) file. Returns an empty storage_linear in case of failure.
 	///
 	/// @param Path Path of the file to open including filaname and filename extension
-	texture load_kmg(char const* Path);
+	/// @param Allocator Source of the memory of the texel data, left uninitialized by default as the loader overwrites all of it
+	texture load_kmg(char const* Path, storage_allocator& Allocator = uninitialized_allocator());
 
 	/// Loads a texture storage_linear from KMG (Khronos Image) file. Returns an empty storage_linear in case of failure.
 	///
 	/// @param Path Path of the file to open including filaname and filename extension
-	texture load_kmg(std::string const& Path);
+	/// @param Allocator Source of the memory of the texel data, left uninitialized by default as the loader overwrites all of it
+	texture load_kmg(std::string const& Path, storage_allocator& Allocator = uninitialized_allocator());
 
 	/// Loads a texture storage_linear from KMG (Khronos Image) memory. Returns an empty storage_linear in case of failure.
 	///
 	/// @param Data Pointer to the beginning of the texture container data to read
 	/// @param Size Size of texture container Data to read
-	texture load_kmg(char const* Data, std::size_t Size);
+	/// @param Allocator Source of the memory of the texel data, left uninitialized by default as the loader overwrites all of it
+	texture load_kmg(char const* Data, std::size_t Size, storage_allocator& Allocator = uninitialized_allocator());
 }//namespace gli
 
 #include "./core/load_kmg.inl"
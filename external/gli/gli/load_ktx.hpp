@@ -10,18 +10,32 @@ namespace gli
 	/// Loads a texture storage_linear from KTX file. Returns an empty storage_linear in case of failure.
 	///
 	/// @param Path Path of the file to open including filaname and filename extension
-	texture load_ktx(char const* Path);
+	/// @param Allocator Source of the memory of the texel data, left uninitialized by default as the loader overwrites all of it
+	texture load_ktx(char const* Path, storage_allocator& Allocator = uninitialized_allocator());
 
 	/// Loads a texture storage_linear from KTX file. Returns an empty storage_linear in case of failure.
 	///
 	/// @param Path Path of the file to open including filaname and filename extension
-	texture load_ktx(std::string const& Path);
+	/// @param Allocator Source of the memory of the texel data, left uninitialized by default as the loader overwrites all of it
+	texture load_ktx(std::string const& Path, storage_allocator& Allocator = uninitialized_allocator());
 
 	/// Loads a texture storage_linear from KTX memory. Returns an empty storage_linear in case of failure.
 	///
 	/// @param Data Pointer to the beginning of the texture container data to read
 	/// @param Size Size of texture container Data to read
-	texture load_ktx(char const* Data, std::size_t Size);
+	/// @param Allocator Source of the memory of the texel data, left uninitialized by default as the loader overwrites all of it
+	texture load_ktx(char const* Data, std::size_t Size, storage_allocator& Allocator = uninitialized_allocator());
+
+	/// Loads a texture storage_linear from a KTX file mapped in memory. Returns an empty storage_linear in case of failure.
+	/// KTX stores each level with a size prefix and padding so texels are copied once from the mapping, skipping the intermediate file read buffer.
+	///
+	/// @param Path Path of the file to open including filaname and filename extension
+	texture load_ktx_mapped(char const* Path);
+
+	/// Loads a texture storage_linear from a KTX file mapped in memory. Returns an empty storage_linear in case of failure.
+	///
+	/// @param Path Path of the file to open including filaname and filename extension
+	texture load_ktx_mapped(std::string const& Path);
 }//namespace gli
 
 #include "./core/load_ktx.inl"
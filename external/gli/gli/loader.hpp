@@ -0,0 +1,110 @@
+/// @brief Include to load textures and files on worker threads and hand them over to the thread owning the graphics API as upload commands.
+/// @file gli/loader.hpp
+
+#pragma once
+
+#include "cache.hpp"
+#include "job_system.hpp"
+#include "texture.hpp"
+#include <chrono>
+#include <deque>
+#include <string>
+
+namespace gli
+{
+	/// Kind of the upload commands
+	enum upload_kind
+	{
+		UPLOAD_TEXTURE,	///< Create the storage of Texture: target, format, extent, layers, faces, levels and swizzles
+		UPLOAD_IMAGE,	///< Upload the image Layer, Face, Level of Texture
+		UPLOAD_FILE,	///< Content of a file, in Data
+		UPLOAD_DONE,	///< Last command of an asset that loaded
+		UPLOAD_FAILED	///< Only command of an asset that failed to load
+	};
+
+	/// Backend agnostic command produced by the loader workers and executed by the thread owning the graphics API
+	struct upload_command
+	{
+		upload_command()
+			: Kind(UPLOAD_FAILED)
+			, Asset(0)
+			, Layer(0)
+			, Face(0)
+			, Level(0)
+		{}
+
+		upload_kind Kind;
+
+		/// Identifier returned by asset_loader::load_texture or asset_loader::load_file
+		std::size_t Asset;
+
+		/// Staged texture: texels are laid out for upload, Texture.data(Layer, Face, Level) is the image of an UPLOAD_IMAGE command
+		texture Texture;
+		texture::size_type Layer;
+		texture::size_type Face;
+		texture::size_type Level;
+
+		/// File content of an UPLOAD_FILE command
+		std::shared_ptr<std::vector<char>> Data;
+	};
+
+	/// Load assets on the threads of a job system: file reads, DDS, KTX and KMG parsing, optional processing and
+	/// staging run on the workers, each asset in its own job. Their results are queued as upload commands that
+	/// the thread owning the graphics API drains a few at a time, so that frames keep presenting while assets load.
+	///
+	/// The commands of an asset are queued together once the asset is ready: UPLOAD_TEXTURE, then the images from
+	/// the smallest level to the largest so that textures can be sampled before the larger levels arrive, then UPLOAD_DONE.
+	/// Textures loaded without images skip the UPLOAD_IMAGE commands, for applications that upload the images themselves.
+	/// Files produce UPLOAD_FILE then UPLOAD_DONE. Assets that fail produce a single UPLOAD_FAILED.
+	class asset_loader
+	{
+	public:
+		typedef std::size_t asset_type;
+
+		/// @param Jobs Job system running the loads. It must outlive the loader.
+		/// @param Cache Cache of the processed textures, or nullptr to process textures on each load. It must outlive the loader.
+		explicit asset_loader(job_system& Jobs, texture_cache* Cache = nullptr);
+
+		/// Wait for the loads still running
+		~asset_loader();
+
+		/// Queue the load of a DDS, KTX or KMG texture file, processed by Recipe when it isn't the default recipe.
+		/// The job reads the pages of the texel data of the files it maps, so that the uploads don't fault on them.
+		/// @param Images Whether to queue an UPLOAD_IMAGE command for each image, otherwise only UPLOAD_TEXTURE then UPLOAD_DONE,
+		/// for textures whose levels are uploaded by the application, by a residency_manager for example
+		asset_type load_texture(std::string const& Path, cache_recipe const& Recipe = cache_recipe(), bool Images = true);
+
+		/// Queue the read of a whole file
+		asset_type load_file(std::string const& Path);
+
+		/// Call Func(upload_command const&) for each queued command, in order, until the queue is empty or Budget is spent.
+		/// At least one command runs when the queue isn't empty, so that loads progress even with a tiny budget.
+		/// Returns the number of commands run.
+		template <typename func>
+		std::size_t drain(func& Func, std::chrono::steady_clock::duration Budget);
+
+		/// Number of assets whose last command, UPLOAD_DONE or UPLOAD_FAILED, hasn't been drained yet
+		std::size_t pending() const;
+
+		/// Block until a command is queued or every asset is drained
+		void wait() const;
+
+	private:
+		asset_loader(asset_loader const&) = delete;
+		asset_loader& operator=(asset_loader const&) = delete;
+
+		void queue(std::vector<upload_command>& Commands);
+
+		job_system& Jobs;
+		texture_cache* Cache;
+
+		mutable std::mutex Mutex;
+		mutable std::condition_variable Ready;
+		std::deque<upload_command> Commands;
+		asset_type NextAsset;
+		std::size_t Pending;
+		std::size_t Running;
+	};
+}//namespace gli
+
+#include "./core/loader.inl"
@@ -0,0 +1,245 @@
+/// @brief Include to measure CPU and GPU scopes of frames, aggregate their statistics and export them as a Chrome trace.
+/// @file gli/profiler.hpp
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace gli
+{
+	/// Timed scope. Times are in nanoseconds on the profiler clock.
+	struct profile_event
+	{
+		/// String literal, or any string outliving the profiler
+		char const* Name;
+		std::uint64_t Begin;
+		std::uint64_t End;
+
+		/// 0 for the GPU scopes, then the CPU threads numbered from 1 in the order of their first scope
+		std::uint32_t Thread;
+	};
+
+	/// Statistics of the durations of the last frames or scopes, in nanoseconds
+	struct profile_statistics
+	{
+		profile_statistics()
+			: Count(0)
+			, Mean(0)
+			, P50(0)
+			, P99(0)
+			, Max(0)
+		{}
+
+		std::size_t Count;
+		std::uint64_t Mean;
+		std::uint64_t P50;
+		std::uint64_t P99;
+		std::uint64_t Max;
+	};
+
+	/// Backend of the GPU scopes: timestamps written when the GPU executes the commands submitted before them
+	class gpu_timer
+	{
+	public:
+		virtual ~gpu_timer() {}
+
+		/// Current GPU time in nanoseconds, to align the GPU clock with the profiler clock
+		virtual std::uint64_t now() = 0;
+
+		/// Queue a timestamp after the commands submitted so far, returns its handle
+		virtual std::uint64_t timestamp() = 0;
+
+		/// GPU time in nanoseconds of a timestamp, false while the GPU hasn't reached it. Each timestamp is resolved once.
+		virtual bool resolve(std::uint64_t Timestamp, std::uint64_t& Time) = 0;
+	};
+
+	/// GPU timer backend of renderers running on the CPU, such as headless runs: timestamps are taken when they are queued
+	class cpu_gpu_timer : public gpu_timer
+	{
+	public:
+		std::uint64_t now();
+		std::uint64_t timestamp();
+		bool resolve(std::uint64_t Timestamp, std::uint64_t& Time);
+	};
+
+namespace detail
+{
+	/// Single producer single consumer ring of the scopes of a thread: the thread pushes, the profiler collects
+	struct profile_ring
+	{
+		profile_ring(std::size_t Capacity, std::uint32_t Thread);
+
+		/// Returns false and counts the event as dropped when the ring is full
+		bool push(profile_event const& Event);
+
+		template <typename func>
+		void collect(func& Func);
+
+		std::vector<profile_event> Events;
+		std::size_t Mask;
+		std::uint32_t Thread;
+		std::atomic<std::size_t> Head;
+		std::atomic<std::size_t> Tail;
+		std::atomic<std::size_t> Dropped;
+	};
+
+	/// Durations of the last frames or scopes
+	class profile_window
+	{
+	public:
+		explicit profile_window(std::size_t Capacity);
+
+		void push(std::uint64_t Duration);
+		profile_statistics statistics() const;
+
+	private:
+		std::vector<std::uint64_t> Durations;
+		std::size_t Capacity;
+		std::size_t Next;
+	};
+}//namespace detail
+
+	/// Frame profiler. Any thread records CPU scopes in its own lock-free ring buffer, the thread owning the graphics API
+	/// records GPU scopes through a gpu_timer backend. Once per frame, end_frame collects the scopes of every thread,
+	/// updates the statistics of the last frames and keeps the latest scopes for the Chrome trace export.
+	///
+	/// A disabled profiler costs one relaxed atomic load per scope. The profiler must outlive the threads recording scopes.
+	class profiler
+	{
+	public:
+		/// @param Timer GPU timer backend, or nullptr to ignore the GPU scopes. It must outlive the profiler.
+		/// @param RingCapacity Scopes each thread can record between two end_frame calls, rounded up to a power of two
+		/// @param TraceCapacity Latest scopes kept for the trace export
+		/// @param Window Frames and scopes of each name the statistics cover
+		explicit profiler(gpu_timer* Timer = nullptr, std::size_t RingCapacity = 4096, std::size_t TraceCapacity = 65536, std::size_t Window = 256);
+
+		void enable(bool Enabled);
+		bool enabled() const;
+
+		/// Nanoseconds since the construction of the profiler
+		std::uint64_t now() const;
+
+		/// Record a CPU scope of the calling thread
+		void record(char const* Name, std::uint64_t Begin, std::uint64_t End);
+
+		/// Queue the GPU timestamp beginning a scope, returns its handle. Only on the thread calling end_frame.
+		std::size_t begin_gpu(char const* Name);
+
+		/// Queue the GPU timestamp ending the scope of Handle
+		void end_gpu(std::size_t Handle);
+
+		/// Mark the end of a frame, record it as a "Frame" scope starting at the previous call, and collect the scopes recorded since
+		void end_frame();
+
+		profile_statistics frame_statistics() const;
+
+		/// Statistics of the CPU or GPU scopes named Name
+		profile_statistics scope_statistics(std::string const& Name, bool Gpu = false) const;
+
+		/// Latest scopes collected, oldest first
+		std::vector<profile_event> events() const;
+
+		/// Number of scopes lost because a ring buffer was full
+		std::size_t dropped() const;
+
+		/// Write the latest scopes in the Chrome trace event format, to open with chrome://tracing or Perfetto
+		void write_chrome_trace(std::ostream& Stream) const;
+		bool write_chrome_trace(char const* Path) const;
+
+	private:
+		profiler(profiler const&) = delete;
+		profiler& operator=(profiler const&) = delete;
+
+		struct gpu_scope
+		{
+			char const* Name;
+			std::uint64_t Begin;
+			std::uint64_t End;
+			std::uint64_t BeginTime;
+			bool Ended;
+			bool BeginResolved;
+		};
+
+		detail::profile_ring& ring();
+		void collect(profile_event const& Event);
+
+		std::uint64_t const Id;
+		std::chrono::steady_clock::time_point const Start;
+		gpu_timer* const Timer;
+		std::size_t const RingCapacity;
+		std::size_t const TraceCapacity;
+		std::size_t const Window;
+		std::atomic<bool> Enabled;
+
+		// Rings of the threads, registered on their first scope
+		mutable std::mutex Mutex;
+		std::map<std::thread::id, std::unique_ptr<detail::profile_ring>> Rings;
+
+		// Owned by the thread calling end_frame
+		std::deque<gpu_scope> GpuScopes;
+		std::size_t GpuScopesResolved;
+		std::int64_t GpuOffset;
+		bool GpuCalibrated;
+		std::uint64_t FrameBegin;
+		std::size_t GpuDropped;
+		std::deque<profile_event> Trace;
+		detail::profile_window Frames;
+		std::map<std::pair<std::string, bool>, detail::profile_window> Scopes;
+	};
+
+	/// Record a CPU scope from its construction to its destruction
+	class profile_scope
+	{
+	public:
+		profile_scope(profiler& Profiler, char const* Name);
+		~profile_scope();
+
+	private:
+		profile_scope(profile_scope const&) = delete;
+		profile_scope& operator=(profile_scope const&) = delete;
+
+		profiler& Profiler;
+		char const* Name;
+		std::uint64_t Begin;
+		bool Enabled;
+	};
+
+	/// Record a GPU scope around the commands submitted from its construction to its destruction
+	class gpu_profile_scope
+	{
+	public:
+		gpu_profile_scope(profiler& Profiler, char const* Name);
+		~gpu_profile_scope();
+
+	private:
+		gpu_profile_scope(gpu_profile_scope const&) = delete;
+		gpu_profile_scope& operator=(gpu_profile_scope const&) = delete;
+
+		profiler& Profiler;
+		std::size_t Handle;
+		bool Enabled;
+	};
+}//namespace gli
+
+/// Profile the CPU time of the rest of the enclosing block. Compiled out when GLI_DISABLE_PROFILER is defined.
+#ifdef GLI_DISABLE_PROFILER
+#	define GLI_PROFILE_SCOPE(Profiler, Name) ((void)0)
+#	define GLI_PROFILE_GPU_SCOPE(Profiler, Name) ((void)0)
+#else
+#	define GLI_PROFILE_CONCAT_IMPL(A, B) A##B
+#	define GLI_PROFILE_CONCAT(A, B) GLI_PROFILE_CONCAT_IMPL(A, B)
+#	define GLI_PROFILE_SCOPE(Profiler, Name) gli::profile_scope GLI_PROFILE_CONCAT(ProfileScope, __LINE__)(Profiler, Name)
+#	define GLI_PROFILE_GPU_SCOPE(Profiler, Name) gli::gpu_profile_scope GLI_PROFILE_CONCAT(GpuProfileScope, __LINE__)(Profiler, Name)
+#endif
+
+#include "./core/profiler.inl"
@@ -0,0 +1,98 @@
+/// @brief Include to stream the images of DDS and KTX files one at a time.
+/// @file gli/reader.hpp
+
+#pragma once
+
+#include "texture.hpp"
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+namespace gli
+{
+	/// Streaming reader of DDS and KTX files.
+	/// The header is parsed once when the file is opened, then each image, identified by its layer, face and level, can be read
+	/// in any order into a caller provided buffer. Reading the smallest levels first allows to display a low resolution texture
+	/// while the rest of the file is still being read.
+	/// A reader is not thread safe: all reads go through the same file handle.
+	class reader
+	{
+	public:
+		typedef texture::size_type size_type;
+		typedef texture::target_type target_type;
+		typedef texture::format_type format_type;
+		typedef texture::extent_type extent_type;
+
+		/// Create an empty reader
+		reader();
+
+		/// Open a DDS or KTX file and parse its header. The reader is empty in case of failure.
+		/// @param Path Path of the file to open including filaname and filename extension
+		explicit reader(char const* Path);
+
+		/// Open a DDS or KTX file and parse its header. The reader is empty in case of failure.
+		/// @param Path Path of the file to open including filaname and filename extension
+		explicit reader(std::string const& Path);
+
+		/// Open a DDS or KTX file and parse its header, closing any file previously opened. Returns false in case of failure.
+		/// @param Path Path of the file to open including filaname and filename extension
+		bool open(char const* Path);
+
+		/// Close the file
+		void close();
+
+		/// Return whether no file is opened
+		bool empty() const;
+
+		/// Return the target of the texture stored in the file
+		target_type target() const;
+
+		/// Return the texel format of the texture stored in the file
+		format_type format() const;
+
+		/// Return the extent of a mipmap level of the texture stored in the file
+		extent_type extent(size_type Level = 0) const;
+
+		size_type layers() const;
+		size_type faces() const;
+		size_type levels() const;
+
+		/// Return the size in bytes of one image of a mipmap level
+		size_type size(size_type Level) const;
+
+		/// Return the offset in bytes from the beginning of the file of the image identified by Layer, Face and Level
+		size_type offset(size_type Layer, size_type Face, size_type Level) const;
+
+		/// Create a texture with the shape of the texture stored in the file, ready to receive images with read
+		texture create_texture() const;
+
+		/// Read the image identified by Layer, Face and Level into Data. Returns false if the file is truncated.
+		/// @param Data Destination of the image, at least size(Level) bytes.
+		bool read(size_type Layer, size_type Face, size_type Level, void* Data);
+
+		/// Read the box of texels at Offset of size Extent of the image identified by Layer, Face and Level into Data, row after row
+		/// without padding. The rows of the box are read one at a time, consecutive rows of the file with a single seek.
+		/// With compressed formats, the box is made of the blocks containing its texels. Returns false if the file is truncated.
+		/// @param Data Destination of the box, at least the size of the box in blocks times the block size.
+		bool read(size_type Layer, size_type Face, size_type Level, extent_type const& Offset, extent_type const& Extent, void* Data);
+
+		/// Read every layer and face of a mipmap level into the same level of Texture. Returns false if the file is truncated.
+		/// @param Texture Destination texture, created by create_texture.
+		bool read(size_type Level, texture& Texture);
+
+	private:
+		size_type image_index(size_type Layer, size_type Face, size_type Level) const;
+
+		std::shared_ptr<FILE> File;
+		target_type Target;
+		format_type Format;
+		extent_type Extent;
+		size_type Layers;
+		size_type Faces;
+		size_type Levels;
+		std::vector<size_type> Sizes;
+		std::vector<size_type> Offsets;
+	};
+}//namespace gli
+
+#include "./core/reader.inl"
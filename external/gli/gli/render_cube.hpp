@@ -0,0 +1,24 @@
+/// @brief Include to render the view of a cube map on the CPU, like a skybox pass.
+/// @file gli/render_cube.hpp
+
+#pragma once
+
+#include "texture2d.hpp"
+#include "texture_cube.hpp"
+
+namespace gli
+{
+	/// Render the cube map Texture as seen from the center of the cube, like a skybox pass drawing the cube around the camera with GL_TEXTURE_CUBE_MAP_SEAMLESS.
+	/// Each pixel samples the direction of its view ray with trilinear filtering, the level coming from the ray derivatives between neighboring pixels.
+	/// The framebuffer is split in tiles rendered by every hardware thread, ray directions are computed four pixels at once.
+	/// Returns an empty texture if the texture format or framebuffer format is not supported.
+	///
+	/// @param Texture Cube map of an uncompressed format supported by convert, or of a BC1 to BC5 format.
+	/// @param InverseViewProjection Inverse of the projection and view transforms: maps clip space positions to world space directions.
+	/// @param Extent Width and height of the framebuffer. The first row of the framebuffer is the top of the view.
+	/// @param Format Framebuffer format: FORMAT_RGBA8_UNORM_PACK8, FORMAT_RGBA8_SRGB_PACK8, FORMAT_RGBA16_SFLOAT_PACK16 or FORMAT_RGBA32_SFLOAT_PACK32.
+	/// Sampled values are written as is in the UNORM and float formats, like a framebuffer without sRGB conversion, and encoded in the sRGB format.
+	texture2d render_cube(texture_cube const& Texture, mat4 const& InverseViewProjection, texture2d::extent_type const& Extent, format Format);
+}//namespace gli
+
+#include "./core/render_cube.inl"
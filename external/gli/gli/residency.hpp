@@ -0,0 +1,157 @@
+/// @brief Include to keep the mipmap levels of textures resident on the device within a memory budget, streaming levels in and out.
+/// @file gli/residency.hpp
+
+#pragma once
+
+#include "texture.hpp"
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace gli
+{
+	/// Backend of the device memory of the textures of a residency_manager
+	class residency_backend
+	{
+	public:
+		typedef texture::size_type size_type;
+
+		virtual ~residency_backend() {}
+
+		/// Make the levels [BaseLevel, Texture.levels()) of the texture Id resident, and only these, while the levels [PreviousBaseLevel, Texture.levels()) are.
+		/// A base level of Texture.levels() means that no level is resident.
+		/// Returns false when the device can't allocate the levels, the levels [PreviousBaseLevel, Texture.levels()) stay resident then.
+		virtual bool resident(std::size_t Id, texture const& Texture, size_type BaseLevel, size_type PreviousBaseLevel) = 0;
+	};
+
+	/// Device memory of a fixed capacity simulated on the CPU, the backend of tests and of budget tuning without a graphics API
+	class simulated_residency_backend : public residency_backend
+	{
+	public:
+		/// @param Capacity Bytes of the simulated device memory
+		explicit simulated_residency_backend(std::uint64_t Capacity);
+
+		bool resident(std::size_t Id, texture const& Texture, size_type BaseLevel, size_type PreviousBaseLevel);
+
+		/// Bytes of the simulated device memory
+		std::uint64_t capacity() const;
+
+		/// Bytes of the resident levels
+		std::uint64_t used() const;
+
+		/// Number of levels copied to the simulated device
+		std::size_t uploads() const;
+
+		/// Whether the level Level of the texture Id is resident
+		bool is_resident(std::size_t Id, size_type Level) const;
+
+	private:
+		std::uint64_t const Capacity;
+		std::uint64_t Used;
+		std::size_t Uploads;
+
+		/// Base level of each texture, the largest size_type when no level is resident
+		std::vector<size_type> BaseLevels;
+	};
+
+	/// Keep the smallest mipmap levels of textures resident on the device within a budget of device memory.
+	/// Every texture is held in host memory with all its levels. Each frame, the application requests the finest level it samples
+	/// for each texture, then update chooses the resident levels: the smallest level of every texture first, so that each texture
+	/// can be sampled, then the finer levels of the textures in order of the last frame they were requested, and of their priority
+	/// for the textures requested in the same frame, until the budget is spent. Levels over the budget are evicted first,
+	/// then the missing levels load from the smallest to the largest, within a budget of bytes per update that spreads the uploads over frames.
+	/// Resident levels finer than the requested ones stay resident as long as the budget leaves room for them.
+	/// The resident levels of a texture are always a complete mipmap tail: the sampler base level of a texture is its first resident level.
+	class residency_manager
+	{
+	public:
+		typedef std::size_t id_type;
+		typedef texture::size_type size_type;
+
+		/// @param Backend Device memory of the textures. It must outlive the manager.
+		/// @param Budget Bytes of device memory of the resident levels of all the textures
+		residency_manager(residency_backend& Backend, std::uint64_t Budget);
+
+		/// Release the device memory of every texture
+		~residency_manager();
+
+		/// Manage a texture. No level is resident until the next update.
+		/// @param Priority Order of the textures requested in the same frame, the higher first
+		id_type insert(texture const& Texture, float Priority = 1.0f);
+
+		/// Release the device memory and the host memory of the texture Id, its identifier is reused by the next insertions
+		void erase(id_type Id);
+
+		/// Change the priority of the texture Id
+		void priority(id_type Id, float Priority);
+
+		/// Request the levels [Level, levels()) of the texture Id for the current frame. A request of a level that isn't resident is a miss.
+		/// Returns the first resident level, the base level to sample the texture with, which is levels() when no level is resident.
+		size_type request(id_type Id, size_type Level = 0);
+
+		/// End the frame: choose the resident levels of each texture, evict the levels over the budget, then load the missing levels.
+		/// @param LoadBudget Bytes of the levels loaded by this update. A level still loads when it is larger than the budget, so that streaming always progresses.
+		void update(std::uint64_t LoadBudget = std::numeric_limits<std::uint64_t>::max());
+
+		/// First resident level of the texture Id, levels() when no level is resident
+		size_type base_level(id_type Id) const;
+
+		/// Texture Id held in host memory
+		texture const& host_texture(id_type Id) const;
+
+		/// Bytes of the level Level of the texture Id, all its layers and faces included
+		std::uint64_t level_size(id_type Id, size_type Level) const;
+
+		/// Bytes of the resident levels of the texture Id
+		std::uint64_t resident_size(id_type Id) const;
+
+		/// Bytes of device memory that the resident levels can use
+		std::uint64_t budget() const;
+
+		/// Bytes of the textures held in host memory
+		std::uint64_t host_size() const;
+
+		/// Bytes of the resident levels of all the textures
+		std::uint64_t resident_size() const;
+
+		/// Number of levels loaded
+		std::size_t loads() const;
+
+		/// Number of resident levels evicted to make room for other levels
+		std::size_t evictions() const;
+
+		/// Number of requests of levels that weren't resident
+		std::size_t misses() const;
+
+	private:
+		residency_manager(residency_manager const&) = delete;
+		residency_manager& operator=(residency_manager const&) = delete;
+
+		struct entry
+		{
+			texture Texture;
+			std::vector<std::uint64_t> LevelSizes;
+			float Priority;
+			std::uint64_t LastUse;
+			size_type Wanted;
+			size_type BaseLevel;
+		};
+
+		bool valid(id_type Id) const;
+
+		/// Change the resident levels of the texture Id, returns whether the backend could
+		bool resident(id_type Id, size_type BaseLevel);
+
+		residency_backend& Backend;
+		std::uint64_t const Budget;
+		std::vector<entry> Entries;
+		std::vector<id_type> FreeIds;
+		std::uint64_t Frame;
+		std::uint64_t Resident;
+		std::size_t Loads;
+		std::size_t Evictions;
+		std::size_t Misses;
+	};
+}//namespace gli
+
+#include "./core/residency.inl"
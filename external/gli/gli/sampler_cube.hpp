@@ -13,14 +13,15 @@ namespace gli
 	/// Cube map texture sampler
 	/// @tparam T Sampler can fetch, write and interpret any texture format but will expose and process the data through type T conversions.
 	/// @tparam P Precision in term of ULPs
-	template <typename T, qualifier P = defaultp>
+	/// @tparam texture_cube_type Sampled texture type: texture_cube, or texture_cube_tiled for cube maps paged from their file
+	template <typename T, qualifier P = defaultp, typename texture_cube_type = texture_cube>
 	class sampler_cube : public sampler
 	{
 	private:
 		typedef typename detail::interpolate<T>::type interpolate_type;
 
 	public:
-		typedef texture_cube texture_type;
+		typedef texture_cube_type texture_type;
 		typedef typename texture_type::size_type size_type;
 		typedef typename texture_type::extent_type extent_type;
 		typedef interpolate_type level_type;
@@ -50,6 +51,9 @@ namespace gli
 		/// Generate the mipmaps of the sampler texture from the texture base level to the texture max level included
 		void generate_mipmaps(size_type BaseFace, size_type MaxFace, size_type BaseLevel, size_type MaxLevel, filter Minification);
 
+		/// Generate the texels of the box Offset, Extent of a face of the Level from the Level - 1, for a partial update of the mipmaps
+		void generate_mipmaps(size_type Face, size_type Level, extent_type const& Offset, extent_type const& Extent, filter Minification);
+
 	private:
 		typedef typename detail::convert<texture_type, T, P>::func convert_type;
 		typedef typename detail::convert<texture_type, T, P>::fetchFunc fetch_type;
@@ -0,0 +1,66 @@
+/// @brief Include to sample cube map textures with batches of direction vectors.
+/// @file gli/sampler_cube_batch.hpp
+
+#pragma once
+
+#include "texture_cube.hpp"
+#include "core/filter.hpp"
+#include <vector>
+
+namespace gli
+{
+	/// Structure of arrays of Count direction vectors. The directions don't need to be normalized.
+	struct cube_directions
+	{
+		float const* X;
+		float const* Y;
+		float const* Z;
+		std::size_t Count;
+	};
+
+	/// Cube map texture sampler for batches of direction vectors.
+	/// Each direction selects a face from its major axis and face coordinates like the GPU does for samplerCube lookups.
+	/// Texels are fetched at the texel centers. Bilinear filtering clamps to the face edges, or reads across them like GL_TEXTURE_CUBE_MAP_SEAMLESS.
+	/// @tparam Format Format of the sampled texture. Supported: FORMAT_RGBA8_UNORM_PACK8, FORMAT_RGBA8_SRGB_PACK8, FORMAT_RGBA16_SFLOAT_PACK16,
+	/// FORMAT_RGBA32_SFLOAT_PACK32, FORMAT_RG11B10_UFLOAT_PACK32 and FORMAT_RGB9E5_UFLOAT_PACK32. The texel decoding is inlined in the sampling loop.
+	template <format Format>
+	class sampler_cube_batch
+	{
+	public:
+		typedef texture_cube texture_type;
+		typedef texture_type::size_type size_type;
+
+		/// @param Mip FILTER_NEAREST or FILTER_LINEAR blending between levels
+		/// @param Min FILTER_NEAREST or FILTER_LINEAR filtering in each level
+		/// @param Seamless Bilinear filtering reads the texels of the adjacent faces past the face edges
+		sampler_cube_batch(texture_type const& Texture, filter Mip = FILTER_LINEAR, filter Min = FILTER_LINEAR, bool Seamless = false);
+
+		/// Access the sampler texture object
+		texture_type const& operator()() const;
+
+		/// Sample every direction at Level, relative to the texture base level, and write the results in Texels
+		void texture_lod(cube_directions const& Directions, float Level, vec4* Texels) const;
+
+		/// Sample every direction at the level of the same index in Levels, relative to the texture base level, and write the results in Texels
+		void texture_lod(cube_directions const& Directions, float const* Levels, vec4* Texels) const;
+
+		/// Sample every direction at the level computed from the screen space derivatives of the direction, like textureGrad, and write the results in Texels
+		void texture_grad(cube_directions const& Directions, cube_directions const& DirectionsDx, cube_directions const& DirectionsDy, vec4* Texels) const;
+
+	private:
+		void sample(cube_directions const& Directions, float const* Levels, float Level, cube_directions const* DirectionsDx, cube_directions const* DirectionsDy, vec4* Texels) const;
+
+		texture_type Texture;
+		filter Mip;
+		filter Min;
+		bool Seamless;
+
+		// First texel of each level of each face, indexed by Face * levels + Level
+		std::vector<glm::uint8 const*> Images;
+
+		// Width and height of each level
+		std::vector<int> Sizes;
+	};
+}//namespace gli
+
+#include "./core/sampler_cube_batch.inl"
@@ -42,6 +42,46 @@ namespace gli
 			size_type Levels,
 			swizzles_type const& Swizzles = swizzles_type(SWIZZLE_RED, SWIZZLE_GREEN, SWIZZLE_BLUE, SWIZZLE_ALPHA));
 
+		/// Create a texture object and allocate its texture storage_linear with Allocator.
+		/// With uninitialized_allocator() or an arena, the texel data is left uninitialized and must be written before it is read.
+		/// @param Target Type/Shape of the texture storage_linear
+		/// @param Format Texel format
+		/// @param Extent Size of the texture: width, height and depth.
+		/// @param Layers Number of one-dimensional or two-dimensional images of identical size and format
+		/// @param Faces 6 for cube map textures otherwise 1.
+		/// @param Levels Number of images in the texture mipmap chain.
+		/// @param Allocator Source of the memory of the texel data
+		/// @param Swizzles A mechanism to swizzle the components of a texture before they are applied according to the texture environment.
+		texture(
+			target_type Target,
+			format_type Format,
+			extent_type const& Extent,
+			size_type Layers,
+			size_type Faces,
+			size_type Levels,
+			storage_allocator& Allocator,
+			swizzles_type const& Swizzles = swizzles_type(SWIZZLE_RED, SWIZZLE_GREEN, SWIZZLE_BLUE, SWIZZLE_ALPHA));
+
+		/// Create a texture object with a texture storage_linear which borrows its texel data from Memory instead of allocating it.
+		/// Memory must contain the images in the storage_linear layout and it stays alive as long as the texture or any of its views.
+		/// @param Target Type/Shape of the texture storage_linear
+		/// @param Format Texel format
+		/// @param Extent Size of the texture: width, height and depth.
+		/// @param Layers Number of one-dimensional or two-dimensional images of identical size and format
+		/// @param Faces 6 for cube map textures otherwise 1.
+		/// @param Levels Number of images in the texture mipmap chain.
+		/// @param Memory Texel data of every layer, face and level of the texture.
+		/// @param Swizzles A mechanism to swizzle the components of a texture before they are applied according to the texture environment.
+		texture(
+			target_type Target,
+			format_type Format,
+			extent_type const& Extent,
+			size_type Layers,
+			size_type Faces,
+			size_type Levels,
+			std::shared_ptr<data_type> const& Memory,
+			swizzles_type const& Swizzles = swizzles_type(SWIZZLE_RED, SWIZZLE_GREEN, SWIZZLE_BLUE, SWIZZLE_ALPHA));
+
 		/// Create a texture object by sharing an existing texture storage_type from another texture instance.
 		/// This texture object is effectively a texture view where the layer, the face and the level allows identifying
 		/// a specific subset of the texture storage_linear source. 
@@ -214,8 +254,15 @@ namespace gli
 				DEFAULT
 			};
 
+			// The cache of an empty texture is zeroed so that empty textures copy without reading uninitialized members
 			explicit cache(ctor)
-			{}
+				: Faces(0)
+				, Levels(0)
+				, GlobalMemorySize(0)
+			{
+				this->ImageExtent.fill(extent_type(0));
+				this->ImageMemorySize.fill(0);
+			}
 
 			cache
 			(
@@ -0,0 +1,90 @@
+/// @brief Include to sample cube map textures paged in memory one tile at a time from DDS or KTX files.
+/// @file gli/texture_cube_tiled.hpp
+
+#pragma once
+
+#include "core/storage_tiled.hpp"
+#include "core/convert_func.hpp"
+#include <string>
+
+namespace gli
+{
+	/// Cube map texture whose texel data stays in its file and is paged in one tile at a time, within a memory budget.
+	/// Allows sampling cube maps larger than the memory available, sampler_cube<T, P, texture_cube_tiled> fetches and filters it
+	/// like a texture_cube. The texture is read only and copies share the same resident tiles.
+	class texture_cube_tiled
+	{
+	public:
+		typedef storage_tiled::size_type size_type;
+		typedef storage_tiled::format_type format_type;
+		typedef storage_tiled::target_type target_type;
+		typedef extent2d extent_type;
+
+	public:
+		/// Create an empty texture cube
+		texture_cube_tiled();
+
+		/// Open a DDS or KTX file of an uncompressed cube map. The texture is empty in case of failure.
+		/// @param Path Path of the file to open including filaname and filename extension
+		/// @param Budget Size in bytes of the resident tiles
+		/// @param TileSize Width and height of the tiles in texels, a power of two
+		texture_cube_tiled(char const* Path, size_type Budget, size_type TileSize = 64);
+
+		/// Open a DDS or KTX file of an uncompressed cube map. The texture is empty in case of failure.
+		/// @param Path Path of the file to open including filaname and filename extension
+		/// @param Budget Size in bytes of the resident tiles
+		/// @param TileSize Width and height of the tiles in texels, a power of two
+		texture_cube_tiled(std::string const& Path, size_type Budget, size_type TileSize = 64);
+
+		bool empty() const;
+		target_type target() const;
+		format_type format() const;
+
+		size_type base_face() const;
+		size_type max_face() const;
+		size_type faces() const;
+
+		size_type base_level() const;
+		size_type max_level() const;
+		size_type levels() const;
+
+		/// Return the dimensions of a texture instance: width and height where both should be equal.
+		extent_type extent(size_type Level = 0) const;
+
+		/// Paged storage, to query the residency of the tiles
+		storage_tiled const& storage() const;
+
+		/// Fetch a texel from a texture, reading its tile from the file if it isn't resident.
+		template <typename gen_type>
+		gen_type load(extent_type const& TexelCoord, size_type Face, size_type Level) const;
+
+	private:
+		std::shared_ptr<storage_tiled> Storage;
+	};
+
+namespace detail
+{
+	template <>
+	struct is_linear_storage<texture_cube_tiled>
+	{
+		static bool const value = false;
+	};
+
+	template <typename genType>
+	struct accessFunc<texture_cube_tiled, genType>
+	{
+		static genType load(texture_cube_tiled const& Texture, texture_cube_tiled::extent_type const& TexelCoord, texture_cube_tiled::size_type Layer, texture_cube_tiled::size_type Face, texture_cube_tiled::size_type Level)
+		{
+			GLI_ASSERT(Layer == 0);
+			return Texture.load<genType>(TexelCoord, Face, Level);
+		}
+
+		static void store(texture_cube_tiled&, texture_cube_tiled::extent_type const&, texture_cube_tiled::size_type, texture_cube_tiled::size_type, texture_cube_tiled::size_type, genType const&)
+		{
+			GLI_ASSERT(!"texture_cube_tiled is read only");
+		}
+	};
+}//namespace detail
+}//namespace gli
+
+#include "./core/texture_cube_tiled.inl"
@@ -0,0 +1,127 @@
+#include <gli/gli.hpp>
+#include <cstdint>
+
+namespace
+{
+	std::string path(const char* filename)
+	{
+		return std::string(SOURCE_DIR) + "/data/" + filename;
+	}
+
+	bool aligned(void const* Data, std::size_t Alignment)
+	{
+		return reinterpret_cast<std::uintptr_t>(Data) % Alignment == 0;
+	}
+}//namespace
+
+namespace heap
+{
+	int test()
+	{
+		int Error = 0;
+
+		{
+			gli::heap_allocator Allocator(true, 256);
+			std::shared_ptr<gli::byte> const Data(Allocator.allocate(1000));
+			Error += aligned(Data.get(), 256) ? 0 : 1;
+			for(std::size_t Index = 0; Index < 1000; ++Index)
+				Error += Data.get()[Index] == 0 ? 0 : 1;
+		}
+
+		// Large allocations are aligned on huge pages when asked, small ones only on the alignment
+		{
+			gli::heap_allocator Allocator(false, 64, true);
+			Error += aligned(Allocator.allocate(gli::heap_allocator::HugePageSize).get(), gli::heap_allocator::HugePageSize) ? 0 : 1;
+			Error += aligned(Allocator.allocate(100).get(), 64) ? 0 : 1;
+		}
+
+		// The texture constructors without allocator still zero-fill the texel data
+		gli::texture2d const Texture(gli::FORMAT_RGBA8_UNORM_PACK8, gli::texture2d::extent_type(16));
+		for(std::size_t Index = 0; Index < Texture.size(); ++Index)
+			Error += Texture.data<gli::byte>()[Index] == 0 ? 0 : 1;
+		Error += aligned(Texture.data(), 64) ? 0 : 1;
+
+		return Error;
+	}
+}//namespace heap
+
+namespace arena
+{
+	int test()
+	{
+		int Error = 0;
+
+		gli::texture_cube Cube;
+		{
+			gli::arena_allocator Arena(1 << 20, true, 256);
+
+			// The storages of a batch share a block
+			gli::texture const A(gli::TARGET_2D, gli::FORMAT_RGBA8_UNORM_PACK8, gli::texture::extent_type(33, 17, 1), 1, 1, 2, Arena);
+			gli::texture const B(gli::TARGET_CUBE, gli::FORMAT_RGBA8_UNORM_PACK8, gli::texture::extent_type(32, 32, 1), 1, 6, 6, Arena);
+			Error += Arena.blocks() == 1 ? 0 : 1;
+			Error += aligned(A.data(), 256) && aligned(B.data(), 256) ? 0 : 1;
+			Error += B.data<gli::byte>() >= A.data<gli::byte>() + A.size() ? 0 : 1;
+			for(std::size_t Index = 0; Index < B.size(); ++Index)
+				Error += B.data<gli::byte>()[Index] == 0 ? 0 : 1;
+
+			// Larger than a block: allocated apart, the current block keeps serving
+			gli::texture const Large(gli::TARGET_2D, gli::FORMAT_RGBA32_SFLOAT_PACK32, gli::texture::extent_type(512, 512, 1), 1, 1, 1, Arena);
+			Error += Arena.blocks() == 2 ? 0 : 1;
+			gli::texture const C(gli::TARGET_2D, gli::FORMAT_R8_UNORM_PACK8, gli::texture::extent_type(4, 4, 1), 1, 1, 1, Arena);
+			Error += Arena.blocks() == 2 ? 0 : 1;
+			Error += C.data<gli::byte>() >= B.data<gli::byte>() + B.size() ? 0 : 1;
+
+			// Full block: a new one starts
+			gli::texture const D(gli::TARGET_2D, gli::FORMAT_RGBA8_UNORM_PACK8, gli::texture::extent_type(512, 511, 1), 1, 1, 1, Arena);
+			Error += Arena.blocks() == 3 ? 0 : 1;
+
+			Arena.reset();
+			gli::texture const E(gli::TARGET_2D, gli::FORMAT_R8_UNORM_PACK8, gli::texture::extent_type(4, 4, 1), 1, 1, 1, Arena);
+			Error += Arena.blocks() == 4 ? 0 : 1;
+
+			Cube = gli::texture_cube(B);
+			Cube.clear(glm::u8vec4(1, 2, 3, 4));
+		}
+
+		// Textures outlive the arena and the other textures of their block
+		Error += Cube.load<glm::u8vec4>(gli::extent2d(5, 6), 3, 2) == glm::u8vec4(1, 2, 3, 4) ? 0 : 1;
+
+		return Error;
+	}
+}//namespace arena
+
+namespace load
+{
+	int test()
+	{
+		int Error = 0;
+
+		char const* const Filenames[] = {"cube_rgba8_unorm.dds", "cube_rgba8_unorm.ktx", "array_r8_uint.dds", "array_r8_uint.ktx"};
+
+		// Loading a batch into an arena gives the same textures as the default uninitialized heap allocations
+		gli::arena_allocator Arena(16 << 20);
+		for(std::size_t Index = 0; Index < sizeof(Filenames) / sizeof(Filenames[0]); ++Index)
+		{
+			gli::texture const Heap(gli::load(path(Filenames[Index])));
+			gli::texture const Batched(gli::load(path(Filenames[Index]), Arena));
+			Error += !Heap.empty() && Heap == Batched ? 0 : 1;
+
+			// Duplicates skip the zero-fill too and stay equal
+			Error += gli::duplicate(Heap) == Heap ? 0 : 1;
+		}
+		Error += Arena.blocks() == 1 ? 0 : 1;
+
+		return Error;
+	}
+}//namespace load
+
+int main()
+{
+	int Error = 0;
+
+	Error += heap::test();
+	Error += arena::test();
+	Error += load::test();
+
+	return Error;
+}
@@ -0,0 +1,146 @@
+#include <gli/cache.hpp>
+#include <gli/comparison.hpp>
+#include <gli/duplicate.hpp>
+#include <gli/load.hpp>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+
+namespace
+{
+	std::string path(const char* filename)
+	{
+		return std::string(SOURCE_DIR) + "/data/" + filename;
+	}
+
+	bool exists(std::string const& Filename)
+	{
+		FILE* File = std::fopen(Filename.c_str(), "rb");
+		if(File)
+			std::fclose(File);
+		return File != nullptr;
+	}
+}//namespace
+
+namespace hash
+{
+	int test()
+	{
+		int Error = 0;
+
+		// Reference values of XXH64 with a null seed
+		char const* const Sentence = "Nobody inspects the spammish repetition";
+		Error += gli::hash("", 0) == 0xEF46DB3751D8E999ull ? 0 : 1;
+		Error += gli::hash("abc", 3) == 0x44BC2CF5AD770999ull ? 0 : 1;
+		Error += gli::hash(Sentence, std::strlen(Sentence)) == 0xFBCEA83C8A378BF1ull ? 0 : 1;
+
+		Error += gli::hash("abc", 3, 1) != gli::hash("abc", 3) ? 0 : 1;
+
+		return Error;
+	}
+}//namespace hash
+
+namespace process
+{
+	int test()
+	{
+		int Error = 0;
+
+		gli::texture const Source(gli::load(path("kueken7_rgba8_unorm.dds")));
+		Error += !Source.empty() ? 0 : 1;
+
+		// An empty recipe keeps the texture
+		Error += gli::process(Source, gli::cache_recipe()) == Source ? 0 : 1;
+
+		// Only the first level is kept by the source, the mipmaps are generated before the compression
+		gli::texture2d const Single(gli::texture2d(gli::duplicate(gli::texture2d(Source), 0, 0)));
+
+		gli::cache_recipe Recipe;
+		Recipe.Format = gli::FORMAT_RGBA_DXT5_UNORM_BLOCK16;
+		Recipe.GenerateMipmaps = true;
+		Recipe.Quality = gli::COMPRESS_QUALITY_FAST;
+
+		gli::texture const Compressed(gli::process(Single, Recipe));
+		Error += Compressed.format() == gli::FORMAT_RGBA_DXT5_UNORM_BLOCK16 ? 0 : 1;
+		Error += Compressed.levels() == Source.levels() ? 0 : 1;
+		Error += Compressed.target() == gli::TARGET_2D ? 0 : 1;
+
+		// Compressed sources are decompressed
+		gli::cache_recipe Decompress;
+		Decompress.Format = gli::FORMAT_RGBA8_UNORM_PACK8;
+		gli::texture const Decompressed(gli::process(gli::load(path("kueken7_rgba_dxt5_unorm.dds")), Decompress));
+		Error += Decompressed.format() == gli::FORMAT_RGBA8_UNORM_PACK8 ? 0 : 1;
+
+		// Unsupported targets formats
+		gli::cache_recipe Unsupported;
+		Unsupported.Format = gli::FORMAT_RGBA_ASTC_4X4_UNORM_BLOCK16;
+		Error += gli::process(Source, Unsupported).empty() ? 0 : 1;
+
+		return Error;
+	}
+}//namespace process
+
+namespace cache
+{
+	int test()
+	{
+		int Error = 0;
+
+		std::string const Filename(path("kueken7_rgba8_unorm.dds"));
+		gli::texture_cache Cache("cache_test", 1 << 30);
+
+		// Eviction keeps the most recently used file: remove the files of the previous runs so that they don't change the order of the evictions below
+		std::vector<gli::detail::file_status> const Previous(gli::detail::list_files("cache_test"));
+		for(std::size_t Index = 0; Index < Previous.size(); ++Index)
+			std::remove(("cache_test/" + Previous[Index].Name).c_str());
+		Error += Cache.size() == 0 ? 0 : 1;
+
+		gli::cache_recipe Recipe;
+		Recipe.Format = gli::FORMAT_BGRA8_UNORM_PACK8;
+
+		// The first load processes the source and writes the cache file, the second one maps it
+		gli::texture const Miss(Cache.load(Filename.c_str(), Recipe));
+		std::string const Cached(Cache.fetch(Filename.c_str(), Recipe));
+		Error += !Cached.empty() && exists(Cached) ? 0 : 1;
+
+		gli::texture const Hit(Cache.load(Filename.c_str(), Recipe));
+		Error += Miss.format() == gli::FORMAT_BGRA8_UNORM_PACK8 ? 0 : 1;
+		Error += Hit == Miss ? 0 : 1;
+		Error += Hit == gli::process(gli::load(Filename), Recipe) ? 0 : 1;
+		Error += gli::load(Cached) == Hit ? 0 : 1;
+
+		// Recipes have their own cache files
+		gli::cache_recipe Other;
+		Other.Format = gli::FORMAT_RGBA8_SRGB_PACK8;
+		std::string const OtherCached(Cache.fetch(Filename.c_str(), Other));
+		Error += !OtherCached.empty() && OtherCached != Cached ? 0 : 1;
+		Error += Cache.size() > 0 ? 0 : 1;
+
+		// Using the first file again makes the second one the least recently used, past the granularity of file times
+		std::this_thread::sleep_for(std::chrono::milliseconds(50));
+		Error += Cache.fetch(Filename.c_str(), Recipe) == Cached ? 0 : 1;
+		Error += Cache.evict(Cache.size() - 1) > 0 ? 0 : 1;
+		Error += exists(Cached) && !exists(OtherCached) ? 0 : 1;
+
+		// The most recently used file is kept
+		Error += Cache.evict(0) > 0 && exists(Cached) ? 0 : 1;
+
+		// Files that can't be loaded
+		Error += Cache.fetch(path("missing.dds").c_str(), Recipe).empty() ? 0 : 1;
+		Error += Cache.load(path("missing.dds").c_str(), Recipe).empty() ? 0 : 1;
+
+		return Error;
+	}
+}//namespace cache
+
+int main()
+{
+	int Error = 0;
+
+	Error += hash::test();
+	Error += process::test();
+	Error += cache::test();
+
+	return Error;
+}
@@ -0,0 +1,243 @@
+#include <gli/gli.hpp>
+#include <gli/generate_mipmaps.hpp>
+#include <cmath>
+
+namespace
+{
+	std::string path(const char* filename)
+	{
+		return std::string(SOURCE_DIR) + "/data/" + filename;
+	}
+
+	// Root mean square error of the channels of Mask between a RGBA8 texture and the decompression of its compressed texture
+	double rmse(gli::texture const& Source, gli::texture const& Compressed, glm::bvec4 const& Mask)
+	{
+		gli::texture const Decompressed(gli::decompress(Compressed, Source.format()));
+
+		double Sum = 0.0;
+		std::size_t Count = 0;
+		for(gli::size_t Layer = 0; Layer < Source.layers(); ++Layer)
+		for(gli::size_t Face = 0; Face < Source.faces(); ++Face)
+		for(gli::size_t Level = 0; Level < Source.levels(); ++Level)
+		{
+			glm::u8vec4 const* const A = Source.data<glm::u8vec4>(Layer, Face, Level);
+			glm::u8vec4 const* const B = Decompressed.data<glm::u8vec4>(Layer, Face, Level);
+			gli::size_t const Texels = Source.size(Level) / sizeof(glm::u8vec4);
+
+			for(gli::size_t Texel = 0; Texel < Texels; ++Texel)
+			for(glm::length_t Channel = 0; Channel < 4; ++Channel)
+			{
+				if(!Mask[Channel])
+					continue;
+				double const Delta = static_cast<double>(A[Texel][Channel]) - static_cast<double>(B[Texel][Channel]);
+				Sum += Delta * Delta;
+				++Count;
+			}
+		}
+
+		return std::sqrt(Sum / static_cast<double>(Count));
+	}
+
+	glm::bvec4 channels(gli::format Format)
+	{
+		switch(Format)
+		{
+		case gli::FORMAT_RGB_DXT1_UNORM_BLOCK8:
+			return glm::bvec4(true, true, true, false);
+		case gli::FORMAT_R_ATI1N_UNORM_BLOCK8:
+			return glm::bvec4(true, false, false, false);
+		case gli::FORMAT_RG_ATI2N_UNORM_BLOCK16:
+			return glm::bvec4(true, true, false, false);
+		default:
+			return glm::bvec4(true);
+		}
+	}
+
+	gli::format const Formats[] =
+	{
+		gli::FORMAT_RGB_DXT1_UNORM_BLOCK8,
+		gli::FORMAT_RGBA_DXT5_UNORM_BLOCK16,
+		gli::FORMAT_R_ATI1N_UNORM_BLOCK8,
+		gli::FORMAT_RG_ATI2N_UNORM_BLOCK16
+	};
+
+	gli::compress_quality const Qualities[] =
+	{
+		gli::COMPRESS_QUALITY_FAST,
+		gli::COMPRESS_QUALITY_NORMAL,
+		gli::COMPRESS_QUALITY_HIGH
+	};
+}//namespace
+
+namespace compress_file
+{
+	// Each quality searches at least the endpoints of the lower qualities
+	int test(gli::format Format, double MaxError)
+	{
+		int Error(0);
+
+		gli::texture2d const Source(gli::load(path("kueken7_rgba8_unorm.dds")));
+		gli::texture2d const Image(gli::view(Source, 0, 0));
+		Error += Image.format() == gli::FORMAT_RGBA8_UNORM_PACK8 ? 0 : 1;
+
+		double Errors[gli::COMPRESS_QUALITY_COUNT];
+		for(std::size_t Index = 0; Index < gli::COMPRESS_QUALITY_COUNT; ++Index)
+		{
+			gli::texture2d const Compressed(gli::compress(Image, Format, Qualities[Index]));
+			Error += Compressed.format() == Format ? 0 : 1;
+			Error += Compressed.extent() == Image.extent() ? 0 : 1;
+
+			Errors[Index] = rmse(Image, Compressed, channels(Format));
+			Error += Errors[Index] < MaxError ? 0 : 1;
+		}
+
+		Error += Errors[1] <= Errors[0] ? 0 : 1;
+		Error += Errors[2] <= Errors[1] ? 0 : 1;
+
+		return Error;
+	}
+}//namespace compress_file
+
+namespace compress_solid
+{
+	// Solid blocks whose colors are exactly representable decode exactly
+	int test()
+	{
+		int Error(0);
+
+		gli::texture2d Source(gli::FORMAT_RGBA8_UNORM_PACK8, gli::texture2d::extent_type(8, 8), 1);
+		Source.clear(glm::u8vec4(255, 0, 255, 255));
+		Source.clear(0, 0, 0, gli::texture::extent_type(0), gli::texture::extent_type(4, 4, 1), glm::u8vec4(0, 255, 0, 255));
+
+		for(std::size_t Index = 0; Index < gli::COMPRESS_QUALITY_COUNT; ++Index)
+		{
+			gli::texture2d const CompressedBC1(gli::compress(Source, gli::FORMAT_RGB_DXT1_UNORM_BLOCK8, Qualities[Index]));
+			Error += rmse(Source, CompressedBC1, channels(gli::FORMAT_RGB_DXT1_UNORM_BLOCK8)) == 0.0 ? 0 : 1;
+
+			gli::texture2d const CompressedBC3(gli::compress(Source, gli::FORMAT_RGBA_DXT5_UNORM_BLOCK16, Qualities[Index]));
+			Error += rmse(Source, CompressedBC3, channels(gli::FORMAT_RGBA_DXT5_UNORM_BLOCK16)) == 0.0 ? 0 : 1;
+		}
+
+		// A value between two R5G6B5 steps is reproduced by an interpolated palette entry
+		gli::texture2d Gray(gli::FORMAT_RGBA8_UNORM_PACK8, gli::texture2d::extent_type(4, 4), 1);
+		Gray.clear(glm::u8vec4(128, 128, 128, 255));
+		Error += rmse(Gray, gli::compress(Gray, gli::FORMAT_RGB_DXT1_UNORM_BLOCK8, gli::COMPRESS_QUALITY_FAST), glm::bvec4(true, true, true, false)) < 1.0 ? 0 : 1;
+
+		// Single channel blocks of any value are exact
+		gli::texture2d Channel(gli::FORMAT_RGBA8_UNORM_PACK8, gli::texture2d::extent_type(4, 4), 1);
+		Channel.clear(glm::u8vec4(37, 201, 0, 255));
+		Error += rmse(Channel, gli::compress(Channel, gli::FORMAT_RG_ATI2N_UNORM_BLOCK16), glm::bvec4(true, true, false, false)) == 0.0 ? 0 : 1;
+
+		return Error;
+	}
+}//namespace compress_solid
+
+namespace compress_alpha
+{
+	// BC1 texels with alpha below one half use the transparent palette entry, BC3 alpha keeps values 0 and 255 exact
+	int test()
+	{
+		int Error(0);
+
+		gli::texture2d Source(gli::FORMAT_RGBA8_UNORM_PACK8, gli::texture2d::extent_type(16, 16), 1);
+		for(int y = 0; y < 16; ++y)
+		for(int x = 0; x < 16; ++x)
+		{
+			glm::u8vec4 const Texel(x * 16, y * 16, 255 - x * 8, ((x + y) % 3) == 0 ? 0 : 255);
+			Source.store(gli::texture2d::extent_type(x, y), 0, Texel);
+		}
+
+		gli::texture2d const CompressedBC1(gli::compress(Source, gli::FORMAT_RGBA_DXT1_UNORM_BLOCK8, gli::COMPRESS_QUALITY_HIGH));
+		gli::texture2d const DecompressedBC1(gli::decompress(CompressedBC1, gli::FORMAT_RGBA8_UNORM_PACK8));
+		gli::texture2d const CompressedBC3(gli::compress(Source, gli::FORMAT_RGBA_DXT5_UNORM_BLOCK16));
+		gli::texture2d const DecompressedBC3(gli::decompress(CompressedBC3, gli::FORMAT_RGBA8_UNORM_PACK8));
+
+		for(int y = 0; y < 16; ++y)
+		for(int x = 0; x < 16; ++x)
+		{
+			gli::texture2d::extent_type const Coord(x, y);
+			glm::u8vec4 const Texel = Source.load<glm::u8vec4>(Coord, 0);
+			Error += DecompressedBC1.load<glm::u8vec4>(Coord, 0).a == Texel.a ? 0 : 1;
+			Error += DecompressedBC3.load<glm::u8vec4>(Coord, 0).a == Texel.a ? 0 : 1;
+		}
+
+		return Error;
+	}
+}//namespace compress_alpha
+
+namespace compress_pipeline
+{
+	// Source cube map, mipmaps, compression and DDS container in a single process
+	int test(gli::format Format, gli::compress_quality Quality)
+	{
+		int Error(0);
+
+		gli::texture_cube::extent_type const Extent(37, 37);
+		gli::texture_cube Source(gli::FORMAT_RGBA32_SFLOAT_PACK32, Extent, gli::levels(Extent));
+		for(gli::size_t Face = 0; Face < Source.faces(); ++Face)
+		for(int y = 0; y < 37; ++y)
+		for(int x = 0; x < 37; ++x)
+			Source.store(gli::texture_cube::extent_type(x, y), Face, 0, glm::vec4((x + y) / 72.0f, 1.0f - (x + y) / 72.0f, Face / 5.0f, 1.0f));
+
+		gli::texture_cube const Mipmaps(gli::generate_mipmaps(Source, gli::FILTER_LINEAR));
+
+		gli::texture_cube const Compressed(gli::compress(Mipmaps, Format, Quality));
+		Error += Compressed.format() == Format ? 0 : 1;
+		Error += Compressed.levels() == Mipmaps.levels() ? 0 : 1;
+		Error += Compressed.faces() == 6 ? 0 : 1;
+
+		std::vector<char> Memory;
+		Error += gli::save_dds(Compressed, Memory) ? 0 : 1;
+		gli::texture_cube const Loaded(gli::load_dds(&Memory[0], Memory.size()));
+		Error += Loaded == Compressed ? 0 : 1;
+
+		// The gradient survives the compression of every level, including the partial blocks
+		gli::texture_cube const Reference(gli::convert(Mipmaps, gli::FORMAT_RGBA8_UNORM_PACK8));
+		Error += rmse(Reference, Compressed, channels(Format)) < 4.0 ? 0 : 1;
+
+		return Error;
+	}
+}//namespace compress_pipeline
+
+namespace compress_srgb
+{
+	// sRGB destination formats compress the sRGB encoding of the source
+	int test()
+	{
+		int Error(0);
+
+		gli::texture2d const Source(gli::load(path("kueken7_rgba8_srgb.dds")));
+		gli::texture2d const Image(gli::view(Source, 0, 0));
+
+		gli::texture2d const Compressed(gli::compress(Image, gli::FORMAT_RGBA_DXT5_SRGB_BLOCK16));
+		Error += Compressed.format() == gli::FORMAT_RGBA_DXT5_SRGB_BLOCK16 ? 0 : 1;
+		Error += rmse(Image, Compressed, glm::bvec4(true)) < 8.0 ? 0 : 1;
+
+		Error += gli::is_compressible(gli::FORMAT_RGBA_DXT1_SRGB_BLOCK8) ? 0 : 1;
+		Error += !gli::is_compressible(gli::FORMAT_RGBA_DXT3_UNORM_BLOCK16) ? 0 : 1;
+		Error += !gli::is_compressible(gli::FORMAT_RGBA8_UNORM_PACK8) ? 0 : 1;
+
+		return Error;
+	}
+}//namespace compress_srgb
+
+int main()
+{
+	int Error(0);
+
+	Error += compress_file::test(gli::FORMAT_RGB_DXT1_UNORM_BLOCK8, 8.0);
+	Error += compress_file::test(gli::FORMAT_RGBA_DXT5_UNORM_BLOCK16, 8.0);
+	Error += compress_file::test(gli::FORMAT_R_ATI1N_UNORM_BLOCK8, 4.0);
+	Error += compress_file::test(gli::FORMAT_RG_ATI2N_UNORM_BLOCK16, 4.0);
+
+	Error += compress_solid::test();
+	Error += compress_alpha::test();
+
+	for(std::size_t Index = 0; Index < sizeof(Formats) / sizeof(Formats[0]); ++Index)
+		Error += compress_pipeline::test(Formats[Index], gli::COMPRESS_QUALITY_NORMAL);
+	Error += compress_pipeline::test(gli::FORMAT_RGBA_DXT1_UNORM_BLOCK8, gli::COMPRESS_QUALITY_HIGH);
+
+	Error += compress_srgb::test();
+
+	return Error;
+}
@@ -0,0 +1,260 @@
+#include <gli/gli.hpp>
+#include <glm/gtc/packing.hpp>
+#include <cstdlib>
+
+namespace
+{
+	std::string path(const char* filename)
+	{
+		return std::string(SOURCE_DIR) + "/data/" + filename;
+	}
+
+	gli::detail::texel_block4x4 decompress_block(gli::format Format, void const* Block)
+	{
+		switch(Format)
+		{
+		case gli::FORMAT_RGB_DXT1_UNORM_BLOCK8:
+		case gli::FORMAT_RGB_DXT1_SRGB_BLOCK8:
+		case gli::FORMAT_RGBA_DXT1_UNORM_BLOCK8:
+		case gli::FORMAT_RGBA_DXT1_SRGB_BLOCK8:
+			return gli::detail::decompress_bc1_block(*static_cast<gli::detail::bc1_block const*>(Block));
+		case gli::FORMAT_RGBA_DXT3_UNORM_BLOCK16:
+		case gli::FORMAT_RGBA_DXT3_SRGB_BLOCK16:
+			return gli::detail::decompress_bc2_block(*static_cast<gli::detail::bc2_block const*>(Block));
+		case gli::FORMAT_RGBA_DXT5_UNORM_BLOCK16:
+		case gli::FORMAT_RGBA_DXT5_SRGB_BLOCK16:
+			return gli::detail::decompress_bc3_block(*static_cast<gli::detail::bc3_block const*>(Block));
+		case gli::FORMAT_R_ATI1N_UNORM_BLOCK8:
+			return gli::detail::decompress_bc4unorm_block(*static_cast<gli::detail::bc4_block const*>(Block));
+		case gli::FORMAT_R_ATI1N_SNORM_BLOCK8:
+			return gli::detail::decompress_bc4snorm_block(*static_cast<gli::detail::bc4_block const*>(Block));
+		case gli::FORMAT_RG_ATI2N_UNORM_BLOCK16:
+			return gli::detail::decompress_bc5unorm_block(*static_cast<gli::detail::bc5_block const*>(Block));
+		default:
+			return gli::detail::decompress_bc5snorm_block(*static_cast<gli::detail::bc5_block const*>(Block));
+		}
+	}
+
+	// Pack a texel decoded by the reference block decoders like the destination format stores it
+	bool equal_texel(gli::texture const& Texture, gli::texture::extent_type const& Coord, gli::size_t Layer, gli::size_t Face, gli::size_t Level, glm::vec4 const& Reference)
+	{
+		gli::texture::extent_type const Extent(Texture.extent(Level));
+		gli::size_t const Offset = static_cast<gli::size_t>((Coord.z * Extent.y + Coord.y) * Extent.x + Coord.x);
+
+		switch(Texture.format())
+		{
+		case gli::FORMAT_RGBA8_UNORM_PACK8:
+		case gli::FORMAT_RGBA8_SRGB_PACK8:
+			return Texture.data<glm::uint32>(Layer, Face, Level)[Offset] == glm::packUnorm4x8(Reference);
+		case gli::FORMAT_RGBA8_SNORM_PACK8:
+			return Texture.data<glm::uint32>(Layer, Face, Level)[Offset] == glm::packSnorm4x8(Reference);
+		case gli::FORMAT_RGBA16_SFLOAT_PACK16:
+			return Texture.data<glm::uint64>(Layer, Face, Level)[Offset] == glm::packHalf4x16(Reference);
+		default:
+			return std::memcmp(Texture.data<glm::vec4>(Layer, Face, Level) + Offset, &Reference[0], sizeof(glm::vec4)) == 0;
+		}
+	}
+
+	// Compare every texel of the bulk decompression with the reference block decoders
+	int compare(gli::texture const& Compressed, gli::texture const& Decompressed)
+	{
+		int Error(0);
+
+		gli::texture::extent_type const BlockExtent(gli::block_extent(Compressed.format()));
+		gli::size_t const BlockSize = gli::block_size(Compressed.format());
+
+		for(gli::size_t Layer = 0; Layer < Compressed.layers(); ++Layer)
+		for(gli::size_t Face = 0; Face < Compressed.faces(); ++Face)
+		for(gli::size_t Level = 0; Level < Compressed.levels(); ++Level)
+		{
+			gli::texture::extent_type const Extent(Compressed.extent(Level));
+			gli::texture::extent_type const BlockCount(glm::ceilMultiple(Extent, BlockExtent) / BlockExtent);
+			char const* const Data = Compressed.data<char>(Layer, Face, Level);
+
+			for(int z = 0; z < Extent.z; ++z)
+			for(int y = 0; y < Extent.y; ++y)
+			for(int x = 0; x < Extent.x; ++x)
+			{
+				gli::size_t const BlockIndex = static_cast<gli::size_t>((z * BlockCount.y + y / 4) * BlockCount.x + x / 4);
+				gli::detail::texel_block4x4 const Block = decompress_block(Compressed.format(), Data + BlockIndex * BlockSize);
+
+				Error += equal_texel(Decompressed, gli::texture::extent_type(x, y, z), Layer, Face, Level, Block.Texel[y % 4][x % 4]) ? 0 : 1;
+			}
+		}
+
+		return Error;
+	}
+
+	gli::format const Destinations[] =
+	{
+		gli::FORMAT_RGBA8_UNORM_PACK8,
+		gli::FORMAT_RGBA8_SNORM_PACK8,
+		gli::FORMAT_RGBA16_SFLOAT_PACK16,
+		gli::FORMAT_RGBA32_SFLOAT_PACK32
+	};
+}//namespace
+
+namespace decompress_file
+{
+	int test(char const* Filename)
+	{
+		int Error(0);
+
+		gli::texture const Compressed(gli::load(path(Filename)));
+		Error += !Compressed.empty() ? 0 : 1;
+
+		for(std::size_t Index = 0; Index < sizeof(Destinations) / sizeof(Destinations[0]); ++Index)
+		{
+			gli::texture const Decompressed(gli::decompress(Compressed, Destinations[Index]));
+			Error += Decompressed.format() == Destinations[Index] ? 0 : 1;
+			Error += Decompressed.levels() == Compressed.levels() ? 0 : 1;
+			Error += compare(Compressed, Decompressed);
+		}
+
+		return Error;
+	}
+}//namespace decompress_file
+
+namespace decompress_random
+{
+	// Random blocks reach every palette mode, sizes that aren't multiple of 4 exercise the partial blocks
+	int test(gli::format Format, gli::target Target, gli::texture::extent_type const& Extent)
+	{
+		int Error(0);
+
+		gli::size_t const Faces = gli::is_target_cube(Target) ? 6 : 1;
+		gli::size_t const Layers = gli::is_target_array(Target) ? 3 : 1;
+		gli::texture Compressed(Target, Format, Extent, Layers, Faces, gli::levels(Extent));
+
+		std::srand(static_cast<unsigned>(Format));
+		glm::uint8* const Data = Compressed.data<glm::uint8>();
+		for(gli::size_t Index = 0; Index < Compressed.size(); ++Index)
+			Data[Index] = static_cast<glm::uint8>(std::rand());
+
+		for(std::size_t Index = 0; Index < sizeof(Destinations) / sizeof(Destinations[0]); ++Index)
+			Error += compare(Compressed, gli::decompress(Compressed, Destinations[Index]));
+
+		return Error;
+	}
+}//namespace decompress_random
+
+namespace dispatch
+{
+	// The SIMD lookup chosen at runtime decodes like the scalar lookup, whatever instruction set the tests are compiled for
+	template <typename packer>
+	int test(gli::format Format)
+	{
+		int Error(0);
+
+		typedef gli::detail::bc_decoder<packer> decoder;
+		decoder const Decoder;
+		typename decoder::decode_func const Scalar = decoder::find(Format, gli::detail::CPU_ARCH_SCALAR);
+		typename decoder::decode_func const Widest = decoder::find(Format);
+		Error += Scalar != nullptr && Widest != nullptr ? 0 : 1;
+		if(!Scalar || !Widest)
+			return Error;
+
+		std::srand(static_cast<unsigned>(Format));
+		for(int Block = 0; Block < 256; ++Block)
+		{
+			glm::uint8 Data[16];
+			for(std::size_t Index = 0; Index < sizeof(Data); ++Index)
+				Data[Index] = static_cast<glm::uint8>(std::rand());
+
+			typename decoder::texel_type TexelsScalar[16];
+			typename decoder::texel_type TexelsWidest[16];
+			(Decoder.*Scalar)(Data, TexelsScalar);
+			(Decoder.*Widest)(Data, TexelsWidest);
+			Error += std::memcmp(TexelsScalar, TexelsWidest, sizeof(TexelsScalar)) == 0 ? 0 : 1;
+		}
+
+		return Error;
+	}
+}//namespace dispatch
+
+namespace decompress_typed
+{
+	int test()
+	{
+		int Error(0);
+
+		gli::texture2d const Compressed2D(gli::load(path("kueken7_rgba_dxt5_unorm.dds")));
+		gli::texture2d const Decompressed(gli::decompress(Compressed2D, gli::FORMAT_RGBA8_UNORM_PACK8));
+		Error += Decompressed.extent() == Compressed2D.extent() ? 0 : 1;
+		Error += !Decompressed.empty() ? 0 : 1;
+
+		// Decompressing a view decompresses only the levels of the view
+		gli::texture2d const View(gli::view(Compressed2D, 1, 2));
+		gli::texture2d const DecompressedView(gli::decompress(View, gli::FORMAT_RGBA8_UNORM_PACK8));
+		Error += DecompressedView.levels() == 2 ? 0 : 1;
+		Error += DecompressedView[0] == Decompressed[1] ? 0 : 1;
+
+		Error += gli::is_decompressible(gli::FORMAT_RGBA_DXT1_UNORM_BLOCK8, gli::FORMAT_RGBA8_UNORM_PACK8) ? 0 : 1;
+		Error += !gli::is_decompressible(gli::FORMAT_RGBA8_UNORM_PACK8, gli::FORMAT_RGBA8_UNORM_PACK8) ? 0 : 1;
+		Error += !gli::is_decompressible(gli::FORMAT_RGBA_DXT1_UNORM_BLOCK8, gli::FORMAT_RGB8_UNORM_PACK8) ? 0 : 1;
+
+		return Error;
+	}
+}//namespace decompress_typed
+
+namespace decompress_reference_file
+{
+	// The repository ships reference decompressions made by an external tool
+	int test(char const* FilenameCompressed, char const* FilenameDecompressed)
+	{
+		int Error(0);
+
+		gli::texture2d const Compressed(gli::load(path(FilenameCompressed)));
+		gli::texture2d const Reference(gli::load(path(FilenameDecompressed)));
+		Error += Reference.format() == gli::FORMAT_RGBA8_UNORM_PACK8 ? 0 : 1;
+
+		gli::texture2d const Decompressed(gli::decompress(Compressed, gli::FORMAT_RGBA8_UNORM_PACK8));
+		Error += Decompressed == Reference ? 0 : 1;
+
+		return Error;
+	}
+}//namespace decompress_reference_file
+
+int main()
+{
+	int Error(0);
+
+	Error += decompress_file::test("kueken7_rgba_dxt1_unorm.dds");
+	Error += decompress_file::test("kueken7_rgb_dxt1_unorm.ktx");
+	Error += decompress_file::test("kueken7_rgba_dxt3_unorm.dds");
+	Error += decompress_file::test("kueken7_rgba_dxt5_unorm.dds");
+	Error += decompress_file::test("kueken7_r_ati1n_unorm.dds");
+	Error += decompress_file::test("kueken7_rg_ati2n_unorm.dds");
+
+	gli::format const Formats[] =
+	{
+		gli::FORMAT_RGBA_DXT1_UNORM_BLOCK8,
+		gli::FORMAT_RGBA_DXT3_UNORM_BLOCK16,
+		gli::FORMAT_RGBA_DXT5_SRGB_BLOCK16,
+		gli::FORMAT_R_ATI1N_UNORM_BLOCK8,
+		gli::FORMAT_R_ATI1N_SNORM_BLOCK8,
+		gli::FORMAT_RG_ATI2N_UNORM_BLOCK16,
+		gli::FORMAT_RG_ATI2N_SNORM_BLOCK16
+	};
+
+	for(std::size_t Index = 0; Index < sizeof(Formats) / sizeof(Formats[0]); ++Index)
+	{
+		Error += decompress_random::test(Formats[Index], gli::TARGET_2D, gli::texture::extent_type(37, 22, 1));
+		Error += decompress_random::test(Formats[Index], gli::TARGET_CUBE_ARRAY, gli::texture::extent_type(32, 32, 1));
+	}
+
+	for(std::size_t Index = 0; Index < sizeof(Formats) / sizeof(Formats[0]); ++Index)
+	{
+		Error += dispatch::test<gli::detail::decompress_rgba8_unorm>(Formats[Index]);
+		Error += dispatch::test<gli::detail::decompress_rgba8_snorm>(Formats[Index]);
+		Error += dispatch::test<gli::detail::decompress_rgba16_sfloat>(Formats[Index]);
+		Error += dispatch::test<gli::detail::decompress_rgba32_sfloat>(Formats[Index]);
+	}
+
+	Error += decompress_typed::test();
+
+	Error += decompress_reference_file::test("kueken7_rgba_dxt1_unorm.dds", "kueken7_rgba_dxt1_unorm_decompressed.dds");
+	Error += decompress_reference_file::test("kueken7_rgba_dxt5_unorm.dds", "kueken7_rgba_dxt5_unorm_decompressed.dds");
+
+	return Error;
+}
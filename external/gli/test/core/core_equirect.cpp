@@ -0,0 +1,164 @@
+#include <gli/equirect.hpp>
+#include <gli/convert.hpp>
+#include <glm/gtc/epsilon.hpp>
+#include <cmath>
+
+namespace
+{
+	// Direction of the center of a texel, following the OpenGL cube map face layout
+	glm::vec3 texel_direction(gli::size_t Face, int x, int y, int Size)
+	{
+		float const s = (static_cast<float>(x) + 0.5f) * 2.0f / static_cast<float>(Size) - 1.0f;
+		float const t = (static_cast<float>(y) + 0.5f) * 2.0f / static_cast<float>(Size) - 1.0f;
+
+		glm::vec3 const Directions[] =
+		{
+			glm::vec3(1.0f, -t, -s), glm::vec3(-1.0f, -t, s),
+			glm::vec3(s, 1.0f, t), glm::vec3(s, -1.0f, -t),
+			glm::vec3(s, -t, 1.0f), glm::vec3(-s, -t, -1.0f)
+		};
+		return glm::normalize(Directions[Face]);
+	}
+
+	// Panorama storing the direction of the center of each texel
+	gli::texture2d make_directions(int Width, int Height)
+	{
+		gli::texture2d Texture(gli::FORMAT_RGBA32_SFLOAT_PACK32, gli::texture2d::extent_type(Width, Height), 1);
+		for(int y = 0; y < Height; ++y)
+		for(int x = 0; x < Width; ++x)
+		{
+			float const Longitude = ((static_cast<float>(x) + 0.5f) / static_cast<float>(Width) - 0.5f) * 2.0f * glm::pi<float>();
+			float const Latitude = (0.5f - (static_cast<float>(y) + 0.5f) / static_cast<float>(Height)) * glm::pi<float>();
+			glm::vec3 const Direction(std::cos(Latitude) * std::sin(Longitude), std::sin(Latitude), -std::cos(Latitude) * std::cos(Longitude));
+			Texture.store(gli::texture2d::extent_type(x, y), 0, glm::vec4(Direction, 1.0f));
+		}
+		return Texture;
+	}
+
+	// Largest distance between the direction stored in each texel and the direction of the texel
+	float direction_error(gli::texture_cube const& Texture)
+	{
+		gli::texture_cube const Float(gli::convert(Texture, gli::FORMAT_RGBA32_SFLOAT_PACK32));
+		int const Size = Float.extent().x;
+		float Max = 0.0f;
+		for(gli::size_t Face = 0; Face < 6; ++Face)
+		for(int y = 0; y < Size; ++y)
+		for(int x = 0; x < Size; ++x)
+		{
+			glm::vec4 const Texel(Float.load<glm::vec4>(gli::texture_cube::extent_type(x, y), Face, 0));
+			Max = glm::max(Max, glm::length(glm::vec3(Texel) - texel_direction(Face, x, y, Size)));
+		}
+		return Max;
+	}
+}//namespace
+
+namespace arc_tangent
+{
+	int test()
+	{
+		int Error = 0;
+
+		float Max = 0.0f;
+		for(int j = -50; j <= 50; ++j)
+		for(int i = -50; i <= 50; ++i)
+		{
+			float const Y[4] = {static_cast<float>(j) * 0.1f, static_cast<float>(j) * 7.0f, static_cast<float>(j) * 1e-3f, static_cast<float>(j)};
+			float const X[4] = {static_cast<float>(i) * 0.1f, static_cast<float>(i) * 1e-3f, static_cast<float>(i) * 7.0f, static_cast<float>(i)};
+			float Angles[4];
+			gli::detail::lane_atan2(gli::detail::simd_vec4::load(Y), gli::detail::simd_vec4::load(X)).store(Angles);
+			for(int Lane = 0; Lane < 4; ++Lane)
+				Max = glm::max(Max, std::abs(Angles[Lane] - std::atan2(Y[Lane], X[Lane])));
+		}
+		Error += Max < 1e-6f ? 0 : 1;
+
+		return Error;
+	}
+}//namespace arc_tangent
+
+namespace constant
+{
+	int test()
+	{
+		int Error = 0;
+
+		// A constant panorama gives constant faces whatever the filtering, opaque for RGB sources
+		gli::texture2d Texture(gli::FORMAT_RGB32_SFLOAT_PACK32, gli::texture2d::extent_type(64, 32), 1);
+		Texture.clear(glm::vec3(2.0f, 0.5f, 16.0f));
+
+		gli::texture_cube const Cube(gli::equirect_to_cube(Texture, 24, gli::FORMAT_RGBA16_SFLOAT_PACK16, 3));
+		Error += Cube.format() == gli::FORMAT_RGBA16_SFLOAT_PACK16 && Cube.extent() == gli::texture_cube::extent_type(24) && Cube.levels() == 1 ? 0 : 1;
+
+		gli::texture_cube const Float(gli::convert(Cube, gli::FORMAT_RGBA32_SFLOAT_PACK32));
+		for(gli::size_t Face = 0; Face < 6; ++Face)
+		for(int y = 0; y < 24; ++y)
+		for(int x = 0; x < 24; ++x)
+		{
+			glm::vec4 const Texel(Float.load<glm::vec4>(gli::texture_cube::extent_type(x, y), Face, 0));
+			Error += glm::all(glm::equal(Texel, glm::vec4(2.0f, 0.5f, 16.0f, 1.0f))) ? 0 : 1;
+		}
+
+		// Unsupported result format
+		Error += gli::equirect_to_cube(Texture, 8, gli::FORMAT_R8_UNORM_PACK8).empty() ? 0 : 1;
+
+		return Error;
+	}
+}//namespace constant
+
+namespace directions
+{
+	int test()
+	{
+		int Error = 0;
+
+		gli::texture2d const Texture(make_directions(256, 128));
+
+		// Each texel of the faces looks at the panorama texels of its direction
+		float const Bilinear = direction_error(gli::equirect_to_cube(Texture, 32, gli::FORMAT_RGBA32_SFLOAT_PACK32));
+		Error += Bilinear < 0.001f ? 0 : 1;
+
+		// The samples spread over the texels average around their center, the half float result loses a little precision
+		float const Supersampled = direction_error(gli::equirect_to_cube(Texture, 32, gli::FORMAT_RGBA16_SFLOAT_PACK16, 4));
+		Error += Supersampled < 0.005f ? 0 : 1;
+
+		// Other formats are converted first
+		float const Half = direction_error(gli::equirect_to_cube(gli::convert(Texture, gli::FORMAT_RGBA16_SFLOAT_PACK16), 32));
+		Error += Half < 0.005f ? 0 : 1;
+		float const Rgb16 = direction_error(gli::equirect_to_cube(gli::convert(Texture, gli::FORMAT_RGB16_SFLOAT_PACK16), 32));
+		Error += Rgb16 < 0.005f ? 0 : 1;
+		float const Snorm = direction_error(gli::equirect_to_cube(gli::convert(Texture, gli::FORMAT_RGBA8_SNORM_PACK8), 32));
+		Error += Snorm < 0.03f ? 0 : 1;
+
+		return Error;
+	}
+}//namespace directions
+
+namespace levels
+{
+	int test()
+	{
+		int Error = 0;
+
+		gli::texture2d Texture(gli::FORMAT_RGBA8_UNORM_PACK8, gli::texture2d::extent_type(128, 64), 1);
+		Texture.clear(glm::u8vec4(255, 128, 0, 255));
+
+		gli::texture_cube const Cube(gli::equirect_to_cube(Texture, 64, gli::FORMAT_RGBA8_UNORM_PACK8, 2, 7));
+		Error += Cube.levels() == 7 ? 0 : 1;
+		for(gli::size_t Face = 0; Face < 6; ++Face)
+		for(gli::size_t Level = 0; Level < Cube.levels(); ++Level)
+			Error += Cube.load<glm::u8vec4>(gli::texture_cube::extent_type(0), Face, Level) == glm::u8vec4(255, 128, 0, 255) ? 0 : 1;
+
+		return Error;
+	}
+}//namespace levels
+
+int main()
+{
+	int Error = 0;
+
+	Error += arc_tangent::test();
+	Error += constant::test();
+	Error += directions::test();
+	Error += levels::test();
+
+	return Error;
+}
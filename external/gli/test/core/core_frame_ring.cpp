@@ -0,0 +1,160 @@
+#include <gli/frame_ring.hpp>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace alignment
+{
+	int test()
+	{
+		int Error = 0;
+
+		// Non power of two alignments are valid, the regions are rounded down to a multiple of the alignment
+		std::vector<unsigned char> Buffer(1000);
+		gli::manual_fence_backend Fences;
+		gli::frame_ring Ring(&Buffer[0], Buffer.size(), 3, 48, Fences);
+		Error += Ring.frames() == 3 ? 0 : 1;
+		Error += Ring.frame_capacity() == 288 ? 0 : 1;
+
+		// No frame begun
+		Error += Ring.allocate(4).Data == nullptr ? 0 : 1;
+
+		Error += Ring.begin_frame() ? 0 : 1;
+		gli::frame_allocation const A = Ring.allocate(1);
+		gli::frame_allocation const B = Ring.allocate(50);
+		gli::frame_allocation const C = Ring.push(42);
+		Error += A.Offset == 0 && A.Data == &Buffer[0] ? 0 : 1;
+		Error += B.Offset == 48 && B.Data == &Buffer[48] && B.Size == 50 ? 0 : 1;
+		Error += C.Offset == 144 && *static_cast<int const*>(C.Data) == 42 ? 0 : 1;
+		Error += Ring.used() == 144 + sizeof(int) ? 0 : 1;
+		Ring.end_frame();
+		Error += Ring.used() == 0 ? 0 : 1;
+
+		// The next frame allocates in the next region
+		Error += Ring.begin_frame() ? 0 : 1;
+		Error += Ring.allocate(1).Offset == 288 ? 0 : 1;
+		Ring.end_frame();
+
+		return Error;
+	}
+}//namespace alignment
+
+namespace wraparound
+{
+	int test()
+	{
+		int Error = 0;
+
+		std::vector<unsigned char> Buffer(3 * 256);
+		gli::manual_fence_backend Fences;
+		{
+			gli::frame_ring Ring(&Buffer[0], Buffer.size(), 3, 256, Fences);
+
+			// The GPU runs two frames behind: the region of each frame was consumed before it is reused
+			for(std::size_t Frame = 0; Frame < 10; ++Frame)
+			{
+				if(Frame >= 2)
+					Fences.signal(Frame - 1);
+
+				Error += Ring.begin_frame(0) ? 0 : 1;
+				Error += Ring.allocate(256).Offset == Frame % 3 * 256 ? 0 : 1;
+				Ring.end_frame();
+			}
+
+			Error += Ring.stalls() == 0 ? 0 : 1;
+			Error += Ring.overflows() == 0 ? 0 : 1;
+
+			// Every fence but the ones of the frames in flight was released
+			Error += Fences.pending() == 3 ? 0 : 1;
+		}
+
+		// The ring releases the fences still pending
+		Error += Fences.pending() == 0 ? 0 : 1;
+
+		return Error;
+	}
+}//namespace wraparound
+
+namespace stall
+{
+	int test()
+	{
+		int Error = 0;
+
+		std::vector<unsigned char> Buffer(2 * 64);
+		gli::manual_fence_backend Fences;
+		gli::frame_ring Ring(&Buffer[0], Buffer.size(), 2, 64, Fences);
+
+		for(int Frame = 0; Frame < 2; ++Frame)
+		{
+			Error += Ring.begin_frame(0) ? 0 : 1;
+			Ring.end_frame();
+		}
+
+		// The GPU didn't consume the first frame: the third one times out and can't allocate
+		Error += !Ring.begin_frame(1000) ? 0 : 1;
+		Error += Ring.stalls() == 1 ? 0 : 1;
+		Error += Ring.allocate(4).Data == nullptr ? 0 : 1;
+		Ring.end_frame();
+		Error += Fences.pending() == 2 ? 0 : 1;
+
+		// It waits for the GPU to reach the fence
+		std::thread Gpu([&Fences]()
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+			Fences.signal(1);
+		});
+		Error += Ring.begin_frame() ? 0 : 1;
+		Gpu.join();
+
+		Error += Ring.stalls() == 2 ? 0 : 1;
+		Error += Ring.allocate(4).Offset == 0 ? 0 : 1;
+		Ring.end_frame();
+		Error += Fences.pending() == 2 ? 0 : 1;
+
+		return Error;
+	}
+}//namespace stall
+
+namespace overflow
+{
+	int test()
+	{
+		int Error = 0;
+
+		std::vector<unsigned char> Buffer(2 * 256);
+		gli::manual_fence_backend Fences;
+		gli::frame_ring Ring(&Buffer[0], Buffer.size(), 2, 64, Fences);
+
+		Error += Ring.begin_frame() ? 0 : 1;
+		Error += Ring.allocate(100).Data != nullptr ? 0 : 1;
+
+		// The padding to the alignment counts
+		Error += Ring.allocate(129).Data == nullptr ? 0 : 1;
+		Error += Ring.allocate(128).Offset == 128 ? 0 : 1;
+		Error += Ring.allocate(1).Data == nullptr ? 0 : 1;
+		Error += Ring.allocate(static_cast<std::size_t>(-1)).Data == nullptr ? 0 : 1;
+		Error += Ring.overflows() == 3 ? 0 : 1;
+		Ring.end_frame();
+
+		// Allocations never spill into the region of another frame
+		Error += Ring.begin_frame() ? 0 : 1;
+		Error += Ring.allocate(257).Data == nullptr ? 0 : 1;
+		Error += Ring.allocate(256).Offset == 256 ? 0 : 1;
+		Ring.end_frame();
+
+		return Error;
+	}
+}//namespace overflow
+
+int main()
+{
+	int Error = 0;
+
+	Error += alignment::test();
+	Error += wraparound::test();
+	Error += stall::test();
+	Error += overflow::test();
+
+	return Error;
+}
@@ -0,0 +1,179 @@
+#include <gli/lighting.hpp>
+#include <gli/convert.hpp>
+#include <glm/gtc/epsilon.hpp>
+#include <glm/gtc/packing.hpp>
+
+namespace
+{
+	// Direction of the center of a texel, following the OpenGL cube map face layout
+	glm::vec3 texel_direction(gli::size_t Face, int x, int y, int Size)
+	{
+		float const s = (static_cast<float>(x) + 0.5f) * 2.0f / static_cast<float>(Size) - 1.0f;
+		float const t = (static_cast<float>(y) + 0.5f) * 2.0f / static_cast<float>(Size) - 1.0f;
+
+		glm::vec3 const Directions[] =
+		{
+			glm::vec3(1.0f, -t, -s), glm::vec3(-1.0f, -t, s),
+			glm::vec3(s, 1.0f, t), glm::vec3(s, -1.0f, -t),
+			glm::vec3(s, -t, 1.0f), glm::vec3(-s, -t, -1.0f)
+		};
+		return glm::normalize(Directions[Face]);
+	}
+
+	gli::texture_cube make_constant(glm::vec4 const& Color, int Size)
+	{
+		gli::texture_cube Texture(gli::FORMAT_RGBA32_SFLOAT_PACK32, gli::texture_cube::extent_type(Size));
+		for(gli::size_t Face = 0; Face < 6; ++Face)
+		for(gli::size_t Level = 0; Level < Texture.levels(); ++Level)
+			Texture.clear(0, Face, Level, Color);
+		return Texture;
+	}
+
+	// Cube map storing the direction of each texel: a signal made of the first band of spherical harmonics
+	gli::texture_cube make_directions(int Size)
+	{
+		gli::texture_cube Texture(gli::FORMAT_RGBA32_SFLOAT_PACK32, gli::texture_cube::extent_type(Size), 1);
+		for(gli::size_t Face = 0; Face < 6; ++Face)
+		for(int y = 0; y < Size; ++y)
+		for(int x = 0; x < Size; ++x)
+			Texture.store(gli::texture_cube::extent_type(x, y), Face, 0, glm::vec4(texel_direction(Face, x, y, Size), 1.0f));
+		return Texture;
+	}
+}//namespace
+
+namespace spherical_harmonics
+{
+	int test()
+	{
+		int Error = 0;
+
+		glm::vec3 const Directions[] =
+		{
+			glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(0.0f, -1.0f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f), glm::normalize(glm::vec3(1.0f, -2.0f, 3.0f))
+		};
+
+		// A constant signal only has a band 0 coefficient, the irradiance of a constant radiance is pi times the radiance
+		{
+			glm::vec4 const Color(0.25f, 0.5f, 1.0f, 1.0f);
+			gli::spherical_harmonics const Constant(gli::project_spherical_harmonics(make_constant(Color, 32)));
+			for(int Index = 1; Index < 9; ++Index)
+				Error += glm::all(glm::epsilonEqual(Constant.Coefficients[Index], glm::vec3(0.0f), 0.001f)) ? 0 : 1;
+
+			for(std::size_t Index = 0; Index < sizeof(Directions) / sizeof(Directions[0]); ++Index)
+			{
+				Error += glm::all(glm::epsilonEqual(Constant.evaluate(Directions[Index]), glm::vec3(Color), 0.001f)) ? 0 : 1;
+				Error += glm::all(glm::epsilonEqual(Constant.irradiance(Directions[Index]), glm::vec3(Color) * glm::pi<float>(), 0.005f)) ? 0 : 1;
+			}
+		}
+
+		// The first band is projected exactly, its irradiance is scaled by 2 pi / 3
+		{
+			gli::spherical_harmonics const Linear(gli::project_spherical_harmonics(make_directions(64)));
+			for(std::size_t Index = 0; Index < sizeof(Directions) / sizeof(Directions[0]); ++Index)
+			{
+				Error += glm::all(glm::epsilonEqual(Linear.evaluate(Directions[Index]), Directions[Index], 0.01f)) ? 0 : 1;
+				Error += glm::all(glm::epsilonEqual(Linear.irradiance(Directions[Index]), Directions[Index] * glm::pi<float>() * 2.0f / 3.0f, 0.02f)) ? 0 : 1;
+			}
+		}
+
+		// The projection reads a level at most MaxExtent texels wide
+		{
+			gli::texture_cube const Texture(make_constant(glm::vec4(0.5f), 64));
+			gli::spherical_harmonics const Small(gli::project_spherical_harmonics(Texture, 4));
+			Error += glm::all(glm::epsilonEqual(Small.evaluate(Directions[3]), glm::vec3(0.5f), 0.001f)) ? 0 : 1;
+		}
+
+		return Error;
+	}
+}//namespace spherical_harmonics
+
+namespace prefilter
+{
+	int test()
+	{
+		int Error = 0;
+
+		// Every roughness keeps a constant radiance constant
+		{
+			glm::vec4 const Color(0.25f, 0.5f, 1.0f, 1.0f);
+			gli::texture_cube const Texture(gli::prefilter_ggx(make_constant(Color, 32), gli::FORMAT_RGBA16_SFLOAT_PACK16, gli::texture_cube::extent_type(16), 5, 32));
+			Error += Texture.extent() == gli::texture_cube::extent_type(16) && Texture.levels() == 5 ? 0 : 1;
+
+			for(gli::size_t Face = 0; Face < 6; ++Face)
+			for(gli::size_t Level = 0; Level < Texture.levels(); ++Level)
+			for(int y = 0; y < Texture.extent(Level).y; ++y)
+			for(int x = 0; x < Texture.extent(Level).x; ++x)
+			{
+				glm::vec4 const Texel(glm::unpackHalf4x16(Texture.load<glm::uint64>(gli::texture_cube::extent_type(x, y), Face, Level)));
+				Error += glm::all(glm::epsilonEqual(Texel, Color, 0.005f)) ? 0 : 1;
+			}
+		}
+
+		// The first level resamples the source, the rougher levels blur it around the normal
+		{
+			gli::texture_cube const Texture(gli::prefilter_ggx(make_directions(64), gli::FORMAT_RGBA32_SFLOAT_PACK32, gli::texture_cube::extent_type(16), 4, 64));
+
+			for(gli::size_t Face = 0; Face < 6; ++Face)
+			for(int y = 0; y < 16; y += 5)
+			for(int x = 0; x < 16; x += 5)
+			{
+				glm::vec3 const Normal(texel_direction(Face, x, y, 16));
+				glm::vec4 const Sharp(Texture.load<glm::vec4>(gli::texture_cube::extent_type(x, y), Face, 0));
+				Error += glm::all(glm::epsilonEqual(glm::vec3(Sharp), Normal, 0.02f)) ? 0 : 1;
+
+				float PreviousLength = glm::length(glm::vec3(Sharp));
+				for(gli::size_t Level = 1; Level < Texture.levels(); ++Level)
+				{
+					int const Scale = 1 << Level;
+					glm::vec3 const LevelNormal(texel_direction(Face, x / Scale, y / Scale, 16 / Scale));
+					glm::vec3 const Blurred(Texture.load<glm::vec4>(gli::texture_cube::extent_type(x / Scale, y / Scale), Face, Level));
+
+					// Averaging directions around the normal shortens them and keeps them along the normal
+					float const Length = glm::length(Blurred);
+					Error += Length < PreviousLength + 0.001f ? 0 : 1;
+					Error += glm::dot(Blurred / Length, LevelNormal) > 0.99f ? 0 : 1;
+					PreviousLength = Length;
+				}
+				Error += PreviousLength < 0.9f ? 0 : 1;
+			}
+		}
+
+		return Error;
+	}
+}//namespace prefilter
+
+namespace source
+{
+	// Texture formats without batched sampler are converted first, unsupported result formats return an empty texture
+	int test()
+	{
+		int Error = 0;
+
+		gli::texture_cube const Texture(make_constant(glm::vec4(0.25f, 0.5f, 0.75f, 1.0f), 16));
+		gli::texture_cube const Bytes(gli::convert(Texture, gli::FORMAT_RGBA8_UNORM_PACK8));
+		gli::texture_cube const Swizzled(gli::convert(Texture, gli::FORMAT_BGRA8_UNORM_PACK8));
+
+		gli::spherical_harmonics const A(gli::project_spherical_harmonics(Bytes));
+		gli::spherical_harmonics const B(gli::project_spherical_harmonics(Swizzled));
+		Error += glm::all(glm::epsilonEqual(A.Coefficients[0], B.Coefficients[0], 0.001f)) ? 0 : 1;
+
+		gli::texture_cube const Prefiltered(gli::prefilter_ggx(Swizzled, gli::FORMAT_RGBA8_UNORM_PACK8, gli::texture_cube::extent_type(8), 4, 16));
+		glm::ivec4 const Expected(Bytes.load<glm::u8vec4>(gli::texture_cube::extent_type(0), 0, 0));
+		Error += glm::all(glm::lessThanEqual(glm::abs(glm::ivec4(Prefiltered.load<glm::u8vec4>(gli::texture_cube::extent_type(3, 3), 2, 1)) - Expected), glm::ivec4(1))) ? 0 : 1;
+
+		Error += gli::prefilter_ggx(Texture, gli::FORMAT_R8_UNORM_PACK8, gli::texture_cube::extent_type(8), 1).empty() ? 0 : 1;
+
+		return Error;
+	}
+}//namespace source
+
+int main()
+{
+	int Error = 0;
+
+	Error += spherical_harmonics::test();
+	Error += prefilter::test();
+	Error += source::test();
+
+	return Error;
+}
@@ -62,6 +62,20 @@ namespace load_mem_only
 	}
 }//namespace load_mem_only
 
+namespace load_truncated
+{
+	// The header of these files declares a 4 bpp PVRTC2 format while their images hold 2 bpp of data
+	int test(std::string const & Filename)
+	{
+		int Error(0);
+
+		gli::texture Texture(gli::load_ktx(path(Filename.c_str())));
+		Error += Texture.empty() ? 0 : 1;
+
+		return Error;
+	}
+}//namespace load_truncated
+
 int main()
 {
 	std::vector<std::string> Filenames;
@@ -88,13 +102,14 @@ int main()
 	Filenames.push_back("kueken7_rg_eac_unorm.ktx");
 	Filenames.push_back("kueken7_rgb_pvrtc_2bpp_srgb.ktx");
 	Filenames.push_back("kueken7_rgb_pvrtc_4bpp_srgb.ktx");
-	Filenames.push_back("kueken7_rgba_pvrtc2_2bpp_unorm.ktx");
-	Filenames.push_back("kueken7_rgba_pvrtc2_2bpp_srgb.ktx");
 	Filenames.push_back("kueken7_rgba_pvrtc2_4bpp_unorm.ktx");
 	Filenames.push_back("kueken7_rgba_pvrtc2_4bpp_srgb.ktx");
 
 	int Error(0);
 
+	Error += load_truncated::test("kueken7_rgba_pvrtc2_2bpp_unorm.ktx");
+	Error += load_truncated::test("kueken7_rgba_pvrtc2_2bpp_srgb.ktx");
+
 	std::clock_t TimeFileStart = std::clock();
 	{
 		for(std::size_t Index = 0; Index < Filenames.size(); ++Index)
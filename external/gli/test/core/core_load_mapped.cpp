@@ -0,0 +1,146 @@
+#include <gli/gli.hpp>
+#include <cstring>
+
+namespace
+{
+	std::string path(const char* filename)
+	{
+		return std::string(SOURCE_DIR) + "/data/" + filename;
+	}
+}//namespace
+
+namespace load_mapped
+{
+	int test(std::string const & Filename)
+	{
+		int Error(0);
+
+		gli::texture TextureA(gli::load(path(Filename.c_str())));
+		gli::texture TextureB(gli::load_mapped(path(Filename.c_str())));
+
+		Error += !TextureA.empty() ? 0 : 1;
+		Error += TextureA == TextureB ? 0 : 1;
+
+		return Error;
+	}
+}//namespace load_mapped
+
+namespace zero_copy
+{
+	int test()
+	{
+		int Error(0);
+
+		std::string const Filename(path("cube_rgba8_unorm.dds"));
+
+		std::shared_ptr<gli::detail::mapped_file> Mapping = gli::detail::map_file(Filename.c_str());
+		Error += Mapping ? 0 : 1;
+		if(!Mapping)
+			return Error;
+
+		gli::texture const Reference(gli::load_dds(Filename));
+
+		gli::texture Texture(gli::detail::load_dds(Mapping->data(), Mapping->size(), Mapping));
+		char const* const Begin = Mapping->data();
+		char const* const End = Mapping->data() + Mapping->size();
+		char const* const Data = static_cast<char const*>(Texture.data());
+		Error += Data > Begin && Data + Texture.size() == End ? 0 : 1;
+
+		// The texture keeps the mapping alive
+		Mapping.reset();
+		Error += Texture == Reference ? 0 : 1;
+
+		// Writes land in private pages, the file is left untouched
+		std::memset(Texture.data(), 0, Texture.size(0));
+		gli::texture const Reload(gli::load_dds_mapped(Filename));
+		Error += Reload == Reference ? 0 : 1;
+		Error += Texture != Reference ? 0 : 1;
+
+		return Error;
+	}
+}//namespace zero_copy
+
+namespace truncated
+{
+	int test()
+	{
+		int Error(0);
+
+		std::string const Filename(path("cube_rgba8_unorm.dds"));
+		std::shared_ptr<gli::detail::mapped_file> Mapping = gli::detail::map_file(Filename.c_str());
+		Error += Mapping ? 0 : 1;
+		if(!Mapping)
+			return Error;
+
+		// The texel data of a truncated file is neither borrowed nor copied
+		Error += gli::detail::load_dds(Mapping->data(), Mapping->size() - 1, Mapping).empty() ? 0 : 1;
+		Error += gli::load_dds(Mapping->data(), Mapping->size() - 1).empty() ? 0 : 1;
+		Error += !gli::load_dds(Mapping->data(), Mapping->size()).empty() ? 0 : 1;
+
+		return Error;
+	}
+
+	int test_ktx()
+	{
+		int Error(0);
+
+		gli::texture_cube Texture(gli::FORMAT_RGBA8_UNORM_PACK8, gli::texture_cube::extent_type(256), 1);
+		Texture.clear(gli::u8vec4(255, 127, 0, 255));
+
+		std::vector<char> Memory;
+		Error += gli::save_ktx(Texture, Memory) ? 0 : 1;
+
+		gli::detail::container_desc Desc;
+		Error += gli::detail::parse_ktx10(&Memory[0], Memory.size(), Desc) ? 0 : 1;
+
+		// Cut inside the texel data of the first face, of the last face and inside the image size of the level
+		Error += gli::load_ktx(&Memory[0], 4224).empty() ? 0 : 1;
+		Error += gli::load_ktx(&Memory[0], Memory.size() - 1).empty() ? 0 : 1;
+		Error += gli::load_ktx(&Memory[0], Desc.Offset + 2).empty() ? 0 : 1;
+		Error += gli::load_ktx(&Memory[0], Memory.size()) == gli::texture(Texture) ? 0 : 1;
+
+		return Error;
+	}
+
+	int test_kmg()
+	{
+		int Error(0);
+
+		std::vector<char> Memory;
+		Error += gli::save_kmg(gli::load_ktx(path("cube_rgba8_unorm.ktx")), Memory) ? 0 : 1;
+
+		Error += gli::load_kmg(&Memory[0], Memory.size() - 1).empty() ? 0 : 1;
+		Error += !gli::load_kmg(&Memory[0], Memory.size()).empty() ? 0 : 1;
+
+		return Error;
+	}
+}//namespace truncated
+
+int main()
+{
+	int Error(0);
+
+	char const* Filenames[] =
+	{
+		"cube_rgba8_unorm.dds",
+		"cube_rgba8_unorm.ktx",
+		"array_r8_uint.dds",
+		"array_r8_uint.ktx",
+		"kueken7_rgba_dxt1_unorm.dds",
+		"kueken7_rgba_dxt5_unorm.ktx",
+		"kueken7_rgba16_sfloat.dds",
+		"kueken7_rgb9e5_ufloat.ktx"
+	};
+
+	for(std::size_t Index = 0; Index < sizeof(Filenames) / sizeof(Filenames[0]); ++Index)
+		Error += load_mapped::test(Filenames[Index]);
+
+	Error += zero_copy::test();
+	Error += truncated::test();
+	Error += truncated::test_ktx();
+	Error += truncated::test_kmg();
+
+	Error += gli::load_mapped(path("missing.dds")).empty() ? 0 : 1;
+
+	return Error;
+}
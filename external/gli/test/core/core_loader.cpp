@@ -0,0 +1,220 @@
+#include <gli/loader.hpp>
+#include <gli/comparison.hpp>
+#include <gli/load.hpp>
+#include <cstring>
+#include <map>
+
+namespace
+{
+	std::string path(const char* filename)
+	{
+		return std::string(SOURCE_DIR) + "/data/" + filename;
+	}
+
+	// Records the commands like a graphics backend would execute them, checking the order of the commands of each asset
+	struct mock_uploader
+	{
+		mock_uploader()
+			: Error(0)
+		{}
+
+		void operator()(gli::upload_command const& Command)
+		{
+			std::vector<gli::upload_command>& Asset = this->Assets[Command.Asset];
+			bool const Finished = !Asset.empty() && (Asset.back().Kind == gli::UPLOAD_DONE || Asset.back().Kind == gli::UPLOAD_FAILED);
+			Error += !Finished ? 0 : 1;
+
+			switch(Command.Kind)
+			{
+			case gli::UPLOAD_TEXTURE:
+				Error += Asset.empty() && !Command.Texture.empty() ? 0 : 1;
+				break;
+			case gli::UPLOAD_IMAGE:
+				Error += !Asset.empty() && Asset.front().Kind == gli::UPLOAD_TEXTURE ? 0 : 1;
+				Error += Asset.back().Kind == gli::UPLOAD_TEXTURE || Asset.back().Level >= Command.Level ? 0 : 1;
+				Error += Command.Texture.data(Command.Layer, Command.Face, Command.Level) != nullptr ? 0 : 1;
+				break;
+			case gli::UPLOAD_FILE:
+				Error += Asset.empty() && Command.Data ? 0 : 1;
+				break;
+			case gli::UPLOAD_DONE:
+				Error += !Asset.empty() ? 0 : 1;
+				break;
+			case gli::UPLOAD_FAILED:
+				Error += Asset.empty() ? 0 : 1;
+				break;
+			}
+
+			Asset.push_back(Command);
+		}
+
+		std::map<std::size_t, std::vector<gli::upload_command>> Assets;
+		int Error;
+	};
+
+	void drain_all(gli::asset_loader& Loader, mock_uploader& Uploader)
+	{
+		while(Loader.pending() > 0)
+		{
+			Loader.wait();
+			Loader.drain(Uploader, std::chrono::milliseconds(1));
+		}
+	}
+}//namespace
+
+namespace job_system
+{
+	int test()
+	{
+		int Error = 0;
+
+		for(std::size_t Threads = 1; Threads <= 4; Threads *= 2)
+		{
+			gli::job_system Jobs(Threads);
+			Error += Jobs.threads() == Threads ? 0 : 1;
+
+			// Jobs submitting jobs run on their worker queue, others steal them
+			std::atomic<int> Count(0);
+			for(int Job = 0; Job < 64; ++Job)
+			{
+				Jobs.submit([&Jobs, &Count]()
+				{
+					for(int Child = 0; Child < 16; ++Child)
+						Jobs.submit([&Count](){++Count;});
+					++Count;
+				});
+			}
+
+			Jobs.wait();
+			Error += Count == 64 * 17 ? 0 : 1;
+
+			// Waiting without jobs returns right away
+			Jobs.wait();
+		}
+
+		return Error;
+	}
+}//namespace job_system
+
+namespace loader
+{
+	int test()
+	{
+		int Error = 0;
+
+		gli::job_system Jobs(2);
+		mock_uploader Uploader;
+
+		gli::asset_loader::asset_type Cube = 0, Array = 0, File = 0, Missing = 0, Converted = 0, Storage = 0;
+		{
+			gli::asset_loader Loader(Jobs);
+
+			Cube = Loader.load_texture(path("cube_rgba8_unorm.dds"));
+			Array = Loader.load_texture(path("array_r8_uint.ktx"));
+			File = Loader.load_file(path("cube_rgba8_unorm.ktx"));
+			Missing = Loader.load_texture(path("missing.dds"));
+
+			gli::cache_recipe Recipe;
+			Recipe.Format = gli::FORMAT_BGRA8_UNORM_PACK8;
+			Converted = Loader.load_texture(path("cube_rgba8_unorm.dds"), Recipe);
+			Storage = Loader.load_texture(path("cube_rgba8_unorm.dds"), gli::cache_recipe(), false);
+
+			Error += Loader.pending() == 6 ? 0 : 1;
+			drain_all(Loader, Uploader);
+			Error += Loader.pending() == 0 ? 0 : 1;
+			Error += Loader.drain(Uploader, std::chrono::milliseconds(1)) == 0 ? 0 : 1;
+		}
+		Error += Uploader.Error;
+
+		// Every image of a texture is uploaded, from the smallest level to the largest, with the texels of the file
+		gli::texture const Texture(gli::load(path("cube_rgba8_unorm.dds")));
+		std::vector<gli::upload_command> const& CubeCommands = Uploader.Assets[Cube];
+		Error += CubeCommands.size() == 2 + Texture.layers() * Texture.faces() * Texture.levels() ? 0 : 1;
+		Error += CubeCommands.front().Texture == Texture ? 0 : 1;
+		Error += CubeCommands.back().Kind == gli::UPLOAD_DONE ? 0 : 1;
+		Error += CubeCommands[1].Level == Texture.levels() - 1 ? 0 : 1;
+		for(std::size_t Index = 1; Index + 1 < CubeCommands.size(); ++Index)
+		{
+			gli::upload_command const& Command = CubeCommands[Index];
+			Error += Command.Kind == gli::UPLOAD_IMAGE ? 0 : 1;
+			Error += std::memcmp(Command.Texture.data(Command.Layer, Command.Face, Command.Level), Texture.data(Command.Layer, Command.Face, Command.Level), Texture.size(Command.Level)) == 0 ? 0 : 1;
+		}
+
+		gli::texture const ArrayTexture(gli::load(path("array_r8_uint.ktx")));
+		Error += Uploader.Assets[Array].size() == 2 + ArrayTexture.layers() * ArrayTexture.faces() * ArrayTexture.levels() ? 0 : 1;
+
+		// Files are read whole
+		std::vector<gli::upload_command> const& FileCommands = Uploader.Assets[File];
+		Error += FileCommands.size() == 2 && FileCommands[0].Kind == gli::UPLOAD_FILE ? 0 : 1;
+		Error += gli::load(&(*FileCommands[0].Data)[0], FileCommands[0].Data->size()) == Texture ? 0 : 1;
+
+		Error += Uploader.Assets[Missing].size() == 1 && Uploader.Assets[Missing][0].Kind == gli::UPLOAD_FAILED ? 0 : 1;
+		Error += Uploader.Assets[Converted].front().Texture.format() == gli::FORMAT_BGRA8_UNORM_PACK8 ? 0 : 1;
+
+		// Textures loaded without images only create their storage
+		std::vector<gli::upload_command> const& StorageCommands = Uploader.Assets[Storage];
+		Error += StorageCommands.size() == 2 && StorageCommands[0].Kind == gli::UPLOAD_TEXTURE && StorageCommands[1].Kind == gli::UPLOAD_DONE ? 0 : 1;
+		Error += StorageCommands[0].Texture == Texture ? 0 : 1;
+
+		return Error;
+	}
+}//namespace loader
+
+namespace budget
+{
+	// The render thread runs at least one command per drain, whatever the budget
+	int test()
+	{
+		int Error = 0;
+
+		gli::job_system Jobs(1);
+		gli::asset_loader Loader(Jobs);
+		Loader.load_texture(path("cube_rgba8_unorm.dds"));
+
+		mock_uploader Uploader;
+		std::size_t Drains = 0;
+		while(Loader.pending() > 0)
+		{
+			Loader.wait();
+			Error += Loader.drain(Uploader, std::chrono::steady_clock::duration::zero()) == 1 ? 0 : 1;
+			++Drains;
+		}
+
+		Error += Drains == Uploader.Assets[0].size() ? 0 : 1;
+		Error += Uploader.Error;
+
+		return Error;
+	}
+}//namespace budget
+
+namespace prefault
+{
+	int test()
+	{
+		int Error = 0;
+
+		// One byte of each page and the last byte
+		gli::texture2d Texture(gli::FORMAT_RGBA8_UNORM_PACK8, gli::texture2d::extent_type(64), 1);
+		Texture.clear(glm::u8vec4(1));
+		Error += Texture.size() == 4 * 4096 && gli::detail::prefault(Texture) == 5 ? 0 : 1;
+
+		// Texel data borrowed from a mapped file reads like owned texel data
+		gli::texture const Mapped(gli::load_mapped(path("kueken7_rgba16_sfloat.dds")));
+		gli::texture const Owned(gli::load(path("kueken7_rgba16_sfloat.dds")));
+		Error += !Mapped.empty() && gli::detail::prefault(Mapped) == gli::detail::prefault(Owned) ? 0 : 1;
+
+		return Error;
+	}
+}//namespace prefault
+
+int main()
+{
+	int Error = 0;
+
+	Error += job_system::test();
+	Error += loader::test();
+	Error += budget::test();
+	Error += prefault::test();
+
+	return Error;
+}
@@ -0,0 +1,263 @@
+#include <gli/profiler.hpp>
+#include <gli/job_system.hpp>
+#include <sstream>
+#include <thread>
+
+namespace
+{
+	/// GPU backend whose timestamps complete Latency end_frame calls after they are queued, like GL timer queries
+	class latent_gpu_timer : public gli::gpu_timer
+	{
+	public:
+		explicit latent_gpu_timer(std::uint64_t Latency)
+			: Latency(Latency)
+			, Frame(0)
+			, Resolved(0)
+			, Clock(1000000)
+		{}
+
+		std::uint64_t now()
+		{
+			return this->Clock;
+		}
+
+		std::uint64_t timestamp()
+		{
+			this->Clock += 1000;
+			this->Queued.push_back(std::make_pair(this->Frame, this->Clock));
+			return this->Queued.size() - 1;
+		}
+
+		bool resolve(std::uint64_t Timestamp, std::uint64_t& Time)
+		{
+			if(this->Queued[Timestamp].first + this->Latency > this->Frame)
+				return false;
+
+			Time = this->Queued[Timestamp].second;
+			++this->Resolved;
+			return true;
+		}
+
+		std::uint64_t Latency;
+		std::uint64_t Frame;
+		std::size_t Resolved;
+		std::uint64_t Clock;
+		std::vector<std::pair<std::uint64_t, std::uint64_t>> Queued;
+	};
+
+	std::size_t count(std::vector<gli::profile_event> const& Events, std::string const& Name, bool Gpu)
+	{
+		std::size_t Count = 0;
+		for(std::size_t Index = 0; Index < Events.size(); ++Index)
+			Count += Name == Events[Index].Name && (Events[Index].Thread == 0) == Gpu ? 1 : 0;
+		return Count;
+	}
+}//namespace
+
+namespace cpu_scopes
+{
+	int test()
+	{
+		int Error = 0;
+
+		gli::profiler Profiler;
+		Profiler.end_frame();
+
+		for(int Frame = 0; Frame < 10; ++Frame)
+		{
+			{
+				GLI_PROFILE_SCOPE(Profiler, "Update");
+				GLI_PROFILE_SCOPE(Profiler, "Nested");
+				std::this_thread::sleep_for(std::chrono::microseconds(100));
+			}
+			Profiler.end_frame();
+		}
+
+		std::vector<gli::profile_event> const Events(Profiler.events());
+		Error += count(Events, "Update", false) == 10 ? 0 : 1;
+		Error += count(Events, "Nested", false) == 10 ? 0 : 1;
+		Error += count(Events, "Frame", false) == 10 ? 0 : 1;
+
+		// Scopes nest and frames contain their scopes
+		for(std::size_t Index = 0; Index + 2 < Events.size(); Index += 3)
+		{
+			gli::profile_event const& Nested = Events[Index];
+			gli::profile_event const& Update = Events[Index + 1];
+			gli::profile_event const& Frame = Events[Index + 2];
+			Error += Update.Begin <= Nested.Begin && Nested.End <= Update.End ? 0 : 1;
+			Error += Frame.Begin <= Update.Begin && Update.End <= Frame.End ? 0 : 1;
+			Error += Nested.End - Nested.Begin >= 100000 ? 0 : 1;
+		}
+
+		gli::profile_statistics const Frames(Profiler.frame_statistics());
+		Error += Frames.Count == 10 ? 0 : 1;
+		Error += Frames.P50 >= 100000 && Frames.P50 <= Frames.P99 && Frames.P99 <= Frames.Max ? 0 : 1;
+
+		gli::profile_statistics const Update(Profiler.scope_statistics("Update"));
+		Error += Update.Count == 10 && Update.Mean >= 100000 ? 0 : 1;
+		Error += Profiler.scope_statistics("Update", true).Count == 0 ? 0 : 1;
+		Error += Profiler.scope_statistics("Missing").Count == 0 ? 0 : 1;
+		Error += Profiler.dropped() == 0 ? 0 : 1;
+
+		return Error;
+	}
+}//namespace cpu_scopes
+
+namespace disabled
+{
+	int test()
+	{
+		int Error = 0;
+
+		gli::profiler Profiler;
+		Profiler.enable(false);
+		for(int Frame = 0; Frame < 4; ++Frame)
+		{
+			GLI_PROFILE_SCOPE(Profiler, "Update");
+			Profiler.end_frame();
+		}
+
+		Error += Profiler.events().empty() ? 0 : 1;
+		Error += Profiler.frame_statistics().Count == 0 ? 0 : 1;
+
+		return Error;
+	}
+}//namespace disabled
+
+namespace threads
+{
+	int test()
+	{
+		int Error = 0;
+
+		// Rings of 8 scopes between two frames: the scopes past the capacity are counted as dropped
+		gli::profiler Profiler(nullptr, 8);
+		{
+			gli::job_system Jobs(4);
+			for(int Job = 0; Job < 64; ++Job)
+				Jobs.submit([&Profiler](){GLI_PROFILE_SCOPE(Profiler, "Job");});
+			Jobs.wait();
+		}
+		Profiler.end_frame();
+
+		std::vector<gli::profile_event> const Events(Profiler.events());
+		Error += count(Events, "Job", false) + Profiler.dropped() == 64 ? 0 : 1;
+		Error += Profiler.dropped() > 0 ? 0 : 1;
+
+		// Collected rings take scopes again
+		{
+			std::thread Thread([&Profiler](){GLI_PROFILE_SCOPE(Profiler, "Thread");});
+			Thread.join();
+		}
+		Profiler.end_frame();
+		Error += count(Profiler.events(), "Thread", false) == 1 ? 0 : 1;
+
+		for(std::size_t Index = 0; Index < Events.size(); ++Index)
+			Error += Events[Index].Thread >= 1 ? 0 : 1;
+
+		return Error;
+	}
+}//namespace threads
+
+namespace gpu_scopes
+{
+	int test()
+	{
+		int Error = 0;
+
+		latent_gpu_timer Timer(2);
+		gli::profiler Profiler(&Timer);
+
+		for(int Frame = 0; Frame < 6; ++Frame)
+		{
+			{
+				GLI_PROFILE_GPU_SCOPE(Profiler, "Draw");
+				GLI_PROFILE_GPU_SCOPE(Profiler, "Clear");
+			}
+			Profiler.end_frame();
+			++Timer.Frame;
+
+			// The scopes of a frame are collected once the GPU reached them
+			Error += count(Profiler.events(), "Draw", true) == (Frame >= 2 ? static_cast<std::size_t>(Frame - 1) : 0) ? 0 : 1;
+		}
+
+		// Each timestamp is resolved once
+		Error += Timer.Resolved == 4 * 4 ? 0 : 1;
+
+		std::vector<gli::profile_event> const Events(Profiler.events());
+		for(std::size_t Index = 0; Index < Events.size(); ++Index)
+			if(Events[Index].Thread == 0)
+				Error += Events[Index].End > Events[Index].Begin ? 0 : 1;
+
+		gli::profile_statistics const Draw(Profiler.scope_statistics("Draw", true));
+		Error += Draw.Count == 4 && Draw.P50 == 3000 ? 0 : 1;
+
+		// Headless backend: timestamps are taken on the CPU, scopes are collected on the next frame
+		gli::cpu_gpu_timer CpuTimer;
+		gli::profiler Headless(&CpuTimer);
+		{
+			GLI_PROFILE_GPU_SCOPE(Headless, "Render");
+			std::this_thread::sleep_for(std::chrono::microseconds(100));
+		}
+		Headless.end_frame();
+		Error += Headless.scope_statistics("Render", true).Count == 1 ? 0 : 1;
+		Error += Headless.scope_statistics("Render", true).Mean >= 100000 ? 0 : 1;
+
+		// Without backend, GPU scopes are ignored
+		gli::profiler Cpu;
+		{
+			GLI_PROFILE_GPU_SCOPE(Cpu, "Render");
+		}
+		Cpu.end_frame();
+		Error += Cpu.events().empty() ? 0 : 1;
+
+		return Error;
+	}
+}//namespace gpu_scopes
+
+namespace chrome_trace
+{
+	int test()
+	{
+		int Error = 0;
+
+		gli::cpu_gpu_timer Timer;
+		gli::profiler Profiler(&Timer);
+		Profiler.end_frame();
+		{
+			GLI_PROFILE_SCOPE(Profiler, "Quoted \"name\"");
+			GLI_PROFILE_GPU_SCOPE(Profiler, "Draw");
+		}
+		Profiler.end_frame();
+
+		std::ostringstream Stream;
+		Profiler.write_chrome_trace(Stream);
+		std::string const Trace(Stream.str());
+
+		Error += Trace.find("{\"traceEvents\":[") == 0 ? 0 : 1;
+		Error += Trace.find("\"name\":\"Quoted \\\"name\\\"\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":") != std::string::npos ? 0 : 1;
+		Error += Trace.find("\"name\":\"Draw\",\"ph\":\"X\",\"pid\":1,\"tid\":0,") != std::string::npos ? 0 : 1;
+		Error += Trace.find("\"name\":\"Frame\"") != std::string::npos ? 0 : 1;
+		Error += Trace.find("\"args\":{\"name\":\"GPU\"}") != std::string::npos ? 0 : 1;
+
+		// Durations are written in microseconds with a nanosecond precision
+		std::size_t const Duration = Trace.find("\"dur\":");
+		std::size_t const Point = Trace.find('.', Duration);
+		Error += Duration != std::string::npos && Point != std::string::npos && Trace.find_first_not_of("0123456789", Point + 1) == Point + 4 ? 0 : 1;
+
+		return Error;
+	}
+}//namespace chrome_trace
+
+int main()
+{
+	int Error = 0;
+
+	Error += cpu_scopes::test();
+	Error += disabled::test();
+	Error += threads::test();
+	Error += gpu_scopes::test();
+	Error += chrome_trace::test();
+
+	return Error;
+}
@@ -0,0 +1,253 @@
+#include <gli/gli.hpp>
+#include <cstdio>
+#include <cstring>
+
+namespace
+{
+	std::string path(const char* filename)
+	{
+		return std::string(SOURCE_DIR) + "/data/" + filename;
+	}
+}//namespace
+
+namespace read_levels
+{
+	int test(std::string const & Filename)
+	{
+		int Error(0);
+
+		gli::texture const Reference(gli::load(path(Filename.c_str())));
+		Error += !Reference.empty() ? 0 : 1;
+
+		gli::reader Reader(path(Filename.c_str()));
+		Error += !Reader.empty() ? 0 : 1;
+		if(Reader.empty())
+			return Error;
+
+		Error += Reader.target() == Reference.target() ? 0 : 1;
+		Error += Reader.format() == Reference.format() ? 0 : 1;
+		Error += Reader.layers() == Reference.layers() ? 0 : 1;
+		Error += Reader.faces() == Reference.faces() ? 0 : 1;
+		Error += Reader.levels() == Reference.levels() ? 0 : 1;
+
+		// Smallest level first
+		gli::texture Texture(Reader.create_texture());
+		for(gli::reader::size_type Level = Reader.levels(); Level-- > 0;)
+		{
+			Error += Reader.extent(Level) == Reference.extent(Level) ? 0 : 1;
+			Error += Reader.size(Level) == Reference.size(Level) ? 0 : 1;
+			Error += Reader.read(Level, Texture) ? 0 : 1;
+		}
+
+		Error += Texture == Reference ? 0 : 1;
+
+		return Error;
+	}
+}//namespace read_levels
+
+namespace read_image
+{
+	int test(std::string const & Filename)
+	{
+		int Error(0);
+
+		gli::texture const Reference(gli::load(path(Filename.c_str())));
+		gli::reader Reader(path(Filename.c_str()));
+		Error += !Reader.empty() ? 0 : 1;
+		if(Reader.empty())
+			return Error;
+
+		gli::reader::size_type const Layer = Reader.layers() - 1;
+		gli::reader::size_type const Face = Reader.faces() - 1;
+		gli::reader::size_type const Level = Reader.levels() / 2;
+
+		std::vector<char> Image(Reader.size(Level));
+		Error += Reader.read(Layer, Face, Level, &Image[0]) ? 0 : 1;
+		Error += std::memcmp(&Image[0], Reference.data(Layer, Face, Level), Image.size()) == 0 ? 0 : 1;
+
+		return Error;
+	}
+}//namespace read_image
+
+namespace read_box
+{
+	int test()
+	{
+		int Error(0);
+
+		gli::texture2d const Reference(gli::load(path("kueken7_rgba16_sfloat.dds")));
+		gli::reader Reader(path("kueken7_rgba16_sfloat.dds"));
+		Error += !Reader.empty() ? 0 : 1;
+		if(Reader.empty())
+			return Error;
+
+		// A box inside the image and a box of whole rows
+		gli::reader::extent_type const Offsets[] = {gli::reader::extent_type(5, 7, 0), gli::reader::extent_type(0, 3, 0)};
+		gli::reader::extent_type const Extents[] = {gli::reader::extent_type(19, 11, 1), gli::reader::extent_type(Reader.extent(1).x, 4, 1)};
+		for(std::size_t Index = 0; Index < 2; ++Index)
+		{
+			std::vector<glm::u16vec4> Box(static_cast<std::size_t>(Extents[Index].x * Extents[Index].y));
+			Error += Reader.read(0, 0, 1, Offsets[Index], Extents[Index], &Box[0]) ? 0 : 1;
+			for(int y = 0; y < Extents[Index].y; ++y)
+			for(int x = 0; x < Extents[Index].x; ++x)
+			{
+				gli::texture2d::extent_type const TexelCoord(Offsets[Index].x + x, Offsets[Index].y + y);
+				Error += Box[y * Extents[Index].x + x] == Reference.load<glm::u16vec4>(TexelCoord, 1) ? 0 : 1;
+			}
+		}
+
+		return Error;
+	}
+}//namespace read_box
+
+namespace byte_range
+{
+	int test()
+	{
+		int Error(0);
+
+		gli::reader Reader(path("cube_rgba8_unorm.dds"));
+		Error += !Reader.empty() ? 0 : 1;
+		if(Reader.empty())
+			return Error;
+
+		// DDS images are contiguous: the next image starts where the previous one ends
+		Error += Reader.offset(0, 0, 1) == Reader.offset(0, 0, 0) + Reader.size(0) ? 0 : 1;
+		Error += Reader.offset(0, 1, 0) > Reader.offset(0, 0, Reader.levels() - 1) ? 0 : 1;
+
+		Reader.close();
+		Error += Reader.empty() ? 0 : 1;
+
+		return Error;
+	}
+}//namespace byte_range
+
+namespace large_offsets
+{
+	int test()
+	{
+		int Error(0);
+
+		// Sparse file of 5 GiB: offsets past 4 GiB don't fit a 32 bits long
+		char const* Filename = "core_reader_large_offsets.bin";
+		std::uint64_t const Offset = (std::uint64_t(5) << 30);
+
+		FILE* File = gli::detail::open_file(Filename, "w+b");
+		Error += File ? 0 : 1;
+		if(!File)
+			return Error;
+
+		// Filesystems without large or sparse files can't run the test
+		if(gli::detail::seek_file(File, Offset) && std::fputc(0x5A, File) == 0x5A && std::fflush(File) == 0)
+		{
+			Error += gli::detail::file_size(File) == static_cast<std::int64_t>(Offset + 1) ? 0 : 1;
+			Error += std::fgetc(File) == 0 ? 0 : 1;
+			Error += gli::detail::seek_file(File, Offset) ? 0 : 1;
+			Error += std::fgetc(File) == 0x5A ? 0 : 1;
+		}
+
+		Error += !gli::detail::seek_file(File, ~std::uint64_t(0)) ? 0 : 1;
+
+		std::fclose(File);
+		std::remove(Filename);
+
+		return Error;
+	}
+}//namespace large_offsets
+
+namespace malformed
+{
+	// Copy of a DDS file with its header changed by Edit, opened by a reader
+	template <typename edit>
+	gli::reader open_edited(char const* Filename, edit const& Edit)
+	{
+		FILE* Source = std::fopen(path(Filename).c_str(), "rb");
+		if(!Source)
+			return gli::reader();
+		std::fseek(Source, 0, SEEK_END);
+		std::vector<char> Data(static_cast<std::size_t>(std::ftell(Source)));
+		std::fseek(Source, 0, SEEK_SET);
+		std::size_t const Read = std::fread(&Data[0], 1, Data.size(), Source);
+		std::fclose(Source);
+		if(Read != Data.size())
+			return gli::reader();
+
+		gli::detail::dds_header Header;
+		std::memcpy(&Header, &Data[sizeof(gli::detail::FOURCC_DDS)], sizeof(Header));
+		Edit(Header);
+		std::memcpy(&Data[sizeof(gli::detail::FOURCC_DDS)], &Header, sizeof(Header));
+
+		char const* EditedFilename = "core_reader_malformed.dds";
+		FILE* File = gli::detail::open_file(EditedFilename, "wb");
+		if(!File)
+			return gli::reader();
+		std::fwrite(&Data[0], 1, Data.size(), File);
+		std::fclose(File);
+
+		gli::reader Reader(EditedFilename);
+		std::remove(EditedFilename);
+		return Reader;
+	}
+
+	int test()
+	{
+		int Error(0);
+
+		// A mipmap count of 0 is a single level
+		gli::reader const Single(open_edited("kueken7_rgba16_sfloat.dds", [](gli::detail::dds_header& Header)
+		{
+			Header.Flags |= gli::detail::DDSD_MIPMAPCOUNT;
+			Header.MipMapLevels = 0;
+		}));
+		Error += !Single.empty() && Single.levels() == 1 ? 0 : 1;
+
+		// More levels than the extent has
+		gli::reader const TooManyLevels(open_edited("kueken7_rgba16_sfloat.dds", [](gli::detail::dds_header& Header)
+		{
+			Header.Flags |= gli::detail::DDSD_MIPMAPCOUNT;
+			Header.MipMapLevels = 32;
+		}));
+		Error += TooManyLevels.empty() ? 0 : 1;
+
+		// A cube map without faces
+		gli::reader const NoFaces(open_edited("kueken7_rgba16_sfloat.dds", [](gli::detail::dds_header& Header)
+		{
+			Header.CubemapFlags = gli::detail::DDSCAPS2_CUBEMAP;
+		}));
+		Error += NoFaces.empty() ? 0 : 1;
+
+		return Error;
+	}
+}//namespace malformed
+
+int main()
+{
+	int Error(0);
+
+	char const* Filenames[] =
+	{
+		"cube_rgba8_unorm.dds",
+		"cube_rgba8_unorm.ktx",
+		"array_r8_uint.dds",
+		"array_r8_uint.ktx",
+		"kueken7_rgba_dxt1_unorm.dds",
+		"kueken7_rgba_dxt5_unorm.ktx",
+		"kueken7_rgb8_unorm.ktx",
+		"kueken7_rgba16_sfloat.dds"
+	};
+
+	for(std::size_t Index = 0; Index < sizeof(Filenames) / sizeof(Filenames[0]); ++Index)
+	{
+		Error += read_levels::test(Filenames[Index]);
+		Error += read_image::test(Filenames[Index]);
+	}
+
+	Error += read_box::test();
+	Error += byte_range::test();
+	Error += large_offsets::test();
+	Error += malformed::test();
+
+	Error += gli::reader(path("missing.dds")).empty() ? 0 : 1;
+
+	return Error;
+}
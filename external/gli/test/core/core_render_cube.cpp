@@ -0,0 +1,145 @@
+#include <gli/render_cube.hpp>
+#include <gli/comparison.hpp>
+#include <gli/convert.hpp>
+#include <glm/gtc/color_space.hpp>
+#include <glm/gtc/epsilon.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/packing.hpp>
+
+namespace
+{
+	glm::vec4 face_color(gli::size_t Face)
+	{
+		return glm::vec4(static_cast<float>(Face) / 5.0f, 1.0f - static_cast<float>(Face) / 5.0f, 0.5f, 1.0f);
+	}
+
+	// Cube map of one color per face with a full mipmap chain
+	gli::texture_cube make_faces(gli::format Format)
+	{
+		gli::texture_cube Texture(gli::FORMAT_RGBA32_SFLOAT_PACK32, gli::texture_cube::extent_type(64));
+		for(gli::size_t Face = 0; Face < 6; ++Face)
+		for(gli::size_t Level = 0; Level < Texture.levels(); ++Level)
+			Texture.clear(0, Face, Level, face_color(Face));
+		return Format == Texture.format() ? Texture : gli::texture_cube(gli::convert(Texture, Format));
+	}
+
+	// Cube map of smooth gradients across each face
+	gli::texture_cube make_gradients()
+	{
+		gli::texture_cube Texture(gli::FORMAT_RGBA32_SFLOAT_PACK32, gli::texture_cube::extent_type(32), 1);
+		for(gli::size_t Face = 0; Face < 6; ++Face)
+		for(int y = 0; y < 32; ++y)
+		for(int x = 0; x < 32; ++x)
+			Texture.store(gli::texture_cube::extent_type(x, y), Face, 0, glm::vec4(x / 31.0f, y / 31.0f, Face / 5.0f, 1.0f));
+		return Texture;
+	}
+
+	glm::mat4 inverse_view_projection(glm::mat4 const& View, float AspectRatio)
+	{
+		return glm::inverse(glm::perspective(glm::pi<float>() * 0.5f, AspectRatio, 0.1f, 1000.0f) * View);
+	}
+
+	glm::vec4 pixel(gli::texture2d const& Framebuffer, int x, int y)
+	{
+		return Framebuffer.load<glm::vec4>(gli::texture2d::extent_type(x, y), 0);
+	}
+}//namespace
+
+namespace orientation
+{
+	int test()
+	{
+		int Error = 0;
+
+		gli::texture_cube const Texture(make_faces(gli::FORMAT_RGBA32_SFLOAT_PACK32));
+
+		// Looking down -Z with a field of view of 90 degrees, every pixel sees the -Z face
+		gli::texture2d const Front(gli::render_cube(Texture, inverse_view_projection(glm::mat4(1.0f), 1.0f), gli::texture2d::extent_type(16), gli::FORMAT_RGBA32_SFLOAT_PACK32));
+		for(int y = 0; y < 16; ++y)
+		for(int x = 0; x < 16; ++x)
+			Error += gli::all(gli::epsilonEqual(pixel(Front, x, y), face_color(5), 0.001f)) ? 0 : 1;
+
+		// Turned toward +X
+		glm::mat4 const Right(glm::rotate(glm::mat4(1.0f), glm::pi<float>() * 0.5f, glm::vec3(0.0f, 1.0f, 0.0f)));
+		gli::texture2d const Side(gli::render_cube(Texture, inverse_view_projection(Right, 1.0f), gli::texture2d::extent_type(16), gli::FORMAT_RGBA32_SFLOAT_PACK32));
+		Error += gli::all(gli::epsilonEqual(pixel(Side, 8, 8), face_color(0), 0.001f)) ? 0 : 1;
+
+		// Looking 45 degrees up: the first row is the top of the view and sees +Y, the last row sees -Z
+		glm::mat4 const Up(glm::rotate(glm::mat4(1.0f), -glm::pi<float>() * 0.25f, glm::vec3(1.0f, 0.0f, 0.0f)));
+		gli::texture2d const Tilted(gli::render_cube(Texture, inverse_view_projection(Up, 2.0f), gli::texture2d::extent_type(32, 16), gli::FORMAT_RGBA32_SFLOAT_PACK32));
+		Error += gli::all(gli::epsilonEqual(pixel(Tilted, 16, 0), face_color(2), 0.001f)) ? 0 : 1;
+		Error += gli::all(gli::epsilonEqual(pixel(Tilted, 16, 15), face_color(5), 0.001f)) ? 0 : 1;
+
+		return Error;
+	}
+}//namespace orientation
+
+namespace framebuffer
+{
+	// Every framebuffer format stores the values of the float framebuffer, on sizes that don't fill the last tiles
+	int test()
+	{
+		int Error = 0;
+
+		gli::texture_cube const Texture(make_gradients());
+		glm::mat4 const View(glm::rotate(glm::mat4(1.0f), 0.7f, glm::normalize(glm::vec3(1.0f, 2.0f, 0.5f))));
+		glm::mat4 const InverseViewProjection(inverse_view_projection(View, 130.0f / 70.0f));
+		gli::texture2d::extent_type const Extent(130, 70);
+
+		gli::texture2d const Float(gli::render_cube(Texture, InverseViewProjection, Extent, gli::FORMAT_RGBA32_SFLOAT_PACK32));
+		gli::texture2d const Half(gli::render_cube(Texture, InverseViewProjection, Extent, gli::FORMAT_RGBA16_SFLOAT_PACK16));
+		gli::texture2d const UNorm(gli::render_cube(Texture, InverseViewProjection, Extent, gli::FORMAT_RGBA8_UNORM_PACK8));
+		gli::texture2d const SRGB(gli::render_cube(Texture, InverseViewProjection, Extent, gli::FORMAT_RGBA8_SRGB_PACK8));
+
+		Error += Float.extent() == Extent && Float.levels() == 1 ? 0 : 1;
+
+		for(int y = 0; y < Extent.y; ++y)
+		for(int x = 0; x < Extent.x; ++x)
+		{
+			glm::vec4 const Expected(pixel(Float, x, y));
+			gli::texture2d::extent_type const Coord(x, y);
+
+			Error += gli::all(gli::epsilonEqual(glm::unpackHalf4x16(Half.load<glm::uint64>(Coord, 0)), Expected, 0.001f)) ? 0 : 1;
+			Error += gli::all(gli::epsilonEqual(glm::vec4(UNorm.load<glm::u8vec4>(Coord, 0)) / 255.0f, Expected, 0.5f / 255.0f + 0.0001f)) ? 0 : 1;
+
+			glm::vec4 const Encoded(glm::convertLinearToSRGB(glm::vec3(Expected)), Expected.w);
+			Error += gli::all(gli::epsilonEqual(glm::vec4(SRGB.load<glm::u8vec4>(Coord, 0)) / 255.0f, Encoded, 2.0f / 255.0f)) ? 0 : 1;
+		}
+
+		return Error;
+	}
+}//namespace framebuffer
+
+namespace source
+{
+	// Texture formats without batched sampler are converted first
+	int test()
+	{
+		int Error = 0;
+
+		glm::mat4 const InverseViewProjection(inverse_view_projection(glm::mat4(1.0f), 1.0f));
+		gli::texture2d::extent_type const Extent(8);
+
+		gli::texture2d const Bytes(gli::render_cube(make_faces(gli::FORMAT_RGBA8_UNORM_PACK8), InverseViewProjection, Extent, gli::FORMAT_RGBA8_UNORM_PACK8));
+		Error += gli::render_cube(make_faces(gli::FORMAT_BGRA8_UNORM_PACK8), InverseViewProjection, Extent, gli::FORMAT_RGBA8_UNORM_PACK8) == Bytes ? 0 : 1;
+
+		gli::texture2d const Floats(gli::render_cube(make_faces(gli::FORMAT_RGBA32_SFLOAT_PACK32), InverseViewProjection, Extent, gli::FORMAT_RGBA8_UNORM_PACK8));
+		Error += gli::render_cube(make_faces(gli::FORMAT_RGBA16_SFLOAT_PACK16), InverseViewProjection, Extent, gli::FORMAT_RGBA8_UNORM_PACK8) == Floats ? 0 : 1;
+
+		// Unsupported framebuffer format
+		Error += gli::render_cube(make_faces(gli::FORMAT_RGBA8_UNORM_PACK8), InverseViewProjection, Extent, gli::FORMAT_R8_UNORM_PACK8).empty() ? 0 : 1;
+
+		return Error;
+	}
+}//namespace source
+
+int main()
+{
+	int Error = 0;
+
+	Error += orientation::test();
+	Error += framebuffer::test();
+	Error += source::test();
+
+	return Error;
+}
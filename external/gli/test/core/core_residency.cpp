@@ -0,0 +1,171 @@
+#include <gli/residency.hpp>
+#include <gli/texture_cube.hpp>
+
+namespace
+{
+	// 64 x 64 RGBA8 cube map, its seven levels are 98304, 24576, 6144, 1536, 384, 96 and 24 bytes
+	gli::texture_cube make_texture()
+	{
+		return gli::texture_cube(gli::FORMAT_RGBA8_UNORM_PACK8, gli::texture_cube::extent_type(64));
+	}
+
+	std::uint64_t const ChainSize = 131064;
+}//namespace
+
+namespace accounting
+{
+	int test()
+	{
+		int Error = 0;
+
+		gli::simulated_residency_backend Device(1 << 20);
+		gli::residency_manager Manager(Device, 1 << 20);
+
+		gli::texture_cube const Texture(make_texture());
+		gli::residency_manager::id_type const Id = Manager.insert(Texture);
+		Error += Manager.level_size(Id, 0) == 98304 && Manager.level_size(Id, 6) == 24 ? 0 : 1;
+		Error += Manager.host_size() == ChainSize && Texture.size() == ChainSize ? 0 : 1;
+		Error += Manager.base_level(Id) == 7 && Manager.resident_size() == 0 ? 0 : 1;
+
+		// Nothing is resident before the first update
+		Error += Manager.request(Id) == 7 ? 0 : 1;
+		Error += Manager.misses() == 1 ? 0 : 1;
+
+		Manager.update();
+		Error += Manager.base_level(Id) == 0 ? 0 : 1;
+		Error += Manager.resident_size() == ChainSize && Manager.resident_size(Id) == ChainSize && Device.used() == ChainSize ? 0 : 1;
+		Error += Manager.loads() == 7 && Device.uploads() == 7 && Manager.evictions() == 0 ? 0 : 1;
+
+		Error += Manager.request(Id) == 0 ? 0 : 1;
+		Error += Manager.misses() == 1 ? 0 : 1;
+
+		// Textures erased release their device memory and their identifier
+		Manager.erase(Id);
+		Error += Manager.resident_size() == 0 && Device.used() == 0 && Manager.host_size() == 0 ? 0 : 1;
+		Error += !Device.is_resident(Id, 6) ? 0 : 1;
+		Error += Manager.insert(Texture) == Id ? 0 : 1;
+
+		return Error;
+	}
+}//namespace accounting
+
+namespace policy
+{
+	int test()
+	{
+		int Error = 0;
+
+		// Room for a complete mipmap chain and all the levels but the first of another one
+		std::uint64_t const Budget = ChainSize + ChainSize - 98304;
+		gli::simulated_residency_backend Device(1 << 20);
+		gli::residency_manager Manager(Device, Budget);
+
+		gli::residency_manager::id_type const A = Manager.insert(make_texture(), 1.0f);
+		gli::residency_manager::id_type const B = Manager.insert(make_texture(), 2.0f);
+
+		// Requested in the same frame, the texture of the highest priority gets its first level
+		Manager.request(A);
+		Manager.request(B);
+		Manager.update();
+		Error += Manager.base_level(A) == 1 && Manager.base_level(B) == 0 ? 0 : 1;
+		Error += Manager.resident_size() == Budget && Device.used() == Budget ? 0 : 1;
+
+		// Levels coarser than the requested level aren't loaded
+		Manager.request(A, 3);
+		Manager.update();
+		Error += Manager.base_level(A) == 1 && Manager.base_level(B) == 0 ? 0 : 1;
+
+		// The texture requested the most recently takes the first level of the other one
+		Manager.request(A);
+		Manager.update();
+		Error += Manager.base_level(A) == 0 && Manager.base_level(B) == 1 ? 0 : 1;
+		Error += Manager.evictions() == 1 ? 0 : 1;
+		Error += Device.is_resident(A, 0) && !Device.is_resident(B, 0) && Device.is_resident(B, 1) ? 0 : 1;
+		Error += Manager.resident_size() <= Budget ? 0 : 1;
+
+		return Error;
+	}
+}//namespace policy
+
+namespace tail
+{
+	int test()
+	{
+		int Error = 0;
+
+		// The smallest level of each texture comes first, textures past the budget have no resident level
+		gli::simulated_residency_backend Device(1 << 20);
+		gli::residency_manager Manager(Device, 24 * 2 + 10);
+		gli::residency_manager::id_type const A = Manager.insert(make_texture());
+		gli::residency_manager::id_type const B = Manager.insert(make_texture());
+		gli::residency_manager::id_type const C = Manager.insert(make_texture());
+		Manager.request(C);
+		Manager.update();
+		Error += Manager.base_level(C) == 6 && Manager.base_level(A) == 6 && Manager.base_level(B) == 7 ? 0 : 1;
+		Error += Manager.resident_size() == 48 ? 0 : 1;
+
+		return Error;
+	}
+}//namespace tail
+
+namespace streaming
+{
+	int test()
+	{
+		int Error = 0;
+
+		gli::simulated_residency_backend Device(1 << 20);
+		gli::residency_manager Manager(Device, 1 << 20);
+		gli::residency_manager::id_type const Id = Manager.insert(make_texture());
+
+		// Levels load from the smallest to the largest within the bytes of each update, a level larger than them loads alone
+		gli::residency_manager::size_type const BaseLevels[] = {2, 1, 0};
+		for(std::size_t Index = 0; Index < sizeof(BaseLevels) / sizeof(BaseLevels[0]); ++Index)
+		{
+			Manager.request(Id);
+			Manager.update(24576);
+			Error += Manager.base_level(Id) == BaseLevels[Index] ? 0 : 1;
+		}
+		Error += Manager.loads() == 7 && Manager.misses() == 3 ? 0 : 1;
+
+		return Error;
+	}
+}//namespace streaming
+
+namespace device
+{
+	int test()
+	{
+		int Error = 0;
+
+		// The simulated device is smaller than the budget: the levels that it can allocate are loaded
+		gli::simulated_residency_backend Device(50000);
+		gli::residency_manager Manager(Device, 1 << 20);
+		gli::residency_manager::id_type const Id = Manager.insert(make_texture());
+
+		Manager.request(Id);
+		Manager.update();
+		Error += Manager.base_level(Id) == 1 ? 0 : 1;
+		Error += Device.used() == ChainSize - 98304 && Manager.resident_size() == Device.used() ? 0 : 1;
+		Error += Manager.loads() == 6 ? 0 : 1;
+
+		Manager.request(Id);
+		Manager.update();
+		Error += Manager.base_level(Id) == 1 && Manager.loads() == 6 ? 0 : 1;
+
+		return Error;
+	}
+}//namespace device
+
+int main()
+{
+	int Error = 0;
+
+	Error += accounting::test();
+	Error += policy::test();
+	Error += tail::test();
+	Error += streaming::test();
+	Error += device::test();
+
+	return Error;
+}
@@ -0,0 +1,280 @@
+#include <gli/sampler_cube_batch.hpp>
+#include <gli/convert.hpp>
+#include <glm/gtc/epsilon.hpp>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+	// Face and face coordinates of a direction from the major axis table of the OpenGL specification
+	int reference_face(glm::vec3 const& Direction, glm::vec2& FaceCoord)
+	{
+		glm::vec3 const Abs(glm::abs(Direction));
+
+		int Face = 0;
+		float Sc = 0.0f, Tc = 0.0f, Ma = 0.0f;
+		if(Abs.x >= Abs.y && Abs.x >= Abs.z)
+		{
+			Face = Direction.x >= 0.0f ? 0 : 1;
+			Sc = Direction.x >= 0.0f ? -Direction.z : Direction.z;
+			Tc = -Direction.y;
+			Ma = Abs.x;
+		}
+		else if(Abs.y >= Abs.z)
+		{
+			Face = Direction.y >= 0.0f ? 2 : 3;
+			Sc = Direction.x;
+			Tc = Direction.y >= 0.0f ? Direction.z : -Direction.z;
+			Ma = Abs.y;
+		}
+		else
+		{
+			Face = Direction.z >= 0.0f ? 4 : 5;
+			Sc = Direction.z >= 0.0f ? Direction.x : -Direction.x;
+			Tc = -Direction.y;
+			Ma = Abs.z;
+		}
+
+		FaceCoord = glm::vec2(Sc / Ma, Tc / Ma) * 0.5f + 0.5f;
+		return Face;
+	}
+
+	// Texels storing their own coordinates, face and level: bilinear filtering gives back the sampled texel coordinates
+	gli::texture_cube make_coordinates(gli::texture_cube::extent_type const& Extent, gli::size_t Levels)
+	{
+		gli::texture_cube Texture(gli::FORMAT_RGBA32_SFLOAT_PACK32, Extent, Levels);
+		for(gli::size_t Face = 0; Face < Texture.faces(); ++Face)
+		for(gli::size_t Level = 0; Level < Texture.levels(); ++Level)
+		{
+			gli::texture_cube::extent_type const LevelExtent(Texture.extent(Level));
+			for(int y = 0; y < LevelExtent.y; ++y)
+			for(int x = 0; x < LevelExtent.x; ++x)
+				Texture.store(gli::texture_cube::extent_type(x, y), Face, Level, glm::vec4(x, y, Face, Level));
+		}
+		return Texture;
+	}
+
+	struct directions
+	{
+		explicit directions(std::size_t Count) : X(Count), Y(Count), Z(Count) {}
+
+		void set(std::size_t Index, glm::vec3 const& Direction)
+		{
+			this->X[Index] = Direction.x;
+			this->Y[Index] = Direction.y;
+			this->Z[Index] = Direction.z;
+		}
+
+		gli::cube_directions operator()() const
+		{
+			gli::cube_directions Directions = {&this->X[0], &this->Y[0], &this->Z[0], this->X.size()};
+			return Directions;
+		}
+
+		std::vector<float> X, Y, Z;
+	};
+}//namespace
+
+namespace face
+{
+	// Each major axis selects its face, batches of any size
+	int test()
+	{
+		int Error = 0;
+
+		gli::texture_cube Texture(gli::FORMAT_RGBA8_UNORM_PACK8, gli::texture_cube::extent_type(1), 1);
+		for(gli::size_t Face = 0; Face < 6; ++Face)
+			Texture.store(gli::texture_cube::extent_type(0), Face, 0, glm::u8vec4(Face * 51, 0, 0, 255));
+
+		glm::vec3 const Axes[] =
+		{
+			glm::vec3( 1.0f, 0.2f,-0.3f), glm::vec3(-2.0f, 0.1f, 0.4f), glm::vec3( 0.3f, 1.0f, 0.2f),
+			glm::vec3(-0.1f,-3.0f, 0.9f), glm::vec3( 0.2f,-0.4f, 1.0f), glm::vec3( 0.6f, 0.5f,-0.8f), glm::vec3(-0.5f, 0.1f, 0.2f)
+		};
+		int const Faces[] = {0, 1, 2, 3, 4, 5, 1};
+
+		gli::sampler_cube_batch<gli::FORMAT_RGBA8_UNORM_PACK8> const Sampler(Texture, gli::FILTER_NEAREST, gli::FILTER_NEAREST);
+
+		for(std::size_t Count = 1; Count <= 7; ++Count)
+		{
+			directions Directions(Count);
+			for(std::size_t Index = 0; Index < Count; ++Index)
+				Directions.set(Index, Axes[Index]);
+
+			std::vector<gli::vec4> Texels(Count);
+			Sampler.texture_lod(Directions(), 0.0f, &Texels[0]);
+
+			for(std::size_t Index = 0; Index < Count; ++Index)
+				Error += gli::all(gli::epsilonEqual(Texels[Index], gli::vec4(Faces[Index] * 0.2f, 0.0f, 0.0f, 1.0f), 0.001f)) ? 0 : 1;
+		}
+
+		return Error;
+	}
+}//namespace face
+
+namespace filter
+{
+	// Bilinear filtering matches the face coordinates of the reference table inside the faces and clamps at the face edges
+	int test()
+	{
+		int Error = 0;
+
+		gli::texture_cube const Texture(make_coordinates(gli::texture_cube::extent_type(8), 1));
+		gli::sampler_cube_batch<gli::FORMAT_RGBA32_SFLOAT_PACK32> const Sampler(Texture);
+
+		std::size_t const Count = 1001;
+		directions Directions(Count);
+		std::srand(7);
+		for(std::size_t Index = 0; Index < Count; ++Index)
+		{
+			glm::vec3 const Direction(
+				static_cast<float>(std::rand()) / RAND_MAX * 2.0f - 1.0f,
+				static_cast<float>(std::rand()) / RAND_MAX * 2.0f - 1.0f,
+				static_cast<float>(std::rand()) / RAND_MAX * 2.0f - 1.0f);
+			Directions.set(Index, Direction);
+		}
+
+		std::vector<gli::vec4> Texels(Count);
+		Sampler.texture_lod(Directions(), 0.0f, &Texels[0]);
+
+		for(std::size_t Index = 0; Index < Count; ++Index)
+		{
+			glm::vec2 FaceCoord;
+			int const Face = reference_face(glm::vec3(Directions.X[Index], Directions.Y[Index], Directions.Z[Index]), FaceCoord);
+			glm::vec2 const TexelCoord(glm::clamp(FaceCoord * 8.0f - 0.5f, 0.0f, 7.0f));
+
+			Error += gli::all(gli::epsilonEqual(Texels[Index], gli::vec4(TexelCoord, Face, 0.0f), 0.001f)) ? 0 : 1;
+		}
+
+		return Error;
+	}
+}//namespace filter
+
+namespace lod
+{
+	int test()
+	{
+		int Error = 0;
+
+		gli::texture_cube const Texture(make_coordinates(gli::texture_cube::extent_type(16), 5));
+		gli::sampler_cube_batch<gli::FORMAT_RGBA32_SFLOAT_PACK32> const Sampler(Texture);
+
+		// Direction of the +Z face center, sampled at the center of the 4 central texels of the levels
+		directions Directions(3);
+		for(std::size_t Index = 0; Index < 3; ++Index)
+			Directions.set(Index, glm::vec3(0.0f, 0.0f, 1.0f));
+
+		float const Levels[] = {1.5f, 3.0f, 9.0f};
+		std::vector<gli::vec4> Texels(3);
+		Sampler.texture_lod(Directions(), Levels, &Texels[0]);
+
+		Error += glm::epsilonEqual(Texels[0].w, 1.5f, 0.001f) && glm::epsilonEqual(Texels[0].x, (3.5f + 1.5f) * 0.5f, 0.001f) ? 0 : 1;
+		Error += glm::epsilonEqual(Texels[1].w, 3.0f, 0.001f) && glm::epsilonEqual(Texels[1].x, 0.5f, 0.001f) ? 0 : 1;
+		Error += glm::epsilonEqual(Texels[2].w, 4.0f, 0.001f) && glm::epsilonEqual(Texels[2].z, 4.0f, 0.001f) ? 0 : 1;
+
+		// A screen space footprint of 4 base level texels along the +Z face selects the level 2
+		directions DirectionsDx(3), DirectionsDy(3);
+		for(std::size_t Index = 0; Index < 3; ++Index)
+		{
+			DirectionsDx.set(Index, glm::vec3(4.0f / 8.0f, 0.0f, 0.0f));
+			DirectionsDy.set(Index, glm::vec3(0.0f, 1.0f / 8.0f, 0.0f));
+		}
+
+		Sampler.texture_grad(Directions(), DirectionsDx(), DirectionsDy(), &Texels[0]);
+		Error += glm::epsilonEqual(Texels[0].w, 2.0f, 0.001f) ? 0 : 1;
+
+		// Nearest level selection
+		gli::sampler_cube_batch<gli::FORMAT_RGBA32_SFLOAT_PACK32> const SamplerNearest(Texture, gli::FILTER_NEAREST);
+		SamplerNearest.texture_lod(Directions(), 1.6f, &Texels[0]);
+		Error += glm::epsilonEqual(Texels[0].w, 2.0f, 0.001f) ? 0 : 1;
+
+		return Error;
+	}
+}//namespace lod
+
+namespace seamless
+{
+	// Near the edge between the +Z and +X faces, seamless filtering blends the texels of both faces
+	int test()
+	{
+		int Error = 0;
+
+		gli::texture_cube Texture(gli::FORMAT_RGBA32_SFLOAT_PACK32, gli::texture_cube::extent_type(4), 1);
+		for(gli::size_t Face = 0; Face < 6; ++Face)
+			Texture.clear(0, Face, 0, glm::vec4(Face, 0.0f, 0.0f, 1.0f));
+
+		// The first direction is on the last texel center of +Z, the second is on the +X side of the edge, half a texel away from the +X texel centers
+		directions Directions(2);
+		Directions.set(0, glm::vec3(0.75f, 0.0f, 1.0f));
+		Directions.set(1, glm::vec3(1.0f, 0.0f, 1.0f - 1e-4f));
+
+		std::vector<gli::vec4> Texels(2);
+		gli::sampler_cube_batch<gli::FORMAT_RGBA32_SFLOAT_PACK32> const Clamped(Texture);
+		Clamped.texture_lod(Directions(), 0.0f, &Texels[0]);
+		Error += glm::epsilonEqual(Texels[0].x, 4.0f, 0.001f) ? 0 : 1;
+		Error += glm::epsilonEqual(Texels[1].x, 0.0f, 0.001f) ? 0 : 1;
+
+		gli::sampler_cube_batch<gli::FORMAT_RGBA32_SFLOAT_PACK32> const Seamless(Texture, gli::FILTER_LINEAR, gli::FILTER_LINEAR, true);
+		Seamless.texture_lod(Directions(), 0.0f, &Texels[0]);
+		Error += glm::epsilonEqual(Texels[0].x, 4.0f, 0.001f) ? 0 : 1;
+		Error += glm::epsilonEqual(Texels[1].x, 2.0f, 0.01f) ? 0 : 1;
+
+		return Error;
+	}
+}//namespace seamless
+
+namespace format
+{
+	template <gli::format Format>
+	int test_format(gli::texture_cube const& Source, gli::vec4 const& Color, float Epsilon)
+	{
+		gli::texture_cube const Texture(gli::convert(Source, Format));
+		gli::sampler_cube_batch<Format> const Sampler(Texture);
+
+		directions Directions(5);
+		Directions.set(0, glm::vec3(1.0f, 0.0f, 0.0f));
+		Directions.set(1, glm::vec3(0.0f, -1.0f, 0.3f));
+		Directions.set(2, glm::vec3(0.2f, 0.1f, -1.0f));
+		Directions.set(3, glm::vec3(1.0f, 1.0f, 1.0f));
+		Directions.set(4, glm::vec3(-0.7f, 0.5f, 0.1f));
+
+		std::vector<gli::vec4> Texels(5);
+		Sampler.texture_lod(Directions(), 0.5f, &Texels[0]);
+
+		int Error = 0;
+		for(std::size_t Index = 0; Index < Texels.size(); ++Index)
+			Error += gli::all(gli::epsilonEqual(Texels[Index], Color, Epsilon)) ? 0 : 1;
+		return Error;
+	}
+
+	// Every specialized format decodes like the generic conversion
+	int test()
+	{
+		int Error = 0;
+
+		gli::texture_cube Source(gli::FORMAT_RGBA32_SFLOAT_PACK32, gli::texture_cube::extent_type(4), 2);
+		Source.clear(glm::vec4(0.25f, 0.5f, 0.75f, 0.5f));
+
+		Error += test_format<gli::FORMAT_RGBA8_UNORM_PACK8>(Source, gli::vec4(0.25f, 0.5f, 0.75f, 0.5f), 0.005f);
+		Error += test_format<gli::FORMAT_RGBA8_SRGB_PACK8>(Source, gli::vec4(0.25f, 0.5f, 0.75f, 0.5f), 0.01f);
+		Error += test_format<gli::FORMAT_RGBA16_SFLOAT_PACK16>(Source, gli::vec4(0.25f, 0.5f, 0.75f, 0.5f), 0.001f);
+		Error += test_format<gli::FORMAT_RGBA32_SFLOAT_PACK32>(Source, gli::vec4(0.25f, 0.5f, 0.75f, 0.5f), 0.0001f);
+		Error += test_format<gli::FORMAT_RG11B10_UFLOAT_PACK32>(Source, gli::vec4(0.25f, 0.5f, 0.75f, 1.0f), 0.01f);
+		Error += test_format<gli::FORMAT_RGB9E5_UFLOAT_PACK32>(Source, gli::vec4(0.25f, 0.5f, 0.75f, 1.0f), 0.01f);
+
+		return Error;
+	}
+}//namespace format
+
+int main()
+{
+	int Error = 0;
+
+	Error += face::test();
+	Error += filter::test();
+	Error += lod::test();
+	Error += seamless::test();
+	Error += format::test();
+
+	return Error;
+}
@@ -0,0 +1,208 @@
+#include <gli/texture_cube_tiled.hpp>
+#include <gli/sampler_cube.hpp>
+#include <gli/save.hpp>
+#include <gli/load.hpp>
+#include <glm/gtc/packing.hpp>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	std::string path(const char* filename)
+	{
+		return std::string(SOURCE_DIR) + "/data/" + filename;
+	}
+
+	typedef gli::sampler_cube<float, gli::defaultp, gli::texture_cube_tiled> fsamplerCubeTiled;
+
+	// Cube map of distinct texels with a complete mipmap chain
+	gli::texture_cube make_texture(int Size)
+	{
+		gli::texture_cube Texture(gli::FORMAT_RGBA16_SFLOAT_PACK16, gli::texture_cube::extent_type(Size));
+		for(gli::size_t Level = 0; Level < Texture.levels(); ++Level)
+		for(gli::size_t Face = 0; Face < 6; ++Face)
+		{
+			gli::texture_cube::extent_type const Extent(Texture.extent(Level));
+			for(int y = 0; y < Extent.y; ++y)
+			for(int x = 0; x < Extent.x; ++x)
+			{
+				glm::vec4 const Texel(static_cast<float>(x), static_cast<float>(y), static_cast<float>(Face), static_cast<float>(Level));
+				Texture.store(gli::texture_cube::extent_type(x, y), Face, Level, glm::packHalf(Texel));
+			}
+		}
+		return Texture;
+	}
+
+	// Number of 64 x 64 tiles of the images of a cube map
+	std::size_t tile_count(gli::texture_cube const& Texture)
+	{
+		std::size_t Count = 0;
+		for(gli::size_t Level = 0; Level < Texture.levels(); ++Level)
+		{
+			std::size_t const Tiles = (static_cast<std::size_t>(Texture.extent(Level).x) + 63) / 64;
+			Count += Tiles * Tiles * 6;
+		}
+		return Count;
+	}
+}//namespace
+
+namespace paging
+{
+	int test(char const* Filename)
+	{
+		int Error = 0;
+
+		gli::texture_cube const Reference(make_texture(256));
+		Error += gli::save(Reference, Filename) ? 0 : 1;
+
+		// The file is 30 times larger than the budget of four tiles
+		std::size_t const Budget = 4 * 64 * 64 * 8;
+		gli::texture_cube_tiled const Texture(Filename, Budget);
+		Error += !Texture.empty() ? 0 : 1;
+		if(Texture.empty())
+			return Error;
+
+		Error += Texture.format() == Reference.format() && Texture.levels() == Reference.levels() && Texture.extent() == Reference.extent() ? 0 : 1;
+		Error += Texture.storage().capacity() * Texture.storage().tile_bytes() <= Budget ? 0 : 1;
+		Error += Reference.size() > 30 * Budget ? 0 : 1;
+
+		// Row by row, the tiles of a row of tiles stay resident until the next row of tiles: each tile is read once
+		gli::fsamplerCube const SamplerReference(Reference, gli::WRAP_CLAMP_TO_EDGE);
+		fsamplerCubeTiled const Sampler(Texture, gli::WRAP_CLAMP_TO_EDGE);
+		for(gli::size_t Level = 0; Level < Reference.levels(); ++Level)
+		for(gli::size_t Face = 0; Face < 6; ++Face)
+		{
+			gli::texture_cube::extent_type const Extent(Reference.extent(Level));
+			for(int y = 0; y < Extent.y; ++y)
+			for(int x = 0; x < Extent.x; ++x)
+			{
+				gli::texture_cube::extent_type const TexelCoord(x, y);
+				Error += Sampler.texel_fetch(TexelCoord, Face, Level) == SamplerReference.texel_fetch(TexelCoord, Face, Level) ? 0 : 1;
+			}
+		}
+		Error += Texture.storage().loads() == tile_count(Reference) ? 0 : 1;
+		Error += Texture.storage().evictions() == tile_count(Reference) - Texture.storage().capacity() ? 0 : 1;
+		Error += Texture.storage().resident() == Texture.storage().capacity() ? 0 : 1;
+
+		// Filtered samples match across tile borders
+		fsamplerCubeTiled const SamplerLinear(Texture, gli::WRAP_CLAMP_TO_EDGE, gli::FILTER_LINEAR, gli::FILTER_LINEAR);
+		gli::fsamplerCube const SamplerLinearReference(Reference, gli::WRAP_CLAMP_TO_EDGE, gli::FILTER_LINEAR, gli::FILTER_LINEAR);
+		glm::vec2 const Coords[] = {glm::vec2(0.25f, 0.25f), glm::vec2(0.5f, 0.5f), glm::vec2(0.1f, 0.75f), glm::vec2(0.999f, 0.001f)};
+		for(std::size_t Index = 0; Index < sizeof(Coords) / sizeof(Coords[0]); ++Index)
+		for(gli::size_t Face = 0; Face < 6; ++Face)
+		{
+			glm::vec4 const Texel(SamplerLinear.texture_lod(Coords[Index], Face, 1.5f));
+			Error += Texel == SamplerLinearReference.texture_lod(Coords[Index], Face, 1.5f) ? 0 : 1;
+		}
+
+		std::remove(Filename);
+
+		return Error;
+	}
+}//namespace paging
+
+namespace eviction
+{
+	int test()
+	{
+		int Error = 0;
+
+		gli::texture_cube const Reference(make_texture(256));
+		Error += gli::save_dds(Reference, "texture_cube_tiled_lru.dds") ? 0 : 1;
+
+		gli::texture_cube_tiled const Texture("texture_cube_tiled_lru.dds", 0);
+		Error += Texture.storage().capacity() == 4 ? 0 : 1;
+
+		// Tiles A, B, C and D fill the resident set, A is used again so B is the least recently used tile when E comes in
+		gli::texture_cube_tiled::extent_type const A(0, 0), B(64, 0), C(128, 0), D(192, 0), E(0, 64);
+		gli::texture_cube_tiled::extent_type const Order[] = {A, B, C, D, A, E};
+		for(std::size_t Index = 0; Index < sizeof(Order) / sizeof(Order[0]); ++Index)
+			Error += Texture.load<glm::u16vec4>(Order[Index], 2, 0) == Reference.load<glm::u16vec4>(Order[Index], 2, 0) ? 0 : 1;
+		Error += Texture.storage().loads() == 5 && Texture.storage().evictions() == 1 ? 0 : 1;
+
+		Texture.load<glm::u16vec4>(A + gli::texture_cube_tiled::extent_type(63), 2, 0);
+		Error += Texture.storage().loads() == 5 ? 0 : 1;
+		Texture.load<glm::u16vec4>(B, 2, 0);
+		Error += Texture.storage().loads() == 6 ? 0 : 1;
+
+		// The tiles of each face and level are paged separately
+		Texture.load<glm::u16vec4>(A, 3, 0);
+		Texture.load<glm::u16vec4>(A, 2, 1);
+		Error += Texture.storage().loads() == 8 ? 0 : 1;
+
+		std::remove("texture_cube_tiled_lru.dds");
+
+		return Error;
+	}
+}//namespace eviction
+
+namespace threads
+{
+	int test()
+	{
+		int Error = 0;
+
+		gli::texture_cube const Reference(make_texture(256));
+		Error += gli::save_dds(Reference, "texture_cube_tiled_threads.dds") ? 0 : 1;
+
+		// Threads fetch texels of tiles of all the faces, more tiles than the capacity: hits, misses and evictions overlap
+		gli::texture_cube_tiled const Texture("texture_cube_tiled_threads.dds", 8 * 64 * 64 * 8);
+		std::vector<int> Errors(4, 0);
+		std::vector<std::thread> Threads;
+		for(std::size_t Index = 0; Index < Errors.size(); ++Index)
+			Threads.push_back(std::thread([&, Index]()
+			{
+				for(int Pass = 0; Pass < 4; ++Pass)
+				for(gli::size_t Face = 0; Face < 6; ++Face)
+				for(int y = static_cast<int>(Index); y < 256; y += 5)
+				for(int x = 0; x < 256; x += 3)
+				{
+					gli::texture_cube_tiled::extent_type const TexelCoord(x, y);
+					Errors[Index] += Texture.load<glm::u16vec4>(TexelCoord, (Face + Index) % 6, 0) == Reference.load<glm::u16vec4>(TexelCoord, (Face + Index) % 6, 0) ? 0 : 1;
+				}
+			}));
+		for(std::size_t Index = 0; Index < Threads.size(); ++Index)
+		{
+			Threads[Index].join();
+			Error += Errors[Index];
+		}
+
+		Error += Texture.storage().resident() <= Texture.storage().capacity() ? 0 : 1;
+		Error += Texture.storage().loads() >= 16 * 6 ? 0 : 1;
+
+		std::remove("texture_cube_tiled_threads.dds");
+
+		return Error;
+	}
+}//namespace threads
+
+namespace open_file
+{
+	int test()
+	{
+		int Error = 0;
+
+		Error += gli::texture_cube_tiled(path("missing.dds"), 1 << 20).empty() ? 0 : 1;
+
+		// Only uncompressed cube maps, not 2D textures nor cube map arrays
+		Error += gli::texture_cube_tiled(path("kueken7_rgba16_sfloat.dds"), 1 << 20).empty() ? 0 : 1;
+		Error += gli::texture_cube_tiled(path("kueken7_rgba_dxt1_unorm.dds"), 1 << 20).empty() ? 0 : 1;
+		Error += gli::texture_cube_tiled(path("cube_rgba8_unorm.dds"), 1 << 20).empty() ? 0 : 1;
+
+		return Error;
+	}
+}//namespace open_file
+
+int main()
+{
+	int Error = 0;
+
+	Error += paging::test("texture_cube_tiled.dds");
+	Error += paging::test("texture_cube_tiled.ktx");
+	Error += eviction::test();
+	Error += threads::test();
+	Error += open_file::test();
+
+	return Error;
+}
@@ -0,0 +1,320 @@
+#include <gli/comparison.hpp>
+#include <gli/type.hpp>
+#include <gli/duplicate.hpp>
+#include <gli/generate_mipmaps.hpp>
+
+#include <glm/gtc/epsilon.hpp>
+#include <glm/gtc/packing.hpp>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+	void fill_random(gli::texture& Texture)
+	{
+		std::srand(static_cast<unsigned>(Texture.format()));
+		for(gli::size_t Layer = 0; Layer < Texture.layers(); ++Layer)
+		for(gli::size_t Face = 0; Face < Texture.faces(); ++Face)
+		{
+			gli::size_t const Size = Texture.size(0);
+			glm::uint8* const Data = Texture.data<glm::uint8>(Layer, Face, 0);
+
+			if(Texture.format() == gli::FORMAT_RGBA8_UNORM_PACK8)
+			{
+				for(gli::size_t Index = 0; Index < Size; ++Index)
+					Data[Index] = static_cast<glm::uint8>(std::rand());
+			}
+			else if(Texture.format() == gli::FORMAT_RGBA16_SFLOAT_PACK16)
+			{
+				for(gli::size_t Index = 0; Index < Size / sizeof(glm::uint16); ++Index)
+					reinterpret_cast<glm::uint16*>(Data)[Index] = glm::packHalf1x16(static_cast<float>(std::rand()) / RAND_MAX);
+			}
+			else
+			{
+				for(gli::size_t Index = 0; Index < Size / sizeof(float); ++Index)
+					reinterpret_cast<float*>(Data)[Index] = static_cast<float>(std::rand()) / RAND_MAX;
+			}
+		}
+	}
+
+	glm::vec4 load_texel(gli::texture const& Texture, gli::size_t Layer, gli::size_t Face, gli::size_t Level, int x, int y)
+	{
+		gli::texture::extent_type const Extent(Texture.extent(Level));
+		gli::size_t const Offset = static_cast<gli::size_t>(y * Extent.x + x);
+
+		switch(Texture.format())
+		{
+		case gli::FORMAT_RGBA8_UNORM_PACK8:
+			return glm::vec4(Texture.data<glm::u8vec4>(Layer, Face, Level)[Offset]);
+		case gli::FORMAT_RGBA16_SFLOAT_PACK16:
+			return glm::unpackHalf4x16(Texture.data<glm::uint64>(Layer, Face, Level)[Offset]);
+		default:
+			return Texture.data<glm::vec4>(Layer, Face, Level)[Offset];
+		}
+	}
+
+	// Rounded average of 2x2 texels for RGBA8, float average for the float formats
+	glm::vec4 box(gli::texture const& Texture, gli::size_t Layer, gli::size_t Face, gli::size_t Level, int x, int y)
+	{
+		gli::texture::extent_type const Extent(Texture.extent(Level));
+		int const x0 = glm::min(x * 2, Extent.x - 1);
+		int const x1 = glm::min(x * 2 + 1, Extent.x - 1);
+		int const y0 = glm::min(y * 2, Extent.y - 1);
+		int const y1 = glm::min(y * 2 + 1, Extent.y - 1);
+
+		glm::vec4 const Sum =
+			load_texel(Texture, Layer, Face, Level, x0, y0) + load_texel(Texture, Layer, Face, Level, x1, y0) +
+			load_texel(Texture, Layer, Face, Level, x0, y1) + load_texel(Texture, Layer, Face, Level, x1, y1);
+
+		if(Texture.format() == gli::FORMAT_RGBA8_UNORM_PACK8)
+			return glm::floor((Sum + 2.0f) / 4.0f);
+		return Sum * 0.25f;
+	}
+
+	// Every level against the filtering of the previous level of the result, Epsilon 0 requires identical values
+	int check_levels(gli::texture const& Mipmaps, float Epsilon)
+	{
+		int Error = 0;
+
+		for(gli::size_t Layer = 0; Layer < Mipmaps.layers(); ++Layer)
+		for(gli::size_t Face = 0; Face < Mipmaps.faces(); ++Face)
+		for(gli::size_t Level = 1; Level < Mipmaps.levels(); ++Level)
+		{
+			gli::texture::extent_type const Extent(Mipmaps.extent(Level));
+			for(int y = 0; y < Extent.y; ++y)
+			for(int x = 0; x < Extent.x; ++x)
+			{
+				glm::vec4 const Expected = box(Mipmaps, Layer, Face, Level - 1, x, y);
+				glm::vec4 const Texel = load_texel(Mipmaps, Layer, Face, Level, x, y);
+				Error += glm::all(glm::lessThanEqual(glm::abs(Texel - Expected), glm::vec4(Epsilon))) ? 0 : 1;
+			}
+		}
+
+		return Error;
+	}
+}//namespace
+
+namespace box_cube
+{
+	int test(gli::format Format, float Epsilon)
+	{
+		int Error = 0;
+
+		gli::texture_cube Texture(Format, gli::texture_cube::extent_type(64));
+		fill_random(Texture);
+
+		gli::texture_cube const Mipmaps(gli::generate_mipmaps(Texture, gli::FILTER_LINEAR));
+		Error += check_levels(Mipmaps, Epsilon);
+
+		return Error;
+	}
+}//namespace box_cube
+
+namespace box_array
+{
+	// Rectangle images reach a single texel row before a single texel column
+	int test(gli::format Format, float Epsilon)
+	{
+		int Error = 0;
+
+		gli::texture2d_array Texture(Format, gli::texture2d_array::extent_type(32, 4), 3);
+		fill_random(Texture);
+
+		gli::texture2d_array const Mipmaps(gli::generate_mipmaps(Texture, gli::FILTER_LINEAR));
+		Error += check_levels(Mipmaps, Epsilon);
+
+		gli::texture2d Texture2D(Format, gli::texture2d::extent_type(4, 16));
+		fill_random(Texture2D);
+
+		gli::texture2d const Mipmaps2D(gli::generate_mipmaps(Texture2D, gli::FILTER_LINEAR));
+		Error += check_levels(Mipmaps2D, Epsilon);
+
+		return Error;
+	}
+}//namespace box_array
+
+namespace separable
+{
+	// Constant images remain constant, the filter weights are normalized
+	int test_constant(gli::format Format, gli::mipmap_filter Filter)
+	{
+		int Error = 0;
+
+		gli::texture_cube Texture(Format, gli::texture_cube::extent_type(32));
+		if(Format == gli::FORMAT_RGBA8_UNORM_PACK8)
+			Texture.clear(glm::u8vec4(255, 128, 3, 255));
+		else if(Format == gli::FORMAT_RGBA16_SFLOAT_PACK16)
+			Texture.clear(glm::packHalf4x16(glm::vec4(1.0f, 0.5f, 0.25f, 1.0f)));
+		else
+			Texture.clear(glm::vec4(1.0f, 0.5f, 0.25f, 1.0f));
+
+		gli::texture_cube const Mipmaps(gli::generate_mipmaps(Texture, Filter));
+		Error += Mipmaps == Texture ? 0 : 1;
+
+		return Error;
+	}
+
+	// Direct 2d evaluation of the separable filter with the weights of the kernel
+	int test_reference(gli::mipmap_filter Filter)
+	{
+		int Error = 0;
+
+		gli::texture2d Texture(gli::FORMAT_RGBA32_SFLOAT_PACK32, gli::texture2d::extent_type(16, 16));
+		fill_random(Texture);
+
+		gli::texture2d const Mipmaps(gli::generate_mipmaps(Texture, Filter));
+		gli::detail::mipmap_taps const Taps = gli::detail::make_mipmap_taps(gli::detail::make_mipmap_kernel_filter(Filter));
+
+		float Sum = 0.0f;
+		for(int Tap = 0; Tap < Taps.Count; ++Tap)
+			Sum += Taps.Weight[Tap];
+		Error += glm::epsilonEqual(Sum, 1.0f, 0.0001f) ? 0 : 1;
+
+		// Symmetric around the two source texels of a destination texel
+		for(int Tap = 0; Tap < Taps.Count / 2; ++Tap)
+			Error += glm::epsilonEqual(Taps.Weight[Tap], Taps.Weight[Taps.Count - 1 - Tap], 0.0001f) ? 0 : 1;
+
+		for(gli::size_t Level = 1; Level < Mipmaps.levels(); ++Level)
+		{
+			gli::texture2d::extent_type const Source(Mipmaps.extent(Level - 1));
+			gli::texture2d::extent_type const Extent(Mipmaps.extent(Level));
+
+			for(int y = 0; y < Extent.y; ++y)
+			for(int x = 0; x < Extent.x; ++x)
+			{
+				glm::vec4 Expected(0.0f);
+				for(int TapY = 0; TapY < Taps.Count; ++TapY)
+				for(int TapX = 0; TapX < Taps.Count; ++TapX)
+				{
+					int const SourceX = glm::clamp(x * 2 + Taps.Offset[TapX], 0, Source.x - 1);
+					int const SourceY = glm::clamp(y * 2 + Taps.Offset[TapY], 0, Source.y - 1);
+					Expected += Taps.Weight[TapX] * Taps.Weight[TapY] * Mipmaps.load<glm::vec4>(gli::texture2d::extent_type(SourceX, SourceY), Level - 1);
+				}
+
+				glm::vec4 const Texel = Mipmaps.load<glm::vec4>(gli::texture2d::extent_type(x, y), Level);
+				Error += glm::all(glm::epsilonEqual(Texel, Expected, 0.0001f)) ? 0 : 1;
+			}
+		}
+
+		return Error;
+	}
+}//namespace separable
+
+namespace unsupported
+{
+	// The separable filters have no sampler fallback: non power of two images and other formats give an empty texture
+	int test()
+	{
+		int Error = 0;
+
+		gli::texture_cube Texture(gli::FORMAT_RGBA8_UNORM_PACK8, gli::texture_cube::extent_type(17));
+		Texture.clear(glm::u8vec4(255, 127, 0, 255));
+		Error += gli::generate_mipmaps(gli::texture_cube(gli::duplicate(Texture)), gli::MIPMAP_FILTER_LANCZOS).empty() ? 0 : 1;
+
+		gli::texture_cube Texture16(gli::FORMAT_RGBA16_UNORM_PACK16, gli::texture_cube::extent_type(16));
+		Texture16.clear(glm::u16vec4(65535, 0, 0, 65535));
+		Error += gli::generate_mipmaps(gli::texture_cube(gli::duplicate(Texture16)), gli::MIPMAP_FILTER_KAISER).empty() ? 0 : 1;
+
+		gli::texture2d TextureNPOT(gli::FORMAT_RGBA32_SFLOAT_PACK32, gli::texture2d::extent_type(24, 20));
+		fill_random(TextureNPOT);
+		Error += gli::generate_mipmaps(gli::texture2d(gli::duplicate(TextureNPOT)), gli::MIPMAP_FILTER_KAISER).empty() ? 0 : 1;
+		Error += gli::generate_mipmaps(gli::texture2d(gli::duplicate(TextureNPOT)), gli::MIPMAP_FILTER_LANCZOS).empty() ? 0 : 1;
+
+		// Nothing is written to an unsupported texture
+		gli::texture_cube const Source(gli::duplicate(Texture));
+		gli::texture_cube Updated(gli::duplicate(Texture));
+		std::vector<gli::cube_region> Regions(1);
+		Regions[0].Face = 0;
+		Regions[0].Level = 0;
+		Regions[0].Offset = gli::texture_cube::extent_type(0);
+		Regions[0].Extent = gli::texture_cube::extent_type(4);
+		Error += gli::update_mipmaps(Updated, Regions, gli::MIPMAP_FILTER_KAISER).empty() ? 0 : 1;
+		Error += Updated == Source ? 0 : 1;
+
+		// The sampler filters still generate these textures
+		Error += gli::generate_mipmaps(gli::texture_cube(gli::duplicate(Texture)), gli::FILTER_LINEAR).load<glm::u8vec4>(gli::texture_cube::extent_type(0), 5, Texture.max_level()) == glm::u8vec4(255, 127, 0, 255) ? 0 : 1;
+		Error += gli::generate_mipmaps(Texture16, gli::FILTER_LINEAR).load<glm::u16vec4>(gli::texture_cube::extent_type(0), 2, Texture16.max_level()) == glm::u16vec4(65535, 0, 0, 65535) ? 0 : 1;
+
+		// Power of two images of the same format are filtered
+		gli::texture2d TexturePOT(gli::FORMAT_RGBA32_SFLOAT_PACK32, gli::texture2d::extent_type(32));
+		fill_random(TexturePOT);
+		gli::texture2d const Kaiser(gli::generate_mipmaps(gli::texture2d(gli::duplicate(TexturePOT)), gli::MIPMAP_FILTER_KAISER));
+		Error += !Kaiser.empty() && Kaiser != gli::generate_mipmaps(gli::texture2d(gli::duplicate(TexturePOT)), gli::FILTER_LINEAR) ? 0 : 1;
+
+		return Error;
+	}
+}//namespace unsupported
+
+namespace dispatch
+{
+	// The F16C row conversions chosen at runtime match the scalar ones, whatever instruction set the tests are compiled for
+	int test()
+	{
+		int Error = 0;
+
+		typedef gli::detail::mipmap_rgba16_sfloat codec;
+		int const Width = 67;
+
+		std::srand(16);
+		std::vector<glm::uint16> Halfs(static_cast<std::size_t>(Width) * 4);
+		for(std::size_t Index = 0; Index < Halfs.size(); ++Index)
+		{
+			// Infinities and NaNs excluded
+			glm::uint16 const Value = static_cast<glm::uint16>(std::rand() & 0xffff);
+			Halfs[Index] = (Value & 0x7c00) == 0x7c00 ? static_cast<glm::uint16>(Value & 0x83ff) : Value;
+		}
+
+		std::vector<glm::vec4> FloatsScalar(static_cast<std::size_t>(Width));
+		std::vector<glm::vec4> FloatsWidest(static_cast<std::size_t>(Width));
+		codec::load_row(reinterpret_cast<glm::uint64 const*>(&Halfs[0]), Width, &FloatsScalar[0], gli::detail::CPU_ARCH_SCALAR);
+		codec::load_row(reinterpret_cast<glm::uint64 const*>(&Halfs[0]), Width, &FloatsWidest[0]);
+		Error += std::memcmp(&FloatsScalar[0], &FloatsWidest[0], FloatsScalar.size() * sizeof(glm::vec4)) == 0 ? 0 : 1;
+
+		std::vector<glm::vec4> Floats(static_cast<std::size_t>(Width));
+		for(std::size_t Index = 0; Index < Floats.size(); ++Index)
+		for(glm::length_t Component = 0; Component < 4; ++Component)
+			Floats[Index][Component] = static_cast<float>(std::rand()) / RAND_MAX * 4.0f - 2.0f;
+
+		std::vector<glm::uint64> HalfsScalar(static_cast<std::size_t>(Width));
+		std::vector<glm::uint64> HalfsWidest(static_cast<std::size_t>(Width));
+		codec::store_row(&Floats[0], Width, &HalfsScalar[0], gli::detail::CPU_ARCH_SCALAR);
+		codec::store_row(&Floats[0], Width, &HalfsWidest[0]);
+
+		// F16C rounds halfway cases to nearest even where the scalar path rounds them up
+		glm::uint16 const* const A = reinterpret_cast<glm::uint16 const*>(&HalfsScalar[0]);
+		glm::uint16 const* const B = reinterpret_cast<glm::uint16 const*>(&HalfsWidest[0]);
+		for(std::size_t Index = 0; Index < HalfsScalar.size() * 4; ++Index)
+			Error += glm::abs(static_cast<int>(A[Index]) - static_cast<int>(B[Index])) <= 1 ? 0 : 1;
+
+		return Error;
+	}
+}//namespace dispatch
+
+int main()
+{
+	int Error = 0;
+
+	Error += box_cube::test(gli::FORMAT_RGBA8_UNORM_PACK8, 0.0f);
+	Error += box_cube::test(gli::FORMAT_RGBA16_SFLOAT_PACK16, 0.001f);
+	Error += box_cube::test(gli::FORMAT_RGBA32_SFLOAT_PACK32, 0.0f);
+
+	Error += box_array::test(gli::FORMAT_RGBA8_UNORM_PACK8, 0.0f);
+	Error += box_array::test(gli::FORMAT_RGBA16_SFLOAT_PACK16, 0.001f);
+	Error += box_array::test(gli::FORMAT_RGBA32_SFLOAT_PACK32, 0.0f);
+
+	gli::format const Formats[] = {gli::FORMAT_RGBA8_UNORM_PACK8, gli::FORMAT_RGBA16_SFLOAT_PACK16, gli::FORMAT_RGBA32_SFLOAT_PACK32};
+	for(std::size_t Index = 0; Index < sizeof(Formats) / sizeof(Formats[0]); ++Index)
+	{
+		Error += separable::test_constant(Formats[Index], gli::MIPMAP_FILTER_KAISER);
+		Error += separable::test_constant(Formats[Index], gli::MIPMAP_FILTER_LANCZOS);
+	}
+
+	Error += separable::test_reference(gli::MIPMAP_FILTER_KAISER);
+	Error += separable::test_reference(gli::MIPMAP_FILTER_LANCZOS);
+
+	Error += unsupported::test();
+	Error += dispatch::test();
+
+	return Error;
+}
@@ -0,0 +1,189 @@
+#include <gli/comparison.hpp>
+#include <gli/duplicate.hpp>
+#include <gli/generate_mipmaps.hpp>
+
+#include <glm/gtc/packing.hpp>
+#include <cstdlib>
+
+namespace
+{
+	// Random texels in a rectangle of a face and level of a cube map
+	void fill_random(gli::texture_cube& Texture, gli::cube_region const& Region)
+	{
+		gli::texture_cube::extent_type const Extent(Texture.extent(Region.Level));
+		gli::size_t const BlockSize = gli::block_size(Texture.format());
+		glm::uint8* const Data = Texture.data<glm::uint8>(0, Region.Face, Region.Level);
+
+		for(int y = Region.Offset.y; y < Region.Offset.y + Region.Extent.y; ++y)
+		for(int x = Region.Offset.x; x < Region.Offset.x + Region.Extent.x; ++x)
+		{
+			glm::uint8* const Texel = Data + (static_cast<gli::size_t>(y) * Extent.x + x) * BlockSize;
+			if(Texture.format() == gli::FORMAT_RGBA8_UNORM_PACK8)
+			{
+				for(gli::size_t Index = 0; Index < BlockSize; ++Index)
+					Texel[Index] = static_cast<glm::uint8>(std::rand());
+			}
+			else if(Texture.format() == gli::FORMAT_RGBA16_SFLOAT_PACK16)
+			{
+				for(gli::size_t Index = 0; Index < 4; ++Index)
+					reinterpret_cast<glm::uint16*>(Texel)[Index] = glm::packHalf1x16(static_cast<float>(std::rand()) / RAND_MAX);
+			}
+			else
+			{
+				for(gli::size_t Index = 0; Index < 4; ++Index)
+					reinterpret_cast<float*>(Texel)[Index] = static_cast<float>(std::rand()) / RAND_MAX;
+			}
+		}
+	}
+
+	gli::cube_region make_region(gli::size_t Face, gli::size_t Level, int x, int y, int Width, int Height)
+	{
+		gli::cube_region const Region = {Face, Level, gli::texture_cube::extent_type(x, y), gli::texture_cube::extent_type(Width, Height)};
+		return Region;
+	}
+
+	// Cube map of random texels with all its mipmaps generated, filter_type is a sampler filter or a separable downsampling filter
+	template <typename filter_type>
+	gli::texture_cube make_texture(gli::format Format, int Size, filter_type Minification)
+	{
+		gli::texture_cube Texture(Format, gli::texture_cube::extent_type(Size));
+		for(gli::size_t Face = 0; Face < Texture.faces(); ++Face)
+			fill_random(Texture, make_region(Face, 0, 0, 0, Size, Size));
+		return gli::texture_cube(gli::duplicate(gli::generate_mipmaps(Texture, Minification)));
+	}
+
+	// Update the mipmaps after random writes to the regions, then check them against the generation of the mipmap chain from BaseLevel,
+	// the first level with changed texels
+	template <typename filter_type>
+	int test(gli::format Format, int Size, filter_type Minification, std::vector<gli::cube_region> const& Regions, gli::size_t BaseLevel = 0)
+	{
+		int Error = 0;
+
+		std::srand(static_cast<unsigned>(Format + Size));
+		gli::texture_cube Texture(make_texture(Format, Size, Minification));
+		for(std::size_t Index = 0; Index < Regions.size(); ++Index)
+			fill_random(Texture, Regions[Index]);
+
+		std::vector<gli::cube_region> const Updated(gli::update_mipmaps(Texture, Regions, Minification));
+		gli::texture_cube const Reference(gli::generate_mipmaps(gli::texture_cube(gli::duplicate(Texture)), 0, 5, BaseLevel, Texture.max_level(), Minification));
+		Error += Texture == Reference ? 0 : 1;
+
+		// Updated texels are a small part of the faces changed and the given regions are part of the updated regions
+		std::size_t Texels = 0;
+		for(std::size_t Index = 0; Index < Updated.size(); ++Index)
+		{
+			gli::cube_region const& Region = Updated[Index];
+			Texels += static_cast<std::size_t>(Region.Extent.x * Region.Extent.y);
+			Error += glm::all(glm::lessThanEqual(Region.Offset + Region.Extent, Texture.extent(Region.Level))) ? 0 : 1;
+		}
+		Error += Texels * 4 < static_cast<std::size_t>(Size * Size) ? 0 : 1;
+
+		for(std::size_t i = 0; i < Regions.size(); ++i)
+		{
+			bool Found = false;
+			for(std::size_t j = 0; j < Updated.size(); ++j)
+			{
+				gli::cube_region const& Region = Updated[j];
+				Found = Found || (Region.Face == Regions[i].Face && Region.Level == Regions[i].Level &&
+					glm::all(glm::lessThanEqual(Region.Offset, Regions[i].Offset)) &&
+					glm::all(glm::lessThanEqual(Regions[i].Offset + Regions[i].Extent, Region.Offset + Region.Extent)));
+			}
+			Error += Found ? 0 : 1;
+		}
+
+		// Every level below the changed texels is updated
+		for(gli::size_t Level = BaseLevel; Level < Texture.levels(); ++Level)
+		{
+			bool Found = false;
+			for(std::size_t Index = 0; Index < Updated.size(); ++Index)
+				Found = Found || Updated[Index].Level == Level;
+			Error += Found ? 0 : 1;
+		}
+
+		return Error;
+	}
+}//namespace
+
+namespace kernel
+{
+	int test()
+	{
+		int Error = 0;
+
+		std::vector<gli::cube_region> Regions;
+		Regions.push_back(make_region(2, 0, 100, 40, 9, 7));
+		Error += ::test(gli::FORMAT_RGBA8_UNORM_PACK8, 256, gli::FILTER_LINEAR, Regions);
+		Error += ::test(gli::FORMAT_RGBA16_SFLOAT_PACK16, 256, gli::MIPMAP_FILTER_KAISER, Regions);
+		Error += ::test(gli::FORMAT_RGBA32_SFLOAT_PACK32, 256, gli::MIPMAP_FILTER_LANCZOS, Regions);
+
+		// Texels on the edges of the faces, close regions of a face are merged, regions of other faces
+		Regions.push_back(make_region(2, 0, 110, 44, 3, 3));
+		Regions.push_back(make_region(0, 0, 0, 0, 4, 4));
+		Regions.push_back(make_region(5, 0, 250, 128, 6, 1));
+		Error += ::test(gli::FORMAT_RGBA8_UNORM_PACK8, 256, gli::FILTER_LINEAR, Regions);
+		Error += ::test(gli::FORMAT_RGBA16_SFLOAT_PACK16, 256, gli::MIPMAP_FILTER_KAISER, Regions);
+
+		// Texels changed in a level other than the base level update the levels below only
+		std::vector<gli::cube_region> LevelRegions;
+		LevelRegions.push_back(make_region(3, 2, 10, 60, 2, 4));
+		LevelRegions.push_back(make_region(1, 2, 0, 60, 4, 4));
+		Error += ::test(gli::FORMAT_RGBA8_UNORM_PACK8, 256, gli::FILTER_LINEAR, LevelRegions, 2);
+		Error += ::test(gli::FORMAT_RGBA32_SFLOAT_PACK32, 256, gli::MIPMAP_FILTER_KAISER, LevelRegions, 2);
+
+		return Error;
+	}
+}//namespace kernel
+
+namespace sampler
+{
+	int test()
+	{
+		int Error = 0;
+
+		// Non power of two extents and formats without a row kernel take the sampler path
+		std::vector<gli::cube_region> Regions;
+		Regions.push_back(make_region(1, 0, 37, 50, 5, 4));
+		Regions.push_back(make_region(4, 0, 92, 0, 4, 2));
+		Error += ::test(gli::FORMAT_RGBA32_SFLOAT_PACK32, 96, gli::FILTER_LINEAR, Regions);
+		Error += ::test(gli::FORMAT_RGBA8_UNORM_PACK8, 100, gli::FILTER_NEAREST, Regions);
+		Error += ::test(gli::FORMAT_RGBA8_UNORM_PACK8, 128, gli::FILTER_NEAREST, Regions);
+
+		return Error;
+	}
+}//namespace sampler
+
+namespace threshold
+{
+	// Footprints of more texels than a job run in parallel, the smaller ones on the calling thread: both match generate_mipmaps
+	template <typename filter_type>
+	int test(gli::format Format, filter_type Minification, int Width)
+	{
+		int Error = 0;
+
+		gli::texture_cube Texture(make_texture(Format, 512, Minification));
+		std::vector<gli::cube_region> Regions;
+		for(gli::size_t Face = 0; Face < Texture.faces(); ++Face)
+			Regions.push_back(make_region(Face, 0, 100, 120, Width, 256));
+		for(std::size_t Index = 0; Index < Regions.size(); ++Index)
+			fill_random(Texture, Regions[Index]);
+
+		gli::update_mipmaps(Texture, Regions, Minification);
+		gli::texture_cube const Reference(gli::generate_mipmaps(gli::texture_cube(gli::duplicate(Texture)), Minification));
+		Error += Texture == Reference ? 0 : 1;
+
+		return Error;
+	}
+}//namespace threshold
+
+int main()
+{
+	int Error = 0;
+
+	Error += kernel::test();
+	Error += sampler::test();
+	Error += threshold::test(gli::FORMAT_RGBA8_UNORM_PACK8, gli::FILTER_LINEAR, 256);
+	Error += threshold::test(gli::FORMAT_RGBA32_SFLOAT_PACK32, gli::MIPMAP_FILTER_KAISER, 256);
+	Error += threshold::test(gli::FORMAT_RGBA8_UNORM_PACK8, gli::FILTER_NEAREST, 8);
+
+	return Error;
+}
@@ -0,0 +1,216 @@
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/gtx/batch_transform.hpp>
+#include <glm/gtc/epsilon.hpp>
+#include <glm/gtc/matrix_inverse.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <random>
+#include <vector>
+
+namespace
+{
+	// Counts covering empty batches, batches shorter than a register and the remainder loops
+	std::size_t const Counts[] = {0, 1, 3, 4, 7, 8, 13, 64, 1001};
+
+	float random(std::minstd_rand& Random)
+	{
+		return static_cast<float>(Random() % 20001) / 10000.0f - 1.0f;
+	}
+
+	glm::mat4 random_matrix(std::minstd_rand& Random)
+	{
+		glm::mat4 const Rotation(glm::rotate(glm::mat4(1.0f), random(Random) * 3.0f, glm::normalize(glm::vec3(random(Random), random(Random), random(Random)) + glm::vec3(0.0f, 0.0f, 2.0f))));
+		glm::mat4 const Scale(glm::scale(glm::mat4(1.0f), glm::vec3(1.5f + random(Random), 1.5f + random(Random), 1.5f + random(Random))));
+		glm::mat4 const Translation(glm::translate(glm::mat4(1.0f), glm::vec3(random(Random), random(Random), random(Random)) * 10.0f));
+		return Translation * Rotation * Scale;
+	}
+
+	bool equal(float A, float B)
+	{
+		return glm::abs(A - B) <= 1e-5f * glm::max(1.0f, glm::max(glm::abs(A), glm::abs(B)));
+	}
+
+	template <typename matrix_type>
+	bool equal(matrix_type const& A, matrix_type const& B)
+	{
+		for(glm::length_t Column = 0; Column < A.length(); ++Column)
+		for(glm::length_t Row = 0; Row < A[Column].length(); ++Row)
+			if(!equal(A[Column][Row], B[Column][Row]))
+				return false;
+		return true;
+	}
+}//namespace
+
+namespace arch
+{
+	int test()
+	{
+		int Error = 0;
+
+		// Detected once, and asking for a wider instruction set than supported falls back to a supported one
+		Error += glm::batchArch() == glm::batchArch() ? 0 : 1;
+		Error += glm::batchArch() >= glm::BATCH_ARCH_SCALAR && glm::batchArch() <= glm::BATCH_ARCH_AVX2 ? 0 : 1;
+
+		glm::mat4 const A(2.0f), B(3.0f);
+		glm::mat4 Result(0.0f);
+		glm::mulBatch(&A, &B, &Result, 1, glm::BATCH_ARCH_AVX2);
+		Error += Result == glm::mat4(6.0f) ? 0 : 1;
+
+		return Error;
+	}
+}//namespace arch
+
+namespace mul_matrix
+{
+	int test()
+	{
+		int Error = 0;
+
+		std::minstd_rand Random(1);
+		for(int Arch = glm::BATCH_ARCH_SCALAR; Arch <= glm::batchArch(); ++Arch)
+		for(std::size_t Index = 0; Index < sizeof(Counts) / sizeof(Counts[0]); ++Index)
+		{
+			std::size_t const Count = Counts[Index];
+			std::vector<glm::mat4> A(Count + 1), B(Count + 1), Result(Count + 1, glm::mat4(0.0f));
+			for(std::size_t i = 0; i < Count; ++i)
+			{
+				A[i] = random_matrix(Random);
+				B[i] = random_matrix(Random);
+			}
+
+			glm::mulBatch(&A[0], &B[0], &Result[0], Count, static_cast<glm::batch_arch>(Arch));
+			for(std::size_t i = 0; i < Count; ++i)
+				Error += equal(Result[i], A[i] * B[i]) ? 0 : 1;
+
+			// Nothing is written past the batch
+			Error += Result[Count] == glm::mat4(0.0f) ? 0 : 1;
+
+			// In place
+			std::vector<glm::mat4> InPlace(A);
+			glm::mulBatch(&InPlace[0], &B[0], &InPlace[0], Count, static_cast<glm::batch_arch>(Arch));
+			for(std::size_t i = 0; i < Count; ++i)
+				Error += equal(InPlace[i], Result[i]) ? 0 : 1;
+		}
+
+		return Error;
+	}
+}//namespace mul_matrix
+
+namespace mul_vector
+{
+	int test()
+	{
+		int Error = 0;
+
+		std::minstd_rand Random(2);
+		glm::mat4 const Matrix(glm::perspective(0.8f, 1.5f, 0.1f, 100.0f) * random_matrix(Random));
+
+		for(int Arch = glm::BATCH_ARCH_SCALAR; Arch <= glm::batchArch(); ++Arch)
+		for(std::size_t Index = 0; Index < sizeof(Counts) / sizeof(Counts[0]); ++Index)
+		{
+			std::size_t const Count = Counts[Index];
+			std::vector<float> X(Count + 1), Y(Count + 1), Z(Count + 1), W(Count + 1), Out(4 * (Count + 1), 0.0f);
+			for(std::size_t i = 0; i < Count; ++i)
+			{
+				X[i] = random(Random);
+				Y[i] = random(Random);
+				Z[i] = random(Random);
+				W[i] = random(Random);
+			}
+
+			glm::soa_vec4<float const> const Vectors = {&X[0], &Y[0], &Z[0], &W[0]};
+			glm::soa_vec4<float> const Result = {&Out[0], &Out[Count + 1], &Out[2 * (Count + 1)], &Out[3 * (Count + 1)]};
+			glm::mulBatch(Matrix, Vectors, Result, Count, static_cast<glm::batch_arch>(Arch));
+
+			for(std::size_t i = 0; i < Count; ++i)
+			{
+				glm::vec4 const Expected(Matrix * glm::vec4(X[i], Y[i], Z[i], W[i]));
+				Error += equal(Result.x[i], Expected.x) && equal(Result.y[i], Expected.y) && equal(Result.z[i], Expected.z) && equal(Result.w[i], Expected.w) ? 0 : 1;
+			}
+			Error += Result.x[Count] == 0.0f && Result.y[Count] == 0.0f && Result.z[Count] == 0.0f && Result.w[Count] == 0.0f ? 0 : 1;
+
+			// In place
+			glm::soa_vec4<float> const InPlace = {&X[0], &Y[0], &Z[0], &W[0]};
+			glm::mulBatch(Matrix, Vectors, InPlace, Count, static_cast<glm::batch_arch>(Arch));
+			for(std::size_t i = 0; i < Count; ++i)
+				Error += X[i] == Result.x[i] && Y[i] == Result.y[i] && Z[i] == Result.z[i] && W[i] == Result.w[i] ? 0 : 1;
+		}
+
+		return Error;
+	}
+}//namespace mul_vector
+
+namespace normalize
+{
+	int test()
+	{
+		int Error = 0;
+
+		std::minstd_rand Random(3);
+		for(int Arch = glm::BATCH_ARCH_SCALAR; Arch <= glm::batchArch(); ++Arch)
+		for(std::size_t Index = 0; Index < sizeof(Counts) / sizeof(Counts[0]); ++Index)
+		{
+			std::size_t const Count = Counts[Index];
+			std::vector<float> X(Count + 1, 0.0f), Y(Count + 1, 0.0f), Z(Count + 1, 0.0f);
+			for(std::size_t i = 0; i < Count; ++i)
+			{
+				X[i] = random(Random) * 100.0f;
+				Y[i] = random(Random) * 100.0f;
+				Z[i] = random(Random) * 100.0f + 200.0f;
+			}
+			std::vector<float> const SourceX(X), SourceY(Y), SourceZ(Z);
+
+			glm::soa_vec3<float const> const Vectors = {&X[0], &Y[0], &Z[0]};
+			glm::soa_vec3<float> const Result = {&X[0], &Y[0], &Z[0]};
+			glm::normalizeBatch(Vectors, Result, Count, static_cast<glm::batch_arch>(Arch));
+
+			for(std::size_t i = 0; i < Count; ++i)
+			{
+				glm::vec3 const Expected(glm::normalize(glm::vec3(SourceX[i], SourceY[i], SourceZ[i])));
+				Error += equal(X[i], Expected.x) && equal(Y[i], Expected.y) && equal(Z[i], Expected.z) ? 0 : 1;
+			}
+			Error += X[Count] == 0.0f && Y[Count] == 0.0f && Z[Count] == 0.0f ? 0 : 1;
+		}
+
+		return Error;
+	}
+}//namespace normalize
+
+namespace inverse_transpose
+{
+	int test()
+	{
+		int Error = 0;
+
+		std::minstd_rand Random(4);
+		for(int Arch = glm::BATCH_ARCH_SCALAR; Arch <= glm::batchArch(); ++Arch)
+		for(std::size_t Index = 0; Index < sizeof(Counts) / sizeof(Counts[0]); ++Index)
+		{
+			std::size_t const Count = Counts[Index];
+			std::vector<glm::mat4> Matrices(Count + 1);
+			for(std::size_t i = 0; i < Count; ++i)
+				Matrices[i] = random_matrix(Random);
+
+			std::vector<glm::mat3> Result(Count + 1, glm::mat3(0.0f));
+			glm::inverseTransposeBatch(&Matrices[0], &Result[0], Count, static_cast<glm::batch_arch>(Arch));
+
+			for(std::size_t i = 0; i < Count; ++i)
+				Error += equal(Result[i], glm::inverseTranspose(glm::mat3(Matrices[i]))) ? 0 : 1;
+			Error += Result[Count] == glm::mat3(0.0f) ? 0 : 1;
+		}
+
+		return Error;
+	}
+}//namespace inverse_transpose
+
+int main()
+{
+	int Error = 0;
+
+	Error += arch::test();
+	Error += mul_matrix::test();
+	Error += mul_vector::test();
+	Error += normalize::test();
+	Error += inverse_transpose::test();
+
+	return Error;
+}
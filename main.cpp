@@ -7,8 +7,11 @@
 #include <fstream>
 #include <string>
 #include <string_view>
+#include <sstream>
 #include <cmath>
 #include <cassert>
+#include <chrono>
+#include <optional>
 
 #define GLEW_STATIC
 #include <GL/glew.h>
@@ -46,6 +49,144 @@ namespace {
 		glm::mat4 MVP;
 	};
 
+	// GPU scopes of the profiler, timed with GL timestamp queries. The queries are created on the first timestamp, once the context exists.
+	class GLTimer : public gli::gpu_timer
+	{
+	public:
+		~GLTimer()
+		{
+			if (queries[0])
+				glDeleteQueries(static_cast<GLsizei>(queries.size()), queries.data());
+		}
+
+		std::uint64_t now() override
+		{
+			GLint64 time{};
+			glGetInteger64v(GL_TIMESTAMP, &time);
+			return static_cast<std::uint64_t>(time);
+		}
+
+		std::uint64_t timestamp() override
+		{
+			if (!queries[0])
+				glCreateQueries(GL_TIMESTAMP, static_cast<GLsizei>(queries.size()), queries.data());
+
+			std::uint64_t handle = next++;
+			glQueryCounter(queries[handle % queries.size()], GL_TIMESTAMP);
+			return handle;
+		}
+
+		bool resolve(std::uint64_t timestamp, std::uint64_t& time) override
+		{
+			GLuint query = queries[timestamp % queries.size()];
+
+			GLint available{};
+			glGetQueryObjectiv(query, GL_QUERY_RESULT_AVAILABLE, &available);
+			if (!available)
+				return false;
+
+			GLuint64 result{};
+			glGetQueryObjectui64v(query, GL_QUERY_RESULT, &result);
+			time = result;
+			return true;
+		}
+
+	private:
+		// Enough for the timestamps of the frames in flight
+		std::array<GLuint, 1024> queries{};
+		std::uint64_t next{};
+	};
+
+	// Fences of the frame ring, as GL sync objects
+	class GLFences : public gli::fence_backend
+	{
+	public:
+		std::uint64_t insert() override
+		{
+			return reinterpret_cast<std::uintptr_t>(glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+		}
+
+		bool wait(std::uint64_t fence, std::uint64_t timeout) override
+		{
+			GLenum result = glClientWaitSync(reinterpret_cast<GLsync>(static_cast<std::uintptr_t>(fence)), GL_SYNC_FLUSH_COMMANDS_BIT, timeout);
+			return result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED;
+		}
+
+		void release(std::uint64_t fence) override
+		{
+			glDeleteSync(reinterpret_cast<GLsync>(static_cast<std::uintptr_t>(fence)));
+		}
+	};
+
+	// Device memory of the textures of the residency manager, as GL cube map textures. Each change of the resident levels allocates
+	// the texture again with only these levels, so that evicted levels free their memory: the levels that stay resident are copied
+	// on the GPU and the new ones are uploaded from the host texture.
+	class GLResidency : public gli::residency_backend
+	{
+	public:
+		bool resident(std::size_t id, const gli::texture& texture, size_type baseLevel, size_type previousBaseLevel) override
+		{
+			if (id >= textures.size())
+				textures.resize(id + 1, 0);
+
+			GLuint previous = textures[id];
+			GLuint next = 0;
+			if (baseLevel < texture.levels())
+			{
+				gli::gl GL(gli::gl::PROFILE_GL33);
+				gli::gl::format const& Format = GL.translate(texture.format(), texture.swizzles());
+				GLsizei const levels = static_cast<GLsizei>(texture.levels() - baseLevel);
+				glm::tvec3<GLsizei> const extent(texture.extent(baseLevel));
+
+				// Bounded: after a context loss, glGetError may keep returning GL_CONTEXT_LOST
+				for (int error = 0; error < 16 && glGetError() != GL_NO_ERROR; ++error) {}
+				glCreateTextures(GL_TEXTURE_CUBE_MAP, 1, &next);
+				glTextureStorage2D(next, levels, Format.Internal, extent.x, extent.y);
+				if (glGetError() == GL_OUT_OF_MEMORY)
+				{
+					glDeleteTextures(1, &next);
+					return false;
+				}
+				glTextureParameteri(next, GL_TEXTURE_MAX_LEVEL, levels - 1);
+				glTextureParameteriv(next, GL_TEXTURE_SWIZZLE_RGBA, &Format.Swizzles[0]);
+
+				for (size_type level = baseLevel; level < texture.levels(); ++level)
+				{
+					glm::tvec3<GLsizei> const levelExtent(texture.extent(level));
+					GLint const nextLevel = static_cast<GLint>(level - baseLevel);
+					if (level >= previousBaseLevel)
+					{
+						glCopyImageSubData(previous, GL_TEXTURE_CUBE_MAP, static_cast<GLint>(level - previousBaseLevel), 0, 0, 0,
+							next, GL_TEXTURE_CUBE_MAP, nextLevel, 0, 0, 0, levelExtent.x, levelExtent.y, static_cast<GLsizei>(texture.faces()));
+						continue;
+					}
+
+					for (size_type face = 0; face < texture.faces(); ++face)
+					{
+						const void* data = texture.data(0, face, level);
+						GLint const zoffset = static_cast<GLint>(face);
+						if (gli::is_compressed(texture.format()))
+							glCompressedTextureSubImage3D(next, nextLevel, 0, 0, zoffset, levelExtent.x, levelExtent.y, 1, Format.Internal, static_cast<GLsizei>(texture.size(level)), data);
+						else
+							glTextureSubImage3D(next, nextLevel, 0, 0, zoffset, levelExtent.x, levelExtent.y, 1, Format.External, Format.Type, data);
+					}
+				}
+			}
+
+			glDeleteTextures(1, &previous);
+			textures[id] = next;
+			return true;
+		}
+
+		GLuint name(std::size_t id) const
+		{
+			return id < textures.size() ? textures[id] : 0;
+		}
+
+	private:
+		std::vector<GLuint> textures;
+	};
+
 	namespace buffer
 	{
 		enum type
@@ -68,8 +209,37 @@ namespace {
 	GLuint render_program{};
 	GLuint vao{};
 	std::array<GLuint, buffer::MAX> buffers{};
-	GLint blockSize{};
-	GLuint skyboxTexture{};
+	// Transient per-frame data, such as transforms, is allocated in the TRANSFORM buffer, mapped once and split between the frames in flight.
+	GLFences frameFences;
+	std::unique_ptr<gli::frame_ring> frameRing;
+	constexpr std::size_t framesInFlight{ 3 };
+	constexpr std::size_t frameRingCapacity{ 64 * 1024 };
+	// Assets load on worker threads while frames present. Each frame, the render thread runs their upload commands for a bounded time.
+	std::unique_ptr<gli::job_system> jobs;
+	std::unique_ptr<gli::texture_cache> textureCache;
+	std::unique_ptr<gli::asset_loader> loader;
+	gli::asset_loader::asset_type skyboxAsset{};
+	gli::asset_loader::asset_type vertexShaderAsset{};
+	gli::asset_loader::asset_type fragmentShaderAsset{};
+	std::string vertexShaderSource;
+	std::string fragmentShaderSource;
+	constexpr std::chrono::microseconds uploadBudget{ 2000 };
+	constexpr const char* skyboxFilename{ "StockholmRoyalCastle.dds" };
+	// Processed textures are kept on disk between launches, keyed by the content of their source and the processing.
+	constexpr const char* textureCacheDirectory{ "cache" };
+	constexpr std::uint64_t textureCacheCapacity{ 1ull << 30 };
+	// The skybox levels resident on the GPU stay within a memory budget, for lower-memory machines. They stream in from the smallest
+	// to the largest, a few megabytes per frame, and the texture is sampled from its first resident level.
+	std::unique_ptr<GLResidency> residencyDevice;
+	std::unique_ptr<gli::residency_manager> residency;
+	std::optional<gli::residency_manager::id_type> skyboxResidency;
+	constexpr std::uint64_t residencyBudget{ 256ull << 20 };
+	constexpr std::uint64_t residencyUploadBytes{ 8ull << 20 };
+	// Frame profiler, enabled by -profile: the frame time percentiles show in the window title and the trace is written on exit.
+	// The timer must be destroyed while the context is current, after the profiler.
+	std::unique_ptr<GLTimer> gpuTimer;
+	std::unique_ptr<gli::profiler> profiler;
+	constexpr const char* profileFilename{ "profile.json" };
 }
 
 // Function Prototypes
@@ -78,22 +248,45 @@ void InitGL();
 void InitProgram();
 void InitBuffer();
 void InitVertexArray();
-void InitTexture();
+void InitAssets();
+void UploadAssets();
+void UpdateResidency();
 void RenderFrame();
+void ShowFrameStatistics(const char* title);
+glm::mat4 SkyboxViewProjection(glm::vec2 rotation, float aspectRatio);
+int RenderHeadless(std::istringstream& arguments);
+int PrecomputeLighting(std::istringstream& arguments);
 void Shutdown();
 void CheckShader(GLuint shader);
 void CheckProgram(GLuint program);
-GLuint CreateShader(std::string_view filename, GLenum shaderType);
+GLuint CreateShader(const std::string& source, GLenum shaderType);
 GLuint CreateProgram(const std::vector<GLuint>& shaders);
-GLuint CreateTexture(const char* filename);
 LRESULT CALLBACK WndProc(HWND, UINT, WPARAM, LPARAM);
 
 
-int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE /*hPrevInstance*/, LPSTR /*lpCmdLine*/, int /*nShowCmd*/)
+int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE /*hPrevInstance*/, LPSTR lpCmdLine, int /*nShowCmd*/)
 {
 	static constexpr const char* APP_TITLE = "Skybox DDS";
 	static constexpr const char* WINDOW_CLASS = "GLWindowClass";
 
+	// -headless renders a single frame on the CPU into an image file, without window nor OpenGL context.
+	// -ibl precomputes the image based lighting of the skybox into files, also without window.
+	// -profile shows frame times in the window title and writes a Chrome trace of the init and frame stages on exit.
+	std::istringstream arguments(lpCmdLine ? lpCmdLine : "");
+	bool profile{ false };
+	if (std::string mode; arguments >> mode)
+	{
+		if (mode == "-headless")
+			return RenderHeadless(arguments);
+		if (mode == "-ibl")
+			return PrecomputeLighting(arguments);
+		profile = mode == "-profile";
+	}
+
+	gpuTimer = std::make_unique<GLTimer>();
+	profiler = std::make_unique<gli::profiler>(gpuTimer.get());
+	profiler->enable(profile);
+
 	WNDCLASSEX wcex = {
 		.cbSize = sizeof(WNDCLASSEX),
 		.style = CS_HREDRAW | CS_VREDRAW,
@@ -142,8 +335,18 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE /*hPrevInstance*/, LPSTR /*lpC
 		}
 		else
 		{
+			{
+				GLI_PROFILE_SCOPE(*profiler, "Wait frame ring");
+				frameRing->begin_frame();
+			}
 			RenderFrame();
-			SwapBuffers(hdc);
+			frameRing->end_frame();
+			{
+				GLI_PROFILE_SCOPE(*profiler, "SwapBuffers");
+				SwapBuffers(hdc);
+			}
+			profiler->end_frame();
+			ShowFrameStatistics(APP_TITLE);
 		}
 	}
 
@@ -218,11 +421,23 @@ bool Init()
 {
 	try
 	{
-		InitGL();
-		InitProgram();
-		InitBuffer();
-		InitVertexArray();
-		InitTexture();
+		GLI_PROFILE_SCOPE(*profiler, "Init");
+		{
+			GLI_PROFILE_SCOPE(*profiler, "InitGL");
+			InitGL();
+		}
+		{
+			GLI_PROFILE_SCOPE(*profiler, "InitBuffer");
+			InitBuffer();
+		}
+		{
+			GLI_PROFILE_SCOPE(*profiler, "InitVertexArray");
+			InitVertexArray();
+		}
+		{
+			GLI_PROFILE_SCOPE(*profiler, "InitAssets");
+			InitAssets();
+		}
 		return true;
 	}
 	catch (const std::exception& e)
@@ -279,8 +494,8 @@ void InitGL()
 
 void InitProgram()
 {
-	auto vs = CreateShader("skybox.vert", GL_VERTEX_SHADER);
-	auto fs = CreateShader("skybox.frag", GL_FRAGMENT_SHADER);
+	auto vs = CreateShader(vertexShaderSource, GL_VERTEX_SHADER);
+	auto fs = CreateShader(fragmentShaderSource, GL_FRAGMENT_SHADER);
 	render_program = CreateProgram({ vs, fs });
 
 	glCreateProgramPipelines(1, &pipeline);
@@ -291,12 +506,17 @@ void InitBuffer()
 {
 	GLint alignment{};
 	glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
-	blockSize = glm::max(GLint(sizeof(Transform)), alignment);
+
+	constexpr GLbitfield transformFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+	const auto transformSize = static_cast<GLsizeiptr>(framesInFlight * frameRingCapacity);
 
 	glCreateBuffers(buffer::MAX, buffers.data());
 	glNamedBufferStorage(buffers[buffer::VERTEX], sizeof(vertices), vertices, 0);
 	glNamedBufferStorage(buffers[buffer::ELEMENT], sizeof(indices), indices, 0);
-	glNamedBufferStorage(buffers[buffer::TRANSFORM], blockSize, nullptr, GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT);
+	glNamedBufferStorage(buffers[buffer::TRANSFORM], transformSize, nullptr, transformFlags);
+
+	void* transforms = glMapNamedBufferRange(buffers[buffer::TRANSFORM], 0, transformSize, transformFlags);
+	frameRing = std::make_unique<gli::frame_ring>(transforms, static_cast<std::size_t>(transformSize), framesInFlight, static_cast<std::size_t>(alignment), frameFences);
 }
 
 void InitVertexArray()
@@ -310,102 +530,220 @@ void InitVertexArray()
 	glVertexArrayElementBuffer(vao, buffers[buffer::ELEMENT]);
 }
 
-void InitTexture()
+void InitAssets()
 {
-	skyboxTexture = CreateTexture("StockholmRoyalCastle.dds");
+	jobs = std::make_unique<gli::job_system>();
+	textureCache = std::make_unique<gli::texture_cache>(textureCacheDirectory, textureCacheCapacity);
+	loader = std::make_unique<gli::asset_loader>(*jobs, textureCache.get());
+	residencyDevice = std::make_unique<GLResidency>();
+	residency = std::make_unique<gli::residency_manager>(*residencyDevice, residencyBudget);
+
+	vertexShaderAsset = loader->load_file("skybox.vert");
+	fragmentShaderAsset = loader->load_file("skybox.frag");
+
+	// Without BC texture support the skybox is decompressed on the workers, only on the first launch: later ones find it in the cache.
+	// Only the header is read here, to pick the decompressed format.
+	gli::cache_recipe recipe;
+	if (gli::reader header; !GLEW_EXT_texture_compression_s3tc && header.open(skyboxFilename) && gli::is_decompressible(header.format(), gli::FORMAT_RGBA8_UNORM_PACK8))
+		recipe.Format = gli::is_srgb(header.format()) ? gli::FORMAT_RGBA8_SRGB_PACK8 : gli::FORMAT_RGBA8_UNORM_PACK8;
+	// The residency manager uploads the levels of the skybox within its budget: the loader only stages the texture
+	skyboxAsset = loader->load_texture(skyboxFilename, recipe, false);
 }
 
-GLuint CreateTexture(const char* filename)
+void UploadAssets()
 {
-	gli::texture Texture = gli::load(filename);
-	if (Texture.empty())
-		return 0;
+	if (!loader || loader->pending() == 0)
+		return;
+
+	GLI_PROFILE_SCOPE(*profiler, "UploadAssets");
+	GLI_PROFILE_GPU_SCOPE(*profiler, "Upload");
 
-	gli::gl GL(gli::gl::PROFILE_GL33);
-	gli::gl::format const& Format = GL.translate(Texture.format(), Texture.swizzles());
-	GLenum Target = GL.translate(Texture.target());
-	//assert(gli::is_compressed(Texture.format()) && Target == gli::TARGET_CUBE);
-
-	GLuint TextureName = 0;
-	glGenTextures(1, &TextureName);
-	glBindTexture(Target, TextureName);
-	glTexParameteri(Target, GL_TEXTURE_BASE_LEVEL, 0);
-	glTexParameteri(Target, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(Texture.levels() - 1));
-	glTexParameteriv(Target, GL_TEXTURE_SWIZZLE_RGBA, &Format.Swizzles[0]);
-	glTexStorage2D(Target, static_cast<GLint>(Texture.levels()), Format.Internal, Texture.extent().x, Texture.extent().y);
-	for (std::size_t Level = 0; Level < Texture.levels(); ++Level)
+	auto upload = [](const gli::upload_command& command)
 	{
-		glm::tvec3<GLsizei> Extent(Texture.extent(Level));
-		for (int face = 0; face < 6; ++face)
+		switch (command.Kind)
 		{
-			glCompressedTexSubImage2D(
-				GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, static_cast<GLint>(Level), 0, 0, Extent.x, Extent.y,
-				Format.Internal, static_cast<GLsizei>(Texture.size(Level)), Texture.data(0, face, Level));
+		case gli::UPLOAD_FILE:
+			(command.Asset == vertexShaderAsset ? vertexShaderSource : fragmentShaderSource).assign(command.Data->begin(), command.Data->end());
+			break;
+		case gli::UPLOAD_TEXTURE:
+			skyboxResidency = residency->insert(command.Texture);
+			break;
+		case gli::UPLOAD_DONE:
+			if (command.Asset != skyboxAsset && !render_program && !vertexShaderSource.empty() && !fragmentShaderSource.empty())
+				InitProgram();
+			break;
+		case gli::UPLOAD_FAILED:
+			throw std::runtime_error(command.Asset == skyboxAsset ? "Could not load the skybox" : "Could not load the shaders");
 		}
+	};
+
+	try
+	{
+		loader->drain(upload, uploadBudget);
+	}
+	catch (const std::exception& e)
+	{
+		MessageBox(nullptr, e.what(), "Exception", MB_OK | MB_ICONERROR);
+		PostQuitMessage(1);
 	}
+}
 
-	return TextureName;
+void UpdateResidency()
+{
+	if (!residency)
+		return;
+
+	GLI_PROFILE_SCOPE(*profiler, "UpdateResidency");
+	GLI_PROFILE_GPU_SCOPE(*profiler, "Residency");
+
+	residency->update(residencyUploadBytes);
 }
 
 void RenderFrame()
 {
+	GLI_PROFILE_SCOPE(*profiler, "RenderFrame");
+
+	UploadAssets();
+	UpdateResidency();
+
+	// The sky covers the screen, its largest level is requested
+	GLuint skyboxTexture{};
+	if (skyboxResidency)
+	{
+		residency->request(*skyboxResidency);
+		skyboxTexture = residencyDevice->name(*skyboxResidency);
+	}
+
 	glEnable(GL_DEPTH_TEST);
 	glDepthFunc(GL_LEQUAL);
 	glDisable(GL_CULL_FACE);
 
 	glEnable(GL_TEXTURE_CUBE_MAP_SEAMLESS);
 
+	gli::frame_allocation transform{};
 	{
-		auto transform = static_cast<Transform*>(glMapNamedBufferRange(buffers[buffer::TRANSFORM], 0,
-			blockSize, GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT | GL_MAP_INVALIDATE_BUFFER_BIT));
+		GLI_PROFILE_SCOPE(*profiler, "Update transform");
 
 		auto aspectRatio = static_cast<float>(windowWidth) / static_cast<float>(windowHeight);
-		glm::mat4 Projection = glm::perspective(glm::pi<float>() * 0.25f, aspectRatio, 0.1f, 1000.0f);
-		glm::mat4 ViewTranslate = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, 0.0f));
-		glm::mat4 ViewRotateX = glm::rotate(glm::mat4(1.0f), glm::radians(-rotation.y), glm::vec3(1.0f, 0.0f, 0.0f));
-		glm::mat4 View = glm::rotate(ViewRotateX, glm::radians(-rotation.x), glm::vec3(0.0f, 1.0f, 0.0f));
 		glm::mat4 Model = glm::scale(glm::mat4(1.0f), glm::vec3(500.0f));
 
-		transform->MVP = Projection * View * Model;
+		transform = frameRing->push(Transform{ SkyboxViewProjection(rotation, aspectRatio) * Model });
+	}
+
+	{
+		GLI_PROFILE_GPU_SCOPE(*profiler, "Clear");
 
-		glUnmapNamedBuffer(buffers[buffer::TRANSFORM]);
+		glViewportIndexedf(0, 0.0f, 0.0f, static_cast<GLfloat>(windowWidth), static_cast<GLfloat>(windowHeight));
+		glClearBufferfv(GL_COLOR, 0, &glm::vec4(0.3f, 0.5f, 0.9f, 1.0f)[0]);
+		glClearBufferfv(GL_DEPTH, 0, &glm::vec4(1.0f)[0]);
 	}
 
-	glViewportIndexedf(0, 0.0f, 0.0f, static_cast<GLfloat>(windowWidth), static_cast<GLfloat>(windowHeight));
-	glClearBufferfv(GL_COLOR, 0, &glm::vec4(0.3f, 0.5f, 0.9f, 1.0f)[0]);
-	glClearBufferfv(GL_DEPTH, 0, &glm::vec4(1.0f)[0]);
+	// The shaders are still loading
+	if (!pipeline || !transform.Data)
+		return;
+
+	GLI_PROFILE_SCOPE(*profiler, "Draw");
+	GLI_PROFILE_GPU_SCOPE(*profiler, "Draw");
 
 	glBindProgramPipeline(pipeline);
 	glBindVertexArray(vao);
-	glBindBufferRange(GL_UNIFORM_BUFFER, 1, buffers[buffer::TRANSFORM], 0, blockSize);
+	// The buffer is coherent: the transform written above is visible to the draw without a flush
+	glBindBufferRange(GL_UNIFORM_BUFFER, 1, buffers[buffer::TRANSFORM], transform.Offset, transform.Size);
 	glBindTextures(0, 1, &skyboxTexture);
 
 	glDrawElements(GL_TRIANGLE_STRIP, 8, GL_UNSIGNED_SHORT, nullptr);
 	glDrawElements(GL_TRIANGLE_STRIP, 8, GL_UNSIGNED_SHORT, (const void*)(8 * sizeof(GLushort)));
 }
 
-GLuint CreateShader(std::string_view filename, GLenum shaderType)
+glm::mat4 SkyboxViewProjection(glm::vec2 rotation, float aspectRatio)
 {
-	auto source = [filename]() {
-		std::string result;
-		std::ifstream stream(filename.data());
+	glm::mat4 Projection = glm::perspective(glm::pi<float>() * 0.25f, aspectRatio, 0.1f, 1000.0f);
+	glm::mat4 ViewRotateX = glm::rotate(glm::mat4(1.0f), glm::radians(-rotation.y), glm::vec3(1.0f, 0.0f, 0.0f));
+	glm::mat4 View = glm::rotate(ViewRotateX, glm::radians(-rotation.x), glm::vec3(0.0f, 1.0f, 0.0f));
 
-		if (!stream.is_open())
-		{
-			throw std::runtime_error("Could not open file: " + std::string(filename));
-
-		}
+	return Projection * View;
+}
 
-		stream.seekg(0, std::ios::end);
-		result.reserve((size_t)stream.tellg());
-		stream.seekg(0, std::ios::beg);
+// Shows the frame time percentiles of the last frames in the window title, twice per second
+void ShowFrameStatistics(const char* title)
+{
+	static std::uint64_t lastUpdate{};
+	if (!profiler->enabled() || profiler->now() - lastUpdate < 500'000'000)
+		return;
+	lastUpdate = profiler->now();
+
+	const auto frames = profiler->frame_statistics();
+	const auto draw = profiler->scope_statistics("Draw", true);
+
+	std::ostringstream text;
+	text.setf(std::ios::fixed);
+	text.precision(2);
+	text << title << " - frame p50 " << frames.P50 * 1e-6 << " ms, p99 " << frames.P99 * 1e-6
+		<< " ms - GPU draw p50 " << draw.P50 * 1e-6 << " ms";
+	SetWindowText(hwnd, text.str().c_str());
+}
 
-		result.assign((std::istreambuf_iterator<char>(stream)),
-			std::istreambuf_iterator<char>());
+// Arguments: output file (.dds or .ktx), then optionally width, height, rotation x and y in degrees, and "half" for an RGBA16F image.
+int RenderHeadless(std::istringstream& arguments)
+{
+	std::string output;
+	int width{ windowWidth };
+	int height{ windowHeight };
+	glm::vec2 headlessRotation(0.0f);
+	std::string format;
+	arguments >> output >> width >> height >> headlessRotation.x >> headlessRotation.y >> format;
+
+	if (output.empty() || width <= 0 || height <= 0)
+		return 1;
+
+	gli::texture_cube skybox(gli::load(skyboxFilename));
+	if (skybox.empty())
+		return 1;
+
+	auto aspectRatio = static_cast<float>(width) / static_cast<float>(height);
+	gli::texture2d frame = gli::render_cube(
+		skybox, glm::inverse(SkyboxViewProjection(headlessRotation, aspectRatio)), gli::texture2d::extent_type(width, height),
+		format == "half" ? gli::FORMAT_RGBA16_SFLOAT_PACK16 : gli::FORMAT_RGBA8_UNORM_PACK8);
+
+	return !frame.empty() && gli::save(frame, output) ? 0 : 1;
+}
 
-		return result;
-	}();
+// Arguments: specular output file (.dds or .ktx) and irradiance output text file, then optionally face size, level count and sample count.
+// The specular cube map is RGBA16F, its levels go from roughness 0 to 1. The irradiance file lists the 9 RGB spherical harmonics coefficients.
+int PrecomputeLighting(std::istringstream& arguments)
+{
+	std::string specularOutput;
+	std::string irradianceOutput;
+	int size{ 128 };
+	int levels{ 6 };
+	int samples{ 128 };
+	arguments >> specularOutput >> irradianceOutput >> size >> levels >> samples;
+
+	if (specularOutput.empty() || irradianceOutput.empty() || size <= 0 || levels <= 0 || samples <= 0)
+		return 1;
+
+	gli::texture_cube skybox(gli::load(skyboxFilename));
+	if (skybox.empty())
+		return 1;
+
+	gli::texture_cube::extent_type extent(size);
+	gli::texture_cube specular = gli::prefilter_ggx(
+		skybox, gli::FORMAT_RGBA16_SFLOAT_PACK16, extent,
+		glm::min(static_cast<gli::texture_cube::size_type>(levels), static_cast<gli::texture_cube::size_type>(gli::levels(extent))),
+		static_cast<std::size_t>(samples));
+	if (specular.empty() || !gli::save(specular, specularOutput))
+		return 1;
+
+	gli::spherical_harmonics irradiance = gli::project_spherical_harmonics(skybox);
+	std::ofstream stream(irradianceOutput);
+	for (const auto& coefficient : irradiance.Coefficients)
+		stream << coefficient.x << ' ' << coefficient.y << ' ' << coefficient.z << '\n';
+
+	return stream ? 0 : 1;
+}
 
+GLuint CreateShader(const std::string& source, GLenum shaderType)
+{
 	const GLchar* src = source.c_str();
 
 	GLuint shader{ glCreateShader(shaderType) };
@@ -484,11 +822,25 @@ void CheckProgram(GLuint program)
 
 void Shutdown()
 {
+	// The loads still running finish before the workers stop
+	loader.reset();
+	jobs.reset();
+	textureCache.reset();
+
+	if (profiler && profiler->enabled())
+		profiler->write_chrome_trace(profileFilename);
+	// The timer queries are deleted while the context is current
+	profiler.reset();
+	gpuTimer.reset();
+	frameRing.reset();
+	// The textures are deleted while the context is current
+	residency.reset();
+	residencyDevice.reset();
+
 	glDeleteProgram(render_program);
 	glDeleteProgramPipelines(1, &pipeline);
 	glDeleteBuffers(buffer::MAX, buffers.data());
 	glDeleteVertexArrays(1, &vao);
-	glDeleteTextures(1, &skyboxTexture);
 
 	if (hwnd)
 	{